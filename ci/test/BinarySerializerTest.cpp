@@ -0,0 +1,232 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdio>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/split_member.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+#include "TestData.hpp"
+#include "io/ByteArrayOutputStream.hpp"
+#include "io/serialize/BinarySerializer.hpp"
+#include "io/serialize/BoostSerializer.hpp"
+
+using namespace common::io;
+using namespace common::io::serialize;
+
+namespace
+{
+enum class Level : uint8_t { LOW, MEDIUM, HIGH };
+
+class Record final : public common::interface::IfaceBoostSerializable<Record>
+{
+public:
+	std::string name;
+	int32_t id = 0;
+	int64_t offset = 0;
+	uint32_t flags = 0;
+	double score = 0;
+	Level level = Level::LOW;
+	std::vector<double> samples;
+	std::vector<std::string> tags;
+	std::map<std::string, int> counters;
+
+	template <class Archive> auto serializeImpl(Archive& archive, unsigned) -> void {
+		archive & BOOST_SERIALIZATION_NVP(name) & BOOST_SERIALIZATION_NVP(id) & BOOST_SERIALIZATION_NVP(offset) & BOOST_SERIALIZATION_NVP(flags);
+		archive & BOOST_SERIALIZATION_NVP(score) & BOOST_SERIALIZATION_NVP(level) & BOOST_SERIALIZATION_NVP(samples);
+		archive & BOOST_SERIALIZATION_NVP(tags) & BOOST_SERIALIZATION_NVP(counters);
+	}
+
+	auto operator==(const Record& other) const -> bool {
+		return name == other.name && id == other.id && offset == other.offset && flags == other.flags && score == other.score && level == other.level && samples == other.samples && tags == other.tags && counters == other.counters;
+	}
+};
+
+/// Saves and loads through separate functions, as split members of Boost types do.
+class Versioned final : public common::interface::IfaceBoostSerializable<Versioned>
+{
+public:
+	std::string text;
+
+	template <class Archive> auto save(Archive& archive, unsigned) const -> void {
+		const auto length = static_cast<uint32_t>(text.size());
+		archive & length;
+		archive.writeBytes(text.data(), text.size());
+	}
+
+	template <class Archive> auto load(Archive& archive, unsigned) -> void {
+		uint32_t length;
+		archive & length;
+		text.resize(length);
+		archive.readBytes(text.data(), length);
+	}
+
+	template <class Archive> auto serializeImpl(Archive& archive, const unsigned version) -> void {
+		boost::serialization::split_member(archive, *this, version);
+	}
+};
+
+class Optionals final : public common::interface::IfaceBoostSerializable<Optionals>
+{
+public:
+	std::optional<int> present;
+	std::optional<std::string> absent;
+	std::array<uint16_t, 3> triple{};
+	std::pair<bool, int8_t> pair;
+
+	template <class Archive> auto serializeImpl(Archive& archive, unsigned) -> void {
+		archive & present & absent & triple & pair;
+	}
+};
+
+auto sampleRecord(const int seed) -> Record {
+	Record record;
+	record.name = "record-" + std::to_string(seed);
+	record.id = seed;
+	record.offset = -static_cast<int64_t>(seed) * 1000003;
+	record.flags = 0xDEADBEEF;
+	record.score = seed * 0.25;
+	record.level = static_cast<Level>(seed % 3);
+	for (int i = 0; i < 64; ++i) {
+		record.samples.push_back(seed + i / 8.0);
+	}
+	record.tags = {"alpha", "beta", "gamma", "delta"};
+	record.counters = {{"hits", seed}, {"misses", -seed}};
+	return record;
+}
+}
+
+TEST(BinarySerializerTest, RoundTripsThroughEveryOutputTarget) {
+	const Record record = sampleRecord(42);
+	const auto bytes = BinarySerializer::serializeObject(record);
+	EXPECT_EQ(BinarySerializer::deserializeObject<Record>(bytes), record);
+
+	std::vector<std::byte> fixed(bytes.size());
+	EXPECT_EQ(BinarySerializer::serializeObject(record, std::span(fixed)), bytes.size());
+	EXPECT_EQ(fixed, bytes);
+
+	ByteArrayOutputStream stream;
+	EXPECT_EQ(BinarySerializer::serializeObject(record, stream), bytes.size());
+	EXPECT_EQ(stream.toByteArray(), bytes);
+}
+
+TEST(BinarySerializerTest, ConsecutiveObjectsShareOneBlock) {
+	std::vector<std::byte> block;
+	for (int i = 0; i < 100; ++i) {
+		BinarySerializer::serializeObject(sampleRecord(i), block);
+	}
+	std::span<const std::byte> rest(block);
+	Record record;
+	for (int i = 0; i < 100; ++i) {
+		rest = rest.subspan(BinarySerializer::deserializeObject(rest, record));
+		ASSERT_EQ(record, sampleRecord(i)) << i;
+	}
+	EXPECT_TRUE(rest.empty());
+}
+
+TEST(BinarySerializerTest, SplitMembersAndStandardWrappers) {
+	Versioned versioned;
+	versioned.text = "split member";
+	EXPECT_EQ(BinarySerializer::deserializeObject<Versioned>(BinarySerializer::serializeObject(versioned)).text, versioned.text);
+
+	Optionals optionals;
+	optionals.present = -7;
+	optionals.triple = {1, 300, 65535};
+	optionals.pair = {true, -128};
+	const auto loaded = BinarySerializer::deserializeObject<Optionals>(BinarySerializer::serializeObject(optionals));
+	EXPECT_EQ(loaded.present, optionals.present);
+	EXPECT_FALSE(loaded.absent.has_value());
+	EXPECT_EQ(loaded.triple, optionals.triple);
+	EXPECT_EQ(loaded.pair, optionals.pair);
+}
+
+TEST(BinarySerializerTest, SmallIntegersTakeOneByte) {
+	Record record;
+	const size_t empty = BinarySerializer::serializeObject(record).size();
+	record.id = 63;
+	EXPECT_EQ(BinarySerializer::serializeObject(record).size(), empty);
+	record.id = -64;
+	EXPECT_EQ(BinarySerializer::serializeObject(record).size(), empty);
+	record.id = 64;
+	EXPECT_EQ(BinarySerializer::serializeObject(record).size(), empty + 1);
+}
+
+TEST(BinarySerializerTest, FixedBufferTooSmallThrows) {
+	const auto bytes = BinarySerializer::serializeObject(sampleRecord(1));
+	std::vector<std::byte> fixed(bytes.size() - 1);
+	EXPECT_THROW(BinarySerializer::serializeObject(sampleRecord(1), std::span(fixed)), std::out_of_range);
+}
+
+TEST(BinarySerializerTest, TruncatedOrMalformedInputThrows) {
+	const auto bytes = BinarySerializer::serializeObject(sampleRecord(7));
+	for (size_t length = 0; length < bytes.size(); ++length) {
+		EXPECT_THROW(BinarySerializer::deserializeObject<Record>(std::span(bytes).first(length)), std::ios_base::failure) << length;
+	}
+	std::vector<std::byte> hugeLength(bytes.size(), std::byte{0xFF});
+	EXPECT_THROW(BinarySerializer::deserializeObject<Record>(hugeLength), std::ios_base::failure);
+}
+
+TEST(BinarySerializerTest, SmallerThanBoostBinaryArchive) {
+	const Record record = sampleRecord(3);
+	EXPECT_LT(BinarySerializer::serializeObject(record).size(), BoostSerializer::serializeObject(record).size());
+	EXPECT_EQ(BoostSerializer::deserializeObject<Record>(BoostSerializer::serializeObject(record)), record);
+}
+
+TEST(BinarySerializerBenchmark, DISABLED_VersusBoostSerializer) {
+	constexpr int count = 1000;
+	constexpr int rounds = 20;
+	std::vector<Record> records;
+	for (int i = 0; i < count; ++i) {
+		records.push_back(sampleRecord(i));
+	}
+	const auto microsecondsPerObject = [&](auto&& work) {
+		const auto start = std::chrono::steady_clock::now();
+		for (int round = 0; round < rounds; ++round) {
+			work();
+		}
+		return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / (count * rounds);
+	};
+	size_t sink = 0;
+
+	std::vector<std::string> boost(count);
+	const double boostSave = microsecondsPerObject([&] {
+		for (int i = 0; i < count; ++i) {
+			boost[i] = BoostSerializer::serializeObject(records[i]);
+		}
+	});
+	const double boostLoad = microsecondsPerObject([&] {
+		for (int i = 0; i < count; ++i) {
+			sink += BoostSerializer::deserializeObject<Record>(boost[i]).samples.size();
+		}
+	});
+
+	std::vector<std::vector<std::byte>> binary(count);
+	const double binarySave = microsecondsPerObject([&] {
+		for (int i = 0; i < count; ++i) {
+			binary[i].clear();
+			BinarySerializer::serializeObject(records[i], binary[i]);
+		}
+	});
+	const double binaryLoad = microsecondsPerObject([&] {
+		for (int i = 0; i < count; ++i) {
+			sink += BinarySerializer::deserializeObject<Record>(binary[i]).samples.size();
+		}
+	});
+	Record reused;
+	const double binaryReuse = microsecondsPerObject([&] {
+		for (int i = 0; i < count; ++i) {
+			BinarySerializer::deserializeObject(binary[i], reused);
+			sink += reused.samples.size();
+		}
+	});
+
+	std::printf("               serialize  deserialize  bytes/object\n");
+	std::printf("Boost          %6.2f us  %6.2f us    %zu\n", boostSave, boostLoad, boost[0].size());
+	std::printf("BinaryArchive  %6.2f us  %6.2f us    %zu  (%.2f us reusing the object)\n", binarySave, binaryLoad, binary[0].size(), binaryReuse);
+	EXPECT_GT(sink, 0U);
+}
@@ -0,0 +1,58 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <vector>
+#include "io/BufferPool.hpp"
+
+using common::io::ByteBufferPool;
+
+TEST(BufferPoolTest, ReusesBufferOfSameClass) {
+	ByteBufferPool pool;
+	auto buffer = pool.acquire(1000);
+	EXPECT_EQ(buffer.size(), 1000U);
+	EXPECT_GE(buffer.capacity(), 1024U);
+	pool.release(std::move(buffer));
+	const auto reused = pool.acquire(600);
+	EXPECT_EQ(reused.size(), 600U);
+	EXPECT_EQ(pool.hits(), 1U);
+	EXPECT_EQ(pool.misses(), 1U);
+}
+
+TEST(BufferPoolTest, OversizedBuffersAreNotRetained) {
+	ByteBufferPool pool;
+	pool.release(std::vector<std::byte>(3 << 20));
+	pool.release(std::vector<std::byte>((1 << 20) + 1));
+	const auto largest = pool.acquire(1 << 20);
+	EXPECT_EQ(pool.hits(), 0U);
+	auto direct = pool.acquire(2 << 20);
+	pool.release(std::move(direct));
+	const auto again = pool.acquire(2 << 20);
+	EXPECT_EQ(pool.hits(), 0U);
+	EXPECT_EQ(pool.misses(), 3U);
+}
+
+TEST(BufferPoolTest, BiggestClassIsRetained) {
+	ByteBufferPool pool;
+	pool.release(pool.acquire(1 << 20));
+	const auto reused = pool.acquire((1 << 19) + 1);
+	EXPECT_EQ(pool.hits(), 1U);
+}
+
+TEST(BufferPoolTest, SharedListHonoursRetentionCap) {
+	ByteBufferPool pool(2);
+	std::vector<std::vector<std::byte>> buffers;
+	for (int i = 0; i < 12; ++i) {
+		buffers.push_back(pool.acquire(1024));
+	}
+	for (auto& buffer : buffers) {
+		pool.release(std::move(buffer));
+	}
+	buffers.clear();
+	for (int i = 0; i < 12; ++i) {
+		buffers.push_back(pool.acquire(1024));
+	}
+	// Eight buffers fit in the thread-local cache and two in the shared list; the last two were freed.
+	EXPECT_EQ(pool.hits(), 10U);
+	EXPECT_EQ(pool.misses(), 14U);
+}
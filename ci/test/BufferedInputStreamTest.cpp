@@ -0,0 +1,311 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "TestData.hpp"
+#include "io/BufferedInputStream.hpp"
+#include "io/ByteArrayInputStream.hpp"
+#include "io/SeekableInputStream.hpp"
+
+using namespace std::chrono_literals;
+using common::io::AbstractInputStream;
+using common::io::BufferedInputStream;
+using common::io::ByteArrayInputStream;
+using common::io::SeekableInputStream;
+using common::thread::ThreadPool;
+
+namespace
+{
+constexpr auto END_OF_STREAM = static_cast<size_t>(-1);
+
+/// Serves bytes from memory in reads of at most the requested size. It can hold one numbered read until released,
+/// fail after a number of bytes, and it records the reads and whether it was closed.
+class ScriptedStream final : public AbstractInputStream
+{
+public:
+	explicit ScriptedStream(std::vector<std::byte> bytes): bytes_(std::move(bytes)) {}
+
+	auto available() -> size_t override {
+		return bytes_.size() - position_;
+	}
+
+	auto read(std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> size_t override {
+		{
+			std::unique_lock lock(mutex_);
+			const size_t number = ++reads_;
+			entered_.notify_all();
+			released_.wait(lock, [this, number] {
+				return number != heldRead_ || released;
+			});
+		}
+		if (position_ >= failAt_) {
+			throw std::ios_base::failure("Scripted read failure");
+		}
+		const size_t count = std::min({len, bytes_.size() - position_, failAt_ - position_});
+		if (count == 0) {
+			return END_OF_STREAM;
+		}
+		std::copy_n(bytes_.begin() + static_cast<std::ptrdiff_t>(position_), count, buffer.begin() + static_cast<std::ptrdiff_t>(offset));
+		position_ += count;
+		return count;
+	}
+
+	auto close() -> void override {
+		closed_ = true;
+	}
+
+	/// Makes read number \p number (counting from 1) wait for release().
+	auto holdRead(const size_t number) -> void {
+		std::lock_guard lock(mutex_);
+		heldRead_ = number;
+	}
+
+	auto release() -> void {
+		std::lock_guard lock(mutex_);
+		released = true;
+		released_.notify_all();
+	}
+
+	/// Waits until the stream has been asked for at least \p count reads.
+	auto awaitReads(const size_t count) -> bool {
+		std::unique_lock lock(mutex_);
+		return entered_.wait_for(lock, 5s, [this, count] {
+			return reads_ >= count;
+		});
+	}
+
+	auto failAt(const size_t position) -> void {
+		failAt_ = position;
+	}
+
+	std::atomic<bool> closed_{false};
+	bool released{false};
+
+private:
+	std::vector<std::byte> bytes_;
+	size_t position_{0};
+	size_t failAt_{static_cast<size_t>(-1)};
+	std::mutex mutex_;
+	std::condition_variable entered_;
+	std::condition_variable released_;
+	size_t heldRead_{0};
+	size_t reads_{0};
+};
+
+/// A seekable stream over memory that counts the bytes it hands out, so a skip can be told apart from a read.
+class MemorySeekable final : public SeekableInputStream
+{
+public:
+	explicit MemorySeekable(std::vector<std::byte> bytes): bytes_(std::move(bytes)) {}
+
+	auto read(std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> size_t override {
+		const size_t count = readAt(position_, std::span(buffer.data() + offset, len));
+		position_ += count;
+		bytesRead += count;
+		return count == 0 && len > 0 ? END_OF_STREAM : count;
+	}
+
+	auto available() -> size_t override {
+		return position_ < bytes_.size() ? bytes_.size() - position_ : 0;
+	}
+
+	auto close() -> void override {}
+
+	/// BufferedInputStream forwards mark() to its source, which has nothing to record.
+	auto mark(int) -> void override {}
+
+	[[nodiscard]] auto position() const -> uint64_t override {
+		return position_;
+	}
+
+	auto seek(const uint64_t position) -> void override {
+		position_ = position;
+		++seeks;
+	}
+
+	auto readAt(const uint64_t offset, const std::span<std::byte> buffer) -> size_t override {
+		if (offset >= bytes_.size()) {
+			return 0;
+		}
+		const size_t count = std::min<size_t>(buffer.size(), bytes_.size() - offset);
+		std::copy_n(bytes_.begin() + static_cast<std::ptrdiff_t>(offset), count, buffer.begin());
+		return count;
+	}
+
+	[[nodiscard]] auto size() const -> uint64_t override {
+		return bytes_.size();
+	}
+
+	size_t bytesRead{0};
+	size_t seeks{0};
+
+private:
+	std::vector<std::byte> bytes_;
+	uint64_t position_{0};
+};
+
+auto makePool(const size_t threads) -> std::shared_ptr<ThreadPool> {
+	return std::make_shared<ThreadPool>(threads, threads, 64, std::chrono::milliseconds(1000));
+}
+
+auto readahead(std::unique_ptr<AbstractInputStream> in, const int size, const std::shared_ptr<ThreadPool>& pool, const size_t depth) -> BufferedInputStream {
+	return {std::move(in), size, pool, depth};
+}
+}
+
+TEST(BufferedInputStreamReadaheadTest, ReadsWholeStreamThenReportsEndOfStream) {
+	const auto pool = makePool(2);
+	for (const size_t length : {size_t{0}, size_t{1}, size_t{64}, size_t{65}, size_t{100000}}) {
+		const auto content = test::randomBytes(length);
+		BufferedInputStream in(std::make_unique<ByteArrayInputStream>(content), 64, pool, 4);
+		EXPECT_EQ(test::readAll(in, 100), content) << length;
+		std::vector<std::byte> buffer(16);
+		EXPECT_EQ(in.read(buffer, 0, buffer.size()), END_OF_STREAM) << length;
+		EXPECT_EQ(in.read(buffer, 0, buffer.size()), END_OF_STREAM) << length;
+		EXPECT_EQ(in.available(), 0U) << length;
+		in.close();
+	}
+}
+
+TEST(BufferedInputStreamReadaheadTest, SingleByteReadsAndSkipMatchSource) {
+	const auto pool = makePool(2);
+	const auto content = test::randomBytes(5000);
+	BufferedInputStream in(std::make_unique<ByteArrayInputStream>(content), 128, pool, 3);
+	EXPECT_EQ(in.read(), content[0]);
+	EXPECT_EQ(in.skip(1000), 1000U);
+	EXPECT_EQ(in.read(), content[1001]);
+	EXPECT_FALSE(in.markSupported());
+	EXPECT_THROW(in.mark(10), std::runtime_error);
+	EXPECT_THROW(in.reset(), std::runtime_error);
+	EXPECT_EQ(in.skip(10000), 5000U - 1002);
+}
+
+TEST(BufferedInputStreamReadaheadTest, WorkerExceptionIsRethrownOnceAfterBufferedBytes) {
+	const auto pool = makePool(2);
+	const auto content = test::randomBytes(1000);
+	auto source = std::make_unique<ScriptedStream>(content);
+	source->failAt(300);
+	BufferedInputStream in(std::move(source), 100, pool, 4);
+	std::vector<std::byte> buffer(100);
+	std::vector<std::byte> received;
+	try {
+		while (true) {
+			const size_t count = in.read(buffer, 0, buffer.size());
+			if (count == END_OF_STREAM) {
+				break;
+			}
+			received.insert(received.end(), buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(count));
+		}
+		ADD_FAILURE() << "The read failure was not rethrown";
+	}
+	catch (const std::ios_base::failure&) {
+		// The error surfaces only after the bytes read before it.
+	}
+	EXPECT_EQ(received, std::vector(content.begin(), content.begin() + 300));
+	EXPECT_EQ(in.read(buffer, 0, buffer.size()), END_OF_STREAM);
+}
+
+TEST(BufferedInputStreamReadaheadTest, CloseWaitsForReadInFlight) {
+	const auto pool = makePool(2);
+	auto source = std::make_unique<ScriptedStream>(test::randomBytes(10000));
+	auto* scripted = source.get();
+	scripted->holdRead(3);
+	BufferedInputStream in(std::move(source), 100, pool, 2);
+	std::vector<std::byte> buffer(100);
+	ASSERT_EQ(in.read(buffer, 0, buffer.size()), 100U);
+	ASSERT_EQ(in.read(buffer, 0, buffer.size()), 100U);
+	// Taking the second buffer started the task again, and it is now blocked in the third read.
+	ASSERT_TRUE(scripted->awaitReads(3));
+	std::atomic<bool> closed{false};
+	std::thread closer([&] {
+		in.close();
+		closed = true;
+	});
+	std::this_thread::sleep_for(50ms);
+	EXPECT_FALSE(closed.load());
+	EXPECT_FALSE(scripted->closed_.load());
+	scripted->release();
+	closer.join();
+	EXPECT_TRUE(closed.load());
+	EXPECT_TRUE(scripted->closed_.load());
+}
+
+TEST(BufferedInputStreamReadaheadTest, DestructorWaitsForReadInFlight) {
+	const auto pool = makePool(2);
+	auto source = std::make_unique<ScriptedStream>(test::randomBytes(10000));
+	auto* scripted = source.get();
+	scripted->holdRead(2);
+	std::atomic<bool> destroyed{false};
+	std::atomic<bool> releasedBeforeDestruction{false};
+	std::thread releaser;
+	{
+		BufferedInputStream in(std::move(source), 100, pool, 2);
+		std::vector<std::byte> buffer(100);
+		ASSERT_EQ(in.read(buffer, 0, buffer.size()), 100U);
+		ASSERT_TRUE(scripted->awaitReads(2));
+		releaser = std::thread([&] {
+			std::this_thread::sleep_for(50ms);
+			releasedBeforeDestruction = !destroyed.load();
+			scripted->release();
+		});
+	}
+	destroyed = true;
+	releaser.join();
+	// The source is owned by the stream, so a destructor that did not wait would leave the task reading freed memory.
+	EXPECT_TRUE(releasedBeforeDestruction.load());
+}
+
+TEST(BufferedInputStreamReadaheadTest, RejectsInvalidArguments) {
+	const auto content = test::randomBytes(10);
+	EXPECT_THROW(readahead(std::make_unique<ByteArrayInputStream>(content), 64, nullptr, 2), std::invalid_argument);
+	EXPECT_THROW(readahead(std::make_unique<ByteArrayInputStream>(content), 64, makePool(1), 0), std::invalid_argument);
+}
+
+TEST(BufferedInputStreamTest, SkipInsideBufferDoesNotTouchSource) {
+	const auto content = test::randomBytes(10000);
+	auto source = std::make_unique<MemorySeekable>(content);
+	auto* memory = source.get();
+	BufferedInputStream in(std::move(source), 256);
+	EXPECT_EQ(in.read(), content[0]);
+	EXPECT_EQ(memory->bytesRead, 256U);
+	EXPECT_EQ(in.skip(200), 200U);
+	EXPECT_EQ(in.read(), content[201]);
+	EXPECT_EQ(in.skip(54), 54U);
+	EXPECT_EQ(memory->seeks, 0U);
+	EXPECT_EQ(memory->bytesRead, 256U);
+	EXPECT_EQ(in.available(), 10000U - 256);
+}
+
+TEST(BufferedInputStreamTest, SkipBeyondBufferSeeksSource) {
+	const auto content = test::randomBytes(10000);
+	auto source = std::make_unique<MemorySeekable>(content);
+	auto* memory = source.get();
+	BufferedInputStream in(std::move(source), 256);
+	EXPECT_EQ(in.read(), content[0]);
+	EXPECT_EQ(in.skip(5000), 5000U);
+	EXPECT_EQ(memory->seeks, 1U);
+	EXPECT_EQ(memory->bytesRead, 256U);
+	EXPECT_EQ(in.read(), content[5001]);
+	EXPECT_EQ(memory->position(), 5002U + 255);
+	// Skipping past the end stops at the end of the stream.
+	EXPECT_EQ(in.skip(100000), 10000U - 5002);
+	EXPECT_EQ(in.read(), static_cast<std::byte>(-1));
+}
+
+TEST(BufferedInputStreamTest, SkipWithMarkReadsThrough) {
+	const auto content = test::randomBytes(10000);
+	auto source = std::make_unique<MemorySeekable>(content);
+	auto* memory = source.get();
+	BufferedInputStream in(std::move(source), 256);
+	EXPECT_EQ(in.read(), content[0]);
+	in.mark(10000);
+	EXPECT_EQ(in.skip(1000), 1000U);
+	EXPECT_EQ(memory->seeks, 0U);
+	EXPECT_GE(memory->bytesRead, 1001U);
+	EXPECT_EQ(in.read(), content[1001]);
+}
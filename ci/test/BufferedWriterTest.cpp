@@ -0,0 +1,59 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include "io/BufferedWriter.hpp"
+
+using common::io::BufferedWriter;
+using common::io::CharBufferPool;
+
+namespace
+{
+auto readFile(const std::filesystem::path& path) -> std::string {
+	const std::ifstream in(path, std::ios::binary);
+	std::ostringstream contents;
+	contents << in.rdbuf();
+	return contents.str();
+}
+
+class BufferedWriterTest : public testing::Test
+{
+protected:
+	std::filesystem::path path_ = std::filesystem::temp_directory_path() / "BufferedWriterTest.txt";
+
+	void TearDown() override {
+		std::filesystem::remove(path_);
+	}
+};
+}
+
+TEST_F(BufferedWriterTest, WritesAfterCloseThrow) {
+	auto pool = std::make_shared<CharBufferPool>();
+	BufferedWriter writer(std::make_unique<std::ofstream>(path_), 16, pool);
+	writer.write(std::string("hello"));
+	writer.close();
+	EXPECT_THROW(writer.write(std::string("lost")), std::runtime_error);
+	EXPECT_THROW(writer.append('x'), std::runtime_error);
+	EXPECT_THROW(writer.append(std::string("lost")), std::runtime_error);
+	EXPECT_THROW(writer.flush(), std::runtime_error);
+	EXPECT_EQ(readFile(path_), "hello");
+}
+
+TEST_F(BufferedWriterTest, CloseTwiceReleasesPooledBufferOnce) {
+	auto pool = std::make_shared<CharBufferPool>();
+	{
+		BufferedWriter writer(std::make_unique<std::ofstream>(path_), 1024, pool);
+		writer.append(std::string("data")).newLine();
+		writer.close();
+		EXPECT_NO_THROW(writer.close());
+	}
+	EXPECT_EQ(readFile(path_), "data\n");
+	const auto first = pool->acquire(1024);
+	const auto second = pool->acquire(1024);
+	EXPECT_EQ(pool->hits(), 1U);
+	EXPECT_EQ(pool->misses(), 2U);
+}
@@ -0,0 +1,172 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <vector>
+#include "TestData.hpp"
+#include "io/ByteArrayOutputStream.hpp"
+
+using common::io::AbstractOutputStream;
+using common::io::ByteArrayOutputStream;
+
+namespace
+{
+constexpr size_t CHUNK = 16;
+
+/// Records the length of every block written, to check that chunks are handed over one write each.
+class BlockRecorder final : public AbstractOutputStream
+{
+public:
+	using AbstractOutputStream::write;
+
+	auto write(const std::byte b) -> void override {
+		bytes.push_back(b);
+		blocks.push_back(1);
+	}
+
+	auto write(const std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> void override {
+		bytes.insert(bytes.end(), buffer.begin() + static_cast<std::ptrdiff_t>(offset), buffer.begin() + static_cast<std::ptrdiff_t>(offset + len));
+		blocks.push_back(len);
+	}
+
+	auto flush() -> void override {}
+
+	auto close() -> void override {}
+
+	std::vector<std::byte> bytes;
+	std::vector<size_t> blocks;
+};
+
+auto chunked(const std::vector<std::byte>& content) -> ByteArrayOutputStream {
+	ByteArrayOutputStream out(ByteArrayOutputStream::Mode::CHUNKED, CHUNK);
+	out.write(content, 0, content.size());
+	return out;
+}
+
+auto joined(const std::vector<std::span<const std::byte>>& spans) -> std::vector<std::byte> {
+	std::vector<std::byte> bytes;
+	for (const auto& span : spans) {
+		bytes.insert(bytes.end(), span.begin(), span.end());
+	}
+	return bytes;
+}
+
+auto sizes(const std::vector<std::span<const std::byte>>& spans) -> std::vector<size_t> {
+	std::vector<size_t> result;
+	for (const auto& span : spans) {
+		result.push_back(span.size());
+	}
+	return result;
+}
+}
+
+TEST(ByteArrayOutputStreamTest, EmptyStreamHasNoSpansOrChunks) {
+	for (const auto mode : {ByteArrayOutputStream::Mode::CONTIGUOUS, ByteArrayOutputStream::Mode::CHUNKED}) {
+		ByteArrayOutputStream out(mode, CHUNK);
+		EXPECT_TRUE(out.spans().empty());
+		BlockRecorder recorder;
+		out.writeTo(recorder);
+		EXPECT_TRUE(recorder.bytes.empty());
+		EXPECT_TRUE(out.releaseChunks().empty());
+		EXPECT_TRUE(out.release().empty());
+		out.write(std::byte{1});
+		out.reset();
+		EXPECT_TRUE(out.spans().empty());
+		EXPECT_TRUE(out.releaseChunks().empty());
+	}
+}
+
+TEST(ByteArrayOutputStreamTest, ChunksFillExactlyBeforeTheNextIsAllocated) {
+	// Chunk sizes double: 16, 32, 64, so 48 bytes fill the first two chunks exactly.
+	const auto content = test::randomBytes(48);
+	auto out = chunked(content);
+	EXPECT_EQ(sizes(out.spans()), (std::vector<size_t>{16, 32}));
+	EXPECT_EQ(joined(out.spans()), content);
+	out.write(std::byte{7});
+	EXPECT_EQ(sizes(out.spans()), (std::vector<size_t>{16, 32, 1}));
+	EXPECT_EQ(out.size(), 49U);
+}
+
+TEST(ByteArrayOutputStreamTest, SpansOverFullChunksSurviveLaterWrites) {
+	auto out = chunked(test::randomBytes(CHUNK));
+	const auto first = out.spans().front();
+	const std::vector copy(first.begin(), first.end());
+	for (int i = 0; i < 1000; ++i) {
+		out.write(std::byte{0x5A});
+	}
+	EXPECT_EQ(out.spans().front().data(), first.data());
+	EXPECT_EQ(std::vector(first.begin(), first.end()), copy);
+}
+
+TEST(ByteArrayOutputStreamTest, WriteToHandsOverOneBlockPerChunk) {
+	for (const size_t length : {size_t{1}, CHUNK - 1, CHUNK, CHUNK + 1, size_t{48}, size_t{1000}}) {
+		const auto content = test::randomBytes(length);
+		const auto out = chunked(content);
+		BlockRecorder recorder;
+		out.writeTo(recorder);
+		EXPECT_EQ(recorder.bytes, content) << length;
+		EXPECT_EQ(recorder.blocks, sizes(out.spans())) << length;
+		ByteArrayOutputStream chunkedTarget(ByteArrayOutputStream::Mode::CHUNKED, 7);
+		chunkedTarget.write(std::byte{0xEE});
+		out.writeTo(chunkedTarget);
+		auto expected = content;
+		expected.insert(expected.begin(), std::byte{0xEE});
+		EXPECT_EQ(chunkedTarget.toByteArray(), expected) << length;
+		ByteArrayOutputStream contiguousTarget;
+		out.writeTo(contiguousTarget);
+		EXPECT_EQ(contiguousTarget.toByteArray(), content) << length;
+	}
+}
+
+TEST(ByteArrayOutputStreamTest, ReleaseJoinsChunksAndLeavesStreamReusable) {
+	const auto content = test::randomBytes(100);
+	auto out = chunked(content);
+	EXPECT_EQ(out.release(), content);
+	EXPECT_EQ(out.size(), 0U);
+	EXPECT_TRUE(out.spans().empty());
+	out.write(content, 0, 10);
+	EXPECT_EQ(out.release(), std::vector(content.begin(), content.begin() + 10));
+	ByteArrayOutputStream contiguous(4);
+	contiguous.write(content, 0, content.size());
+	EXPECT_EQ(contiguous.release(), content);
+	contiguous.write(std::byte{3});
+	EXPECT_EQ(contiguous.toByteArray(), std::vector{std::byte{3}});
+}
+
+TEST(ByteArrayOutputStreamTest, ReleaseChunksMovesChunksTrimmedToTheirContent) {
+	const auto content = test::randomBytes(60);
+	auto out = chunked(content);
+	const auto* firstChunk = out.spans().front().data();
+	auto chunks = out.releaseChunks();
+	ASSERT_EQ(chunks.size(), 3U);
+	EXPECT_EQ(chunks[0].data(), firstChunk);
+	EXPECT_EQ(chunks[0].size(), 16U);
+	EXPECT_EQ(chunks[1].size(), 32U);
+	EXPECT_EQ(chunks[2].size(), 12U);
+	std::vector<std::byte> rejoined;
+	for (const auto& chunk : chunks) {
+		rejoined.insert(rejoined.end(), chunk.begin(), chunk.end());
+	}
+	EXPECT_EQ(rejoined, content);
+	EXPECT_EQ(out.size(), 0U);
+	// Exactly full chunks are returned whole.
+	auto full = chunked(test::randomBytes(48));
+	EXPECT_EQ(full.releaseChunks().size(), 2U);
+	ByteArrayOutputStream contiguous;
+	contiguous.write(content, 0, content.size());
+	const auto single = contiguous.releaseChunks();
+	ASSERT_EQ(single.size(), 1U);
+	EXPECT_EQ(single[0], content);
+}
+
+TEST(ByteArrayOutputStreamTest, ResetKeepsFirstChunkForReuse) {
+	auto out = chunked(test::randomBytes(200));
+	const auto* firstChunk = out.spans().front().data();
+	out.reset();
+	EXPECT_EQ(out.size(), 0U);
+	const auto content = test::randomBytes(20);
+	out.write(content, 0, content.size());
+	EXPECT_EQ(out.spans().front().data(), firstChunk);
+	EXPECT_EQ(out.toByteArray(), content);
+	EXPECT_THROW(out.write(content, 15, 10), std::out_of_range);
+	EXPECT_THROW(ByteArrayOutputStream(ByteArrayOutputStream::Mode::CHUNKED, 0), std::invalid_argument);
+}
@@ -0,0 +1,134 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "TestData.hpp"
+#include "io/ByteArrayInputStream.hpp"
+#include "io/ByteArrayOutputStream.hpp"
+#include "io/ChecksumInputStream.hpp"
+#include "io/ChecksumOutputStream.hpp"
+#include "io/Crc32c.hpp"
+#include "io/XxHash64.hpp"
+
+using namespace common::io;
+
+namespace
+{
+auto bytesOf(const std::string_view text) -> std::vector<std::byte> {
+	std::vector<std::byte> bytes(text.size());
+	std::memcpy(bytes.data(), text.data(), text.size());
+	return bytes;
+}
+
+auto checksumWritten(const std::vector<std::byte>& data, const Checksum::Algorithm algorithm, const size_t writeSize) -> uint64_t {
+	const auto sink = std::make_shared<ByteArrayOutputStream>();
+	ChecksumOutputStream out(sink, algorithm);
+	for (size_t offset = 0; offset < data.size(); offset += writeSize) {
+		out.write(data, offset, std::min(writeSize, data.size() - offset));
+	}
+	EXPECT_EQ(out.getCount(), data.size());
+	EXPECT_EQ(sink->toByteArray(), data);
+	return out.getChecksum();
+}
+
+auto checksumRead(const std::vector<std::byte>& data, const Checksum::Algorithm algorithm, const size_t readSize) -> uint64_t {
+	ChecksumInputStream in(std::make_unique<ByteArrayInputStream>(data), algorithm);
+	EXPECT_EQ(test::readAll(in, readSize), data);
+	EXPECT_EQ(in.getCount(), data.size());
+	return in.getChecksum();
+}
+}
+
+TEST(ChecksumStreamTest, Crc32cMatchesReferenceVectors) {
+	EXPECT_EQ(Crc32c::compute(bytesOf("")), 0U);
+	EXPECT_EQ(Crc32c::compute(bytesOf("123456789")), 0xE3069283U);
+	EXPECT_EQ(Crc32c::compute(std::vector<std::byte>(32)), 0x8A9136AAU);
+	EXPECT_EQ(Crc32c::compute(std::vector<std::byte>(32, std::byte{0xFF})), 0x62A8AB43U);
+}
+
+TEST(ChecksumStreamTest, XxHash64MatchesReferenceVectors) {
+	EXPECT_EQ(XxHash64::hash(bytesOf("")), 0xEF46DB3751D8E999ULL);
+	EXPECT_EQ(XxHash64::hash(bytesOf("abc")), 0x44BC2CF5AD770999ULL);
+}
+
+TEST(ChecksumStreamTest, ResultIsIndependentOfHowInputIsSplit) {
+	const auto data = test::randomBytes(100003);
+	const uint64_t crc = Crc32c::compute(data);
+	const uint64_t hash = XxHash64::hash(data);
+	for (const size_t chunk : {1UL, 7UL, 31UL, 32UL, 33UL, 4096UL, 100003UL}) {
+		EXPECT_EQ(checksumWritten(data, Checksum::Algorithm::CRC32C, chunk), crc) << "write " << chunk;
+		EXPECT_EQ(checksumRead(data, Checksum::Algorithm::CRC32C, chunk), crc) << "read " << chunk;
+		EXPECT_EQ(checksumWritten(data, Checksum::Algorithm::XXH64, chunk), hash) << "write " << chunk;
+		EXPECT_EQ(checksumRead(data, Checksum::Algorithm::XXH64, chunk), hash) << "read " << chunk;
+	}
+}
+
+TEST(ChecksumStreamTest, ByteWiseReadStopsAtEndWithoutCountingIt) {
+	const std::vector data(5, std::byte{0xFF});
+	ChecksumInputStream in(std::make_unique<ByteArrayInputStream>(data));
+	for (size_t i = 0; i < data.size(); ++i) {
+		ASSERT_EQ(in.read(), std::byte{0xFF});
+	}
+	in.read();
+	EXPECT_EQ(in.getCount(), data.size());
+	EXPECT_EQ(in.getChecksum(), Crc32c::compute(data));
+}
+
+TEST(ChecksumStreamTest, SkippedBytesAreChecksummed) {
+	const auto data = test::accessLog(50000);
+	ChecksumInputStream in(std::make_unique<ByteArrayInputStream>(data), Checksum::Algorithm::XXH64);
+	EXPECT_EQ(in.skip(20000), 20000U);
+	test::readAll(in);
+	EXPECT_EQ(in.getChecksum(), XxHash64::hash(data));
+	EXPECT_EQ(in.skip(10), 0U);
+}
+
+TEST(ChecksumStreamTest, ResetChecksumStartsNextPayload) {
+	const auto first = test::accessLog(1000);
+	const auto second = test::randomBytes(1000);
+	ChecksumOutputStream out(std::make_shared<ByteArrayOutputStream>());
+	out.write(first);
+	EXPECT_EQ(out.getChecksum(), Crc32c::compute(first));
+	out.resetChecksum();
+	out.write(second);
+	EXPECT_EQ(out.getChecksum(), Crc32c::compute(second));
+	EXPECT_EQ(out.getCount(), second.size());
+}
+
+TEST(ChecksumStreamTest, MarkAndResetAreRejected) {
+	ChecksumInputStream in(std::make_unique<ByteArrayInputStream>(test::randomBytes(16)));
+	EXPECT_FALSE(in.markSupported());
+	EXPECT_THROW(in.reset(), std::exception);
+}
+
+TEST(ChecksumStreamBenchmark, DISABLED_Throughput) {
+	const auto data = test::randomBytes(64 << 20);
+	constexpr size_t chunk = 64 << 10;
+	std::printf("crc32c hardware: %s\n", Crc32c::hardwareAccelerated() ? "yes" : "no");
+	uint64_t sink = 0;
+	const double crc = test::megabytesPerSecond(data.size(), [&] { sink ^= Crc32c::compute(data); });
+	const double xxh = test::megabytesPerSecond(data.size(), [&] { sink ^= XxHash64::hash(data); });
+	std::printf("raw     crc32c %8.0f MB/s  xxh64 %8.0f MB/s\n", crc, xxh);
+	for (const auto algorithm : {Checksum::Algorithm::CRC32C, Checksum::Algorithm::XXH64}) {
+		const char* name = algorithm == Checksum::Algorithm::CRC32C ? "crc32c" : "xxh64";
+		const double write = test::megabytesPerSecond(data.size(), [&] {
+			const auto out = std::make_shared<ByteArrayOutputStream>(data.size());
+			ChecksumOutputStream checksum(out, algorithm);
+			for (size_t offset = 0; offset < data.size(); offset += chunk) {
+				checksum.write(data, offset, chunk);
+			}
+			sink ^= checksum.getChecksum();
+		});
+		ChecksumInputStream checksum(std::make_unique<ByteArrayInputStream>(data), algorithm);
+		std::vector<std::byte> buffer(chunk);
+		const double read = test::megabytesPerSecond(data.size(), [&] {
+			while (checksum.read(buffer, 0, chunk) == chunk) {}
+			sink ^= checksum.getChecksum();
+		});
+		std::printf("stream  %-6s  write %8.0f MB/s  read %8.0f MB/s\n", name, write, read);
+	}
+	EXPECT_NE(sink, 1U);
+}
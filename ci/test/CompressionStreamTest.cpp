@@ -0,0 +1,118 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "TestData.hpp"
+#include "io/ByteArrayInputStream.hpp"
+#include "io/ByteArrayOutputStream.hpp"
+#include "io/DeflateOutputStream.hpp"
+#include "io/InflateInputStream.hpp"
+#include "io/Lz4InputStream.hpp"
+#include "io/Lz4OutputStream.hpp"
+
+using namespace common::io;
+
+namespace
+{
+auto deflate(const std::vector<std::byte>& data, const int level, const bool gzip = false, const size_t writeSize = 4096) -> std::vector<std::byte> {
+	const auto sink = std::make_shared<ByteArrayOutputStream>();
+	DeflateOutputStream out(sink, level, gzip);
+	for (size_t offset = 0; offset < data.size(); offset += writeSize) {
+		out.write(data, offset, std::min(writeSize, data.size() - offset));
+	}
+	out.finish();
+	return sink->toByteArray();
+}
+
+auto inflate(const std::vector<std::byte>& compressed, const size_t readSize = 4096) -> std::vector<std::byte> {
+	InflateInputStream in(std::make_unique<ByteArrayInputStream>(compressed));
+	return test::readAll(in, readSize);
+}
+
+auto lz4(const std::vector<std::byte>& data, const size_t blockSize = Lz4OutputStream::DEFAULT_BLOCK_SIZE, const size_t writeSize = 4096) -> std::vector<std::byte> {
+	const auto sink = std::make_shared<ByteArrayOutputStream>();
+	Lz4OutputStream out(sink, Lz4Codec::DEFAULT_ACCELERATION, blockSize);
+	for (size_t offset = 0; offset < data.size(); offset += writeSize) {
+		out.write(data, offset, std::min(writeSize, data.size() - offset));
+	}
+	out.finish();
+	return sink->toByteArray();
+}
+
+auto unlz4(const std::vector<std::byte>& compressed, const size_t readSize = 4096) -> std::vector<std::byte> {
+	Lz4InputStream in(std::make_unique<ByteArrayInputStream>(compressed));
+	return test::readAll(in, readSize);
+}
+}
+
+TEST(CompressionStreamTest, DeflateRoundTripsAtEveryLevel) {
+	const auto data = test::accessLog(300000);
+	for (const int level : {0, 1, 6, 9}) {
+		const auto compressed = deflate(data, level);
+		EXPECT_EQ(inflate(compressed), data) << "level " << level;
+		if (level > 0) {
+			EXPECT_LT(compressed.size(), data.size() / 3) << "level " << level;
+		}
+	}
+}
+
+TEST(CompressionStreamTest, GzipRoundTripsWithOddChunkSizes) {
+	const auto data = test::accessLog(200000);
+	const auto compressed = deflate(data, 6, true, 777);
+	ASSERT_GE(compressed.size(), 2U);
+	EXPECT_EQ(compressed[0], std::byte{0x1F});
+	EXPECT_EQ(compressed[1], std::byte{0x8B});
+	EXPECT_EQ(inflate(compressed, 333), data);
+}
+
+TEST(CompressionStreamTest, InflateByteWise) {
+	const auto data = test::accessLog(5000);
+	InflateInputStream in(std::make_unique<ByteArrayInputStream>(deflate(data, 6)));
+	for (const std::byte expected : data) {
+		ASSERT_EQ(in.read(), expected);
+	}
+	EXPECT_EQ(in.read(), static_cast<std::byte>(-1));
+}
+
+TEST(CompressionStreamTest, Lz4RoundTripsCompressibleAndRandomData) {
+	const auto text = test::accessLog(500000);
+	const auto compressedText = lz4(text, 16384, 1000);
+	EXPECT_LT(compressedText.size(), text.size() / 2);
+	EXPECT_EQ(unlz4(compressedText, 555), text);
+	const auto noise = test::randomBytes(100000);
+	const auto compressedNoise = lz4(noise);
+	EXPECT_LE(compressedNoise.size(), noise.size() + noise.size() / 100 + 64);
+	EXPECT_EQ(unlz4(compressedNoise), noise);
+}
+
+TEST(CompressionStreamTest, EmptyInputRoundTrips) {
+	EXPECT_TRUE(inflate(deflate({}, 6)).empty());
+	EXPECT_TRUE(unlz4(lz4({})).empty());
+}
+
+TEST(CompressionStreamTest, TruncatedDeflateStreamFails) {
+	auto compressed = deflate(test::accessLog(100000), 6);
+	compressed.resize(compressed.size() / 2);
+	EXPECT_ANY_THROW(inflate(compressed));
+}
+
+/// Prints MB/s and ratio for each codec over 16 MB of access-log text; run with --gtest_also_run_disabled_tests.
+TEST(CompressionStreamBenchmark, DISABLED_ThroughputAndRatio) {
+	const auto data = test::accessLog(16 * 1000 * 1000);
+	for (const int level : {1, 6}) {
+		std::vector<std::byte> compressed;
+		const double compress = test::megabytesPerSecond(data.size(), [&] { compressed = deflate(data, level, false, 65536); });
+		std::vector<std::byte> restored;
+		const double decompress = test::megabytesPerSecond(data.size(), [&] { restored = inflate(compressed, 65536); });
+		ASSERT_EQ(restored, data);
+		std::printf("deflate level %d: ratio %.2f, compress %.0f MB/s, decompress %.0f MB/s\n", level, static_cast<double>(data.size()) / static_cast<double>(compressed.size()), compress, decompress);
+	}
+	std::vector<std::byte> compressed;
+	const double compress = test::megabytesPerSecond(data.size(), [&] { compressed = lz4(data, Lz4OutputStream::DEFAULT_BLOCK_SIZE, 65536); });
+	std::vector<std::byte> restored;
+	const double decompress = test::megabytesPerSecond(data.size(), [&] { restored = unlz4(compressed, 65536); });
+	ASSERT_EQ(restored, data);
+	std::printf("lz4: ratio %.2f, compress %.0f MB/s, decompress %.0f MB/s\n", static_cast<double>(data.size()) / static_cast<double>(compressed.size()), compress, decompress);
+}
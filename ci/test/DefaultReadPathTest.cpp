@@ -0,0 +1,239 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+#include "TestData.hpp"
+#include "io/AbstractInputStream.hpp"
+#include "io/AbstractReader.hpp"
+#include "io/BufferedInputStream.hpp"
+#include "io/BufferedReader.hpp"
+#include "io/ByteArrayInputStream.hpp"
+#include "io/CharArrayReader.hpp"
+#include "io/FileInputStream.hpp"
+#include "io/InputStreamReader.hpp"
+#include "io/PipedInputStream.hpp"
+#include "io/PipedReader.hpp"
+#include "io/StringReader.hpp"
+
+using namespace common::io;
+
+namespace
+{
+/// Overrides only the bulk read, so read() and skip() take the defaults of AbstractInputStream.
+class BulkOnlyInputStream final : public AbstractInputStream
+{
+public:
+	using AbstractInputStream::read;
+	explicit BulkOnlyInputStream(std::vector<std::byte> data) : data_(std::move(data)) {}
+	auto available() -> size_t override { return data_.size() - position_; }
+	auto read(std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> size_t override {
+		++calls;
+		if (position_ == data_.size()) {
+			return static_cast<size_t>(-1);
+		}
+		const size_t count = std::min(len, data_.size() - position_);
+		std::copy_n(data_.begin() + static_cast<std::ptrdiff_t>(position_), count, buffer.begin() + static_cast<std::ptrdiff_t>(offset));
+		position_ += count;
+		return count;
+	}
+	auto close() -> void override {}
+	size_t calls = 0;
+
+private:
+	std::vector<std::byte> data_;
+	size_t position_ = 0;
+};
+
+/// Overrides only read(), so the bulk read takes the default of AbstractInputStream.
+class ByteOnlyInputStream final : public AbstractInputStream
+{
+public:
+	using AbstractInputStream::read;
+	explicit ByteOnlyInputStream(std::vector<std::byte> data) : data_(std::move(data)) {}
+	auto available() -> size_t override { return data_.size() - position_; }
+	auto read() -> std::byte override { return position_ < data_.size() ? data_[position_++] : static_cast<std::byte>(-1); }
+	auto close() -> void override {}
+
+private:
+	std::vector<std::byte> data_;
+	size_t position_ = 0;
+};
+
+class NeitherInputStream final : public AbstractInputStream
+{
+public:
+	auto available() -> size_t override { return 0; }
+	auto close() -> void override {}
+};
+
+/// Overrides only the bulk read and, like some readers, signals the end of the stream by returning 0.
+class BulkOnlyReader final : public AbstractReader
+{
+public:
+	using AbstractReader::read;
+	explicit BulkOnlyReader(std::string data) : data_(std::move(data)) {}
+	auto read(std::vector<char>& cBuf, const size_t off, const size_t len) -> size_t override {
+		const size_t count = std::min(len, data_.size() - position_);
+		std::copy_n(data_.begin() + static_cast<std::ptrdiff_t>(position_), count, cBuf.begin() + static_cast<std::ptrdiff_t>(off));
+		position_ += count;
+		return count;
+	}
+	auto mark(size_t) -> void override {}
+	auto reset() -> void override {}
+	auto close() -> void override {}
+
+private:
+	std::string data_;
+	size_t position_ = 0;
+};
+
+auto text(const size_t size) -> std::string {
+	const auto bytes = test::accessLog(size);
+	return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+}
+}
+
+TEST(DefaultReadPathTest, ByteReadGoesThroughBulkRead) {
+	const auto data = test::randomBytes(1000);
+	BulkOnlyInputStream in(data);
+	for (const std::byte expected : data) {
+		ASSERT_EQ(in.read(), expected);
+	}
+	EXPECT_EQ(in.read(), static_cast<std::byte>(-1));
+}
+
+TEST(DefaultReadPathTest, SkipReadsBlocksThroughBulkRead) {
+	const auto data = test::randomBytes(100000);
+	BulkOnlyInputStream in(data);
+	EXPECT_EQ(in.skip(90000), 90000U);
+	EXPECT_LE(in.calls, 90000 / 8192 + 1);
+	EXPECT_EQ(in.read(), data[90000]);
+	EXPECT_EQ(in.skip(100000), 100000U - 90001);
+	EXPECT_EQ(in.skip(1), 0U);
+}
+
+TEST(DefaultReadPathTest, BulkReadGoesThroughByteRead) {
+	// read() returns the end of the stream as 0xFF, so the byte-wise default cannot carry that byte value.
+	const auto data = test::accessLog(5000);
+	ByteOnlyInputStream in(data);
+	EXPECT_EQ(test::readAll(in, 777), data);
+	std::vector<std::byte> buffer(4);
+	EXPECT_THROW(in.read(buffer, 2, 3), std::out_of_range);
+}
+
+TEST(DefaultReadPathTest, MissingReadOverrideIsALogicError) {
+	NeitherInputStream in;
+	std::vector<std::byte> buffer(4);
+	EXPECT_THROW(in.read(), std::logic_error);
+	EXPECT_THROW(in.read(buffer, 0, 4), std::logic_error);
+	EXPECT_THROW(in.read(), std::logic_error);
+}
+
+TEST(DefaultReadPathTest, ReaderCharReadAndSkipStopAtZeroReturn) {
+	const std::string data = text(20000);
+	BulkOnlyReader reader(data);
+	EXPECT_EQ(reader.read(), data[0]);
+	EXPECT_EQ(reader.skip(10000), 10000U);
+	EXPECT_EQ(reader.read(), data[10001]);
+	EXPECT_EQ(reader.skip(100000), data.size() - 10002);
+	EXPECT_EQ(reader.skip(10), 0U);
+	EXPECT_EQ(reader.read(), -1);
+}
+
+TEST(DefaultReadPathTest, DefaultsMatchConcreteOverrides) {
+	const auto bytes = test::accessLog(50000);
+	BulkOnlyInputStream generic(bytes);
+	ByteArrayInputStream concrete(bytes);
+	for (size_t i = 0; i < bytes.size(); i += 1000) {
+		ASSERT_EQ(generic.skip(997), concrete.skip(997));
+		ASSERT_EQ(generic.read(), concrete.read());
+	}
+	const std::string chars = text(50000);
+	BulkOnlyReader genericReader(chars);
+	StringReader concreteReader(chars);
+	for (size_t i = 0; i < chars.size(); i += 1000) {
+		ASSERT_EQ(genericReader.skip(997), concreteReader.skip(997));
+		ASSERT_EQ(genericReader.read(), concreteReader.read());
+	}
+}
+
+TEST(DefaultReadPathBenchmark, DISABLED_DefaultVersusConcretePaths) {
+	constexpr size_t size = 20 << 20;
+	const auto bytes = test::randomBytes(size);
+	const std::string chars = text(size);
+	const auto file = std::filesystem::temp_directory_path() / "DefaultReadPathBenchmark.bin";
+	{
+		std::ofstream out(file, std::ios::binary | std::ios::trunc);
+		out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	}
+	const std::vector<std::pair<const char*, std::function<std::unique_ptr<AbstractInputStream>()>>> streams{
+		{"default", [&] { return std::make_unique<BulkOnlyInputStream>(bytes); }},
+		{"ByteArrayInputStream", [&] { return std::make_unique<ByteArrayInputStream>(bytes); }},
+		{"BufferedInputStream", [&] { return std::make_unique<BufferedInputStream>(std::make_unique<BulkOnlyInputStream>(bytes)); }},
+		{"FileInputStream", [&] { return std::make_unique<FileInputStream>(file); }},
+		{"PipedInputStream", [&] {
+			auto pipe = std::make_unique<PipedInputStream>(size + 1);
+			pipe->receive(std::span(bytes));
+			pipe->receivedLast();
+			return pipe;
+		}},
+	};
+	const std::vector<std::pair<const char*, std::function<std::unique_ptr<AbstractReader>()>>> readers{
+		{"default", [&] { return std::make_unique<BulkOnlyReader>(chars); }},
+		{"StringReader", [&] { return std::make_unique<StringReader>(chars); }},
+		{"CharArrayReader", [&] { return std::make_unique<CharArrayReader>(std::vector(chars.begin(), chars.end())); }},
+		{"BufferedReader", [&] { return std::make_unique<BufferedReader>(std::make_unique<BulkOnlyReader>(chars), 8192); }},
+		{"InputStreamReader", [&] { return std::make_unique<InputStreamReader>(std::make_shared<BulkOnlyReader>(chars)); }},
+		{"PipedReader", [&] {
+			auto pipe = std::make_unique<PipedReader>(static_cast<int>(size + 1));
+			for (const char c : chars) {
+				pipe->writeToBuffer(c);
+			}
+			return pipe;
+		}},
+	};
+	int sink = 0;
+	// Each measurement drains a fresh stream, built before the clock starts.
+	const auto measure = [&](const auto& make, const auto& work) {
+		auto in = make();
+		return test::megabytesPerSecond(size, [&] { work(*in); });
+	};
+	for (const auto& [name, make] : streams) {
+		const double read = measure(make, [&](AbstractInputStream& in) {
+			for (size_t i = 0; i < size; ++i) {
+				sink += static_cast<int>(in.read());
+			}
+		});
+		double skip[2];
+		for (const size_t step : {size_t{100}, size_t{4096}}) {
+			skip[step == 4096] = measure(make, [&](AbstractInputStream& in) {
+				while (in.skip(step) == step) {}
+			});
+		}
+		std::printf("stream %-22s read() %8.0f  skip(100) %8.0f  skip(4096) %8.0f MB/s\n", name, read, skip[0], skip[1]);
+	}
+	for (const auto& [name, make] : readers) {
+		const double read = measure(make, [&](AbstractReader& in) {
+			for (size_t i = 0; i < size; ++i) {
+				sink += in.read();
+			}
+		});
+		double skip[2];
+		for (const size_t step : {size_t{100}, size_t{4096}}) {
+			skip[step == 4096] = measure(make, [&](AbstractReader& in) {
+				while (in.skip(step) == step) {}
+			});
+		}
+		std::printf("reader %-22s read() %8.0f  skip(100) %8.0f  skip(4096) %8.0f MB/s\n", name, read, skip[0], skip[1]);
+	}
+	std::filesystem::remove(file);
+	EXPECT_NE(sink, 1);
+}
@@ -0,0 +1,68 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include "io/DirectoryWalker.hpp"
+#include "io/FileMetadata.hpp"
+
+using common::io::DirectoryWalker;
+using common::io::FileMetadata;
+
+namespace
+{
+class FileMetadataTest : public testing::Test
+{
+protected:
+	std::filesystem::path directory_ = std::filesystem::temp_directory_path() / "FileMetadataTest";
+
+	void SetUp() override {
+		std::filesystem::remove_all(directory_);
+		std::filesystem::create_directories(directory_ / ".cache");
+		std::ofstream(directory_ / "visible.txt") << "12345";
+		std::ofstream(directory_ / ".hidden") << "x";
+	}
+
+	void TearDown() override {
+		std::filesystem::remove_all(directory_);
+	}
+};
+}
+
+TEST_F(FileMetadataTest, SnapshotCapturesTypeAndSize) {
+	const auto file = FileMetadata::of(directory_ / "visible.txt");
+	EXPECT_TRUE(file.isFile());
+	EXPECT_EQ(file.length(), 5);
+	EXPECT_GT(file.lastModified(), 0);
+	EXPECT_TRUE(FileMetadata::of(directory_).isDirectory());
+	EXPECT_FALSE(FileMetadata::of(directory_ / "missing").exists());
+}
+
+#ifndef _WIN32
+TEST_F(FileMetadataTest, DotFilesAreHiddenWhateverTheEntryPoint) {
+	EXPECT_TRUE(FileMetadata::of(directory_ / ".hidden").isHidden());
+	EXPECT_TRUE(FileMetadata::of(directory_ / ".cache").isHidden());
+	EXPECT_FALSE(FileMetadata::of(directory_ / "visible.txt").isHidden());
+	EXPECT_FALSE(FileMetadata::of(directory_ / ".cache" / "..").isHidden());
+	EXPECT_TRUE(FileMetadata::of(std::filesystem::directory_entry(directory_ / ".hidden")).isHidden());
+	for (const bool statEntries : {true, false}) {
+		for (const auto& entry : DirectoryWalker::list(directory_, statEntries)) {
+			EXPECT_EQ(entry.isHidden(), entry.getName().front() == '.') << entry.getName() << " stat " << statEntries;
+		}
+	}
+}
+
+TEST_F(FileMetadataTest, OwnerBitsAreReportedWithoutOpeningTheFile) {
+	const auto path = directory_ / "visible.txt";
+	std::filesystem::permissions(path, std::filesystem::perms::owner_read);
+	const auto readOnly = FileMetadata::of(path);
+	EXPECT_TRUE(readOnly.ownerCanRead());
+	EXPECT_FALSE(readOnly.ownerCanWrite());
+	EXPECT_FALSE(readOnly.ownerCanExecute());
+	std::filesystem::permissions(path, std::filesystem::perms::owner_all);
+	EXPECT_TRUE(FileMetadata::of(path).ownerCanWrite());
+	EXPECT_TRUE(FileMetadata::of(path).ownerCanExecute());
+	EXPECT_FALSE(FileMetadata::of(directory_).ownerCanExecute());
+}
+#endif
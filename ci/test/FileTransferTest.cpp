@@ -0,0 +1,254 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "TestData.hpp"
+#include "io/ByteArrayOutputStream.hpp"
+#include "io/FileDescriptorInputStream.hpp"
+#include "io/FileDescriptorOutputStream.hpp"
+#include "io/FileTransfer.hpp"
+#include "io/RandomAccessInputStream.hpp"
+
+using namespace std::chrono_literals;
+using namespace common::io;
+
+namespace
+{
+constexpr size_t SIZE = 3 * 1024 * 1024 + 17;
+
+auto readFile(const std::filesystem::path& path) -> std::vector<std::byte> {
+	std::ifstream in(path, std::ios::binary);
+	std::vector<std::byte> bytes(std::filesystem::file_size(path));
+	in.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	return bytes;
+}
+
+/// Reads a descriptor to its end on a separate thread, so a writer blocked on a full pipe can make progress.
+class Drain
+{
+public:
+	explicit Drain(const int descriptor, const std::chrono::microseconds pause = 0us): thread_([this, descriptor, pause] {
+		std::vector<std::byte> buffer(64 * 1024);
+		while (true) {
+			const ssize_t count = ::read(descriptor, buffer.data(), buffer.size());
+			if (count < 0 && errno == EINTR) {
+				continue;
+			}
+			if (count <= 0) {
+				break;
+			}
+			bytes_.insert(bytes_.end(), buffer.begin(), buffer.begin() + count);
+			std::this_thread::sleep_for(pause);
+		}
+		::close(descriptor);
+	}) {}
+
+	auto join() -> std::vector<std::byte> {
+		thread_.join();
+		return std::move(bytes_);
+	}
+
+private:
+	std::vector<std::byte> bytes_;
+	std::thread thread_;
+};
+
+/// Interrupts a thread with a handler installed without SA_RESTART, so blocking calls in it fail with EINTR or
+/// return short counts.
+class Interrupter
+{
+public:
+	explicit Interrupter(const pthread_t target): thread_([this, target] {
+		while (!stop_) {
+			pthread_kill(target, SIGUSR1);
+			std::this_thread::sleep_for(200us);
+		}
+	}) {}
+
+	~Interrupter() {
+		stop_ = true;
+		thread_.join();
+	}
+
+private:
+	std::atomic<bool> stop_{false};
+	std::thread thread_;
+};
+
+class FileTransferTest : public testing::Test
+{
+protected:
+	void SetUp() override {
+		content_ = test::randomBytes(SIZE);
+		std::ofstream out(source_, std::ios::binary | std::ios::trunc);
+		out.write(reinterpret_cast<const char*>(content_.data()), static_cast<std::streamsize>(content_.size()));
+		struct sigaction action{};
+		action.sa_handler = [](int) {};
+		sigemptyset(&action.sa_mask);
+		action.sa_flags = 0;
+		sigaction(SIGUSR1, &action, &previous_);
+	}
+
+	void TearDown() override {
+		sigaction(SIGUSR1, &previous_, nullptr);
+		std::filesystem::remove(source_);
+		std::filesystem::remove(target_);
+	}
+
+	std::filesystem::path source_ = std::filesystem::temp_directory_path() / (std::string("FileTransferTest.") + testing::UnitTest::GetInstance()->current_test_info()->name() + ".in");
+	std::filesystem::path target_ = std::filesystem::temp_directory_path() / (std::string("FileTransferTest.") + testing::UnitTest::GetInstance()->current_test_info()->name() + ".out");
+	std::vector<std::byte> content_;
+	struct sigaction previous_{};
+};
+}
+
+TEST_F(FileTransferTest, FileToFileRoundTrip) {
+	FileDescriptorInputStream in(source_);
+	{
+		FileDescriptorOutputStream out(target_);
+		EXPECT_EQ(in.transferTo(out), SIZE);
+	}
+	EXPECT_EQ(readFile(target_), content_);
+	// At the end of the input there is nothing left to transfer.
+	FileDescriptorOutputStream again(target_, true);
+	EXPECT_EQ(in.transferTo(again), 0U);
+}
+
+TEST_F(FileTransferTest, RandomAccessTransferStartsAtPositionAndAdvancesIt) {
+	RandomAccessInputStream in(source_);
+	in.seek(1000);
+	{
+		FileDescriptorOutputStream out(target_);
+		EXPECT_EQ(in.transferTo(out), SIZE - 1000);
+	}
+	EXPECT_EQ(in.position(), SIZE);
+	EXPECT_EQ(readFile(target_), std::vector(content_.begin() + 1000, content_.end()));
+}
+
+TEST_F(FileTransferTest, FileToPipeAndPipeToFile) {
+	int toReader[2];
+	ASSERT_EQ(::pipe(toReader), 0);
+	Drain drain(toReader[0]);
+	{
+		FileDescriptorInputStream in(source_);
+		FileDescriptorOutputStream out(toReader[1], true);
+		EXPECT_EQ(in.transferTo(out), SIZE);
+	}
+	EXPECT_EQ(drain.join(), content_);
+
+	int fromWriter[2];
+	ASSERT_EQ(::pipe(fromWriter), 0);
+	std::thread writer([&] {
+		FileDescriptorOutputStream out(fromWriter[1], true);
+		out.write(content_);
+	});
+	{
+		FileDescriptorInputStream in(fromWriter[0], true);
+		FileDescriptorOutputStream out(target_);
+		EXPECT_EQ(in.transferTo(out), SIZE);
+	}
+	writer.join();
+	EXPECT_EQ(readFile(target_), content_);
+}
+
+TEST_F(FileTransferTest, SocketSourceFallsBackToBufferedCopy) {
+	// splice needs a pipe on one side and sendfile a mappable source, so a socket into a file is copied through a buffer.
+	int sockets[2];
+	ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+	std::thread writer([&] {
+		FileDescriptorOutputStream out(sockets[1], true);
+		out.write(content_);
+	});
+	{
+		FileDescriptorInputStream in(sockets[0], true);
+		FileDescriptorOutputStream out(target_);
+		EXPECT_EQ(in.transferTo(out), SIZE);
+	}
+	writer.join();
+	EXPECT_EQ(readFile(target_), content_);
+}
+
+TEST_F(FileTransferTest, NonDescriptorTargetUsesBufferedCopy) {
+	FileDescriptorInputStream in(source_);
+	ByteArrayOutputStream out(ByteArrayOutputStream::Mode::CHUNKED);
+	EXPECT_EQ(in.transferTo(out), SIZE);
+	EXPECT_EQ(out.toByteArray(), content_);
+}
+
+TEST_F(FileTransferTest, CopyReportsIncompleteForUnsupportedPair) {
+	int sockets[2];
+	ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+	const int file = ::open(target_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	ASSERT_GE(file, 0);
+	const auto [bytes, complete] = FileTransfer::copy(sockets[0], nullptr, file);
+	EXPECT_EQ(bytes, 0U);
+	EXPECT_FALSE(complete);
+	::close(file);
+	::close(sockets[0]);
+	::close(sockets[1]);
+}
+
+TEST_F(FileTransferTest, InterruptedWritesAreResumed) {
+	int pipe[2];
+	ASSERT_EQ(::pipe(pipe), 0);
+	// A slow reader keeps the pipe full, so every write blocks and is cut short or interrupted by the signals.
+	Drain drain(pipe[0], 50us);
+	std::thread writer([&] {
+		Interrupter interrupter(pthread_self());
+		FileDescriptorOutputStream out(pipe[1], true);
+		out.write(content_);
+	});
+	writer.join();
+	EXPECT_EQ(drain.join(), content_);
+}
+
+TEST_F(FileTransferTest, InterruptedReadsAndSplicesAreResumed) {
+	int input[2];
+	int output[2];
+	ASSERT_EQ(::pipe(input), 0);
+	ASSERT_EQ(::pipe(output), 0);
+	Drain drain(output[0], 50us);
+	std::thread writer([&] {
+		FileDescriptorOutputStream out(input[1], true);
+		for (size_t offset = 0; offset < content_.size(); offset += 256 * 1024) {
+			std::this_thread::sleep_for(1ms);
+			out.write(content_, offset, std::min<size_t>(256 * 1024, content_.size() - offset));
+		}
+	});
+	std::thread copier([&] {
+		Interrupter interrupter(pthread_self());
+		FileDescriptorInputStream in(input[0], true);
+		FileDescriptorOutputStream out(output[1], true);
+		EXPECT_EQ(in.transferTo(out), SIZE);
+	});
+	writer.join();
+	copier.join();
+	EXPECT_EQ(drain.join(), content_);
+
+	int empty[2];
+	ASSERT_EQ(::pipe(empty), 0);
+	std::thread late([&] {
+		std::this_thread::sleep_for(20ms);
+		static_cast<void>(::write(empty[1], "x", 1));
+		::close(empty[1]);
+	});
+	{
+		Interrupter interrupter(pthread_self());
+		FileDescriptorInputStream in(empty[0], true);
+		std::vector<std::byte> buffer(4);
+		EXPECT_EQ(in.read(buffer, 0, buffer.size()), 1U);
+		EXPECT_EQ(buffer[0], std::byte{'x'});
+	}
+	late.join();
+}
@@ -0,0 +1,80 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "io/FileMetadata.hpp"
+#include "io/FileWatcher.hpp"
+
+using common::io::FileMetadata;
+using common::io::FileWatcher;
+using namespace std::chrono_literals;
+
+namespace
+{
+class FileWatcherTest : public testing::Test
+{
+protected:
+	std::filesystem::path directory_ = std::filesystem::temp_directory_path() / "FileWatcherTest";
+	std::filesystem::path file_ = directory_ / "data.txt";
+
+	void SetUp() override {
+		std::filesystem::remove_all(directory_);
+		std::filesystem::create_directories(directory_);
+		std::ofstream(file_) << "aaaa";
+	}
+
+	void TearDown() override {
+		std::filesystem::remove_all(directory_);
+	}
+};
+}
+
+TEST_F(FileWatcherTest, SameSizeRewriteWithinOneSecondChangesModifiedTime) {
+	const auto before = FileMetadata::of(file_);
+	std::this_thread::sleep_for(5ms);
+	std::ofstream(file_) << "bbbb";
+	const auto after = FileMetadata::of(file_);
+	ASSERT_EQ(before.length(), after.length());
+	EXPECT_NE(before.lastModifiedTime(), after.lastModifiedTime());
+	EXPECT_EQ(before.lastModified(), std::chrono::floor<std::chrono::seconds>(before.lastModifiedTime()).count());
+}
+
+#ifdef __linux__
+TEST_F(FileWatcherTest, RestoredModifiedTimeStillChangesStatusChangeTime) {
+	const auto before = FileMetadata::of(file_);
+	const auto time = std::filesystem::last_write_time(file_);
+	std::this_thread::sleep_for(5ms);
+	std::ofstream(file_) << "cccc";
+	std::filesystem::last_write_time(file_, time);
+	const auto after = FileMetadata::of(file_);
+	EXPECT_EQ(before.lastModifiedTime(), after.lastModifiedTime());
+	EXPECT_NE(before.lastStatusChangeTime(), after.lastStatusChangeTime());
+}
+#endif
+
+TEST_F(FileWatcherTest, ReportsSameSizeRewrites) {
+	const auto pool = std::make_shared<common::thread::ThreadPool>(1, 1, 16, 1000ms);
+	std::mutex mutex;
+	std::condition_variable arrived;
+	std::vector<FileWatcher::Event> events;
+	FileWatcher watcher(pool, 20ms);
+	watcher.watch(file_, [&](const std::vector<FileWatcher::Event>& batch) {
+		std::lock_guard lock(mutex);
+		events.insert(events.end(), batch.begin(), batch.end());
+		arrived.notify_all();
+	});
+	for (const char* content : {"bbbb", "cccc"}) {
+		std::ofstream(file_) << content;
+		std::unique_lock lock(mutex);
+		ASSERT_TRUE(arrived.wait_for(lock, 5s, [&] { return !events.empty(); })) << content;
+		EXPECT_EQ(events.back().change, FileWatcher::Change::MODIFIED);
+		events.clear();
+	}
+	watcher.close();
+}
@@ -0,0 +1,297 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+#include "io/MappedFile.hpp"
+#include "io/serialize/FlatBuffer.hpp"
+
+using namespace common::io;
+using namespace common::io::serialize;
+
+namespace
+{
+enum class Color : uint8_t { RED, GREEN, BLUE = 7 };
+
+struct Weapon : FlatTable
+{
+	using FlatTable::FlatTable;
+	enum Field : uint16_t { NAME, DAMAGE };
+
+	[[nodiscard]] auto name() const -> std::string_view {
+		return string(NAME);
+	}
+
+	[[nodiscard]] auto damage() const -> int16_t {
+		return scalar<int16_t>(DAMAGE);
+	}
+
+	static auto verify(FlatVerifier& verifier, const Weapon& table) -> bool {
+		return verifier.verifyString(table, NAME) && verifier.verifyScalar<int16_t>(table, DAMAGE);
+	}
+};
+
+struct Monster : FlatTable
+{
+	using FlatTable::FlatTable;
+	enum Field : uint16_t { HP, NAME, INVENTORY, COLOR, SPEED, WEAPONS, TAGS, FRIEND, WEIGHTS };
+
+	[[nodiscard]] auto hp() const -> int16_t {
+		return scalar<int16_t>(HP, 100);
+	}
+
+	[[nodiscard]] auto name() const -> std::string_view {
+		return string(NAME);
+	}
+
+	[[nodiscard]] auto inventory() const -> FlatVector<uint8_t> {
+		return vector<uint8_t>(INVENTORY);
+	}
+
+	[[nodiscard]] auto color() const -> Color {
+		return scalar<Color>(COLOR, Color::BLUE);
+	}
+
+	[[nodiscard]] auto speed() const -> double {
+		return scalar<double>(SPEED, 1.5);
+	}
+
+	[[nodiscard]] auto weapons() const -> FlatVector<Weapon> {
+		return vector<Weapon>(WEAPONS);
+	}
+
+	[[nodiscard]] auto tags() const -> FlatVector<std::string_view> {
+		return vector<std::string_view>(TAGS);
+	}
+
+	[[nodiscard]] auto friendOf() const -> std::optional<Monster> {
+		return table<Monster>(FRIEND);
+	}
+
+	[[nodiscard]] auto weights() const -> FlatVector<int64_t> {
+		return vector<int64_t>(WEIGHTS);
+	}
+
+	static auto verify(FlatVerifier& verifier, const Monster& table) -> bool {
+		return verifier.verifyScalar<int16_t>(table, HP) && verifier.verifyString(table, NAME) && verifier.verifyVector<uint8_t>(table, INVENTORY) && verifier.verifyScalar<Color>(table, COLOR) && verifier.verifyScalar<double>(table, SPEED) && verifier.verifyVector<Weapon>(table, WEAPONS) && verifier.verifyVector<std::string_view>(table, TAGS) && verifier.verifyTable<Monster>(table, FRIEND) && verifier.verifyVector<int64_t>(table, WEIGHTS);
+	}
+};
+
+/// A linked list node whose verify does not descend into the next node, as a view of a large list would do to keep
+/// verification shallow; only the reference rules keep a reader walking the list from looping.
+struct Node : FlatTable
+{
+	using FlatTable::FlatTable;
+	enum Field : uint16_t { VALUE, NEXT };
+
+	[[nodiscard]] auto next() const -> std::optional<Node> {
+		return table<Node>(NEXT);
+	}
+
+	static auto verify(FlatVerifier& verifier, const Node& table) -> bool {
+		return verifier.verifyScalar<int32_t>(table, VALUE) && verifier.verifyTable<FlatTable>(table, NEXT);
+	}
+};
+
+auto buildMonster(FlatBuilder& builder) -> std::vector<std::byte> {
+	const auto friendName = builder.createString("pal");
+	builder.startTable();
+	builder.addOffset(Monster::NAME, friendName);
+	const auto friendOf = builder.endTable<Monster>();
+	std::vector<FlatOffset<Weapon>> weapons;
+	for (int i = 0; i < 3; ++i) {
+		const auto name = builder.createString("sword" + std::to_string(i));
+		builder.startTable();
+		builder.addOffset(Weapon::NAME, name);
+		builder.addScalar<int16_t>(Weapon::DAMAGE, static_cast<int16_t>(i * 10));
+		weapons.push_back(builder.endTable<Weapon>());
+	}
+	const auto weaponVector = builder.createVector<Weapon>(std::span<const FlatOffset<Weapon>>(weapons));
+	const std::vector<uint8_t> inventory{1, 2, 3, 4, 5};
+	const auto inventoryVector = builder.createVector<uint8_t>(std::span<const uint8_t>(inventory));
+	const std::vector<int64_t> weights{-1, int64_t{1} << 40};
+	const auto weightVector = builder.createVector<int64_t>(std::span<const int64_t>(weights));
+	const std::vector tags{builder.createString("a"), builder.createString("")};
+	const auto tagVector = builder.createVector<std::string_view>(std::span<const FlatOffset<std::string_view>>(tags));
+	const auto name = builder.createString("orc");
+	builder.startTable();
+	builder.addScalar<int16_t>(Monster::HP, 80, 100);
+	builder.addOffset(Monster::NAME, name);
+	builder.addOffset(Monster::INVENTORY, inventoryVector);
+	builder.addScalar(Monster::COLOR, Color::RED, Color::BLUE);
+	builder.addScalar(Monster::SPEED, 2.25, 1.5);
+	builder.addOffset(Monster::WEAPONS, weaponVector);
+	builder.addOffset(Monster::TAGS, tagVector);
+	builder.addOffset(Monster::FRIEND, friendOf);
+	builder.addOffset(Monster::WEIGHTS, weightVector);
+	const auto monster = builder.endTable<Monster>();
+	const auto bytes = builder.finish(monster, "MONS");
+	return {bytes.begin(), bytes.end()};
+}
+
+/// Reads every field reachable from an accepted buffer, so that AddressSanitizer catches any read the verifier let
+/// through outside the buffer.
+auto readAll(const Monster& monster) -> size_t {
+	size_t sum = static_cast<size_t>(monster.hp()) + monster.name().size() + static_cast<size_t>(monster.color()) + static_cast<size_t>(monster.speed());
+	for (const auto value : monster.inventory()) sum += value;
+	for (const auto weapon : monster.weapons()) sum += weapon.name().size() + static_cast<size_t>(weapon.damage());
+	for (const auto tag : monster.tags()) sum += tag.size();
+	for (const auto weight : monster.weights()) sum += static_cast<size_t>(weight);
+	if (const auto friendOf = monster.friendOf()) {
+		sum += friendOf->name().size();
+		if (const auto second = friendOf->friendOf()) sum += static_cast<size_t>(second->hp());
+	}
+	return sum;
+}
+
+/// Builds a list of two nodes and returns the buffer with the position of the root and of its NEXT reference.
+auto buildList(uint32_t& root, uint32_t& next) -> std::vector<std::byte> {
+	FlatBuilder builder;
+	builder.startTable();
+	builder.addScalar<int32_t>(Node::VALUE, 2);
+	const auto tail = builder.endTable<Node>();
+	builder.startTable();
+	builder.addScalar<int32_t>(Node::VALUE, 1);
+	builder.addOffset(Node::NEXT, tail);
+	const auto head = builder.endTable<Node>();
+	const auto bytes = builder.finish(head);
+	std::vector<std::byte> buffer(bytes.begin(), bytes.end());
+	const auto node = FlatBuffer::root<Node>(buffer);
+	root = node.position();
+	next = node.position() + node.fieldOffset(Node::NEXT);
+	return buffer;
+}
+}
+
+TEST(FlatBufferTest, ReadsWhatTheBuilderWrote) {
+	FlatBuilder builder;
+	const auto buffer = buildMonster(builder);
+	const auto monster = FlatBuffer::verifiedRoot<Monster>(buffer, "MONS");
+	EXPECT_EQ(FlatBuffer::identifier(buffer), "MONS");
+	EXPECT_EQ(monster.hp(), 80);
+	EXPECT_EQ(monster.name(), "orc");
+	EXPECT_EQ(monster.color(), Color::RED);
+	EXPECT_EQ(monster.speed(), 2.25);
+	ASSERT_EQ(monster.inventory().size(), 5u);
+	EXPECT_EQ(monster.inventory()[4], 5);
+	EXPECT_EQ(monster.inventory().span()[2], 3);
+	ASSERT_EQ(monster.weapons().size(), 3u);
+	EXPECT_EQ(monster.weapons()[2].name(), "sword2");
+	EXPECT_EQ(monster.weapons()[2].damage(), 20);
+	EXPECT_FALSE(monster.weapons()[0].has(Weapon::DAMAGE));
+	int damage = 0;
+	for (const auto weapon : monster.weapons()) damage += weapon.damage();
+	EXPECT_EQ(damage, 30);
+	EXPECT_EQ(monster.tags()[0], "a");
+	EXPECT_TRUE(monster.tags()[1].empty());
+	ASSERT_TRUE(monster.friendOf());
+	EXPECT_EQ(monster.friendOf()->name(), "pal");
+	EXPECT_EQ(monster.friendOf()->hp(), 100);
+	EXPECT_FALSE(monster.friendOf()->friendOf());
+	EXPECT_EQ(monster.weights()[1], int64_t{1} << 40);
+	EXPECT_EQ(monster.weights().span()[0], -1);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(monster.weights().span().data()) % alignof(int64_t), 0u);
+	EXPECT_FALSE(FlatBuffer::verify<Monster>(buffer, "XXXX"));
+}
+
+TEST(FlatBufferTest, BuilderRejectsMisuse) {
+	FlatBuilder builder;
+	builder.startTable();
+	builder.addScalar<int16_t>(Monster::HP, 80);
+	EXPECT_THROW(builder.addScalar<int16_t>(Monster::HP, 1), std::invalid_argument);
+	EXPECT_THROW(builder.createString("x"), std::logic_error);
+}
+
+TEST(FlatBufferTest, ReadsMappedFile) {
+	FlatBuilder builder;
+	const auto buffer = buildMonster(builder);
+	const auto path = std::filesystem::temp_directory_path() / "flat_buffer_test.bin";
+	{
+		std::ofstream out(path, std::ios::binary);
+		out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+	}
+	{
+		const MappedFile file(path);
+		const auto monster = FlatBuffer::verifiedRoot<Monster>(file.bytes(), "MONS");
+		EXPECT_EQ(monster.name(), "orc");
+		EXPECT_EQ(monster.weapons()[1].name(), "sword1");
+	}
+	std::filesystem::remove(path);
+}
+
+TEST(FlatBufferTest, RejectsTruncatedBuffers) {
+	FlatBuilder builder;
+	const auto buffer = buildMonster(builder);
+	for (size_t size = 0; size < buffer.size(); ++size) {
+		const std::span truncated(buffer.data(), size);
+		if (FlatBuffer::verify<Monster>(truncated)) {
+			readAll(FlatBuffer::root<Monster>(truncated));
+		}
+	}
+	EXPECT_FALSE(FlatBuffer::verify<Monster>(std::span(buffer.data(), FlatBuilder::HEADER_SIZE - 1)));
+}
+
+TEST(FlatBufferTest, RejectsTableReferencingItself) {
+	uint32_t root;
+	uint32_t next;
+	auto buffer = buildList(root, next);
+	ASSERT_TRUE(FlatBuffer::verify<Node>(buffer));
+	LittleEndian::store(buffer.data() + next, root);
+	EXPECT_FALSE(FlatBuffer::verify<Node>(buffer));
+}
+
+TEST(FlatBufferTest, RejectsForwardReference) {
+	uint32_t root;
+	uint32_t next;
+	auto buffer = buildList(root, next);
+	LittleEndian::store(buffer.data() + next, static_cast<uint32_t>(root + sizeof(uint32_t)));
+	EXPECT_FALSE(FlatBuffer::verify<Node>(buffer));
+}
+
+TEST(FlatBufferTest, AcceptedCorruptBuffersStayInBounds) {
+	FlatBuilder builder;
+	const auto buffer = buildMonster(builder);
+	std::mt19937 random(1);
+	int accepted = 0;
+	for (int i = 0; i < 20000; ++i) {
+		// A fresh heap copy of the exact size, so that AddressSanitizer flags any read past its end.
+		std::vector corrupt(buffer);
+		const int flips = 1 + static_cast<int>(random() % 4);
+		for (int k = 0; k < flips; ++k) {
+			corrupt[random() % corrupt.size()] = static_cast<std::byte>(random());
+		}
+		if (FlatBuffer::verify<Monster>(corrupt)) {
+			++accepted;
+			readAll(FlatBuffer::root<Monster>(corrupt));
+		}
+	}
+	EXPECT_GT(accepted, 0);
+}
+
+TEST(FlatBufferTest, ReleaseSharedVtableAndEmptyRoot) {
+	FlatBuilder builder;
+	const auto size = buildMonster(builder).size();
+	EXPECT_EQ(builder.release().size(), size);
+	EXPECT_EQ(builder.size(), FlatBuilder::HEADER_SIZE);
+	builder.startTable();
+	builder.addScalar<int32_t>(0, 1);
+	builder.endTable();
+	const size_t before = builder.size();
+	builder.startTable();
+	builder.addScalar<int32_t>(0, 2);
+	const auto second = builder.endTable();
+	EXPECT_EQ(builder.size() - before, 2 * sizeof(int32_t));
+	builder.finish(second);
+	EXPECT_TRUE(FlatBuffer::verify(builder.bytes()));
+	builder.clear();
+	builder.startTable();
+	const auto empty = builder.endTable();
+	builder.finish(empty);
+	ASSERT_TRUE(FlatBuffer::verify<Monster>(builder.bytes()));
+	EXPECT_EQ(FlatBuffer::root<Monster>(builder.bytes()).hp(), 100);
+}
@@ -0,0 +1,127 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+#include "io/CharArrayWriter.hpp"
+#include "io/StringWriter.hpp"
+
+using common::io::CharArrayWriter;
+using common::io::StringWriter;
+
+namespace
+{
+constexpr size_t HUGE_LENGTH = std::numeric_limits<size_t>::max();
+
+auto text(const size_t length) -> std::string {
+	std::string result;
+	for (size_t i = 0; i < length; ++i) {
+		result.push_back(static_cast<char>('a' + i % 26));
+	}
+	return result;
+}
+}
+
+TEST(CharArrayWriterTest, ReserveKeepsStorageWhileContentFits) {
+	CharArrayWriter writer;
+	writer.reserve(1000);
+	const char* storage = writer.view().data();
+	const std::string content = text(1000);
+	for (size_t i = 0; i < content.size(); i += 10) {
+		writer.write(std::string_view(content).substr(i, 10));
+	}
+	EXPECT_EQ(writer.view().data(), storage);
+	EXPECT_EQ(writer.view(), content);
+	writer.write('!');
+	EXPECT_EQ(writer.size(), 1001U);
+	EXPECT_EQ(writer.toString(), content + "!");
+}
+
+TEST(CharArrayWriterTest, GrowsGeometricallyWithoutReserve) {
+	CharArrayWriter writer(4);
+	size_t reallocations = 0;
+	const char* storage = writer.view().data();
+	for (int i = 0; i < 100000; ++i) {
+		writer.write(std::span<const char>("xy", 2));
+		if (writer.view().data() != storage) {
+			storage = writer.view().data();
+			++reallocations;
+		}
+	}
+	EXPECT_EQ(writer.size(), 200000U);
+	EXPECT_LT(reallocations, 40U);
+	EXPECT_THROW(CharArrayWriter(-1), std::invalid_argument);
+}
+
+TEST(CharArrayWriterTest, ReleaseMovesStorageAndEmptiesWriter) {
+	CharArrayWriter writer;
+	writer.write(std::string_view(text(300)));
+	const std::string_view before = writer.view();
+	auto released = writer.release();
+	// The released vector owns the storage the old view pointed into, so the view still reads the same characters.
+	EXPECT_EQ(released.data(), before.data());
+	EXPECT_EQ(std::string_view(released.data(), released.size()), text(300));
+	EXPECT_TRUE(writer.view().empty());
+	EXPECT_EQ(writer.size(), 0U);
+	writer.write(std::string_view("again"));
+	EXPECT_EQ(writer.view(), "again");
+	EXPECT_EQ(std::string(released.begin(), released.end()), text(300));
+}
+
+TEST(CharArrayWriterTest, RejectsOutOfRangeWrites) {
+	CharArrayWriter writer;
+	const std::vector<char> chars{'a', 'b', 'c'};
+	EXPECT_THROW(writer.write(chars, 2, 2), std::out_of_range);
+	EXPECT_THROW(writer.write(chars, 1, HUGE_LENGTH), std::out_of_range);
+	EXPECT_THROW(writer.write(std::string("abc"), 4, 0), std::out_of_range);
+	EXPECT_THROW(writer.append(std::string("abc"), 2, 1), std::out_of_range);
+	writer.write(chars, 1, 2);
+	EXPECT_EQ(writer.view(), "bc");
+}
+
+TEST(StringWriterTest, ReserveKeepsStorageWhileContentFits) {
+	StringWriter writer(16);
+	writer.reserve(2000);
+	const char* storage = writer.view().data();
+	const std::string content = text(2000);
+	writer.write(std::span<const char>(content.data(), 1000));
+	writer.append(content.substr(1000, 500));
+	writer.write(content, 1500, 500);
+	EXPECT_EQ(writer.view().data(), storage);
+	EXPECT_EQ(writer.view(), content);
+	EXPECT_EQ(writer.getBuffer(), content);
+}
+
+TEST(StringWriterTest, InitialSizeLeavesNoPadding) {
+	StringWriter writer(64);
+	EXPECT_TRUE(writer.view().empty());
+	writer.write('x');
+	EXPECT_EQ(writer.toString(), "x");
+}
+
+TEST(StringWriterTest, TakeMovesStringAndEmptiesWriter) {
+	StringWriter writer;
+	writer.write(std::string_view(text(300)));
+	const char* storage = writer.view().data();
+	std::string taken = writer.take();
+	EXPECT_EQ(taken.data(), storage);
+	EXPECT_EQ(taken, text(300));
+	EXPECT_TRUE(writer.view().empty());
+	writer.write(std::string_view("again"));
+	EXPECT_EQ(writer.view(), "again");
+	EXPECT_EQ(writer.take(), "again");
+	EXPECT_EQ(writer.take(), "");
+}
+
+TEST(StringWriterTest, RejectsOutOfRangeWrites) {
+	StringWriter writer;
+	const std::string str = "abc";
+	EXPECT_THROW(writer.write(str, 1, HUGE_LENGTH), std::out_of_range);
+	EXPECT_THROW(writer.write(str, 4, 0), std::out_of_range);
+	EXPECT_THROW(writer.write(std::vector{'a'}, 0, 2), std::out_of_range);
+	EXPECT_THROW(writer.append(str, 2, 1), std::out_of_range);
+	writer.write(str, 3, 0);
+	EXPECT_TRUE(writer.view().empty());
+}
@@ -0,0 +1,62 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "io/InputStreamReader.hpp"
+#include "io/StringReader.hpp"
+
+using common::io::InputStreamReader;
+using common::io::StringReader;
+
+namespace
+{
+constexpr auto END_OF_STREAM = static_cast<size_t>(-1);
+
+auto readerOf(std::string text) -> InputStreamReader {
+	return InputStreamReader(std::make_shared<StringReader>(std::move(text)));
+}
+}
+
+TEST(InputStreamReaderTest, LengthShorterThanSequenceIsNotEndOfStream) {
+	auto reader = readerOf("\xC3\xA9x");
+	std::vector<char> buffer(4);
+	EXPECT_EQ(reader.read(buffer, 0, 1), 0U);
+	ASSERT_EQ(reader.read(buffer, 0, 2), 2U);
+	EXPECT_EQ(std::string(buffer.data(), 2), "\xC3\xA9");
+	ASSERT_EQ(reader.read(buffer, 0, 1), 1U);
+	EXPECT_EQ(buffer[0], 'x');
+	EXPECT_EQ(reader.read(buffer, 0, 1), END_OF_STREAM);
+}
+
+TEST(InputStreamReaderTest, SmallReadsKeepSequencesWhole) {
+	const std::string text = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80z";
+	for (size_t chunk = 1; chunk <= 5; ++chunk) {
+		auto reader = readerOf(text);
+		std::vector<char> buffer(chunk);
+		std::string decoded;
+		size_t length = chunk;
+		while (true) {
+			const size_t count = reader.read(buffer, 0, length);
+			if (count == END_OF_STREAM) {
+				break;
+			}
+			if (count == 0) {
+				ASSERT_LT(++length, 5U) << "no progress with chunk " << chunk;
+				buffer.resize(length);
+				continue;
+			}
+			decoded.append(buffer.data(), count);
+			length = chunk;
+		}
+		EXPECT_EQ(decoded, text) << "chunk " << chunk;
+	}
+}
+
+TEST(InputStreamReaderTest, EmptyInputIsEndOfStream) {
+	auto reader = readerOf("");
+	std::vector<char> buffer(4);
+	EXPECT_EQ(reader.read(buffer, 0, 4), END_OF_STREAM);
+	EXPECT_EQ(reader.read(), -1);
+}
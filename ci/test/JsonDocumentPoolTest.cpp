@@ -0,0 +1,167 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <bit>
+#include <string>
+#include <thread>
+#include <vector>
+#include "io/interface/IfaceJsonSerializable.hpp"
+#include "io/serialize/JsonDocumentPool.hpp"
+
+using common::interface::IfaceJsonSerializable;
+using common::io::serialize::JsonDocumentPool;
+
+namespace
+{
+struct Point final : IfaceJsonSerializable
+{
+	int x{0};
+	int y{0};
+
+	auto serialize(rapidjson::Writer<rapidjson::StringBuffer>& writer) const -> void override {
+		writer.StartObject();
+		writer.Key("x");
+		writer.Int(x);
+		writer.Key("y");
+		writer.Int(y);
+		writer.EndObject();
+	}
+
+	auto deserialize(const rapidjson::Value& json) -> void override {
+		x = json["x"].GetInt();
+		y = json["y"].GetInt();
+	}
+};
+
+auto largeArray(const size_t count) -> std::string {
+	std::string json = "[";
+	for (size_t i = 0; i < count; ++i) {
+		json += (i == 0 ? "" : ",") + std::string(R"({"id":)") + std::to_string(i) + R"(,"name":"a name longer than short strings"})";
+	}
+	return json + "]";
+}
+
+/// Each test runs on a new thread, so it starts with an empty pool whatever the previous tests left behind.
+class JsonDocumentPoolTest : public testing::Test
+{
+protected:
+	void TearDown() override {
+		JsonDocumentPool::setRetainedLimit(JsonDocumentPool::DEFAULT_RETAINED_LIMIT);
+	}
+
+	template <typename Body> static auto onFreshThread(Body body) -> void {
+		std::thread(body).join();
+	}
+};
+}
+
+TEST_F(JsonDocumentPoolTest, ReusesArenaAcrossAcquireAndRelease) {
+	onFreshThread([] {
+		EXPECT_EQ(JsonDocumentPool::retained(), 0U);
+		rapidjson::Document* first;
+		{
+			const auto lease = JsonDocumentPool::acquire();
+			first = &lease.document();
+			EXPECT_TRUE(first->IsNull());
+			first->Parse(R"({"id":1,"tags":["a","b"]})");
+			ASSERT_FALSE(first->HasParseError());
+			EXPECT_GT(first->GetAllocator().Size(), 0U);
+		}
+		EXPECT_EQ(JsonDocumentPool::retained(), JsonDocumentPool::INITIAL_ARENA_SIZE);
+		const auto lease = JsonDocumentPool::acquire();
+		EXPECT_EQ(&lease.document(), first);
+		EXPECT_TRUE(lease.document().IsNull());
+		EXPECT_EQ(lease.document().GetAllocator().Size(), 0U);
+		EXPECT_EQ(JsonDocumentPool::retained(), 0U);
+	});
+}
+
+TEST_F(JsonDocumentPoolTest, GrowsArenaAfterOverflow) {
+	onFreshThread([] {
+		const std::string json = largeArray(2000);
+		size_t used;
+		{
+			const auto lease = JsonDocumentPool::acquire();
+			lease.document().Parse(json.data(), json.size());
+			ASSERT_FALSE(lease.document().HasParseError());
+			used = lease.document().GetAllocator().Size();
+			ASSERT_GT(used, JsonDocumentPool::INITIAL_ARENA_SIZE);
+		}
+		const size_t grown = std::bit_ceil(used + used / 4);
+		EXPECT_EQ(JsonDocumentPool::retained(), grown);
+		const auto lease = JsonDocumentPool::acquire();
+		lease.document().Parse(json.data(), json.size());
+		ASSERT_FALSE(lease.document().HasParseError());
+		EXPECT_EQ(lease.document().Size(), 2000U);
+		// The values fit in the grown arena, so the allocator took no chunk beyond it.
+		EXPECT_LE(lease.document().GetAllocator().Capacity(), grown);
+	});
+}
+
+TEST_F(JsonDocumentPoolTest, DropsDocumentsBeyondRetainedLimit) {
+	onFreshThread([] {
+		JsonDocumentPool::setRetainedLimit(2 * JsonDocumentPool::INITIAL_ARENA_SIZE);
+		std::vector<rapidjson::Document*> documents;
+		{
+			std::vector<JsonDocumentPool::Lease> leases;
+			for (int i = 0; i < 3; ++i) {
+				leases.push_back(JsonDocumentPool::acquire());
+				documents.push_back(&leases.back().document());
+			}
+		}
+		EXPECT_EQ(JsonDocumentPool::retained(), 2 * JsonDocumentPool::INITIAL_ARENA_SIZE);
+		{
+			const std::string json = largeArray(2000);
+			const auto lease = JsonDocumentPool::acquire();
+			lease.document().Parse(json.data(), json.size());
+			ASSERT_FALSE(lease.document().HasParseError());
+		}
+		// The grown arena would exceed the limit, so the overflowing document was freed instead of kept.
+		EXPECT_EQ(JsonDocumentPool::retained(), JsonDocumentPool::INITIAL_ARENA_SIZE);
+		JsonDocumentPool::setRetainedLimit(0);
+		{
+			const auto lease = JsonDocumentPool::acquire();
+		}
+		EXPECT_EQ(JsonDocumentPool::retained(), 0U);
+	});
+}
+
+TEST_F(JsonDocumentPoolTest, MoveAssignmentReturnsTheReplacedDocument) {
+	onFreshThread([] {
+		auto target = JsonDocumentPool::acquire();
+		auto source = JsonDocumentPool::acquire();
+		rapidjson::Document* moved = &source.document();
+		moved->Parse(R"({"kept":true})");
+		target = std::move(source);
+		EXPECT_EQ(&target.document(), moved);
+		EXPECT_TRUE(target.document()["kept"].GetBool());
+		EXPECT_EQ(JsonDocumentPool::retained(), JsonDocumentPool::INITIAL_ARENA_SIZE);
+		JsonDocumentPool::Lease constructed(std::move(target));
+		EXPECT_EQ(&constructed.document(), moved);
+		EXPECT_EQ(JsonDocumentPool::retained(), JsonDocumentPool::INITIAL_ARENA_SIZE);
+	});
+	onFreshThread([] {
+		// Self-assignment keeps the document instead of returning it to the pool.
+		auto lease = JsonDocumentPool::acquire();
+		auto& alias = lease;
+		lease = std::move(alias);
+		EXPECT_TRUE(lease.document().IsNull());
+		EXPECT_EQ(JsonDocumentPool::retained(), 0U);
+	});
+}
+
+TEST_F(JsonDocumentPoolTest, DeserializesPooledDocument) {
+	onFreshThread([] {
+		for (int i = 0; i < 3; ++i) {
+			const auto lease = JsonDocumentPool::acquire();
+			const std::string json = R"({"x":)" + std::to_string(i) + R"(,"y":-4})";
+			lease.document().Parse(json.data(), json.size());
+			ASSERT_FALSE(lease.document().HasParseError());
+			Point point;
+			point.deserialize(lease.document());
+			EXPECT_EQ(point.x, i);
+			EXPECT_EQ(point.y, -4);
+		}
+		EXPECT_EQ(JsonDocumentPool::retained(), JsonDocumentPool::INITIAL_ARENA_SIZE);
+	});
+}
@@ -0,0 +1,235 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <string>
+#include <tuple>
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include "io/serialize/JsonReflection.hpp"
+
+using namespace common::io::serialize;
+
+namespace
+{
+struct Config
+{
+	std::string host;
+	int port{80};
+	bool secure{false};
+
+	static constexpr auto jsonFields() {
+		return std::tuple{jsonField("host", &Config::host), jsonField("port", &Config::port), jsonField("secure", &Config::secure)};
+	}
+};
+
+/// Enough fields with shared prefixes that the key table must be built within the constexpr step limits.
+struct Wide
+{
+	int metric_00_total{0};
+	int metric_01_total{0};
+	int metric_02_total{0};
+	int metric_03_total{0};
+	int metric_04_total{0};
+	int metric_05_total{0};
+	int metric_06_total{0};
+	int metric_07_total{0};
+	int metric_08_total{0};
+	int metric_09_total{0};
+	int metric_10_total{0};
+	int metric_11_total{0};
+	int metric_12_total{0};
+	int metric_13_total{0};
+	int metric_14_total{0};
+	int metric_15_total{0};
+	int metric_16_total{0};
+	int metric_17_total{0};
+	int metric_18_total{0};
+	int metric_19_total{0};
+	int metric_20_total{0};
+	int metric_21_total{0};
+	int metric_22_total{0};
+	int metric_23_total{0};
+	int metric_24_total{0};
+	int metric_25_total{0};
+	int metric_26_total{0};
+	int metric_27_total{0};
+	int metric_28_total{0};
+	int metric_29_total{0};
+	int metric_30_total{0};
+	int metric_31_total{0};
+	int metric_32_total{0};
+	int metric_33_total{0};
+	int metric_34_total{0};
+	int metric_35_total{0};
+	int metric_36_total{0};
+	int metric_37_total{0};
+	int metric_38_total{0};
+	int metric_39_total{0};
+	int metric_40_total{0};
+	int metric_41_total{0};
+	int metric_42_total{0};
+	int metric_43_total{0};
+	int metric_44_total{0};
+	int metric_45_total{0};
+	int metric_46_total{0};
+	int metric_47_total{0};
+	int metric_48_total{0};
+	int metric_49_total{0};
+	int metric_50_total{0};
+	int metric_51_total{0};
+	int metric_52_total{0};
+	int metric_53_total{0};
+	int metric_54_total{0};
+	int metric_55_total{0};
+	int metric_56_total{0};
+	int metric_57_total{0};
+	int metric_58_total{0};
+	int metric_59_total{0};
+	int metric_60_total{0};
+	int metric_61_total{0};
+	int metric_62_total{0};
+	int metric_63_total{0};
+	int metric_64_total{0};
+	int metric_65_total{0};
+	int metric_66_total{0};
+	int metric_67_total{0};
+	int metric_68_total{0};
+	int metric_69_total{0};
+	int metric_70_total{0};
+	int metric_71_total{0};
+
+	static constexpr auto jsonFields() {
+		return std::tuple{
+			jsonField("metric_00_total", &Wide::metric_00_total),
+			jsonField("metric_01_total", &Wide::metric_01_total),
+			jsonField("metric_02_total", &Wide::metric_02_total),
+			jsonField("metric_03_total", &Wide::metric_03_total),
+			jsonField("metric_04_total", &Wide::metric_04_total),
+			jsonField("metric_05_total", &Wide::metric_05_total),
+			jsonField("metric_06_total", &Wide::metric_06_total),
+			jsonField("metric_07_total", &Wide::metric_07_total),
+			jsonField("metric_08_total", &Wide::metric_08_total),
+			jsonField("metric_09_total", &Wide::metric_09_total),
+			jsonField("metric_10_total", &Wide::metric_10_total),
+			jsonField("metric_11_total", &Wide::metric_11_total),
+			jsonField("metric_12_total", &Wide::metric_12_total),
+			jsonField("metric_13_total", &Wide::metric_13_total),
+			jsonField("metric_14_total", &Wide::metric_14_total),
+			jsonField("metric_15_total", &Wide::metric_15_total),
+			jsonField("metric_16_total", &Wide::metric_16_total),
+			jsonField("metric_17_total", &Wide::metric_17_total),
+			jsonField("metric_18_total", &Wide::metric_18_total),
+			jsonField("metric_19_total", &Wide::metric_19_total),
+			jsonField("metric_20_total", &Wide::metric_20_total),
+			jsonField("metric_21_total", &Wide::metric_21_total),
+			jsonField("metric_22_total", &Wide::metric_22_total),
+			jsonField("metric_23_total", &Wide::metric_23_total),
+			jsonField("metric_24_total", &Wide::metric_24_total),
+			jsonField("metric_25_total", &Wide::metric_25_total),
+			jsonField("metric_26_total", &Wide::metric_26_total),
+			jsonField("metric_27_total", &Wide::metric_27_total),
+			jsonField("metric_28_total", &Wide::metric_28_total),
+			jsonField("metric_29_total", &Wide::metric_29_total),
+			jsonField("metric_30_total", &Wide::metric_30_total),
+			jsonField("metric_31_total", &Wide::metric_31_total),
+			jsonField("metric_32_total", &Wide::metric_32_total),
+			jsonField("metric_33_total", &Wide::metric_33_total),
+			jsonField("metric_34_total", &Wide::metric_34_total),
+			jsonField("metric_35_total", &Wide::metric_35_total),
+			jsonField("metric_36_total", &Wide::metric_36_total),
+			jsonField("metric_37_total", &Wide::metric_37_total),
+			jsonField("metric_38_total", &Wide::metric_38_total),
+			jsonField("metric_39_total", &Wide::metric_39_total),
+			jsonField("metric_40_total", &Wide::metric_40_total),
+			jsonField("metric_41_total", &Wide::metric_41_total),
+			jsonField("metric_42_total", &Wide::metric_42_total),
+			jsonField("metric_43_total", &Wide::metric_43_total),
+			jsonField("metric_44_total", &Wide::metric_44_total),
+			jsonField("metric_45_total", &Wide::metric_45_total),
+			jsonField("metric_46_total", &Wide::metric_46_total),
+			jsonField("metric_47_total", &Wide::metric_47_total),
+			jsonField("metric_48_total", &Wide::metric_48_total),
+			jsonField("metric_49_total", &Wide::metric_49_total),
+			jsonField("metric_50_total", &Wide::metric_50_total),
+			jsonField("metric_51_total", &Wide::metric_51_total),
+			jsonField("metric_52_total", &Wide::metric_52_total),
+			jsonField("metric_53_total", &Wide::metric_53_total),
+			jsonField("metric_54_total", &Wide::metric_54_total),
+			jsonField("metric_55_total", &Wide::metric_55_total),
+			jsonField("metric_56_total", &Wide::metric_56_total),
+			jsonField("metric_57_total", &Wide::metric_57_total),
+			jsonField("metric_58_total", &Wide::metric_58_total),
+			jsonField("metric_59_total", &Wide::metric_59_total),
+			jsonField("metric_60_total", &Wide::metric_60_total),
+			jsonField("metric_61_total", &Wide::metric_61_total),
+			jsonField("metric_62_total", &Wide::metric_62_total),
+			jsonField("metric_63_total", &Wide::metric_63_total),
+			jsonField("metric_64_total", &Wide::metric_64_total),
+			jsonField("metric_65_total", &Wide::metric_65_total),
+			jsonField("metric_66_total", &Wide::metric_66_total),
+			jsonField("metric_67_total", &Wide::metric_67_total),
+			jsonField("metric_68_total", &Wide::metric_68_total),
+			jsonField("metric_69_total", &Wide::metric_69_total),
+			jsonField("metric_70_total", &Wide::metric_70_total),
+			jsonField("metric_71_total", &Wide::metric_71_total)};
+	}
+};
+
+struct Empty
+{
+	static constexpr auto jsonFields() {
+		return std::tuple{};
+	}
+};
+}
+
+TEST(JsonReflectionTest, FindsEveryFieldOfAWideType) {
+	constexpr size_t count = std::tuple_size_v<decltype(Wide::jsonFields())>;
+	static_assert(count >= 64);
+	size_t expected = 0;
+	std::apply([&](const auto&... fields) {
+		const auto check = [&](const std::string_view name) {
+			EXPECT_EQ(JsonReflection::fieldIndex<Wide>(name), expected++) << name;
+		};
+		(check(fields.name), ...);
+	}, Wide::jsonFields());
+	EXPECT_EQ(JsonReflection::fieldIndex<Wide>("metric_72_total"), count);
+	EXPECT_EQ(JsonReflection::fieldIndex<Wide>(""), count);
+}
+
+TEST(JsonReflectionTest, UnknownKeysAndEmptyTypes) {
+	EXPECT_EQ(JsonReflection::fieldIndex<Config>("port"), 1U);
+	EXPECT_EQ(JsonReflection::fieldIndex<Config>("Port"), 3U);
+	EXPECT_EQ(JsonReflection::fieldIndex<Config>("hostname"), 3U);
+	EXPECT_EQ(JsonReflection::fieldIndex<Empty>("anything"), 0U);
+}
+
+TEST(JsonReflectionTest, WideTypeRoundTrips) {
+	Wide wide;
+	wide.metric_00_total = 1;
+	wide.metric_37_total = -37;
+	wide.metric_71_total = 71;
+	rapidjson::StringBuffer buffer;
+	rapidjson::Writer writer(buffer);
+	JsonReflection::write(writer, wide);
+	rapidjson::Document document;
+	document.Parse(buffer.GetString());
+	Wide loaded;
+	ASSERT_TRUE(JsonReflection::read(document, loaded));
+	EXPECT_EQ(loaded.metric_00_total, 1);
+	EXPECT_EQ(loaded.metric_37_total, -37);
+	EXPECT_EQ(loaded.metric_71_total, 71);
+	EXPECT_EQ(loaded.metric_50_total, 0);
+}
+
+TEST(JsonReflectionTest, MissingKeysKeepValues) {
+	rapidjson::Document document;
+	document.Parse(R"({"port": 8080, "unknown": true})");
+	Config config;
+	config.host = "localhost";
+	ASSERT_TRUE(JsonReflection::read(document, config));
+	EXPECT_EQ(config.host, "localhost");
+	EXPECT_EQ(config.port, 8080);
+	EXPECT_FALSE(config.secure);
+}
@@ -0,0 +1,273 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <rapidjson/reader.h>
+#include "io/ByteArrayInputStream.hpp"
+#include "io/MappedFile.hpp"
+#include "io/serialize/JsonInputStream.hpp"
+#include "io/serialize/JsonRecordReader.hpp"
+#include "io/serialize/JsonSaxHandler.hpp"
+#include "io/serialize/JsonSerializer.hpp"
+
+using namespace common::io;
+using namespace common::io::serialize;
+using common::interface::IfaceJsonSerializable;
+
+namespace
+{
+struct Address
+{
+	std::string city;
+	int zip{0};
+
+	static constexpr auto jsonFields() {
+		return std::tuple{jsonField("city", &Address::city), jsonField("zip", &Address::zip)};
+	}
+
+	auto operator==(const Address&) const -> bool = default;
+};
+
+/// Reads a DOM, so the SAX handler must collect its object and parse it into a document.
+struct Point final : IfaceJsonSerializable
+{
+	int x{0};
+	int y{0};
+	int depth{0};
+
+	auto serialize(rapidjson::Writer<rapidjson::StringBuffer>& writer) const -> void override {
+		writer.StartObject();
+		writer.Key("x");
+		writer.Int(x);
+		writer.Key("y");
+		writer.Int(y);
+		writer.EndObject();
+	}
+
+	auto deserialize(const rapidjson::Value& json) -> void override {
+		x = json["x"].GetInt();
+		y = json["y"].GetInt();
+		depth = json.HasMember("meta") && json["meta"].IsObject() ? static_cast<int>(json["meta"]["levels"].Size()) : 0;
+	}
+};
+
+struct Person
+{
+	std::string name;
+	int age{-1};
+	uint8_t level{7};
+	std::optional<double> score;
+	std::vector<int> tags;
+	std::map<std::string, int> counts;
+	Address address;
+	std::vector<Address> history;
+	Point location;
+	bool active{false};
+
+	static constexpr auto jsonFields() {
+		return std::tuple{jsonField("name", &Person::name), jsonField("age", &Person::age), jsonField("level", &Person::level), jsonField("score", &Person::score), jsonField("tags", &Person::tags), jsonField("counts", &Person::counts), jsonField("address", &Person::address), jsonField("history", &Person::history), jsonField("location", &Person::location), jsonField("active", &Person::active)};
+	}
+};
+
+auto parse(const std::string& json, Person& person) -> rapidjson::ParseResult {
+	JsonSaxHandler handler(person);
+	rapidjson::Reader reader;
+	rapidjson::StringStream stream(json.c_str());
+	return reader.Parse(stream, handler);
+}
+
+auto bytesOf(const std::string& text) -> std::vector<std::byte> {
+	const auto* data = reinterpret_cast<const std::byte*>(text.data());
+	return {data, data + text.size()};
+}
+
+class JsonFileTest : public testing::Test
+{
+protected:
+	void TearDown() override {
+		std::filesystem::remove(path_);
+	}
+
+	auto write(const std::string& text) const -> void {
+		std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+		out << text;
+	}
+
+	std::filesystem::path path_ = std::filesystem::temp_directory_path() / (std::string("JsonSaxTest.") + testing::UnitTest::GetInstance()->current_test_info()->name() + ".json");
+};
+}
+
+TEST(JsonSaxHandlerTest, FillsNestedMembers) {
+	Person person;
+	const auto result = parse(R"({"name":"Ada","age":36,"score":9.5,"tags":[1,2,3],"counts":{"a":1,"b":2},)"
+		R"("address":{"city":"London","zip":12345},"history":[{"city":"Paris"},{"city":"Rome","zip":7}],"active":true})", person);
+	ASSERT_FALSE(result.IsError());
+	EXPECT_EQ(person.name, "Ada");
+	EXPECT_EQ(person.age, 36);
+	EXPECT_EQ(person.score, 9.5);
+	EXPECT_EQ(person.tags, (std::vector{1, 2, 3}));
+	EXPECT_EQ(person.counts, (std::map<std::string, int>{{"a", 1}, {"b", 2}}));
+	EXPECT_EQ(person.address, (Address{"London", 12345}));
+	EXPECT_EQ(person.history, (std::vector<Address>{{"Paris", 0}, {"Rome", 7}}));
+	EXPECT_TRUE(person.active);
+}
+
+TEST(JsonSaxHandlerTest, SkipsUnknownKeysAndMismatchedValues) {
+	Person person;
+	person.score = 1.0;
+	const auto result = parse(R"({"unknown":{"deep":[1,{"name":"inner"}]},"name":42,"age":"old","level":300,)"
+		R"("score":null,"tags":{"not":"an array"},"address":[1,2],"active":true,"extra":[[],{}]})", person);
+	ASSERT_FALSE(result.IsError());
+	EXPECT_EQ(person.name, "");
+	EXPECT_EQ(person.age, -1);
+	EXPECT_EQ(person.level, 7);
+	EXPECT_FALSE(person.score.has_value());
+	EXPECT_TRUE(person.tags.empty());
+	EXPECT_EQ(person.address, Address{});
+	EXPECT_TRUE(person.active);
+}
+
+TEST(JsonSaxHandlerTest, CapturesNestedSerializable) {
+	Person person;
+	const auto result = parse(R"({"name":"before","location":{"x":3,"y":-4,"meta":{"levels":[[1],{"k":"v"},null]}},"age":5})", person);
+	ASSERT_FALSE(result.IsError());
+	EXPECT_EQ(person.location.x, 3);
+	EXPECT_EQ(person.location.y, -4);
+	EXPECT_EQ(person.location.depth, 3);
+	EXPECT_EQ(person.name, "before");
+	EXPECT_EQ(person.age, 5);
+}
+
+TEST(JsonSaxHandlerTest, ResetReusesHandlerForAnotherTarget) {
+	JsonSaxHandler handler;
+	rapidjson::Reader reader;
+	Address first;
+	Address second;
+	handler.reset(jsonSaxSlot(first));
+	const std::string a = R"({"city":"Oslo","zip":1})";
+	rapidjson::StringStream streamA(a.c_str());
+	ASSERT_FALSE(reader.Parse(streamA, handler).IsError());
+	handler.reset(jsonSaxSlot(second));
+	const std::string b = R"({"city":"Bergen","zip":2})";
+	rapidjson::StringStream streamB(b.c_str());
+	ASSERT_FALSE(reader.Parse(streamB, handler).IsError());
+	EXPECT_EQ(first, (Address{"Oslo", 1}));
+	EXPECT_EQ(second, (Address{"Bergen", 2}));
+}
+
+TEST(JsonSaxHandlerTest, MalformedInputFails) {
+	for (const std::string json : {R"({"name":)", R"({"name":"x",})", R"({"tags":[1,2})", "nonsense", ""}) {
+		Person person;
+		EXPECT_TRUE(parse(json, person).IsError()) << json;
+		const auto bytes = bytesOf(json);
+		ByteArrayInputStream in(bytes);
+		EXPECT_THROW(JsonSerializer::loadFromJsonStream<Person>(in), std::runtime_error) << json;
+	}
+}
+
+TEST(JsonInputStreamTest, RefillsSmallWindowFromStream) {
+	const auto bytes = bytesOf("[1, 2]");
+	ByteArrayInputStream in(bytes);
+	JsonInputStream stream(in, 4);
+	std::string taken;
+	EXPECT_EQ(stream.Peek(), '[');
+	EXPECT_EQ(stream.Tell(), 0U);
+	while (stream.Peek() != '\0') {
+		taken.push_back(stream.Take());
+	}
+	EXPECT_EQ(taken, "[1, 2]");
+	EXPECT_EQ(stream.Tell(), 6U);
+	EXPECT_EQ(stream.Take(), '\0');
+	EXPECT_EQ(stream.Tell(), 6U);
+}
+
+TEST(JsonInputStreamTest, ReadsMemoryWithoutCopying) {
+	const auto bytes = bytesOf(R"({"city":"Oslo","zip":1})");
+	JsonInputStream stream(bytes);
+	EXPECT_EQ(stream.Peek(), '{');
+	Address address;
+	JsonSaxHandler handler(address);
+	rapidjson::Reader reader;
+	ASSERT_FALSE(reader.Parse(stream, handler).IsError());
+	EXPECT_EQ(address, (Address{"Oslo", 1}));
+	EXPECT_EQ(stream.Peek(), '\0');
+}
+
+TEST(JsonRecordReaderTest, ReadsReflectedRecordsFromStream) {
+	const auto bytes = bytesOf(" [ {\"city\":\"A\",\"zip\":1} ,\n{\"city\":\"B\"}, {\"zip\":3,\"other\":[1]} ] ");
+	ByteArrayInputStream in(bytes);
+	JsonRecordReader reader(in, 8);
+	std::vector<Address> records;
+	for (Address address; reader.next(address); address = {}) {
+		records.push_back(address);
+	}
+	EXPECT_EQ(records, (std::vector<Address>{{"A", 1}, {"B", 0}, {"", 3}}));
+	EXPECT_EQ(reader.count(), 3U);
+	Address after;
+	EXPECT_FALSE(reader.next(after));
+}
+
+TEST(JsonRecordReaderTest, EmptyArrayHasNoRecords) {
+	const auto bytes = bytesOf("  [ ]  ");
+	ByteArrayInputStream in(bytes);
+	JsonRecordReader reader(in);
+	Address address;
+	EXPECT_FALSE(reader.next(address));
+	EXPECT_EQ(reader.count(), 0U);
+}
+
+TEST(JsonRecordReaderTest, RejectsMalformedArrays) {
+	for (const std::string json : {R"({"city":"A"})", R"([{"city":"A"} {"city":"B"}])", R"([{"city":"A"},{"city":)", R"([{"city":"A"})"}) {
+		const auto bytes = bytesOf(json);
+		ByteArrayInputStream in(bytes);
+		JsonRecordReader reader(in);
+		EXPECT_THROW({
+			for (Address address; reader.next(address);) {}
+		}, std::runtime_error) << json;
+	}
+}
+
+TEST_F(JsonFileTest, RecordReaderMapsFileAndReadsSerializableRecords) {
+	write(R"([{"x":1,"y":2},{"x":3,"y":4,"meta":{"levels":[1,2]}}])");
+	JsonRecordReader reader(path_);
+	std::vector<std::tuple<int, int, int>> records;
+	for (Point point; reader.next(point);) {
+		records.emplace_back(point.x, point.y, point.depth);
+	}
+	EXPECT_EQ(records, (std::vector<std::tuple<int, int, int>>{{1, 2, 0}, {3, 4, 2}}));
+}
+
+TEST_F(JsonFileTest, LoadsReflectedObjectFromMappedFile) {
+	write(R"({"name":"Grace","history":[{"city":"NYC","zip":10001}],"location":{"x":7,"y":8}})");
+	const auto person = JsonSerializer::loadFromJsonFile<Person>(path_);
+	EXPECT_EQ(person.name, "Grace");
+	EXPECT_EQ(person.history, (std::vector<Address>{{"NYC", 10001}}));
+	EXPECT_EQ(person.location.x, 7);
+	EXPECT_EQ(person.location.y, 8);
+}
+
+TEST_F(JsonFileTest, MappedFileExposesContentsUntilClosed) {
+	write("mapped bytes");
+	MappedFile file(path_, MappedFile::Access::RANDOM);
+	ASSERT_EQ(file.size(), 12U);
+	EXPECT_EQ(std::string(reinterpret_cast<const char*>(file.bytes().data()), file.size()), "mapped bytes");
+	file.close();
+	EXPECT_EQ(file.size(), 0U);
+	EXPECT_TRUE(file.bytes().empty());
+	EXPECT_NO_THROW(file.close());
+}
+
+TEST_F(JsonFileTest, MappedFileHandlesEmptyAndMissingFiles) {
+	write("");
+	const MappedFile empty(path_);
+	EXPECT_EQ(empty.size(), 0U);
+	EXPECT_TRUE(empty.bytes().empty());
+	EXPECT_THROW(MappedFile(path_.string() + ".missing"), std::ios_base::failure);
+}
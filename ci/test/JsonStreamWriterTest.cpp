@@ -0,0 +1,109 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include "io/ByteArrayOutputStream.hpp"
+#include "io/interface/IfaceJsonStreamable.hpp"
+#include "io/serialize/JsonStreamWriter.hpp"
+
+using namespace common::io;
+using namespace common::io::serialize;
+
+namespace
+{
+class Student final : public common::interface::IfaceJsonStreamable<Student>
+{
+public:
+	std::string name;
+	int grade{0};
+	static inline int streamed = 0;
+
+	template <typename Writer> auto serializeTo(Writer& writer) const -> void {
+		if constexpr (!std::is_same_v<Writer, rapidjson::Writer<rapidjson::StringBuffer>>) {
+			++streamed;
+		}
+		writer.StartObject();
+		writer.Key("name");
+		writer.String(name.data(), static_cast<rapidjson::SizeType>(name.size()));
+		writer.Key("grade");
+		writer.Int(grade);
+		writer.EndObject();
+	}
+
+	auto deserialize(const rapidjson::Value&) -> void override {}
+};
+
+/// Implements only serialize(), so other writers get it through the per-thread buffer.
+class Legacy final : public common::interface::IfaceJsonSerializable
+{
+public:
+	std::string text;
+
+	auto serialize(rapidjson::Writer<rapidjson::StringBuffer>& writer) const -> void override {
+		writer.StartObject();
+		writer.Key("text");
+		writer.String(text.data(), static_cast<rapidjson::SizeType>(text.size()));
+		writer.EndObject();
+	}
+
+	auto deserialize(const rapidjson::Value&) -> void override {}
+};
+
+struct Course
+{
+	std::string title;
+	Student best;
+	Legacy notes;
+
+	static constexpr auto jsonFields() {
+		return std::tuple{jsonField("title", &Course::title), jsonField("best", &Course::best), jsonField("notes", &Course::notes)};
+	}
+};
+
+template <typename T> auto written(const T& value) -> std::string {
+	ByteArrayOutputStream out;
+	JsonStreamWriter writer(out);
+	writer.write(value);
+	writer.close();
+	return out.toString();
+}
+}
+
+TEST(JsonStreamWriterTest, StreamableTypesWriteStraightToTheStream) {
+	Student student;
+	student.name = "Ada";
+	student.grade = 97;
+	Student::streamed = 0;
+	EXPECT_EQ(written(student), R"({"name":"Ada","grade":97})");
+	EXPECT_EQ(Student::streamed, 1);
+
+	rapidjson::StringBuffer buffer;
+	rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+	student.serialize(writer);
+	EXPECT_STREQ(buffer.GetString(), R"({"name":"Ada","grade":97})");
+	EXPECT_EQ(Student::streamed, 1);
+}
+
+TEST(JsonStreamWriterTest, NestedStreamableAndBufferedMembers) {
+	Course course;
+	course.title = "Logic";
+	course.best.name = "Kurt";
+	course.best.grade = 100;
+	course.notes.text = "sound";
+	Student::streamed = 0;
+	EXPECT_EQ(written(course), R"({"title":"Logic","best":{"name":"Kurt","grade":100},"notes":{"text":"sound"}})");
+	EXPECT_EQ(Student::streamed, 1);
+}
+
+TEST(JsonStreamWriterTest, LargeBufferedObjectsAreWrittenWhole) {
+	Legacy large;
+	large.text.assign(300000, 'x');
+	Legacy small;
+	small.text = "y";
+	const std::string expected = R"({"text":")" + large.text + R"("})";
+	EXPECT_EQ(written(large), expected);
+	EXPECT_EQ(written(small), R"({"text":"y"})");
+	EXPECT_EQ(written(large), expected);
+}
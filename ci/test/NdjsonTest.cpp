@@ -0,0 +1,246 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include "io/ByteArrayInputStream.hpp"
+#include "io/ByteArrayOutputStream.hpp"
+#include "io/serialize/NdjsonReader.hpp"
+#include "io/serialize/NdjsonWriter.hpp"
+#include "thread/ThreadPool.hpp"
+
+using namespace common::io;
+using namespace common::io::serialize;
+using common::thread::ThreadPool;
+
+namespace
+{
+struct Record
+{
+	uint64_t id{0};
+	std::string name;
+	double score{0};
+	std::vector<std::string> tags;
+
+	static constexpr auto jsonFields() {
+		return std::tuple{jsonField("id", &Record::id), jsonField("name", &Record::name), jsonField("score", &Record::score), jsonField("tags", &Record::tags)};
+	}
+
+	auto operator==(const Record&) const -> bool = default;
+};
+
+auto records(const size_t count) -> std::vector<Record> {
+	std::vector<Record> result;
+	result.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		result.push_back({i, "user-" + std::to_string(i), static_cast<double>(i % 1000) / 8, {"alpha", i % 2 ? "odd" : "even"}});
+	}
+	return result;
+}
+
+auto sequentialText(const std::vector<Record>& input) -> std::vector<std::byte> {
+	ByteArrayOutputStream out;
+	NdjsonWriter writer(out);
+	for (const Record& record : input) {
+		writer.write(record);
+	}
+	writer.close();
+	return out.toByteArray();
+}
+
+auto bytesOf(const std::string& text) -> std::vector<std::byte> {
+	const auto* data = reinterpret_cast<const std::byte*>(text.data());
+	return {data, data + text.size()};
+}
+
+auto makePool(const size_t threads) -> ThreadPool {
+	return {threads, threads, 64, std::chrono::milliseconds(1000)};
+}
+}
+
+TEST(NdjsonTest, SequentialRoundTrip) {
+	const auto input = records(1000);
+	const auto text = sequentialText(input);
+	ASSERT_EQ(std::count(text.begin(), text.end(), std::byte{'\n'}), 1000);
+	ByteArrayInputStream in(text);
+	NdjsonReader reader(in, 256);
+	std::vector<Record> output;
+	EXPECT_EQ(reader.forEach<Record>([&](const uint64_t line, Record& record) {
+		EXPECT_EQ(line, output.size());
+		output.push_back(record);
+	}), 1000U);
+	EXPECT_EQ(output, input);
+}
+
+TEST(NdjsonTest, WriteAllMatchesSequentialOutput) {
+	const auto input = records(5000);
+	const auto expected = sequentialText(input);
+	ThreadPool pool = makePool(4);
+	ByteArrayOutputStream ordered;
+	{
+		NdjsonWriter writer(ordered);
+		EXPECT_EQ(writer.writeAll(pool, input, NdjsonWriter::Order::ORDERED, 97), 5000U);
+		writer.close();
+	}
+	EXPECT_EQ(ordered.toByteArray(), expected);
+
+	ByteArrayOutputStream unordered;
+	{
+		NdjsonWriter writer(unordered);
+		EXPECT_EQ(writer.writeAll(pool, input, NdjsonWriter::Order::UNORDERED, 97), 5000U);
+		writer.close();
+	}
+	const auto lines = [](const std::string& text) {
+		std::vector<std::string> result;
+		for (size_t start = 0, end; (end = text.find('\n', start)) != std::string::npos; start = end + 1) {
+			result.push_back(text.substr(start, end - start));
+		}
+		std::ranges::sort(result);
+		return result;
+	};
+	EXPECT_EQ(lines(unordered.toString()), lines(std::string(reinterpret_cast<const char*>(expected.data()), expected.size())));
+}
+
+TEST(NdjsonTest, ParallelReadKeepsOrderOrCoversEveryLine) {
+	const auto input = records(5000);
+	const auto text = sequentialText(input);
+	ThreadPool pool = makePool(4);
+	{
+		ByteArrayInputStream in(text);
+		NdjsonReader reader(in, 1000);
+		std::vector<Record> output;
+		EXPECT_EQ(reader.forEach<Record>(pool, [&](const uint64_t line, Record& record) {
+			EXPECT_EQ(line, output.size());
+			output.push_back(record);
+		}), 5000U);
+		EXPECT_EQ(output, input);
+	}
+	{
+		ByteArrayInputStream in(text);
+		NdjsonReader reader(in, 1000);
+		std::mutex mutex;
+		std::vector<Record> output(input.size());
+		EXPECT_EQ(reader.forEach<Record>(pool, [&](const uint64_t line, Record& record) {
+			std::lock_guard lock(mutex);
+			output[line] = record;
+		}, NdjsonReader::Order::UNORDERED), 5000U);
+		EXPECT_EQ(output, input);
+	}
+}
+
+TEST(NdjsonTest, MappedFileRead) {
+	const auto input = records(3000);
+	const auto file = std::filesystem::temp_directory_path() / "NdjsonTest.ndjson";
+	{
+		NdjsonWriter writer(file);
+		ThreadPool pool = makePool(2);
+		writer.writeAll(pool, input);
+		writer.close();
+	}
+	NdjsonReader reader(file, 4096);
+	ThreadPool pool = makePool(2);
+	std::vector<Record> output;
+	reader.forEach<Record>(pool, [&](uint64_t, Record& record) {
+		output.push_back(record);
+	});
+	std::filesystem::remove(file);
+	EXPECT_EQ(output, input);
+}
+
+TEST(NdjsonTest, BlankLinesAreSkippedAndErrorsNameTheLine) {
+	const auto text = bytesOf("{\"id\":1}\n\n  \r\n{\"id\":2}\n{\"id\":\n{\"id\":4}\n");
+	ByteArrayInputStream in(text);
+	NdjsonReader reader(in);
+	std::vector<uint64_t> ids;
+	try {
+		reader.forEach<Record>([&](const uint64_t line, const Record& record) {
+			ids.push_back(line * 100 + record.id);
+		});
+		FAIL() << "expected a parse error";
+	}
+	catch (const std::runtime_error& error) {
+		EXPECT_NE(std::string(error.what()).find("line 4"), std::string::npos) << error.what();
+	}
+	EXPECT_EQ(ids, (std::vector<uint64_t>{1, 302}));
+}
+
+TEST(NdjsonTest, UnorderedFailureStopsOtherWorkers) {
+	// Three chunks of 4 KiB: a slow record, a malformed line, then many records whose visitor also takes its time.
+	constexpr size_t chunk = 4096;
+	const auto pad = [](std::string text, const size_t size) {
+		return text + std::string(size - text.size() - 1, ' ') + "\n";
+	};
+	std::string text = pad("{\"id\":0}\n", chunk) + pad("{\"id\":\n", chunk);
+	for (int i = 1; i <= 300; ++i) {
+		text += "{\"id\":" + std::to_string(i) + "}\n";
+	}
+	const auto bytes = bytesOf(text);
+	ByteArrayInputStream in(bytes);
+	NdjsonReader reader(in, chunk);
+	ThreadPool pool = makePool(3);
+	std::atomic<int> late{0};
+	EXPECT_THROW(reader.forEach<Record>(pool, [&](uint64_t, const Record& record) {
+		if (record.id == 0) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(300));
+			return;
+		}
+		++late;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}, NdjsonReader::Order::UNORDERED, 8), std::runtime_error);
+	// The calling thread only reaches the failed chunk after the slow one, so the last chunk stops early only if the
+	// failing worker raised the flag itself.
+	EXPECT_LT(late.load(), 100);
+}
+
+/// Measures the sequential and parallel paths of NdjsonWriter and NdjsonReader. The record count can be set with
+/// NDJSON_BENCHMARK_RECORDS; the pool uses every hardware thread. Parallel rates only mean something on a multi-core
+/// host built against the real rapidjson.
+TEST(NdjsonBenchmark, DISABLED_SequentialVersusParallel) {
+	const char* configured = std::getenv("NDJSON_BENCHMARK_RECORDS");
+	const size_t count = configured != nullptr ? std::strtoull(configured, nullptr, 10) : 1000000;
+	const size_t threads = std::max(1U, std::thread::hardware_concurrency());
+	const auto input = records(count);
+	ThreadPool pool = makePool(threads);
+	std::vector<std::byte> text;
+	const auto report = [&](const char* name, auto&& work) {
+		const auto start = std::chrono::steady_clock::now();
+		work();
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::printf("%-18s %6.2fM rec/s  %7.0f MB/s\n", name, static_cast<double>(count) / seconds / 1e6, static_cast<double>(text.size()) / seconds / 1e6);
+	};
+	std::printf("%zu records, %zu hardware threads\n", count, threads);
+	report("write sequential", [&] { text = sequentialText(input); });
+	for (const auto order : {NdjsonWriter::Order::ORDERED, NdjsonWriter::Order::UNORDERED}) {
+		report(order == NdjsonWriter::Order::ORDERED ? "write ordered" : "write unordered", [&] {
+			ByteArrayOutputStream out(text.size());
+			NdjsonWriter writer(out);
+			writer.writeAll(pool, input, order);
+			writer.close();
+		});
+	}
+	uint64_t sink = 0;
+	report("read sequential", [&] {
+		ByteArrayInputStream in(text);
+		NdjsonReader reader(in);
+		reader.forEach<Record>([&](uint64_t, const Record& record) { sink += record.id; });
+	});
+	for (const auto order : {NdjsonReader::Order::ORDERED, NdjsonReader::Order::UNORDERED}) {
+		report(order == NdjsonReader::Order::ORDERED ? "read ordered" : "read unordered", [&] {
+			ByteArrayInputStream in(text);
+			NdjsonReader reader(in);
+			std::atomic<uint64_t> total{0};
+			reader.forEach<Record>(pool, [&](uint64_t, const Record& record) { total.fetch_add(record.id, std::memory_order_relaxed); }, order);
+			sink += total;
+		});
+	}
+	EXPECT_EQ(sink, 3 * (count * (count - 1) / 2));
+}
@@ -0,0 +1,124 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include "io/CharArrayWriter.hpp"
+#include "io/OutputStreamWriter.hpp"
+
+using common::io::CharArrayWriter;
+using common::io::OutputStreamWriter;
+
+namespace
+{
+/// Collects everything written; unlike CharArrayWriter, flush() keeps the content.
+class StringSink final : public common::io::AbstractWriter
+{
+public:
+	using AbstractWriter::write;
+
+	auto write(const std::vector<char>& cBuf, const size_t off, const size_t len) -> void override {
+		text_.append(cBuf.data() + off, len);
+	}
+
+	auto write(const std::string_view str) -> void override {
+		text_.append(str);
+	}
+
+	auto flush() -> void override {}
+
+	auto close() -> void override {}
+
+	[[nodiscard]] auto toString() const -> std::string override {
+		return text_;
+	}
+
+private:
+	std::string text_;
+};
+
+/// Keeps a pointer to the target, since toString() of the writer itself is unavailable once it is closed.
+struct Utf16Writer
+{
+	explicit Utf16Writer(const std::string& charset) {
+		auto target = std::make_unique<StringSink>();
+		output = target.get();
+		writer = std::make_unique<OutputStreamWriter>(std::move(target), charset);
+	}
+
+	StringSink* output;
+	std::unique_ptr<OutputStreamWriter> writer;
+};
+
+auto bytes(std::initializer_list<unsigned char> values) -> std::string {
+	return {values.begin(), values.end()};
+}
+}
+
+TEST(OutputStreamWriterTest, EncodesBmpAndSurrogatePairs) {
+	Utf16Writer be("UTF-16BE");
+	be.writer->write(std::string("A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\xF4\x8F\xBF\xBF"));
+	be.writer->flush();
+	EXPECT_EQ(be.output->toString(), bytes({0x00, 0x41, 0x00, 0xE9, 0x20, 0xAC, 0xD8, 0x3D, 0xDE, 0x00, 0xDB, 0xFF, 0xDF, 0xFF}));
+	Utf16Writer le("UTF-16LE");
+	le.writer->write(std::string("\xF0\x90\x80\x80"));
+	le.writer->flush();
+	EXPECT_EQ(le.output->toString(), bytes({0x00, 0xD8, 0x00, 0xDC}));
+}
+
+TEST(OutputStreamWriterTest, WritesByteOrderMarkOnceForUtf16) {
+	Utf16Writer bom("UTF-16");
+	bom.writer->write(std::string("a"));
+	bom.writer->write(std::string("b"));
+	bom.writer->close();
+	EXPECT_EQ(bom.output->toString(), bytes({0xFE, 0xFF, 0x00, 0x61, 0x00, 0x62}));
+}
+
+TEST(OutputStreamWriterTest, CompletesSequencesSplitAcrossWrites) {
+	const std::string text = "x\xE2\x82\xAC\xF0\x9F\x98\x80y";
+	for (size_t split = 0; split <= text.size(); ++split) {
+		Utf16Writer writer("UTF-16BE");
+		writer.writer->write(text.substr(0, split));
+		// A flush in the middle of a sequence keeps it pending for the next write.
+		writer.writer->flush();
+		writer.writer->write(text.substr(split));
+		writer.writer->close();
+		EXPECT_EQ(writer.output->toString(), bytes({0x00, 0x78, 0x20, 0xAC, 0xD8, 0x3D, 0xDE, 0x00, 0x00, 0x79})) << split;
+	}
+}
+
+TEST(OutputStreamWriterTest, IncompleteSequenceAtCloseBecomesReplacementCharacter) {
+	for (const std::string tail : {"\xC3", "\xE2\x82", "\xF0\x9F\x98"}) {
+		Utf16Writer writer("UTF-16LE");
+		writer.writer->write("ok" + tail);
+		writer.writer->flush();
+		EXPECT_EQ(writer.output->toString(), bytes({0x6F, 0x00, 0x6B, 0x00}));
+		writer.writer->close();
+		EXPECT_EQ(writer.output->toString(), bytes({0x6F, 0x00, 0x6B, 0x00, 0xFD, 0xFF}));
+		EXPECT_NO_THROW(writer.writer->close());
+		EXPECT_THROW(writer.writer->write(std::string("x")), std::ios_base::failure);
+	}
+}
+
+TEST(OutputStreamWriterTest, RejectsInvalidInputAndUnknownCharsets) {
+	Utf16Writer writer("UTF-16BE");
+	EXPECT_THROW(writer.writer->write(std::string("\xC3x")), std::runtime_error);
+	EXPECT_THROW(writer.writer->write(std::string("\xED\xA0\x80")), std::runtime_error);
+	EXPECT_THROW(writer.writer->write(std::string("\xFF")), std::runtime_error);
+	EXPECT_THROW(OutputStreamWriter(std::make_unique<CharArrayWriter>(), "ISO-8859-1"), std::invalid_argument);
+}
+
+TEST(OutputStreamWriterTest, LongInputIsStagedInPieces) {
+	std::string text;
+	for (int i = 0; i < 5000; ++i) {
+		text += "a\xF0\x9F\x98\x80";
+	}
+	Utf16Writer writer("UTF-16BE");
+	writer.writer->write(text);
+	writer.writer->close();
+	const std::string output = writer.output->toString();
+	ASSERT_EQ(output.size(), 5000U * 6);
+	for (size_t i = 0; i < output.size(); i += 6) {
+		ASSERT_EQ(output.substr(i, 6), bytes({0x00, 0x61, 0xD8, 0x3D, 0xDE, 0x00})) << i;
+	}
+}
@@ -0,0 +1,133 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+#include "TestData.hpp"
+#include "io/PipedInputStream.hpp"
+#include "io/PipedOutputStream.hpp"
+
+using common::io::PipedInputStream;
+using common::io::PipedOutputStream;
+using test::randomBytes;
+
+namespace
+{
+constexpr size_t RING_SIZE = 64 * 1024;
+
+/// Sends \p source through a pipe with bulk receive(span) on one thread and bulk read(span) on the calling thread,
+/// both in chunks of \p transfer bytes.
+auto transferThroughPipe(const std::vector<std::byte>& source, const size_t transfer, const size_t ringSize) -> std::vector<std::byte> {
+	const size_t total = source.size();
+	std::vector<std::byte> received(total);
+	auto pipe = std::make_shared<PipedInputStream>(ringSize);
+	std::thread writer([&] {
+		for (size_t offset = 0; offset < total; offset += transfer) {
+			pipe->receive(std::span(source).subspan(offset, std::min(transfer, total - offset)));
+		}
+		pipe->receivedLast();
+	});
+	size_t offset = 0;
+	while (offset < total) {
+		const size_t count = pipe->read(std::span(received).subspan(offset, std::min(transfer, total - offset)));
+		if (count == 0) {
+			break;
+		}
+		offset += count;
+	}
+	writer.join();
+	received.resize(offset);
+	return received;
+}
+}
+
+/// Checks that every byte arrives in order for transfers smaller than, equal to and larger than the ring.
+class PipedStreamTransferTest : public testing::TestWithParam<size_t>
+{};
+
+TEST_P(PipedStreamTransferTest, BulkTransferIsByteExact) {
+	const size_t transfer = GetParam();
+	const auto source = randomBytes(256 * 1024 + 13);
+	EXPECT_EQ(transferThroughPipe(source, transfer, 4096), source);
+}
+
+INSTANTIATE_TEST_SUITE_P(TransferSizes, PipedStreamTransferTest, testing::Values(1, 64, 4095, 4096, 4097, 1024 * 1024));
+
+TEST(PipedStreamBenchmark, DISABLED_BulkTransferThroughput) {
+	for (const size_t transfer : {size_t{64}, size_t{4 * 1024}, size_t{1024 * 1024}}) {
+		const size_t total = transfer < 4096 ? 4 * 1024 * 1024 : 64 * 1024 * 1024;
+		const auto source = randomBytes(total);
+		std::vector<std::byte> received;
+		const double throughput = test::megabytesPerSecond(total, [&] { received = transferThroughPipe(source, transfer, RING_SIZE); });
+		ASSERT_EQ(received, source);
+		std::printf("transfer %zu B: %.0f MB/s\n", transfer, throughput);
+	}
+}
+
+TEST(PipedStreamTest, BulkReceiveAndReadWrapAroundTheRing) {
+	PipedInputStream pipe(16);
+	std::vector<std::byte> data(10);
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = static_cast<std::byte>(i + 1);
+	}
+	std::vector<std::byte> out(10);
+	pipe.receive(std::span<const std::byte>(data));
+	ASSERT_EQ(pipe.read(std::span(out)), 10U);
+	EXPECT_EQ(out, data);
+	std::ranges::for_each(data, [](std::byte& byte) { byte = static_cast<std::byte>(static_cast<int>(byte) + 100); });
+	pipe.receive(std::span<const std::byte>(data));
+	ASSERT_EQ(pipe.available(), 10U);
+	std::ranges::fill(out, std::byte{0});
+	ASSERT_EQ(pipe.read(std::span(out)), 10U);
+	EXPECT_EQ(out, data);
+}
+
+TEST(PipedStreamTest, ReceiveLargerThanRingBlocksUntilDrained) {
+	auto pipe = std::make_shared<PipedInputStream>(16);
+	const auto source = randomBytes(1000);
+	std::thread writer([&] {
+		pipe->receive(std::span(source));
+		pipe->receivedLast();
+	});
+	std::vector<std::byte> received;
+	std::vector<std::byte> chunk(7);
+	while (const size_t count = pipe->read(std::span(chunk))) {
+		received.insert(received.end(), chunk.begin(), chunk.begin() + static_cast<std::ptrdiff_t>(count));
+	}
+	writer.join();
+	EXPECT_EQ(received, source);
+}
+
+TEST(PipedStreamTest, OutputStreamWritesReachReader) {
+	auto pipe = std::make_shared<PipedInputStream>(32);
+	const auto source = randomBytes(4096);
+	std::thread writer([&] {
+		PipedOutputStream out(pipe);
+		out.write(source, 0, 1000);
+		out.write(source[1000]);
+		out.write(source, 1001, source.size() - 1001);
+		out.close();
+	});
+	std::vector<std::byte> received(source.size() + 1);
+	size_t offset = 0;
+	while (const size_t count = pipe->read(received, offset, received.size() - offset)) {
+		offset += count;
+	}
+	writer.join();
+	received.resize(offset);
+	EXPECT_EQ(received, source);
+}
+
+TEST(PipedStreamTest, SkipDropsBytesWithoutCopying) {
+	PipedInputStream pipe(16);
+	const auto source = randomBytes(12);
+	pipe.receive(std::span(source));
+	EXPECT_EQ(pipe.skip(5), 5U);
+	EXPECT_EQ(pipe.read(), source[5]);
+	EXPECT_EQ(pipe.available(), 6U);
+}
@@ -0,0 +1,176 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <charconv>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include "io/PrintStream.hpp"
+
+using common::io::AbstractOutputStream;
+using common::io::PrintStream;
+
+namespace
+{
+/// Records the bytes that reach the underlying stream and how often it was flushed.
+class RecordingStream final : public AbstractOutputStream
+{
+public:
+	using AbstractOutputStream::write;
+
+	auto write(const std::byte b) -> void override {
+		bytes.push_back(static_cast<char>(b));
+		++writes;
+	}
+
+	auto write(const std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> void override {
+		bytes.append(reinterpret_cast<const char*>(buffer.data()) + offset, len);
+		++writes;
+	}
+
+	auto flush() -> void override {
+		++flushes;
+	}
+
+	auto close() -> void override {
+		closed = true;
+	}
+
+	std::string bytes;
+	int writes{0};
+	int flushes{0};
+	bool closed{false};
+};
+
+auto parse(const std::string& text, double& value) -> bool {
+	const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+	return ec == std::errc() && ptr == text.data() + text.size();
+}
+
+auto parse(const std::string& text, float& value) -> bool {
+	const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+	return ec == std::errc() && ptr == text.data() + text.size();
+}
+}
+
+TEST(PrintStreamTest, AutoFlushOnlyOnNewline) {
+	const auto sink = std::make_shared<RecordingStream>();
+	PrintStream out(sink, true);
+	out.print("no newline");
+	out.print(42);
+	out.print('x');
+	out.append("tail");
+	out.append('y');
+	EXPECT_EQ(sink->flushes, 0);
+	EXPECT_EQ(sink->bytes, "");
+	out.print("line\nmore");
+	EXPECT_EQ(sink->flushes, 1);
+	EXPECT_EQ(sink->bytes, "no newline42xtailyline\nmore");
+	out.append('\n');
+	EXPECT_EQ(sink->flushes, 2);
+	out.append(std::string("a\nb"), 2, 3);
+	EXPECT_EQ(sink->flushes, 2);
+	out.append(std::string("a\nb"), 0, 2);
+	EXPECT_EQ(sink->flushes, 3);
+	out.println(1);
+	out.printf("{}", 2);
+	EXPECT_EQ(sink->flushes, 5);
+	EXPECT_EQ(sink->bytes, "no newline42xtailyline\nmore\nba\n1\n2");
+}
+
+TEST(PrintStreamTest, WithoutAutoFlushOutputWaitsForBufferOrFlush) {
+	const auto sink = std::make_shared<RecordingStream>();
+	PrintStream out(sink, false, 64);
+	out.println("first line");
+	out.printf("{} {}\n", "formatted", 3);
+	EXPECT_EQ(sink->bytes, "");
+	EXPECT_EQ(sink->flushes, 0);
+	out.print(std::string(100, 'z'));
+	EXPECT_GE(sink->bytes.size(), 64U);
+	EXPECT_EQ(sink->flushes, 0);
+	out.flush();
+	EXPECT_EQ(sink->flushes, 1);
+	EXPECT_EQ(sink->bytes, "first line\nformatted 3\n" + std::string(100, 'z'));
+	out.close();
+	EXPECT_TRUE(sink->closed);
+}
+
+TEST(PrintStreamTest, FloatingPointIsShortestRoundTrip) {
+	const auto sink = std::make_shared<RecordingStream>();
+	PrintStream out(sink, false);
+	out.print(0.1);
+	out.print(' ');
+	out.print(1.0 / 3.0);
+	out.print(' ');
+	out.print(0.1f);
+	out.print(' ');
+	out.print(1e300);
+	out.print(' ');
+	out.print(-0.0);
+	out.flush();
+	EXPECT_EQ(sink->bytes, "0.1 0.3333333333333333 0.1 1e+300 -0");
+	for (const double value : {std::numeric_limits<double>::min(), std::numeric_limits<double>::max(), 123456.789, 2.0 / 3.0, -7e-9}) {
+		const auto valueSink = std::make_shared<RecordingStream>();
+		PrintStream valueOut(valueSink, false);
+		valueOut.print(value);
+		valueOut.flush();
+		double parsed = 0;
+		ASSERT_TRUE(parse(valueSink->bytes, parsed)) << valueSink->bytes;
+		EXPECT_EQ(parsed, value) << valueSink->bytes;
+	}
+	for (const float value : {std::numeric_limits<float>::max(), 3.14159265f, 1e-30f}) {
+		const auto valueSink = std::make_shared<RecordingStream>();
+		PrintStream valueOut(valueSink, false);
+		valueOut.print(value);
+		valueOut.flush();
+		float parsed = 0;
+		ASSERT_TRUE(parse(valueSink->bytes, parsed)) << valueSink->bytes;
+		EXPECT_EQ(parsed, value) << valueSink->bytes;
+	}
+}
+
+TEST(PrintStreamTest, EveryPrintOverloadWritesItsValue) {
+	const auto sink = std::make_shared<RecordingStream>();
+	PrintStream out(sink, false);
+	const std::vector chars{'v', 'e', 'c'};
+	out.print(true);
+	out.print(false);
+	out.print('c');
+	out.print(std::numeric_limits<int>::min());
+	out.print(std::numeric_limits<long>::max());
+	out.print(2.5f);
+	out.print(-2.5);
+	out.print("cstr");
+	out.print(static_cast<const char*>(nullptr));
+	out.print(std::string("string"));
+	out.print(chars);
+	out.println(true);
+	out.println('c');
+	out.println(-1);
+	out.println(7L);
+	out.println(0.5f);
+	out.println(0.25);
+	out.println("cstr");
+	out.println(std::string("string"));
+	out.println(chars);
+	out.write(std::byte{'!'});
+	out.write(std::vector{std::byte{'a'}, std::byte{'b'}, std::byte{'c'}}, 1, 2);
+	out.flush();
+	const std::string expected = std::string("\x01\x00", 2) + "c" + std::to_string(std::numeric_limits<int>::min()) + std::to_string(std::numeric_limits<long>::max()) + "2.5-2.5cstrstringvec" + "\x01\nc\n-1\n7\n0.5\n0.25\ncstr\nstring\nvec\n!bc";
+	EXPECT_EQ(sink->bytes, expected);
+	// Everything fitted in the buffer, so it reached the stream in a single block.
+	EXPECT_EQ(sink->writes, 1);
+	EXPECT_THROW(out.write(std::vector<std::byte>(2), 1, 2), std::out_of_range);
+	EXPECT_THROW(out.append(std::string("abc"), 2, 1), std::out_of_range);
+}
+
+TEST(PrintStreamTest, DestructorDrainsBuffer) {
+	const auto sink = std::make_shared<RecordingStream>();
+	{
+		PrintStream out(sink, false);
+		out.print("kept");
+		EXPECT_EQ(sink->bytes, "");
+	}
+	EXPECT_EQ(sink->bytes, "kept");
+}
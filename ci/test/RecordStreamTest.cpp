@@ -0,0 +1,250 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "io/FileOutputStream.hpp"
+#include "io/LittleEndian.hpp"
+#include "io/RecordInputStream.hpp"
+#include "io/RecordOutputStream.hpp"
+#include "io/Varint.hpp"
+#include "thread/ThreadPool.hpp"
+
+using namespace common::io;
+using common::thread::ThreadPool;
+
+namespace
+{
+auto records(const size_t count) -> std::vector<std::string> {
+	std::vector<std::string> result;
+	result.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		result.push_back("record-" + std::to_string(i) + std::string(i % 50, 'x'));
+	}
+	return result;
+}
+
+auto writeRecords(const std::filesystem::path& path, const std::vector<std::string>& input, const size_t blockSize) -> void {
+	RecordOutputStream out(std::make_shared<FileOutputStream>(path), blockSize);
+	for (const auto& record : input) {
+		out.write(record);
+	}
+	out.close();
+}
+
+auto text(const std::vector<std::byte>& bytes) -> std::string {
+	return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+}
+
+auto readFile(const std::filesystem::path& path) -> std::vector<std::byte> {
+	std::ifstream in(path, std::ios::binary);
+	std::vector<std::byte> bytes(std::filesystem::file_size(path));
+	in.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	return bytes;
+}
+
+auto writeFile(const std::filesystem::path& path, const std::vector<std::byte>& bytes) -> void {
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+auto makePool(const size_t threads) -> ThreadPool {
+	return {threads, threads, 64, std::chrono::milliseconds(1000)};
+}
+
+class RecordStreamTest : public testing::Test
+{
+protected:
+	void TearDown() override {
+		std::filesystem::remove(path_);
+	}
+
+	/// Reads every record sequentially, so that a corrupt block anywhere in the file is reached.
+	auto readAll() const -> std::vector<std::string> {
+		RecordInputStream in(path_);
+		std::vector<std::string> output;
+		std::vector<std::byte> record;
+		while (in.read(record)) {
+			output.push_back(text(record));
+		}
+		return output;
+	}
+
+	std::filesystem::path path_ = std::filesystem::temp_directory_path() / (std::string("RecordStreamTest.") + testing::UnitTest::GetInstance()->current_test_info()->name() + ".rec");
+};
+}
+
+TEST(VarintTest, RoundTripsBoundaryValues) {
+	for (const uint64_t value : {uint64_t{0}, uint64_t{1}, uint64_t{127}, uint64_t{128}, uint64_t{16383}, uint64_t{16384}, uint64_t{UINT32_MAX}, std::numeric_limits<uint64_t>::max()}) {
+		std::byte buffer[Varint::MAX_LENGTH + 1]{};
+		const size_t length = Varint::encode(value, buffer);
+		EXPECT_EQ(length, Varint::length(value));
+		size_t offset = 0;
+		EXPECT_EQ(Varint::decode(buffer, offset), value);
+		EXPECT_EQ(offset, length);
+	}
+	std::byte buffer[Varint::MAX_LENGTH];
+	EXPECT_EQ(Varint::encode(std::numeric_limits<uint64_t>::max(), buffer), Varint::MAX_LENGTH);
+}
+
+TEST(VarintTest, RejectsTruncatedAndOverlongValues) {
+	const std::byte truncated[] = {std::byte{0x80}, std::byte{0x80}};
+	size_t offset = 0;
+	EXPECT_THROW(Varint::decode(truncated, offset), std::ios_base::failure);
+	std::vector overlong(Varint::MAX_LENGTH + 1, std::byte{0x80});
+	overlong.back() = std::byte{0x01};
+	offset = 0;
+	EXPECT_THROW(Varint::decode(overlong, offset), std::ios_base::failure);
+}
+
+TEST(LittleEndianTest, StoresLeastSignificantByteFirst) {
+	std::byte bytes[8];
+	LittleEndian::store<uint32_t>(bytes, 0x11223344);
+	EXPECT_EQ(bytes[0], std::byte{0x44});
+	EXPECT_EQ(bytes[3], std::byte{0x11});
+	EXPECT_EQ(LittleEndian::load<uint32_t>(bytes), 0x11223344U);
+	LittleEndian::store<int16_t>(bytes, -2);
+	EXPECT_EQ(bytes[0], std::byte{0xFE});
+	EXPECT_EQ(bytes[1], std::byte{0xFF});
+	EXPECT_EQ(LittleEndian::load<int16_t>(bytes), -2);
+	LittleEndian::store<uint64_t>(bytes, 0x0102030405060708);
+	EXPECT_EQ(bytes[0], std::byte{0x08});
+	EXPECT_EQ(bytes[7], std::byte{0x01});
+	EXPECT_EQ(LittleEndian::load<uint64_t>(bytes), 0x0102030405060708U);
+}
+
+TEST_F(RecordStreamTest, RoundTripAcrossBlocks) {
+	const auto input = records(1000);
+	writeRecords(path_, input, 256);
+	RecordInputStream in(path_);
+	EXPECT_EQ(in.count(), input.size());
+	EXPECT_GT(in.blocks(), 10U);
+	EXPECT_EQ(readAll(), input);
+}
+
+TEST_F(RecordStreamTest, EmptyFile) {
+	writeRecords(path_, {}, 256);
+	RecordInputStream in(path_);
+	EXPECT_EQ(in.count(), 0U);
+	EXPECT_EQ(in.blocks(), 0U);
+	std::vector<std::byte> record;
+	EXPECT_FALSE(in.read(record));
+	ThreadPool pool = makePool(2);
+	in.forEach(pool, [](uint64_t, std::span<const std::byte>) {
+		ADD_FAILURE() << "An empty file has no records";
+	});
+}
+
+TEST_F(RecordStreamTest, SeekMovesToAnyRecord) {
+	const auto input = records(1000);
+	writeRecords(path_, input, 256);
+	RecordInputStream in(path_);
+	std::vector<std::byte> record;
+	for (const uint64_t number : {uint64_t{999}, uint64_t{0}, uint64_t{500}, uint64_t{501}, uint64_t{499}, uint64_t{123}}) {
+		in.seek(number);
+		EXPECT_EQ(in.position(), number);
+		ASSERT_TRUE(in.read(record));
+		EXPECT_EQ(text(record), input[number]);
+		EXPECT_EQ(in.position(), number + 1);
+	}
+	in.seek(in.count());
+	EXPECT_FALSE(in.read(record));
+	EXPECT_THROW(in.seek(in.count() + 1), std::out_of_range);
+}
+
+TEST_F(RecordStreamTest, ForEachVisitsEveryRecordOnce) {
+	const auto input = records(5000);
+	writeRecords(path_, input, 512);
+	const RecordInputStream in(path_);
+	ThreadPool pool = makePool(4);
+	for (const size_t partitions : {size_t{0}, size_t{1}, size_t{3}, size_t{1000000}}) {
+		std::mutex mutex;
+		std::vector<std::string> output(input.size());
+		std::atomic<size_t> visits{0};
+		in.forEach(pool, [&](const uint64_t number, const std::span<const std::byte> bytes) {
+			std::lock_guard lock(mutex);
+			output[number] = std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+			++visits;
+		}, partitions);
+		EXPECT_EQ(visits.load(), input.size());
+		EXPECT_EQ(output, input);
+	}
+}
+
+TEST_F(RecordStreamTest, ForEachRethrowsVisitorException) {
+	writeRecords(path_, records(2000), 256);
+	const RecordInputStream in(path_);
+	ThreadPool pool = makePool(4);
+	EXPECT_THROW(in.forEach(pool, [](const uint64_t number, std::span<const std::byte>) {
+		if (number == 1234) {
+			throw std::runtime_error("visitor failed");
+		}
+	}), std::runtime_error);
+}
+
+TEST_F(RecordStreamTest, CorruptBlockLengthIsRejectedBeforeAllocation) {
+	writeRecords(path_, records(100), 256);
+	auto bytes = readFile(path_);
+	// The first block header starts after the magic: a one-byte record count, then the payload length at offset 5.
+	for (size_t i = 5; i < 14; ++i) {
+		bytes[i] = std::byte{0xFF};
+	}
+	bytes[14] = std::byte{0x01};
+	writeFile(path_, bytes);
+	EXPECT_THROW(readAll(), std::ios_base::failure);
+}
+
+TEST_F(RecordStreamTest, BlockCountMustMatchIndex) {
+	writeRecords(path_, records(100), 256);
+	auto bytes = readFile(path_);
+	ASSERT_LT(static_cast<uint8_t>(bytes[4]), 0x7F);
+	bytes[4] = static_cast<std::byte>(static_cast<uint8_t>(bytes[4]) + 1);
+	writeFile(path_, bytes);
+	EXPECT_THROW(readAll(), std::ios_base::failure);
+}
+
+TEST_F(RecordStreamTest, CorruptPayloadFailsChecksum) {
+	writeRecords(path_, records(100), 256);
+	auto bytes = readFile(path_);
+	bytes[20] ^= std::byte{0x01};
+	writeFile(path_, bytes);
+	EXPECT_THROW(readAll(), std::ios_base::failure);
+	const RecordInputStream in(path_);
+	ThreadPool pool = makePool(2);
+	EXPECT_THROW(in.forEach(pool, [](uint64_t, std::span<const std::byte>) {}), std::ios_base::failure);
+}
+
+TEST_F(RecordStreamTest, TruncatedOrCorruptIndexIsRejected) {
+	writeRecords(path_, records(100), 256);
+	const auto bytes = readFile(path_);
+	for (const size_t size : {size_t{0}, size_t{3}, size_t{27}, bytes.size() / 2, bytes.size() - 1}) {
+		writeFile(path_, std::vector(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(size)));
+		EXPECT_THROW(RecordInputStream{path_}, std::ios_base::failure) << size;
+	}
+	auto corrupt = bytes;
+	corrupt[corrupt.size() - RecordOutputStream::TRAILER_SIZE - 1] ^= std::byte{0x01};
+	writeFile(path_, corrupt);
+	EXPECT_THROW(RecordInputStream{path_}, std::ios_base::failure);
+}
+
+TEST_F(RecordStreamTest, RandomCorruptionNeverEscapesAsAnotherError) {
+	writeRecords(path_, records(300), 256);
+	const auto bytes = readFile(path_);
+	for (size_t i = 0; i < bytes.size(); i += 3) {
+		auto corrupt = bytes;
+		corrupt[i] ^= std::byte{0xA5};
+		writeFile(path_, corrupt);
+		try {
+			static_cast<void>(readAll());
+		}
+		catch (const std::ios_base::failure&) {
+			// Expected for most positions; a flip inside a record's bytes is caught by the block checksum.
+		}
+	}
+}
@@ -0,0 +1,118 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TestData.hpp"
+#include "io/FileInputStream.hpp"
+#include "io/RandomAccessInputStream.hpp"
+
+using common::io::FileInputStream;
+using common::io::RandomAccessInputStream;
+using common::io::SeekableInputStream;
+
+namespace
+{
+constexpr size_t FILE_SIZE = 1 << 20;
+
+class SeekableInputStreamTest : public testing::Test
+{
+protected:
+	void SetUp() override {
+		content_ = test::randomBytes(FILE_SIZE);
+		std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+		out.write(reinterpret_cast<const char*>(content_.data()), static_cast<std::streamsize>(content_.size()));
+	}
+
+	void TearDown() override {
+		std::filesystem::remove(path_);
+	}
+
+	/// Reads random ranges from several threads at once and checks each against the file contents.
+	auto readConcurrently(SeekableInputStream& in) const -> void {
+		std::atomic<size_t> mismatches{0};
+		std::vector<std::thread> threads;
+		for (unsigned t = 0; t < 8; ++t) {
+			threads.emplace_back([&, t] {
+				std::mt19937_64 random(t);
+				std::vector<std::byte> buffer(4096);
+				for (int i = 0; i < 500; ++i) {
+					const size_t offset = random() % (FILE_SIZE + 100);
+					const size_t length = random() % buffer.size();
+					const size_t count = in.readAt(offset, std::span(buffer.data(), length));
+					const size_t expected = offset >= FILE_SIZE ? 0 : std::min(length, FILE_SIZE - offset);
+					if (count != expected || !std::equal(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(count), content_.begin() + static_cast<std::ptrdiff_t>(std::min(offset, FILE_SIZE)))) {
+						++mismatches;
+					}
+				}
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		EXPECT_EQ(mismatches.load(), 0U);
+	}
+
+	std::filesystem::path path_ = std::filesystem::temp_directory_path() / (std::string("SeekableInputStreamTest.") + testing::UnitTest::GetInstance()->current_test_info()->name() + ".bin");
+	std::vector<std::byte> content_;
+};
+}
+
+TEST_F(SeekableInputStreamTest, ConcurrentPositionalReadsOnRandomAccessStream) {
+	RandomAccessInputStream in(path_);
+	std::vector<std::byte> head(10);
+	ASSERT_EQ(in.read(head, 0, head.size()), 10U);
+	readConcurrently(in);
+	// Positional reads leave the sequential position alone.
+	EXPECT_EQ(in.position(), 10U);
+	ASSERT_EQ(in.read(head, 0, head.size()), 10U);
+	EXPECT_TRUE(std::equal(head.begin(), head.end(), content_.begin() + 10));
+}
+
+TEST_F(SeekableInputStreamTest, ConcurrentPositionalReadsOnFileStream) {
+	FileInputStream in(path_);
+	std::vector<std::byte> head(10);
+	ASSERT_EQ(in.read(head, 0, head.size()), 10U);
+	readConcurrently(in);
+	EXPECT_EQ(in.position(), 10U);
+	ASSERT_EQ(in.read(head, 0, head.size()), 10U);
+	EXPECT_TRUE(std::equal(head.begin(), head.end(), content_.begin() + 10));
+}
+
+TEST_F(SeekableInputStreamTest, SeekAndSkipMoveThePosition) {
+	for (const bool randomAccess : {true, false}) {
+		std::unique_ptr<SeekableInputStream> in;
+		if (randomAccess) {
+			in = std::make_unique<RandomAccessInputStream>(path_);
+		}
+		else {
+			in = std::make_unique<FileInputStream>(path_);
+		}
+		EXPECT_EQ(in->size(), FILE_SIZE);
+		in->seek(FILE_SIZE - 5);
+		EXPECT_EQ(in->available(), 5U);
+		std::vector<std::byte> buffer(10);
+		EXPECT_EQ(in->read(buffer, 0, buffer.size()), 5U);
+		EXPECT_TRUE(std::equal(buffer.begin(), buffer.begin() + 5, content_.end() - 5));
+		in->seek(100);
+		EXPECT_EQ(in->skip(50), 50U);
+		EXPECT_EQ(in->position(), 150U);
+		EXPECT_EQ(in->read(), content_[150]);
+		EXPECT_EQ(in->skip(FILE_SIZE), FILE_SIZE - 151);
+		EXPECT_EQ(in->position(), FILE_SIZE);
+		in->close();
+		EXPECT_THROW(in->seek(0), std::ios_base::failure);
+		EXPECT_THROW(static_cast<void>(in->readAt(0, std::span(buffer))), std::ios_base::failure);
+	}
+}
+
+TEST_F(SeekableInputStreamTest, MissingFileIsRejected) {
+	EXPECT_THROW(RandomAccessInputStream(path_.string() + ".missing"), std::ios_base::failure);
+	EXPECT_THROW(RandomAccessInputStream(std::filesystem::temp_directory_path()), std::ios_base::failure);
+}
@@ -0,0 +1,145 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include <gtest/gtest.h>
+#include <concepts>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "TestData.hpp"
+#include "io/BufferedInputStream.hpp"
+#include "io/ByteArrayInputStream.hpp"
+#include "io/ByteArrayOutputStream.hpp"
+#include "io/DynamicInputStream.hpp"
+#include "io/PushbackInputStream.hpp"
+#include "io/StaticBufferedInputStream.hpp"
+#include "io/StaticBufferedOutputStream.hpp"
+#include "io/StaticPushbackInputStream.hpp"
+
+using namespace common::io;
+
+namespace
+{
+using StaticBuffered = StaticBufferedInputStream<ByteArrayInputStream, 4096>;
+using StaticPushback = StaticPushbackInputStream<StaticBuffered>;
+
+template <typename Stream> requires std::same_as<decltype(std::declval<Stream&>().read()), int> auto readByteWise(Stream& in, const size_t expected = 0) -> std::vector<std::byte> {
+	std::vector<std::byte> bytes(expected);
+	size_t count = 0;
+	for (int b = in.read(); b != -1; b = in.read()) {
+		if (count == bytes.size()) {
+			bytes.resize(2 * count + 1);
+		}
+		bytes[count++] = static_cast<std::byte>(b);
+	}
+	bytes.resize(count);
+	return bytes;
+}
+
+auto readByteWise(AbstractInputStream& in, const size_t expected) -> std::vector<std::byte> {
+	std::vector<std::byte> bytes(expected);
+	for (auto& byte : bytes) {
+		byte = in.read();
+	}
+	return bytes;
+}
+
+template <typename Stream> auto readBulk(Stream& in, const size_t chunk) -> std::vector<std::byte> {
+	std::vector<std::byte> bytes;
+	std::vector<std::byte> buffer(chunk);
+	while (true) {
+		const size_t count = in.read(buffer, 0, buffer.size());
+		if (isEndOfStream(count)) {
+			return bytes;
+		}
+		bytes.insert(bytes.end(), buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(count));
+	}
+}
+}
+
+TEST(StaticStreamTest, BufferedStackMatchesSourceByteWiseAndBulk) {
+	const auto data = test::randomBytes(100000);
+	StaticBuffered byteWise(data);
+	EXPECT_EQ(readByteWise(byteWise), data);
+	for (const size_t chunk : {1, 7, 4096, 10000}) {
+		StaticBuffered bulk(data);
+		EXPECT_EQ(readBulk(bulk, chunk), data) << "chunk " << chunk;
+	}
+}
+
+TEST(StaticStreamTest, ByteFFIsNotEndOfStream) {
+	const std::vector data(10, std::byte{0xFF});
+	StaticBuffered in(data);
+	EXPECT_EQ(readByteWise(in), data);
+}
+
+TEST(StaticStreamTest, SkipAcrossBufferBoundary) {
+	const auto data = test::randomBytes(20000);
+	StaticBuffered in(data);
+	ASSERT_EQ(in.read(), std::to_integer<int>(data[0]));
+	EXPECT_EQ(in.skip(9000), 9000U);
+	EXPECT_EQ(in.read(), std::to_integer<int>(data[9001]));
+}
+
+TEST(StaticStreamTest, PushbackOverBufferedReturnsUnreadBytesFirst) {
+	const auto data = test::randomBytes(5000);
+	StaticPushback in(data);
+	const int first = in.read();
+	const int second = in.read();
+	in.unread(static_cast<std::byte>(second));
+	in.unread(static_cast<std::byte>(first));
+	EXPECT_EQ(readByteWise(in), data);
+}
+
+TEST(StaticStreamTest, DynamicAdapterServesVirtualCallers) {
+	const auto data = test::accessLog(30000);
+	DynamicInputStream<StaticBuffered> in(data);
+	EXPECT_EQ(test::readAll(in, 333), data);
+}
+
+TEST(StaticStreamTest, BufferedOutputToVirtualSink) {
+	const auto data = test::randomBytes(50000);
+	const auto sink = std::make_shared<ByteArrayOutputStream>();
+	{
+		StaticBufferedOutputStream<OutputStreamSink, 1024> out(sink);
+		for (size_t i = 0; i < 1000; ++i) {
+			out.write(data[i]);
+		}
+		out.write(std::span(data).subspan(1000));
+		out.flush();
+	}
+	EXPECT_EQ(sink->toByteArray(), data);
+}
+
+/// Compares the virtual and the compile-time stacks over 64 MB; run with --gtest_also_run_disabled_tests.
+TEST(StaticStreamBenchmark, DISABLED_VirtualAgainstStaticStacks) {
+	const auto data = test::randomBytes(64 * 1000 * 1000);
+	const auto report = [&data](const char* name, const double mbps, const std::vector<std::byte>& result) {
+		ASSERT_EQ(result.size(), data.size());
+		std::printf("%-40s %8.0f MB/s\n", name, mbps);
+	};
+	std::vector<std::byte> result;
+	{
+		BufferedInputStream in(std::make_unique<ByteArrayInputStream>(data));
+		report("virtual Buffered, byte-wise", test::megabytesPerSecond(data.size(), [&] { result = readByteWise(in, data.size()); }), result);
+	}
+	{
+		StaticBuffered in(data);
+		report("static Buffered, byte-wise", test::megabytesPerSecond(data.size(), [&] { result = readByteWise(in, data.size()); }), result);
+	}
+	{
+		PushbackInputStream in(std::make_unique<BufferedInputStream>(std::make_unique<ByteArrayInputStream>(data)));
+		report("virtual Pushback(Buffered), byte-wise", test::megabytesPerSecond(data.size(), [&] { result = readByteWise(in, data.size()); }), result);
+	}
+	{
+		StaticPushback in(data);
+		report("static Pushback(Buffered), byte-wise", test::megabytesPerSecond(data.size(), [&] { result = readByteWise(in, data.size()); }), result);
+	}
+	{
+		BufferedInputStream in(std::make_unique<ByteArrayInputStream>(data));
+		report("virtual Buffered, 4 KiB bulk", test::megabytesPerSecond(data.size(), [&] { result = readBulk(in, 4096); }), result);
+	}
+	{
+		StaticBuffered in(data);
+		report("static Buffered, 4 KiB bulk", test::megabytesPerSecond(data.size(), [&] { result = readBulk(in, 4096); }), result);
+	}
+}
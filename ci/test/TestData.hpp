@@ -0,0 +1,71 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "io/AbstractInputStream.hpp"
+
+namespace test
+{
+/// \brief Generates text that compresses like a web server access log.
+/// \param size The number of bytes.
+/// \return The bytes.
+inline auto accessLog(const size_t size) -> std::vector<std::byte> {
+	static constexpr const char* PATHS[] = {"/index.html", "/api/v1/users", "/static/app.js", "/api/v1/orders?page=2", "/favicon.ico"};
+	static constexpr int STATUSES[] = {200, 200, 200, 304, 404, 500};
+	std::mt19937 random(42);
+	std::vector<std::byte> bytes;
+	bytes.reserve(size + 256);
+	while (bytes.size() < size) {
+		const std::string line = "10.0." + std::to_string(random() % 256) + "." + std::to_string(random() % 256) + " - - [18/Oct/2026:10:" + std::to_string(random() % 60) + ":" + std::to_string(random() % 60) + " +0000] \"GET " + PATHS[random() % 5] + " HTTP/1.1\" " + std::to_string(STATUSES[random() % 6]) + " " + std::to_string(random() % 100000) + "\n";
+		for (const char c : line) {
+			bytes.push_back(static_cast<std::byte>(c));
+		}
+	}
+	bytes.resize(size);
+	return bytes;
+}
+
+/// \brief Generates incompressible bytes.
+/// \param size The number of bytes.
+/// \return The bytes.
+inline auto randomBytes(const size_t size) -> std::vector<std::byte> {
+	std::mt19937_64 random(size);
+	std::vector<std::byte> bytes(size);
+	for (auto& byte : bytes) {
+		byte = static_cast<std::byte>(random());
+	}
+	return bytes;
+}
+
+/// \brief Reads a stream to its end through the bulk read.
+/// \param in The stream.
+/// \param chunk The number of bytes requested per read.
+/// \return The bytes read.
+inline auto readAll(common::io::AbstractInputStream& in, const size_t chunk = 4096) -> std::vector<std::byte> {
+	std::vector<std::byte> bytes;
+	std::vector<std::byte> buffer(chunk);
+	while (true) {
+		const size_t count = in.read(buffer, 0, buffer.size());
+		if (count == 0 || count == static_cast<size_t>(-1)) {
+			return bytes;
+		}
+		bytes.insert(bytes.end(), buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(count));
+	}
+}
+
+/// \brief Measures the throughput of a piece of work.
+/// \param bytes The number of bytes the work processes.
+/// \param work The work.
+/// \return The throughput in MB/s.
+template <typename Work> auto megabytesPerSecond(const size_t bytes, Work&& work) -> double {
+	const auto start = std::chrono::steady_clock::now();
+	work();
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return static_cast<double>(bytes) / seconds / 1e6;
+}
+}
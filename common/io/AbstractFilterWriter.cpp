@@ -75,6 +75,16 @@ auto AbstractFilterWriter::write(const std::string& str) -> void {
 	outputWriter_->write(str);
 }
 
+/// \brief Writes a view of characters to the output stream.
+/// \param str The characters to write.
+/// \throws std::runtime_error if the output stream is not available.
+auto AbstractFilterWriter::write(const std::string_view str) -> void {
+	if (!outputWriter_) {
+		throw std::runtime_error("Output stream is not available");
+	}
+	outputWriter_->write(str);
+}
+
 /// \brief Flushes the output stream.
 /// \throws std::runtime_error if the output stream is not available.
 auto AbstractFilterWriter::flush() -> void {
@@ -15,11 +15,13 @@ class AbstractFilterWriter abstract : public AbstractWriter
 public:
 	explicit AbstractFilterWriter(std::unique_ptr<AbstractWriter> outputWriter);
 	~AbstractFilterWriter() override;
+	using AbstractWriter::write;
 	auto write(char c) -> void override;
 	auto write(const std::vector<char>& cBuf, size_t off, size_t len) -> void override;
 	auto write(const std::vector<char>& cBuf) -> void override;
 	auto write(const std::string& str, size_t off, size_t len) -> void override;
 	auto write(const std::string& str) -> void override;
+	auto write(std::string_view str) -> void override;
 	auto flush() -> void override;
 	auto close() -> void override;
 
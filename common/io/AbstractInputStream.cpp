@@ -1,6 +1,9 @@
 // Created by author ethereal on 2024/12/4.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #include "AbstractInputStream.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include "AbstractOutputStream.hpp"
 
 namespace common::io
 {
@@ -20,6 +23,32 @@ auto AbstractInputStream::markSupported() const -> bool {
 	return false;
 }
 
+/// \brief Reads the next byte of data from the input stream.
+/// \details The default implementation reads one byte through the bulk read into the scratch buffer, so a subclass
+/// that overrides only the bulk read needs no separate single-byte path.
+/// \return The byte read, or -1 if the end of the stream has been reached.
+/// \throws std::logic_error If the subclass overrides neither read() nor the bulk read.
+auto AbstractInputStream::read() -> std::byte {
+	if (inDefaultRead_) {
+		throw std::logic_error("Input streams must override read() or read(buffer, offset, len)");
+	}
+	scratch_.resize(std::max<size_t>(scratch_.size(), 1));
+	inDefaultRead_ = true;
+	size_t bytesRead;
+	try {
+		bytesRead = read(scratch_, 0, 1);
+	}
+	catch (...) {
+		inDefaultRead_ = false;
+		throw;
+	}
+	inDefaultRead_ = false;
+	if (bytesRead == 0 || bytesRead == static_cast<size_t>(-1)) {
+		return static_cast<std::byte>(-1);
+	}
+	return scratch_[0];
+}
+
 /// \brief Reads bytes into the specified buffer.
 /// \details Attempts to read up to buffer.size() bytes into the provided buffer vector.
 /// \param buffer The buffer into which the data is read.
@@ -29,24 +58,36 @@ auto AbstractInputStream::read(std::vector<std::byte>& buffer) -> size_t {
 }
 
 /// \brief Reads bytes into the specified buffer.
-/// \details Attempts to read up to len bytes into the provided buffer vector, starting at the offset.
+/// \details Attempts to read up to len bytes into the provided buffer vector, starting at the offset. The default
+/// implementation calls read() once per byte; subclasses that can transfer blocks should override it.
 /// \param buffer The buffer into which the data is read.
 /// \param offset The starting position in the buffer.
 /// \param len The maximum number of bytes to read.
 /// \return The total number of bytes read into the buffer, or -1 if the end of the stream has been reached.
+/// \throws std::logic_error If the subclass overrides neither read() nor the bulk read.
 auto AbstractInputStream::read(std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> size_t {
-	if (offset + len > buffer.size()) {
+	if (offset > buffer.size() || len > buffer.size() - offset) {
 		throw std::out_of_range("Buffer offset/length out of range");
 	}
+	if (inDefaultRead_) {
+		throw std::logic_error("Input streams must override read() or read(buffer, offset, len)");
+	}
+	inDefaultRead_ = true;
 	size_t bytesRead = 0;
-	for (int i = 0; i < len; ++i) {
-		const std::byte byte = read();
-		if (byte == static_cast<std::byte>(-1)) {
-			break;
+	try {
+		for (; bytesRead < len; ++bytesRead) {
+			const std::byte byte = read();
+			if (byte == static_cast<std::byte>(-1)) {
+				break;
+			}
+			buffer[offset + bytesRead] = byte;
 		}
-		buffer[offset + i] = static_cast<std::byte>(byte);
-		++bytesRead;
 	}
+	catch (...) {
+		inDefaultRead_ = false;
+		throw;
+	}
+	inDefaultRead_ = false;
 	return bytesRead;
 }
 
@@ -58,17 +99,39 @@ auto AbstractInputStream::reset() -> void {
 }
 
 /// \brief Skips over and discards n bytes of data from this input stream.
-/// \details The skip method may, for a variety of reasons, end before skipping n bytes.
+/// \details The skip method may, for a variety of reasons, end before skipping n bytes. The default implementation
+/// reads and discards blocks of up to SKIP_BUFFER_SIZE bytes through the bulk read, reusing the scratch buffer.
 /// \param n The number of bytes to skip.
 /// \return The number of bytes actually skipped.
 auto AbstractInputStream::skip(const size_t n) -> size_t {
+	scratch_.resize(std::max(scratch_.size(), std::min(n, SKIP_BUFFER_SIZE)));
 	size_t skipped = 0;
-	for (size_t i = 0; i < n; ++i) {
-		if (read() == static_cast<std::byte>(-1)) {
+	while (skipped < n) {
+		const size_t bytesRead = read(scratch_, 0, std::min(n - skipped, scratch_.size()));
+		if (bytesRead == 0 || bytesRead == static_cast<size_t>(-1)) {
 			break;
 		}
-		++skipped;
+		skipped += bytesRead;
 	}
 	return skipped;
 }
+
+/// \brief Reads the rest of this stream and writes it to an output stream.
+/// \details The default implementation copies blocks of TRANSFER_BUFFER_SIZE bytes through the bulk read and write.
+/// The output stream is neither flushed nor closed.
+/// \param out The stream receiving the bytes.
+/// \return The number of bytes transferred.
+auto AbstractInputStream::transferTo(AbstractOutputStream& out) -> uint64_t {
+	std::vector<std::byte> buffer(TRANSFER_BUFFER_SIZE);
+	uint64_t transferred = 0;
+	while (true) {
+		const size_t bytesRead = read(buffer, 0, buffer.size());
+		if (bytesRead == 0 || bytesRead == static_cast<size_t>(-1)) {
+			break;
+		}
+		out.write(buffer, 0, bytesRead);
+		transferred += bytesRead;
+	}
+	return transferred;
+}
 }
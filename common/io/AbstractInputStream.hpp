@@ -1,16 +1,24 @@
 // Created by author ethereal on 2024/12/4.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #pragma once
+#include <cstdint>
 #include <fstream>
 #include <vector>
 #include "interface/IfaceCloseable.hpp"
 
 namespace common::io
 {
+class AbstractOutputStream;
+
 /// \brief Abstract class for input streams.
 /// \details This abstract class provides a general interface for input streams.
 /// It declares methods for reading from the stream, marking the stream, and resetting the stream.
 /// The available method returns the number of bytes that can be read from the stream without blocking.
+/// \remark Subclasses must override at least one of read() and read(buffer, offset, len); each has a default in
+/// terms of the other. Overriding the bulk read is preferred: read() and skip() then take their bytes from it through
+/// a scratch buffer kept by the stream, instead of making one virtual call per byte.
+/// \remark transferTo() copies the rest of the stream to an output stream. Streams backed by a file descriptor
+/// override it to let the kernel move the bytes.
 class AbstractInputStream abstract : public interface::IfaceCloseable
 {
 public:
@@ -18,10 +26,19 @@ public:
 	[[nodiscard]] virtual auto available() -> size_t = 0;
 	virtual auto mark(int readLimit) -> void;
 	[[nodiscard]] virtual auto markSupported() const -> bool;
-	virtual auto read() -> std::byte = 0;
+	virtual auto read() -> std::byte;
 	virtual auto read(std::vector<std::byte>& buffer) -> size_t;
 	virtual auto read(std::vector<std::byte>& buffer, size_t offset, size_t len) -> size_t;
 	virtual auto reset() -> void;
 	virtual auto skip(size_t n) -> size_t;
+	virtual auto transferTo(AbstractOutputStream& out) -> uint64_t;
+
+protected:
+	static constexpr size_t TRANSFER_BUFFER_SIZE = 128 * 1024;
+
+private:
+	static constexpr size_t SKIP_BUFFER_SIZE = 8192;
+	std::vector<std::byte> scratch_;
+	bool inDefaultRead_{false};
 };
 }
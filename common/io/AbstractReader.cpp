@@ -1,6 +1,7 @@
 // Created by author ethereal on 2024/12/6.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #include "AbstractReader.hpp"
+#include <algorithm>
 
 namespace common::io
 {
@@ -8,14 +9,14 @@ AbstractReader::~AbstractReader() = default;
 
 /// \brief Reads a single character.
 /// \details Reads a single character from the reader and returns it. If the end of the stream has been reached, -1 is
-/// returned.
+/// returned. The character is read through the bulk read into the scratch buffer, so no allocation is made per call.
 /// \return The character read, or -1 if the end of the stream has been reached.
 auto AbstractReader::read() -> int {
-	std::vector<char> buffer(1);
-	if (const size_t bytesRead = read(buffer, 0, 1); bytesRead == -1) {
+	scratch_.resize(std::max<size_t>(scratch_.size(), 1));
+	if (const size_t charsRead = read(scratch_, 0, 1); charsRead == 0 || charsRead == static_cast<size_t>(-1)) {
 		return -1;
 	}
-	return buffer[0];
+	return scratch_[0];
 }
 
 /// \brief Reads characters into a buffer.
@@ -41,18 +42,19 @@ auto AbstractReader::ready() const -> bool {
 }
 
 /// \brief Skips over and discards n characters of data from this reader.
-/// \details The skip method may, for a variety of reasons, end before skipping n characters.
+/// \details The skip method may, for a variety of reasons, end before skipping n characters. The characters are read
+/// and discarded in blocks of up to SKIP_BUFFER_SIZE through the bulk read, reusing the scratch buffer.
 /// \param n The number of characters to skip.
 /// \return The number of characters actually skipped.
-/// \throws std::invalid_argument If the skip value is negative.
 auto AbstractReader::skip(const size_t n) -> size_t {
+	scratch_.resize(std::max(scratch_.size(), std::min(n, SKIP_BUFFER_SIZE)));
 	size_t skipped = 0;
 	while (skipped < n) {
-		std::vector<char> buffer(1024);
-		const size_t toRead = std::min(n - skipped, buffer.size());
-		const size_t readCount = read(buffer, 0, static_cast<int>(toRead));
-		if (readCount == -1) break;
-		skipped += readCount;
+		const size_t charsRead = read(scratch_, 0, std::min(n - skipped, scratch_.size()));
+		if (charsRead == 0 || charsRead == static_cast<size_t>(-1)) {
+			break;
+		}
+		skipped += charsRead;
 	}
 	return skipped;
 }
@@ -13,6 +13,8 @@ namespace common::io
 /// the Closeable and Readable interfaces, requiring derived classes to implement methods for reading characters into
 /// buffers, marking, and resetting the stream. The class also provides methods to check if marking is supported,
 /// determine if the stream is ready to be read, and skip characters.
+/// \remark Subclasses only need to implement the bulk read; read() and skip() are built on it through a scratch
+/// buffer kept by the reader, so they allocate nothing per call.
 class AbstractReader abstract : public interface::IfaceCloseable, public interface::IfaceReadable
 {
 public:
@@ -25,5 +27,9 @@ public:
 	virtual auto reset() -> void =0;
 	[[nodiscard]] virtual auto ready() const -> bool;
 	virtual auto skip(size_t n) -> size_t;
+
+private:
+	static constexpr size_t SKIP_BUFFER_SIZE = 8192;
+	std::vector<char> scratch_;
 };
 }
@@ -42,11 +42,10 @@ auto AbstractWriter::append(const std::string& csq, const size_t start, const si
 
 /// \brief Writes a single character to the Writer.
 /// \details This method writes a single character to the writer object.
-/// It utilizes the overloaded write method to specify the starting position and length, writing a single character.
+/// It forwards the character as a one-element view, so writers that override the view overload need no buffer.
 /// \param c The character to write.
 auto AbstractWriter::write(const char c) -> void {
-	const std::vector buf(1, c);
-	write(buf, 0, 1);
+	write(std::string_view(&c, 1));
 }
 
 /// \brief Writes a vector of characters to the Writer.
@@ -59,10 +58,10 @@ auto AbstractWriter::write(const std::vector<char>& cBuf) -> void {
 
 /// \brief Writes a string to the Writer.
 /// \details This method writes the entire content of the given string to the writer object.
-/// It utilizes the overloaded write method to specify the starting position and length, writing from the start to the end of the string.
+/// It forwards the string as a view, so writers that override the view overload receive it without a copy.
 /// \param str The string to write.
 auto AbstractWriter::write(const std::string& str) -> void {
-	write(str, 0, str.size());
+	write(std::string_view(str));
 }
 
 /// \brief Writes a substring of the given string to the Writer.
@@ -75,9 +74,25 @@ auto AbstractWriter::write(const std::string& str) -> void {
 /// \param len The length of the substring to write.
 auto AbstractWriter::write(const std::string& str, const size_t off, const size_t len) -> void {
 	if (off < str.size()) {
-		const size_t end = off + len < str.size() ? off + len : str.size();
-		const std::vector buf(str.begin() + static_cast<std::string::difference_type>(off), str.begin() + static_cast<std::string::difference_type>(end));
-		write(buf, 0, buf.size());
+		write(std::string_view(str).substr(off, len));
 	}
 }
+
+/// \brief Writes a view of characters to the Writer.
+/// \details This is the zero-copy entry point of the writer hierarchy. The default implementation copies the
+/// characters into a temporary vector for the buffer overload; writers that can consume the characters in place
+/// override it.
+/// \param str The characters to write.
+auto AbstractWriter::write(const std::string_view str) -> void {
+	const std::vector buf(str.begin(), str.end());
+	write(buf, 0, buf.size());
+}
+
+/// \brief Writes a null-terminated string to the Writer.
+/// \details Resolves calls with string literals, which would otherwise be ambiguous between the string and the view
+/// overloads, and forwards them as a view.
+/// \param str The null-terminated string to write.
+auto AbstractWriter::write(const char* str) -> void {
+	write(std::string_view(str));
+}
 }
@@ -1,6 +1,7 @@
 // Created by author ethereal on 2024/12/6.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #pragma once
+#include <string_view>
 #include <vector>
 #include "interface/IfaceAppendable.hpp"
 #include "interface/IfaceCloseable.hpp"
@@ -24,6 +25,8 @@ public:
 	virtual auto write(const std::vector<char>& cBuf, size_t off, size_t len) -> void = 0;
 	virtual auto write(const std::string& str) -> void;
 	virtual auto write(const std::string& str, size_t off, size_t len) -> void;
+	virtual auto write(std::string_view str) -> void;
+	auto write(const char* str) -> void;
 	[[nodiscard]] virtual auto toString() const -> std::string = 0;
 };
 }
@@ -0,0 +1,166 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace common::io
+{
+/// \brief A size-classed pool of reusable stream buffers.
+/// \details Buffers are grouped into power-of-two size classes from 512 bytes to 1 MiB. A released buffer first goes
+/// to a small cache owned by the releasing thread, which the next acquire on that thread serves without locking; when
+/// the cache is full it falls back to a shared free list guarded by a mutex. Requests larger than the biggest class
+/// are allocated directly and never retained. The hit and miss counters report how many acquisitions were served
+/// from the pool.
+/// \tparam T The element type of the buffers, std::byte for streams or char for readers and writers.
+/// \remark The thread-local cache serves one pool at a time, normally the global one; using a different pool on the
+/// same thread drops the cached buffers of the previous one.
+template <typename T> class BufferPool final
+{
+public:
+	explicit BufferPool(size_t maxRetainedPerClass = 64);
+	~BufferPool();
+	static auto global() -> const std::shared_ptr<BufferPool>&;
+	auto acquire(size_t size) -> std::vector<T>;
+	auto release(std::vector<T>&& buffer) -> void;
+	[[nodiscard]] auto hits() const -> size_t;
+	[[nodiscard]] auto misses() const -> size_t;
+
+private:
+	static constexpr size_t MIN_CLASS_SHIFT = 9;
+	static constexpr size_t CLASS_COUNT = 12;
+	static constexpr size_t LOCAL_CAPACITY = 8;
+	using FreeLists = std::array<std::vector<std::vector<T>>, CLASS_COUNT>;
+	struct LocalCache
+	{
+		uint64_t owner{0};
+		FreeLists free{};
+	};
+	static auto local() -> LocalCache&;
+	static auto classOf(size_t size) -> size_t;
+	static inline std::atomic<uint64_t> nextId_{1};
+	const uint64_t id_;
+	const size_t maxRetainedPerClass_;
+	std::mutex mutex_;
+	FreeLists shared_{};
+	std::atomic<size_t> hits_{0};
+	std::atomic<size_t> misses_{0};
+};
+
+using ByteBufferPool = BufferPool<std::byte>;
+using CharBufferPool = BufferPool<char>;
+
+/// \brief Constructs an empty pool.
+/// \param maxRetainedPerClass The maximum number of buffers kept per size class in the shared free list.
+template <typename T> BufferPool<T>::BufferPool(const size_t maxRetainedPerClass) : id_(nextId_.fetch_add(1)), maxRetainedPerClass_(maxRetainedPerClass) {}
+
+/// \brief Destroys the pool and drops the cache of the calling thread if it belongs to this pool.
+template <typename T> BufferPool<T>::~BufferPool() {
+	if (LocalCache& cache = local(); cache.owner == id_) {
+		cache = LocalCache{};
+	}
+}
+
+/// \brief Returns the process-wide pool shared by all streams that are not given one explicitly.
+/// \return The global pool.
+template <typename T> auto BufferPool<T>::global() -> const std::shared_ptr<BufferPool>& {
+	static const auto pool = std::make_shared<BufferPool>();
+	return pool;
+}
+
+/// \brief Acquires a buffer of the given size.
+/// \details The buffer is taken from the thread-local cache, then from the shared free list, and allocated with the
+/// capacity of its size class only if both are empty.
+/// \param size The number of elements the buffer must hold.
+/// \return A buffer whose size() equals \p size.
+template <typename T> auto BufferPool<T>::acquire(const size_t size) -> std::vector<T> {
+	const size_t cls = classOf(size);
+	if (cls >= CLASS_COUNT) {
+		misses_.fetch_add(1, std::memory_order_relaxed);
+		return std::vector<T>(size);
+	}
+	std::vector<T> buffer;
+	if (LocalCache& cache = local(); cache.owner == id_ && !cache.free[cls].empty()) {
+		buffer = std::move(cache.free[cls].back());
+		cache.free[cls].pop_back();
+	}
+	else {
+		std::lock_guard lock(mutex_);
+		if (!shared_[cls].empty()) {
+			buffer = std::move(shared_[cls].back());
+			shared_[cls].pop_back();
+		}
+	}
+	if (buffer.capacity() == 0) {
+		misses_.fetch_add(1, std::memory_order_relaxed);
+		buffer.reserve(size_t{1} << (cls + MIN_CLASS_SHIFT));
+	}
+	else {
+		hits_.fetch_add(1, std::memory_order_relaxed);
+	}
+	buffer.resize(size);
+	return buffer;
+}
+
+/// \brief Returns a buffer to the pool.
+/// \details The buffer is filed under the largest size class its capacity can serve. Buffers smaller than the
+/// smallest class or larger than the biggest one, or arriving when both the thread-local cache and the shared list
+/// are full, are freed.
+/// \param buffer The buffer to return; it is left empty.
+template <typename T> auto BufferPool<T>::release(std::vector<T>&& buffer) -> void {
+	const size_t capacity = buffer.capacity();
+	if (capacity < size_t{1} << MIN_CLASS_SHIFT || capacity > size_t{1} << (MIN_CLASS_SHIFT + CLASS_COUNT - 1)) {
+		buffer = std::vector<T>();
+		return;
+	}
+	const size_t cls = std::bit_width(capacity) - 1 - MIN_CLASS_SHIFT;
+	LocalCache& cache = local();
+	if (cache.owner != id_) {
+		cache = LocalCache{};
+		cache.owner = id_;
+	}
+	if (cache.free[cls].size() < LOCAL_CAPACITY) {
+		cache.free[cls].push_back(std::move(buffer));
+	}
+	else {
+		std::lock_guard lock(mutex_);
+		if (shared_[cls].size() < maxRetainedPerClass_) {
+			shared_[cls].push_back(std::move(buffer));
+		}
+	}
+	buffer = std::vector<T>();
+}
+
+/// \brief Returns the number of acquisitions served by a pooled buffer.
+/// \return The hit count.
+template <typename T> auto BufferPool<T>::hits() const -> size_t {
+	return hits_.load(std::memory_order_relaxed);
+}
+
+/// \brief Returns the number of acquisitions that had to allocate.
+/// \return The miss count.
+template <typename T> auto BufferPool<T>::misses() const -> size_t {
+	return misses_.load(std::memory_order_relaxed);
+}
+
+/// \brief Returns the cache of the calling thread.
+/// \return The thread-local cache.
+template <typename T> auto BufferPool<T>::local() -> LocalCache& {
+	static thread_local LocalCache cache;
+	return cache;
+}
+
+/// \brief Maps a requested size to the smallest size class that can hold it.
+/// \param size The requested number of elements.
+/// \return The size class index, CLASS_COUNT or more if the request is too large to be pooled.
+template <typename T> auto BufferPool<T>::classOf(const size_t size) -> size_t {
+	if (size <= size_t{1} << MIN_CLASS_SHIFT) {
+		return 0;
+	}
+	return std::bit_width(size - 1) - MIN_CLASS_SHIFT;
+}
+}
@@ -1,33 +1,76 @@
 // Created by author ethereal on 2024/12/7.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #include "BufferedInputStream.hpp"
+#include <ranges>
+#include "AbstractOutputStream.hpp"
 
 namespace common::io
 {
 BufferedInputStream::BufferedInputStream(std::unique_ptr<AbstractInputStream> in): BufferedInputStream(std::move(in), DEFAULT_BUFFER_SIZE) {}
 
-BufferedInputStream::BufferedInputStream(std::unique_ptr<AbstractInputStream> in, const int size): FilterInputStream(std::move(in)), buf_(size) {
+BufferedInputStream::BufferedInputStream(std::unique_ptr<AbstractInputStream> in, const int size): BufferedInputStream(std::move(in), size, nullptr) {}
+
+BufferedInputStream::BufferedInputStream(std::unique_ptr<AbstractInputStream> in, const int size, std::shared_ptr<ByteBufferPool> pool): FilterInputStream(std::move(in)), pool_(std::move(pool)) {
 	if (!&inputStream_) {
 		throw std::invalid_argument("Input stream cannot be null");
 	}
 	if (size <= 0) {
 		throw std::invalid_argument("Buffer size must be greater than zero");
 	}
+	buf_ = pool_ ? pool_->acquire(size) : std::vector<std::byte>(size);
+	seekable_ = dynamic_cast<SeekableInputStream*>(inputStream_.get());
+}
+
+/// \brief Constructs a stream that reads ahead on a thread pool.
+/// \param in The underlying input stream; it is only read by the readahead task from now on.
+/// \param size The size of each buffer.
+/// \param threadPool The pool running the readahead task.
+/// \param readaheadDepth The maximum number of buffers filled ahead of the consumer.
+/// \throws std::invalid_argument If the pool is null or the depth is zero.
+BufferedInputStream::BufferedInputStream(std::unique_ptr<AbstractInputStream> in, const int size, std::shared_ptr<thread::ThreadPool> threadPool, const size_t readaheadDepth): BufferedInputStream(std::move(in), size) {
+	if (!threadPool) {
+		throw std::invalid_argument("Thread pool cannot be null");
+	}
+	if (readaheadDepth == 0) {
+		throw std::invalid_argument("Readahead depth must be greater than zero");
+	}
+	threadPool_ = std::move(threadPool);
+	readahead_ = std::make_shared<Readahead>();
+	readahead_->source = inputStream_.get();
+	readahead_->bufferSize = static_cast<size_t>(size);
+	readahead_->maxDepth = readaheadDepth;
+}
+
+BufferedInputStream::~BufferedInputStream() {
+	stopReadahead();
+	releaseBuffer();
 }
 
 /// \brief Returns the number of bytes that can be read from the input stream without blocking.
 /// \details This function calculates the available bytes in the buffer and adds it to the available bytes in the underlying input stream.
+/// In readahead mode only the bytes already read ahead are counted, as the underlying stream belongs to the readahead task.
 /// \return The total number of bytes available for reading without blocking.
 auto BufferedInputStream::available() const -> size_t {
+	if (readahead_) {
+		std::lock_guard lock(readahead_->mutex);
+		size_t buffered = count_ - pos_;
+		for (const auto& length : readahead_->filled | std::views::values) {
+			buffered += length;
+		}
+		return buffered;
+	}
 	return count_ - pos_ + inputStream_->available();
 }
 
 /// \brief Closes the input stream and releases its resources.
 /// \details This function closes the underlying input stream, clears the buffer, and resets the position and mark position.
+/// A pooled buffer is returned to its pool.
 /// \note This function does not throw any exceptions.
 auto BufferedInputStream::close() -> void {
+	stopReadahead();
 	inputStream_->close();
-	buf_.clear();
+	releaseBuffer();
+	pos_ = count_ = 0;
 }
 
 /// \brief Marks the current position in the stream.
@@ -35,7 +78,11 @@ auto BufferedInputStream::close() -> void {
 /// The `readLimit` parameter defines the maximum limit of bytes that can be read
 /// before the mark position becomes invalid.
 /// \param readLimit The limit of bytes that can be read before the mark position becomes invalid.
+/// \throws std::runtime_error In readahead mode.
 auto BufferedInputStream::mark(const int readLimit) -> void {
+	if (readahead_) {
+		throw std::runtime_error("mark not supported in readahead mode");
+	}
 	markLimit_ = readLimit;
 	inputStream_->mark(readLimit);
 	markPos_ = pos_;
@@ -45,7 +92,7 @@ auto BufferedInputStream::mark(const int readLimit) -> void {
 /// \details Whether this input stream supports the mark and reset methods.
 /// \return true if this input stream supports the mark and reset methods, false otherwise.
 auto BufferedInputStream::markSupported() const -> bool {
-	return true;
+	return !readahead_;
 }
 
 /// \brief Reads the next byte of data from the input stream.
@@ -98,13 +145,19 @@ auto BufferedInputStream::read(std::vector<std::byte>& buffer, size_t offset, si
 /// \details This method resets the position in the stream to the last marked position
 /// by calling the mark() method. If a mark has not been set, this method does nothing.
 /// \throws std::ios_base::failure If an error occurs while resetting the stream.
+/// \throws std::runtime_error In readahead mode.
 auto BufferedInputStream::reset() -> void {
+	if (readahead_) {
+		throw std::runtime_error("reset not supported in readahead mode");
+	}
 	pos_ = markPos_;
 	inputStream_->reset();
 }
 
 /// \brief Skips over and discards n bytes of data from this input stream.
 /// \details The skip method may, for a variety of reasons, end before skipping n bytes.
+/// Beyond the buffered bytes, a seekable underlying stream is skipped by seeking unless a mark is set or the stream
+/// reads ahead.
 /// \param n The number of bytes to skip.
 /// \return The number of bytes actually skipped.
 /// \throws std::invalid_argument If the skip value is negative.
@@ -112,6 +165,10 @@ auto BufferedInputStream::skip(size_t n) -> size_t {
 	if (n <= 0) {
 		return 0;
 	}
+	if (const size_t buffered = count_ - pos_; n > buffered && seekable_ != nullptr && !readahead_ && !markActive()) {
+		pos_ = count_ = 0;
+		return buffered + seekable_->skip(n - buffered);
+	}
 	size_t skipped = 0;
 	while (n > 0) {
 		size_t bytesAvailable = count_ - pos_;
@@ -130,20 +187,174 @@ auto BufferedInputStream::skip(size_t n) -> size_t {
 	return skipped;
 }
 
+/// \brief Writes the rest of the stream to an output stream.
+/// \details The buffered bytes are written first and the underlying stream transfers the remainder itself, unless a
+/// mark is set or the stream reads ahead, in which case the bytes are copied through the buffer.
+/// \param out The stream receiving the bytes.
+/// \return The number of bytes transferred.
+auto BufferedInputStream::transferTo(AbstractOutputStream& out) -> uint64_t {
+	if (readahead_ || markActive()) {
+		return FilterInputStream::transferTo(out);
+	}
+	const size_t buffered = count_ - pos_;
+	if (buffered > 0) {
+		out.write(buf_, pos_, buffered);
+	}
+	pos_ = count_ = 0;
+	return buffered + inputStream_->transferTo(out);
+}
+
+/// \brief Checks if a mark is set and still valid.
+/// \return true if reset() would return to a mark.
+auto BufferedInputStream::markActive() const -> bool {
+	return markLimit_ != 0 && markPos_ != static_cast<size_t>(-1);
+}
+
 /// \brief Fills the internal buffer with data from the underlying input stream.
 /// \details This method reads data from the underlying input stream into the internal buffer.
 /// If a mark has been set, it will be cleared if the buffer is filled in such a way that the
 /// mark position is no longer valid.
 auto BufferedInputStream::fillBuffer() -> void {
+	if (readahead_) {
+		fillReadahead();
+		return;
+	}
 	if (markPos_ < 0 || pos_ - markPos_ >= markLimit_) {
 		markPos_ = -1;
 	}
-	if (const size_t bytesRead = inputStream_->read(buf_); bytesRead > 0) {
+	if (const size_t bytesRead = inputStream_->read(buf_); bytesRead > 0 && bytesRead != static_cast<size_t>(-1)) {
 		pos_ = 0;
 		count_ = bytesRead;
 	}
 	else {
+		pos_ = 0;
 		count_ = 0;
 	}
 }
+
+/// \brief Replaces the drained buffer with the next one read ahead.
+/// \details The drained buffer is handed back to the readahead task for reuse. If the task is still filling when
+/// the consumer arrives, the consumer waits and the readahead depth grows by one; if the task has filled every slot
+/// for READAHEAD_SHRINK_AFTER buffers in a row, the depth shrinks by one. An error of the underlying stream is
+/// rethrown here, once, after which the stream behaves as if it had ended.
+auto BufferedInputStream::fillReadahead() -> void {
+	auto& state = *readahead_;
+	std::unique_lock lock(state.mutex);
+	if (!buf_.empty()) {
+		state.spare.push_back(std::exchange(buf_, {}));
+	}
+	pos_ = count_ = 0;
+	if (state.filled.empty() && state.running) {
+		state.depth = std::min(state.depth + 1, state.maxDepth);
+		state.surplus = 0;
+	}
+	else if (state.filled.size() >= state.depth && ++state.surplus >= READAHEAD_SHRINK_AFTER) {
+		state.depth = std::max<size_t>(state.depth - 1, 1);
+		state.surplus = 0;
+	}
+	startReadahead(lock);
+	state.ready.wait(lock, [&state] {
+		return !state.filled.empty() || !state.running;
+	});
+	if (state.filled.empty()) {
+		if (state.error) {
+			std::rethrow_exception(std::exchange(state.error, nullptr));
+		}
+		return;
+	}
+	auto [data, length] = std::move(state.filled.front());
+	state.filled.pop_front();
+	buf_ = std::move(data);
+	count_ = length;
+	startReadahead(lock);
+}
+
+/// \brief Starts the readahead task unless it is running or has nothing to do.
+/// \details When the pool queue is full the task runs on the calling thread instead.
+/// \param lock The held lock of the readahead state; it is released while the task is submitted.
+auto BufferedInputStream::startReadahead(std::unique_lock<std::mutex>& lock) -> void {
+	auto& state = *readahead_;
+	if (state.running || state.eof || state.closed || state.filled.size() >= state.depth) {
+		return;
+	}
+	state.running = true;
+	lock.unlock();
+	try {
+		static_cast<void>(threadPool_->Submit([readahead = readahead_] {
+			produce(readahead);
+		}));
+	}
+	catch (const std::runtime_error&) {
+		produce(readahead_);
+	}
+	lock.lock();
+}
+
+/// \brief Stops the readahead task and waits until it no longer touches the underlying stream.
+/// \details The task finishes the read in progress, if any, and exits. Buffers already read ahead are dropped.
+auto BufferedInputStream::stopReadahead() -> void {
+	if (!readahead_) {
+		return;
+	}
+	std::unique_lock lock(readahead_->mutex);
+	readahead_->closed = true;
+	readahead_->ready.wait(lock, [this] {
+		return !readahead_->running;
+	});
+	readahead_->filled.clear();
+	readahead_->spare.clear();
+}
+
+/// \brief The readahead task.
+/// \details Fills buffers from the underlying stream until the readahead depth is reached, the stream ends or the
+/// stream is closed. Only this task reads the underlying stream, so the buffers are queued in stream order. The
+/// stream is read without holding the lock.
+/// \param readahead The readahead state shared with the stream.
+auto BufferedInputStream::produce(const std::shared_ptr<Readahead>& readahead) -> void {
+	auto& state = *readahead;
+	while (true) {
+		std::vector<std::byte> buffer;
+		{
+			std::lock_guard lock(state.mutex);
+			if (state.closed || state.eof || state.filled.size() >= state.depth) {
+				state.running = false;
+				state.ready.notify_all();
+				return;
+			}
+			if (!state.spare.empty()) {
+				buffer = std::move(state.spare.back());
+				state.spare.pop_back();
+			}
+		}
+		buffer.resize(state.bufferSize);
+		size_t length = 0;
+		std::exception_ptr error;
+		try {
+			length = state.source->read(buffer, 0, state.bufferSize);
+		}
+		catch (...) {
+			error = std::current_exception();
+		}
+		std::lock_guard lock(state.mutex);
+		if (error || length == 0 || length == static_cast<size_t>(-1)) {
+			state.eof = true;
+			state.error = error;
+			state.spare.push_back(std::move(buffer));
+			state.running = false;
+			state.ready.notify_all();
+			return;
+		}
+		state.filled.emplace_back(std::move(buffer), length);
+		state.ready.notify_all();
+	}
+}
+
+/// \brief Releases the internal buffer.
+/// \details A pooled buffer is handed back to the pool; an owned buffer is simply cleared.
+auto BufferedInputStream::releaseBuffer() -> void {
+	if (pool_) {
+		pool_->release(std::move(buf_));
+	}
+	buf_.clear();
+}
 }
@@ -1,20 +1,40 @@
 // Created by author ethereal on 2024/12/7.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #pragma once
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <utility>
 #include <vector>
+#include "BufferPool.hpp"
 #include "FilterInputStream.hpp"
+#include "SeekableInputStream.hpp"
+#include "thread/ThreadPool.hpp"
 
 namespace common::io
 {
 /// \brief A class that reads characters from a stream with buffering.
 /// \details It reads characters from a stream with buffering. The read and skip methods are supported.
 /// The available and markSupported methods are also supported.
-/// \remark The buffer size can be specified in the constructor.
+/// \remark The buffer size can be specified in the constructor. When a buffer pool is given, the buffer is taken
+/// from it and handed back on close() or destruction.
+/// \remark When a thread pool is given, the stream reads ahead: a pool task fills up to the readahead depth of
+/// buffers from the underlying stream while the consumer drains the current one, so reading and processing overlap.
+/// The depth starts at one buffer, grows each time the consumer catches up with the task and shrinks again while
+/// the task stays far ahead, never exceeding the configured maximum. Mark and reset are not supported in this mode.
+/// \remark When the underlying stream is a SeekableInputStream, skip() beyond the buffer discards the buffer and
+/// seeks, so it costs O(1) instead of reading the skipped bytes. It reads through as before while a mark is set or
+/// in readahead mode. transferTo() likewise hands the rest of the stream to the underlying stream after the buffered
+/// bytes, so a descriptor-backed source still copies inside the kernel.
 class BufferedInputStream final : public FilterInputStream
 {
 public:
 	explicit BufferedInputStream(std::unique_ptr<AbstractInputStream> in);
 	BufferedInputStream(std::unique_ptr<AbstractInputStream> in, int size);
+	BufferedInputStream(std::unique_ptr<AbstractInputStream> in, int size, std::shared_ptr<ByteBufferPool> pool);
+	BufferedInputStream(std::unique_ptr<AbstractInputStream> in, int size, std::shared_ptr<thread::ThreadPool> threadPool, size_t readaheadDepth);
+	~BufferedInputStream() override;
 	[[nodiscard]] auto available() const -> size_t;
 	auto close() -> void override;
 	auto mark(int readLimit) -> void override;
@@ -23,14 +43,44 @@ public:
 	auto read(std::vector<std::byte>& buffer, size_t offset, size_t len) -> size_t override;
 	auto reset() -> void override;
 	auto skip(size_t n) -> size_t override;
+	auto transferTo(AbstractOutputStream& out) -> uint64_t override;
 
 protected:
 	static constexpr size_t DEFAULT_BUFFER_SIZE = 8192;
+	static constexpr size_t READAHEAD_SHRINK_AFTER = 16;
+
+	struct Readahead
+	{
+		AbstractInputStream* source{nullptr};
+		size_t bufferSize{0};
+		size_t maxDepth{1};
+		size_t depth{1};
+		size_t surplus{0};
+		std::mutex mutex;
+		std::condition_variable ready;
+		std::deque<std::pair<std::vector<std::byte>, size_t>> filled;
+		std::vector<std::vector<std::byte>> spare;
+		bool running{false};
+		bool eof{false};
+		bool closed{false};
+		std::exception_ptr error;
+	};
+
+	std::shared_ptr<ByteBufferPool> pool_;
 	std::vector<std::byte> buf_;
 	size_t count_{0};
 	size_t markLimit_{0};
 	size_t markPos_{0};
 	size_t pos_{0};
+	std::shared_ptr<thread::ThreadPool> threadPool_;
+	std::shared_ptr<Readahead> readahead_;
+	SeekableInputStream* seekable_{nullptr};
+	[[nodiscard]] auto markActive() const -> bool;
 	auto fillBuffer() -> void;
+	auto fillReadahead() -> void;
+	auto startReadahead(std::unique_lock<std::mutex>& lock) -> void;
+	auto stopReadahead() -> void;
+	auto releaseBuffer() -> void;
+	static auto produce(const std::shared_ptr<Readahead>& readahead) -> void;
 };
 }
@@ -6,22 +6,28 @@ namespace common::io
 {
 BufferedOutputStream::BufferedOutputStream(std::unique_ptr<AbstractOutputStream> out): BufferedOutputStream(std::move(out), DEFAULT_BUFFER_SIZE) {}
 
-BufferedOutputStream::BufferedOutputStream(std::unique_ptr<AbstractOutputStream> out, const size_t size): FilterOutputStream(std::move(out)), bufferSize_(size), buffer_(size), bufferPosition_(0) {
+BufferedOutputStream::BufferedOutputStream(std::unique_ptr<AbstractOutputStream> out, const size_t size): BufferedOutputStream(std::move(out), size, nullptr) {}
+
+BufferedOutputStream::BufferedOutputStream(std::unique_ptr<AbstractOutputStream> out, const size_t size, std::shared_ptr<ByteBufferPool> pool): FilterOutputStream(std::move(out)), bufferSize_(size), pool_(std::move(pool)), bufferPosition_(0) {
 	if (!&outputStream_) {
 		throw std::invalid_argument("Output stream cannot be null");
 	}
 	if (size == 0) {
 		throw std::invalid_argument("Buffer size must be greater than 0");
 	}
+	buffer_ = pool_ ? pool_->acquire(size) : std::vector<std::byte>(size);
 }
 
 BufferedOutputStream::~BufferedOutputStream() {
 	try {
-		BufferedOutputStream::flush();
+		if (!buffer_.empty()) {
+			BufferedOutputStream::flush();
+		}
 	}
 	catch (...) {
 		// Suppress exceptions in destructors
 	}
+	releaseBuffer();
 }
 
 /// \brief Writes a byte to the stream.
@@ -30,6 +36,9 @@ BufferedOutputStream::~BufferedOutputStream() {
 auto BufferedOutputStream::write(const std::byte b) -> void {
 	if (bufferPosition_ >= bufferSize_) {
 		flushBuffer();
+		if (buffer_.empty()) {
+			throw std::runtime_error("Output stream is closed");
+		}
 	}
 	buffer_[bufferPosition_++] = b;
 }
@@ -47,6 +56,9 @@ auto BufferedOutputStream::write(const std::vector<std::byte>& data, const size_
 	while (bytesWritten < len) {
 		if (bufferPosition_ == bufferSize_) {
 			flushBuffer();
+			if (buffer_.empty()) {
+				throw std::runtime_error("Output stream is closed");
+			}
 		}
 		const size_t bytesToCopy = std::min(len - bytesWritten, bufferSize_ - bufferPosition_);
 		std::memcpy(&buffer_[bufferPosition_], &data[offset + bytesWritten], bytesToCopy);
@@ -63,9 +75,12 @@ auto BufferedOutputStream::flush() -> void {
 }
 
 /// \brief Closes the output stream and releases its resources.
-/// \details This function closes the underlying output stream and releases its resources.
+/// \details This function writes out the buffered bytes, closes the underlying output stream and releases its
+/// resources. A pooled buffer is returned to its pool.
 auto BufferedOutputStream::close() -> void {
+	flushBuffer();
 	outputStream_->close();
+	releaseBuffer();
 }
 
 /// \brief Flushes the internal buffer.
@@ -77,4 +92,15 @@ auto BufferedOutputStream::flushBuffer() -> void {
 		bufferPosition_ = 0;
 	}
 }
+
+/// \brief Releases the internal buffer.
+/// \details A pooled buffer is handed back to the pool; an owned buffer is simply cleared. Further writes fail.
+auto BufferedOutputStream::releaseBuffer() -> void {
+	if (pool_) {
+		pool_->release(std::move(buffer_));
+	}
+	buffer_.clear();
+	bufferSize_ = 0;
+	bufferPosition_ = 0;
+}
 }
@@ -3,6 +3,7 @@
 #pragma once
 #include <vector>
 #include "AbstractOutputStream.hpp"
+#include "BufferPool.hpp"
 #include "FilterOutputStream.hpp"
 
 namespace common::io
@@ -13,12 +14,14 @@ namespace common::io
 /// The write method writes a single byte to the internal buffer.
 /// The write method writes a range of bytes to the internal buffer.
 /// The flush method flushes the internal buffer to the underlying stream.
-/// The close method closes the underlying stream.
+/// The close method flushes the buffer and closes the underlying stream.
+/// When a buffer pool is given, the buffer is taken from it and handed back on close() or destruction.
 class BufferedOutputStream final : public FilterOutputStream
 {
 public:
 	explicit BufferedOutputStream(std::unique_ptr<AbstractOutputStream> out);
 	BufferedOutputStream(std::unique_ptr<AbstractOutputStream> out, size_t size);
+	BufferedOutputStream(std::unique_ptr<AbstractOutputStream> out, size_t size, std::shared_ptr<ByteBufferPool> pool);
 	~BufferedOutputStream() override;
 	auto write(std::byte b) -> void override;
 	auto write(const std::vector<std::byte>& data, size_t offset, size_t len) -> void override;
@@ -28,8 +31,10 @@ public:
 protected:
 	static constexpr size_t DEFAULT_BUFFER_SIZE = 8192;
 	size_t bufferSize_;
+	std::shared_ptr<ByteBufferPool> pool_;
 	std::vector<std::byte> buffer_;
 	size_t bufferPosition_;
 	void flushBuffer();
+	void releaseBuffer();
 };
 }
@@ -4,21 +4,26 @@
 
 namespace common::io
 {
-BufferedReader::BufferedReader(std::unique_ptr<AbstractReader> reader, const int size = DEFAULT_BUFFER_SIZE): reader_(std::move(reader)), bufferSize_(size) {
+BufferedReader::BufferedReader(std::unique_ptr<AbstractReader> reader, const int size = DEFAULT_BUFFER_SIZE): BufferedReader(std::move(reader), size, nullptr) {}
+
+BufferedReader::BufferedReader(std::unique_ptr<AbstractReader> reader, const int size, std::shared_ptr<CharBufferPool> pool): pool_(std::move(pool)), reader_(std::move(reader)), bufferSize_(size) {
 	if (size <= 0) {
 		throw std::invalid_argument("Buffer size must be greater than 0");
 	}
-	buffer_.resize(size);
+	buffer_ = pool_ ? pool_->acquire(size) : std::vector<char>(size);
 }
 
-BufferedReader::~BufferedReader() = default;
+BufferedReader::~BufferedReader() {
+	releaseBuffer();
+}
 
 /// \brief Closes the BufferedReader and releases its resources.
 /// \details This method closes the reader and releases any system resources associated with it.
 /// Once the stream has been closed, further read(), ready(), mark(), or reset() operations will throw.
-/// Closing a previously closed stream has no effect.
+/// Closing a previously closed stream has no effect. A pooled buffer is returned to its pool.
 auto BufferedReader::close() -> void {
 	reader_->close();
+	releaseBuffer();
 }
 
 /// \brief Marks the current position in the stream.
@@ -162,4 +167,16 @@ bool BufferedReader::fillBuffer() {
 	count_ = reader_->read(buffer_, 0, bufferSize_);
 	return count_ > 0;
 }
+
+/// \brief Releases the internal buffer.
+/// \details A pooled buffer is handed back to the pool; an owned buffer is simply cleared. Further reads report the
+/// end of the stream.
+void BufferedReader::releaseBuffer() {
+	if (pool_) {
+		pool_->release(std::move(buffer_));
+	}
+	buffer_.clear();
+	bufferSize_ = 0;
+	pos_ = count_ = 0;
+}
 }
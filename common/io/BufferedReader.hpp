@@ -3,17 +3,20 @@
 #pragma once
 #include <iostream>
 #include "AbstractReader.hpp"
+#include "BufferPool.hpp"
 
 namespace common::io
 {
 /// \brief A final class that provides buffering for a Reader object.
 /// \details This class provides buffering for a Reader object. Buffering can greatly improve performance by reducing the number
 /// of calls to the underlying Reader object. The buffering is optional and can be disabled by calling the constructor with
-/// a buffer size of 0.
+/// a buffer size of 0. When a buffer pool is given, the buffer is taken from it and handed back on close() or
+/// destruction.
 class BufferedReader final : public AbstractReader
 {
 public:
 	explicit BufferedReader(std::unique_ptr<AbstractReader> reader, int size);
+	BufferedReader(std::unique_ptr<AbstractReader> reader, int size, std::shared_ptr<CharBufferPool> pool);
 	~BufferedReader() override;
 	auto close() -> void override;
 	auto mark(size_t readAheadLimit) -> void override;
@@ -27,6 +30,7 @@ public:
 
 private:
 	static constexpr size_t DEFAULT_BUFFER_SIZE = 8192;
+	std::shared_ptr<CharBufferPool> pool_;
 	std::vector<char> buffer_;
 	std::unique_ptr<AbstractReader> reader_;
 	size_t bufferSize_{0};
@@ -34,5 +38,6 @@ private:
 	size_t count_{0};
 	size_t markLimit_{0};
 	bool fillBuffer();
+	void releaseBuffer();
 };
 }
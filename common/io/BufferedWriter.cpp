@@ -6,31 +6,49 @@
 
 namespace common::io
 {
-BufferedWriter::BufferedWriter(std::unique_ptr<std::ofstream> os, const size_t size = DEFAULT_BUFFER_SIZE): outputStream_(std::move(os)), bufferSize_(size) {
+BufferedWriter::BufferedWriter(std::unique_ptr<std::ofstream> os, const size_t size = DEFAULT_BUFFER_SIZE): BufferedWriter(std::move(os), size, nullptr) {}
+
+BufferedWriter::BufferedWriter(std::unique_ptr<std::ofstream> os, const size_t size, std::shared_ptr<CharBufferPool> pool): outputStream_(std::move(os)), pool_(std::move(pool)), bufferSize_(size) {
 	if (!outputStream_->is_open()) {
 		throw std::runtime_error("Output stream is not open.");
 	}
-	buffer_.reserve(size);
+	if (pool_) {
+		buffer_ = pool_->acquire(size);
+		buffer_.clear();
+	}
+	else {
+		buffer_.reserve(size);
+	}
 }
 
 BufferedWriter::~BufferedWriter() {
-	BufferedWriter::close();
+	try {
+		BufferedWriter::close();
+	}
+	catch (...) {
+		// Suppress exceptions in destructors
+	}
 }
 
 /// \brief Writes a string to the writer.
-/// \details This function writes a string to the writer. If the size of the string
-/// is greater than the buffer size, the buffer is flushed and the string is written
-/// directly to the output stream. Otherwise, the string is written to the buffer.
-/// If the buffer is full after writing the string, the buffer is flushed.
+/// \details This function writes a string to the writer through the view overload.
 auto BufferedWriter::write(const std::string& str) -> void {
+	write(std::string_view(str));
+}
+
+/// \brief Writes a view of characters to the writer.
+/// \details If the view is larger than the buffer, the buffer is flushed and the characters are written directly to
+/// the output stream. Otherwise they are appended to the buffer in one block, and the buffer is flushed once full.
+/// \param str The characters to write.
+/// \throws std::runtime_error If the writer is closed.
+auto BufferedWriter::write(const std::string_view str) -> void {
+	checkOpen();
 	if (str.size() > bufferSize_) {
 		flush();
-		*outputStream_ << str;
+		outputStream_->write(str.data(), static_cast<std::streamsize>(str.size()));
 	}
 	else {
-		for (const char c : str) {
-			buffer_.push_back(static_cast<char>(c));
-		}
+		buffer_.insert(buffer_.end(), str.begin(), str.end());
 		if (buffer_.size() >= bufferSize_) {
 			flush();
 		}
@@ -42,7 +60,9 @@ auto BufferedWriter::write(const std::string& str) -> void {
 /// is greater than the buffer size, the buffer is flushed and the portion is written directly to the
 /// output stream. Otherwise, the portion is written to the buffer. If the buffer is full after writing
 /// the portion, the buffer is flushed.
+/// \throws std::runtime_error If the writer is closed.
 auto BufferedWriter::write(const std::vector<char>& cBuf, const size_t off, const size_t len) -> void {
+	checkOpen();
 	if (off + len > cBuf.size()) {
 		throw std::out_of_range("Offset and length are out of the bounds of the buffer.");
 	}
@@ -64,14 +84,15 @@ auto BufferedWriter::write(const std::vector<char>& cBuf, const size_t off, cons
 /// \details This function is a convenience method to write a line separator to the writer.
 /// It writes a "\n" to the writer and returns the writer itself.
 auto BufferedWriter::newLine() -> BufferedWriter& {
-	write("\n");
-	return *this;
+	return append('\n');
 }
 
 /// \brief Flushes the buffer.
 /// \details This function flushes the buffer to the output stream. If the buffer is empty,
 /// this function does nothing.
+/// \throws std::runtime_error If the writer is closed.
 auto BufferedWriter::flush() -> void {
+	checkOpen();
 	if (!buffer_.empty()) {
 		outputStream_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
 		buffer_.clear();
@@ -79,16 +100,27 @@ auto BufferedWriter::flush() -> void {
 }
 
 /// \brief Closes the writer.
-/// \details This function flushes the buffer and closes the output stream.
+/// \details This function flushes the buffer and closes the output stream. A pooled buffer is returned to its pool.
+/// If the writer is already closed, this function does nothing.
 auto BufferedWriter::close() -> void {
+	if (closed_) {
+		return;
+	}
 	flush();
 	outputStream_->close();
+	closed_ = true;
+	if (pool_) {
+		pool_->release(std::move(buffer_));
+		buffer_.clear();
+	}
 }
 
 /// \brief Appends a character to the writer.
 /// \details This function appends a character to the writer. If the buffer is full after appending the character,
 /// the buffer is flushed.
+/// \throws std::runtime_error If the writer is closed.
 auto BufferedWriter::append(const char c) -> BufferedWriter& {
+	checkOpen();
 	buffer_.push_back(static_cast<char>(c));
 	if (buffer_.size() >= bufferSize_) {
 		flush();
@@ -99,7 +131,9 @@ auto BufferedWriter::append(const char c) -> BufferedWriter& {
 /// \brief Appends a string to the writer.
 /// \details This function appends a string to the writer. If the buffer is full after appending the string,
 /// the buffer is flushed.
+/// \throws std::runtime_error If the writer is closed.
 auto BufferedWriter::append(const std::string& str) -> BufferedWriter& {
+	checkOpen();
 	for (const char c : str) {
 		buffer_.push_back(static_cast<char>(c));
 		if (buffer_.size() >= bufferSize_) {
@@ -119,7 +153,9 @@ auto BufferedWriter::append(const std::string& str) -> BufferedWriter& {
 /// \param start The starting index (inclusive) of the substring to append.
 /// \param end The ending index (exclusive) of the substring to append.
 /// \return A reference to the BufferedWriter object.
+/// \throws std::runtime_error If the writer is closed.
 auto BufferedWriter::append(const std::string& str, const size_t start, const size_t end) -> BufferedWriter& {
+	checkOpen();
 	if (start < str.length() && end <= str.length() && start < end) {
 		for (size_t i = start; i < end; ++i) {
 			buffer_.push_back(static_cast<char>(str[i]));
@@ -142,4 +178,12 @@ auto BufferedWriter::toString() const -> std::string {
 	}
 	return str;
 }
+
+/// \brief Checks that the writer is open.
+/// \throws std::runtime_error If the writer is closed.
+auto BufferedWriter::checkOpen() const -> void {
+	if (closed_) {
+		throw std::runtime_error("Writer is closed");
+	}
+}
 }
@@ -4,6 +4,7 @@
 #include <vector>
 #include <glog/logging.h>
 #include "AbstractWriter.hpp"
+#include "BufferPool.hpp"
 #include "interface/IfaceAppendable.hpp"
 
 namespace common::io
@@ -11,14 +12,19 @@ namespace common::io
 /// \brief A class that writes characters to a stream with buffering.
 /// \details It writes characters to a stream with buffering. The write and append methods are supported.
 /// The available and markSupported methods are also supported.
-/// \remark The buffer size can be specified in the constructor.
+/// \remark The buffer size can be specified in the constructor. When a buffer pool is given, the buffer is taken
+/// from it and handed back on close() or destruction. Once closed, the writer rejects further writes; closing it again
+/// does nothing.
 class BufferedWriter final : public common::io::AbstractWriter, public common::interface::IfaceAppendable<BufferedWriter>
 {
 public:
 	explicit BufferedWriter(std::unique_ptr<std::ofstream> os, size_t size);
+	BufferedWriter(std::unique_ptr<std::ofstream> os, size_t size, std::shared_ptr<CharBufferPool> pool);
 	~BufferedWriter() override;
+	using AbstractWriter::write;
 	auto write(const std::string& str) -> void override;
 	auto write(const std::vector<char>& cBuf, size_t off, size_t len) -> void override;
+	auto write(std::string_view str) -> void override;
 	auto newLine() -> BufferedWriter&;
 	auto flush() -> void override;
 	auto close() -> void override;
@@ -29,8 +35,11 @@ public:
 
 private:
 	static constexpr size_t DEFAULT_BUFFER_SIZE = 1024;
+	auto checkOpen() const -> void;
 	std::unique_ptr<std::ofstream> outputStream_;
+	std::shared_ptr<CharBufferPool> pool_;
 	std::vector<char> buffer_;
 	size_t bufferSize_;
+	bool closed_{false};
 };
 }
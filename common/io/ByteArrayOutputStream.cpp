@@ -1,6 +1,8 @@
 // Created by author ethereal on 2024/12/8.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #include "ByteArrayOutputStream.hpp"
+#include <algorithm>
+#include <cstring>
 
 namespace common::io
 {
@@ -13,10 +15,32 @@ ByteArrayOutputStream::ByteArrayOutputStream(const size_t size) {
 	buf_.resize(size);
 }
 
+/// \brief Constructor selecting the storage mode.
+/// \param mode The storage mode.
+/// \param chunkSize In chunked mode, the size of the first chunk; later chunks double up to MAX_CHUNK_SIZE. In
+/// contiguous mode, the initial capacity.
+/// \throws std::invalid_argument if the chunk size is zero.
+ByteArrayOutputStream::ByteArrayOutputStream(const Mode mode, const size_t chunkSize): mode_(mode), chunkSize_(chunkSize) {
+	if (chunkSize == 0) {
+		throw std::invalid_argument("Chunk size must be greater than 0");
+	}
+	if (mode == Mode::CONTIGUOUS) {
+		buf_.resize(chunkSize);
+	}
+}
+
 /// \brief Writes a single byte to the buffer.
 /// \param b Byte to write.
 /// \details The method will increase the buffer size if the buffer is full.
 auto ByteArrayOutputStream::write(const std::byte b) -> void {
+	if (mode_ == Mode::CHUNKED) {
+		if (chunks_.empty() || tailUsed_ == chunks_.back().size()) {
+			appendChunk();
+		}
+		chunks_.back()[tailUsed_++] = b;
+		++count_;
+		return;
+	}
 	if (count_ == buf_.size()) {
 		buf_.resize(buf_.size() * 2);
 	}
@@ -34,6 +58,10 @@ auto ByteArrayOutputStream::write(const std::vector<std::byte>& buffer, const si
 	if (offset + len > buffer.size()) {
 		throw std::out_of_range("Buffer offset/length out of range");
 	}
+	if (mode_ == Mode::CHUNKED) {
+		append(buffer.data() + offset, len);
+		return;
+	}
 	if (count_ + len > buf_.size()) {
 		buf_.resize(std::max(buf_.size() * 2, count_ + len));
 	}
@@ -44,14 +72,34 @@ auto ByteArrayOutputStream::write(const std::vector<std::byte>& buffer, const si
 /// \brief Writes the entire content of the internal buffer to the given OutputStream.
 /// \param out Stream to write to.
 /// \details This method writes the entire content of the internal buffer to the given OutputStream.
+/// In chunked mode each chunk is handed to the stream in place, one write per chunk, without joining them first.
+/// When the target is another ByteArrayOutputStream the chunks are appended to it directly.
 auto ByteArrayOutputStream::writeTo(AbstractOutputStream& out) const -> void {
-	out.write(buf_, 0, count_);
+	if (mode_ == Mode::CONTIGUOUS) {
+		out.write(buf_, 0, count_);
+		return;
+	}
+	auto* target = dynamic_cast<ByteArrayOutputStream*>(&out);
+	for (size_t i = 0; i < chunks_.size(); ++i) {
+		const size_t used = i + 1 == chunks_.size() ? tailUsed_ : chunks_[i].size();
+		if (target && target->mode_ == Mode::CHUNKED) {
+			target->append(chunks_[i].data(), used);
+		}
+		else {
+			out.write(chunks_[i], 0, used);
+		}
+	}
 }
 
 /// \brief Resets the buffer to an empty state.
 /// \details This method resets the internal counter to zero, effectively discarding any data written to the stream.
+/// In chunked mode the first chunk is kept for reuse and the others are freed.
 auto ByteArrayOutputStream::reset() -> void {
 	count_ = 0;
+	tailUsed_ = 0;
+	if (chunks_.size() > 1) {
+		chunks_.resize(1);
+	}
 }
 
 /// \brief Creates a copy of the current buffer as a byte array.
@@ -60,7 +108,15 @@ auto ByteArrayOutputStream::reset() -> void {
 /// The returned vector is a copy of the valid bytes in the internal buffer.
 /// The method does not modify the internal state of the ByteArrayOutputStream.
 auto ByteArrayOutputStream::toByteArray() const -> std::vector<std::byte> {
-	return {buf_.begin(), buf_.begin() + static_cast<std::vector<char>::difference_type>(count_)};
+	if (mode_ == Mode::CONTIGUOUS) {
+		return {buf_.begin(), buf_.begin() + static_cast<std::vector<char>::difference_type>(count_)};
+	}
+	std::vector<std::byte> result;
+	result.reserve(count_);
+	for (const auto& span : spans()) {
+		result.insert(result.end(), span.begin(), span.end());
+	}
+	return result;
 }
 
 /// \brief Returns the current size of the buffer.
@@ -76,7 +132,96 @@ auto ByteArrayOutputStream::size() const -> size_t {
 /// The returned string is a copy of the valid bytes in the internal buffer.
 /// The method does not modify the internal state of the ByteArrayOutputStream.
 auto ByteArrayOutputStream::toString() const -> std::string {
-	return {reinterpret_cast<const char*>(buf_.data()), count_};
+	if (mode_ == Mode::CONTIGUOUS) {
+		return {reinterpret_cast<const char*>(buf_.data()), count_};
+	}
+	std::string result;
+	result.reserve(count_);
+	for (const auto& span : spans()) {
+		result.append(reinterpret_cast<const char*>(span.data()), span.size());
+	}
+	return result;
+}
+
+/// \brief Returns the storage mode of the stream.
+/// \return The storage mode.
+auto ByteArrayOutputStream::mode() const -> Mode {
+	return mode_;
+}
+
+/// \brief Returns the content as a list of spans over the internal storage.
+/// \details Nothing is copied: contiguous mode yields one span, chunked mode one span per chunk in write order. The
+/// spans stay valid until the next write, reset() or release; in chunked mode spans over full chunks stay valid
+/// across writes. The list can be turned into an iovec array for gather I/O.
+/// \return The spans covering the valid bytes, empty if nothing has been written.
+auto ByteArrayOutputStream::spans() const -> std::vector<std::span<const std::byte>> {
+	std::vector<std::span<const std::byte>> result;
+	if (mode_ == Mode::CONTIGUOUS) {
+		if (count_ > 0) {
+			result.emplace_back(buf_.data(), count_);
+		}
+		return result;
+	}
+	result.reserve(chunks_.size());
+	for (size_t i = 0; i < chunks_.size(); ++i) {
+		const size_t used = i + 1 == chunks_.size() ? tailUsed_ : chunks_[i].size();
+		if (used > 0) {
+			result.emplace_back(chunks_[i].data(), used);
+		}
+	}
+	return result;
+}
+
+/// \brief Moves the content out of the stream as a single byte array.
+/// \details In contiguous mode the internal buffer is trimmed and moved out without copying. In chunked mode the
+/// chunks are joined into one array, copying each byte once; use releaseChunks() to avoid that copy. The stream is
+/// left empty and can be written again.
+/// \return The valid bytes of the stream.
+auto ByteArrayOutputStream::release() -> std::vector<std::byte> {
+	std::vector<std::byte> result;
+	if (mode_ == Mode::CONTIGUOUS) {
+		buf_.resize(count_);
+		result = std::move(buf_);
+		buf_ = std::vector<std::byte>(32);
+	}
+	else if (chunks_.size() == 1) {
+		chunks_.front().resize(tailUsed_);
+		result = std::move(chunks_.front());
+		chunks_.clear();
+	}
+	else {
+		result = toByteArray();
+		chunks_.clear();
+	}
+	count_ = 0;
+	tailUsed_ = 0;
+	return result;
+}
+
+/// \brief Moves the content out of the stream as a list of byte arrays without copying.
+/// \details Each array is trimmed to its valid bytes. In contiguous mode the list holds the single internal buffer.
+/// Like spans(), the list holds no empty arrays, so it is empty if nothing has been written. The stream is left
+/// empty and can be written again.
+/// \return The valid bytes of the stream, in write order.
+auto ByteArrayOutputStream::releaseChunks() -> std::vector<std::vector<std::byte>> {
+	std::vector<std::vector<std::byte>> result;
+	if (mode_ == Mode::CONTIGUOUS) {
+		if (count_ > 0) {
+			result.push_back(release());
+		}
+		return result;
+	}
+	if (!chunks_.empty()) {
+		chunks_.back().resize(tailUsed_);
+		if (tailUsed_ == 0) {
+			chunks_.pop_back();
+		}
+	}
+	result = std::move(chunks_);
+	chunks_.clear();
+	count_ = 0;
+	tailUsed_ = 0;
+	return result;
 }
 
 /// \brief Closes the stream and releases any system resources associated with it.
@@ -88,4 +233,30 @@ auto ByteArrayOutputStream::close() -> void {}
 auto ByteArrayOutputStream::flush() -> void {
 	// No operation for ByteArrayOutputStream.
 }
+
+/// \brief Allocates the next chunk.
+/// \details Chunk sizes start at the configured chunk size and double with each chunk up to MAX_CHUNK_SIZE, which
+/// keeps the chunk list short for large payloads while small ones stay in a single small allocation.
+auto ByteArrayOutputStream::appendChunk() -> void {
+	const size_t shift = std::min<size_t>(chunks_.size(), 20);
+	chunks_.emplace_back(std::max(chunkSize_, std::min(chunkSize_ << shift, MAX_CHUNK_SIZE)));
+	tailUsed_ = 0;
+}
+
+/// \brief Appends a block of bytes to the chunk list, filling the last chunk before allocating another.
+/// \param data The bytes to append.
+/// \param len The number of bytes to append.
+auto ByteArrayOutputStream::append(const std::byte* data, size_t len) -> void {
+	count_ += len;
+	while (len > 0) {
+		if (chunks_.empty() || tailUsed_ == chunks_.back().size()) {
+			appendChunk();
+		}
+		const size_t count = std::min(len, chunks_.back().size() - tailUsed_);
+		std::memcpy(chunks_.back().data() + tailUsed_, data, count);
+		tailUsed_ += count;
+		data += count;
+		len -= count;
+	}
+}
 }
@@ -1,6 +1,7 @@
 // Created by author ethereal on 2024/12/8.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #pragma once
+#include <span>
 #include "AbstractOutputStream.hpp"
 
 namespace common::io
@@ -8,11 +9,19 @@ namespace common::io
 /// \brief A ByteArrayOutputStream provides a stream for writing data to a byte array.
 /// \details This class is inspired by Java's ByteArrayOutputStream and allows writing
 /// to a dynamically growing byte buffer.
+/// In the default contiguous mode the data is kept in one vector that is reallocated as it grows. In chunked mode
+/// the data is kept in a list of chunks whose sizes double up to MAX_CHUNK_SIZE; full chunks are never moved, so
+/// building a multi-megabyte payload copies every byte exactly once. The content can be inspected as a list of
+/// spans without copying, and release() or releaseChunks() move it out instead of copying it.
 class ByteArrayOutputStream final : public AbstractOutputStream
 {
 public:
+	enum class Mode { CONTIGUOUS, CHUNKED };
+	static constexpr size_t DEFAULT_CHUNK_SIZE = 4096;
+	static constexpr size_t MAX_CHUNK_SIZE = 1 << 20;
 	ByteArrayOutputStream();
 	explicit ByteArrayOutputStream(size_t size);
+	ByteArrayOutputStream(Mode mode, size_t chunkSize = DEFAULT_CHUNK_SIZE);
 	auto write(std::byte b) -> void override;
 	auto write(const std::vector<std::byte>& buffer, size_t offset, size_t len) -> void override;
 	auto writeTo(AbstractOutputStream& out) const -> void;
@@ -20,11 +29,21 @@ public:
 	[[nodiscard]] auto toByteArray() const -> std::vector<std::byte>;
 	[[nodiscard]] auto size() const -> size_t;
 	[[nodiscard]] auto toString() const -> std::string;
+	[[nodiscard]] auto mode() const -> Mode;
+	[[nodiscard]] auto spans() const -> std::vector<std::span<const std::byte>>;
+	auto release() -> std::vector<std::byte>;
+	auto releaseChunks() -> std::vector<std::vector<std::byte>>;
 	auto close() -> void override;
 	auto flush() -> void override;
 
 protected:
 	std::vector<std::byte> buf_;
 	size_t count_{0};
+	Mode mode_{Mode::CONTIGUOUS};
+	size_t chunkSize_{DEFAULT_CHUNK_SIZE};
+	std::vector<std::vector<std::byte>> chunks_;
+	size_t tailUsed_{0};
+	auto appendChunk() -> void;
+	auto append(const std::byte* data, size_t len) -> void;
 };
 }
@@ -2,6 +2,7 @@
 // Copyright (c) 2024 ethereal. All rights reserved.
 #include "CharArrayWriter.hpp"
 #include <stdexcept>
+#include <utility>
 
 namespace common::io
 {
@@ -17,18 +18,10 @@ CharArrayWriter::CharArrayWriter(const int initialSize) {
 CharArrayWriter::~CharArrayWriter() = default;
 
 /// \brief Writes a single character to the writer.
-/// \details This method writes a character to the internal buffer of the CharArrayWriter.
-/// If the buffer is already full, it appends the character to the end of the buffer.
-/// Otherwise, it replaces the character at the current position.
+/// \details This method appends a character to the internal buffer of the CharArrayWriter.
 /// \param c The character to write.
 void CharArrayWriter::write(const char c) {
-	if (count_ == buf_.size()) {
-		buf_.push_back(c);
-	}
-	else {
-		buf_[count_] = c;
-	}
-	++count_;
+	buf_.push_back(c);
 }
 
 /// \brief Writes a portion of a byte array to the writer.
@@ -38,14 +31,10 @@ void CharArrayWriter::write(const char c) {
 /// \param off The starting position in the buffer to write the data.
 /// \param len The maximum number of bytes to write from the buffer.
 auto CharArrayWriter::write(const std::vector<char>& cBuf, const size_t off, const size_t len) -> void {
-	if (off + len > static_cast<int>(cBuf.size())) {
+	if (off > cBuf.size() || len > cBuf.size() - off) {
 		throw std::out_of_range("Invalid offset or length");
 	}
-	if (count_ + len > static_cast<int>(buf_.size())) {
-		buf_.resize(count_ + len);
-	}
-	std::copy_n(cBuf.begin() + static_cast<std::ptrdiff_t>(off), len, buf_.begin() + static_cast<std::ptrdiff_t>(count_));
-	count_ += len;
+	write(std::string_view(cBuf.data() + off, len));
 }
 
 /// \brief Writes a portion of a string to the writer.
@@ -55,21 +44,39 @@ auto CharArrayWriter::write(const std::vector<char>& cBuf, const size_t off, con
 /// \param off The starting position in the string to write the data.
 /// \param len The maximum number of characters to write from the string.
 void CharArrayWriter::write(const std::string& str, const size_t off, const size_t len) {
-	if (off + len > static_cast<int>(str.size())) {
+	if (off > str.size() || len > str.size() - off) {
 		throw std::out_of_range("Invalid offset or length");
 	}
-	if (count_ + len > static_cast<int>(buf_.size())) {
-		buf_.resize(count_ + len);
-	}
-	std::copy_n(str.begin() + static_cast<std::ptrdiff_t>(off), len, buf_.begin() + static_cast<std::ptrdiff_t>(count_));
-	count_ += len;
+	write(std::string_view(str.data() + off, len));
+}
+
+/// \brief Writes a view of characters to the writer.
+/// \details This method copies the viewed characters to the end of the internal buffer in one block. The buffer
+/// grows geometrically and the new space is not zero-filled before the copy.
+/// \param str The characters to write.
+auto CharArrayWriter::write(const std::string_view str) -> void {
+	buf_.insert(buf_.end(), str.begin(), str.end());
+}
+
+/// \brief Writes a block of characters to the writer.
+/// \param data The characters to write.
+auto CharArrayWriter::write(const std::span<const char> data) -> void {
+	buf_.insert(buf_.end(), data.begin(), data.end());
+}
+
+/// \brief Reserves space for at least \p capacity characters.
+/// \details Reserving the expected final size up front avoids the reallocations, and the copies they cause, while
+/// the content grows.
+/// \param capacity The number of characters to reserve space for, including those already written.
+auto CharArrayWriter::reserve(const size_t capacity) -> void {
+	buf_.reserve(capacity);
 }
 
 /// \brief Writes the contents of the writer to the specified AbstractWriter.
 /// \details This method writes all the characters currently stored in the internal buffer of the CharArrayWriter to the specified AbstractWriter.
 /// \param out The AbstractWriter to write the data to.
 auto CharArrayWriter::writeTo(AbstractWriter& out) const -> void {
-	out.write(buf_, 0, count_);
+	out.write(view());
 }
 
 /// \brief Appends a string to the writer.
@@ -107,7 +114,7 @@ CharArrayWriter& CharArrayWriter::append(const char c) {
 /// \brief Resets the writer to its initial state.
 /// \details This method resets the writer to its initial state, effectively clearing the internal buffer.
 auto CharArrayWriter::reset() -> void {
-	count_ = 0;
+	buf_.clear();
 }
 
 /// \brief Returns the internal buffer of the CharArrayWriter as a vector of characters.
@@ -116,7 +123,21 @@ auto CharArrayWriter::reset() -> void {
 /// The size of the vector will be equal to the number of characters written to the writer.
 /// \return The internal buffer of the CharArrayWriter as a vector of characters.
 auto CharArrayWriter::toCharArray() const -> std::vector<char> {
-	return {buf_.begin(), buf_.begin() + static_cast<std::vector<char>::difference_type>(count_)};
+	return buf_;
+}
+
+/// \brief Returns a view of the characters written so far.
+/// \details Unlike toString() and toCharArray() this does not copy. The view is invalidated by the next write.
+/// \return A view of the internal buffer.
+auto CharArrayWriter::view() const -> std::string_view {
+	return {buf_.data(), buf_.size()};
+}
+
+/// \brief Moves the internal buffer out of the writer.
+/// \details The characters are handed over without a copy and the writer is left empty, ready to be written again.
+/// \return The characters written so far.
+auto CharArrayWriter::release() -> std::vector<char> {
+	return std::exchange(buf_, {});
 }
 
 /// \brief Returns the number of characters currently stored in the internal buffer of the CharArrayWriter.
@@ -124,7 +145,7 @@ auto CharArrayWriter::toCharArray() const -> std::vector<char> {
 /// This is the number of characters that have been written to the writer but not yet flushed or reset.
 /// \return The number of characters currently stored in the internal buffer of the CharArrayWriter.
 auto CharArrayWriter::size() const -> size_t {
-	return count_;
+	return buf_.size();
 }
 
 /// \brief Converts the internal buffer of the CharArrayWriter to a string.
@@ -133,7 +154,7 @@ auto CharArrayWriter::size() const -> size_t {
 /// The size of the string will be equal to the number of characters written to the writer.
 /// \return The internal buffer of the CharArrayWriter as a string.
 auto CharArrayWriter::toString() const -> std::string {
-	return {buf_.begin(), buf_.begin() + static_cast<std::vector<char>::difference_type>(count_)};
+	return {buf_.data(), buf_.size()};
 }
 
 /// \brief Flushes the internal buffer.
@@ -141,7 +162,6 @@ auto CharArrayWriter::toString() const -> std::string {
 /// This is a no-op for CharArrayWriter, as it does not require flushing.
 auto CharArrayWriter::flush() -> void {
 	buf_.clear();
-	count_ = 0;
 }
 
 /// \brief Closes the writer and releases its resources.
@@ -149,6 +169,5 @@ auto CharArrayWriter::flush() -> void {
 /// It is a no-op for CharArrayWriter, as it does not require closing.
 auto CharArrayWriter::close() -> void {
 	buf_.clear();
-	count_ = 0;
 }
 }
@@ -1,6 +1,7 @@
 // Created by author ethereal on 2024/12/10.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #pragma once
+#include <span>
 #include "AbstractWriter.hpp"
 
 namespace common::io
@@ -9,21 +10,28 @@ namespace common::io
 /// \details The CharArrayWriter class implements an output stream in which the data is written into a character array.
 /// The buffer automatically grows as data is written to it.
 /// The class is designed for use as a drop-in replacement for an FileWriter in situations where writing to a file is not possible.
+/// Use reserve() when the final size can be estimated, and release() to take the characters without copying them.
 class CharArrayWriter final : public AbstractWriter, interface::IfaceAppendable<CharArrayWriter>
 {
 public:
 	CharArrayWriter();
 	explicit CharArrayWriter(int initialSize);
 	~CharArrayWriter() override;
+	using AbstractWriter::write;
 	auto write(char c) -> void override;
 	auto write(const std::vector<char>& cBuf, size_t off, size_t len) -> void override;
 	auto write(const std::string& str, size_t off, size_t len) -> void override;
+	auto write(std::string_view str) -> void override;
+	auto write(std::span<const char> data) -> void;
+	auto reserve(size_t capacity) -> void;
 	auto writeTo(AbstractWriter& out) const -> void;
 	auto append(const std::string& csq) -> CharArrayWriter& override;
 	auto append(const std::string& csq, size_t start, size_t end) -> CharArrayWriter& override;
 	auto append(char c) -> CharArrayWriter& override;
 	auto reset() -> void;
 	[[nodiscard]] auto toCharArray() const -> std::vector<char>;
+	[[nodiscard]] auto view() const -> std::string_view;
+	[[nodiscard]] auto release() -> std::vector<char>;
 	[[nodiscard]] auto size() const -> size_t;
 	[[nodiscard]] auto toString() const -> std::string override;
 	auto flush() -> void override;
@@ -31,6 +39,5 @@ public:
 
 private:
 	std::vector<char> buf_;
-	size_t count_{0};
 };
 }
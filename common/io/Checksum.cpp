@@ -0,0 +1,44 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "Checksum.hpp"
+#include "Crc32c.hpp"
+
+namespace common::io
+{
+Checksum::Checksum(const Algorithm algorithm): algorithm_(algorithm) {}
+
+/// \brief Adds a single byte to the checksum.
+/// \param b The byte to add.
+auto Checksum::update(const std::byte b) -> void {
+	update(std::span(&b, 1));
+}
+
+/// \brief Adds bytes to the checksum.
+/// \param data The bytes to add.
+auto Checksum::update(const std::span<const std::byte> data) -> void {
+	if (algorithm_ == Algorithm::CRC32C) {
+		crc_ = Crc32c::update(crc_, data);
+	}
+	else {
+		hash_.update(data);
+	}
+}
+
+/// \brief Returns the checksum of the bytes added so far.
+/// \return The checksum; a CRC-32C occupies the low 32 bits.
+auto Checksum::value() const -> uint64_t {
+	return algorithm_ == Algorithm::CRC32C ? crc_ : hash_.digest();
+}
+
+/// \brief Returns the algorithm of the checksum.
+/// \return The algorithm.
+auto Checksum::algorithm() const -> Algorithm {
+	return algorithm_;
+}
+
+/// \brief Discards the bytes added so far.
+auto Checksum::reset() -> void {
+	crc_ = 0;
+	hash_.reset();
+}
+}
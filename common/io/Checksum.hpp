@@ -0,0 +1,31 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "XxHash64.hpp"
+
+namespace common::io
+{
+/// \brief A running checksum over a stream of bytes, with a choice of algorithm.
+/// \details CRC32C is the hardware-accelerated CRC-32C of Crc32c, suited for detecting corruption and interoperable
+/// with other CRC-32C implementations. XXH64 is the 64-bit hash of XxHash64, faster where no CRC instruction is
+/// available and with far fewer collisions among distinct payloads.
+class Checksum final
+{
+public:
+	enum class Algorithm { CRC32C, XXH64 };
+	explicit Checksum(Algorithm algorithm = Algorithm::CRC32C);
+	auto update(std::byte b) -> void;
+	auto update(std::span<const std::byte> data) -> void;
+	[[nodiscard]] auto value() const -> uint64_t;
+	[[nodiscard]] auto algorithm() const -> Algorithm;
+	auto reset() -> void;
+
+private:
+	Algorithm algorithm_;
+	uint32_t crc_{0};
+	XxHash64 hash_;
+};
+}
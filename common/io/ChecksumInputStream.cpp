@@ -0,0 +1,106 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "ChecksumInputStream.hpp"
+
+namespace common::io
+{
+/// \brief Constructs a checksumming stream.
+/// \param inputStream The underlying input stream.
+/// \param algorithm The checksum algorithm.
+/// \throws std::invalid_argument If the stream is null.
+ChecksumInputStream::ChecksumInputStream(std::unique_ptr<AbstractInputStream> inputStream, const Checksum::Algorithm algorithm): FilterInputStream(std::move(inputStream)), checksum_(algorithm) {
+	if (!inputStream_) {
+		throw std::invalid_argument("Input stream cannot be null");
+	}
+}
+
+ChecksumInputStream::~ChecksumInputStream() = default;
+
+/// \brief Marking is not supported.
+/// \param readLimit Ignored.
+/// \throws std::runtime_error Always.
+auto ChecksumInputStream::mark(const int readLimit) -> void {
+	AbstractInputStream::mark(readLimit);
+}
+
+/// \brief Tests if this input stream supports the mark and reset methods.
+/// \return false.
+auto ChecksumInputStream::markSupported() const -> bool {
+	return false;
+}
+
+/// \brief Reads a byte and adds it to the checksum.
+/// \details The byte is read through the bulk read of the underlying stream, which tells the end of the stream apart
+/// from a 0xFF byte, so the end is never added to the checksum.
+/// \return The byte read, or -1 at the end of the stream.
+auto ChecksumInputStream::read() -> std::byte {
+	scratch_.resize(1);
+	if (const size_t bytesRead = inputStream_->read(scratch_, 0, 1); bytesRead == 0 || bytesRead == static_cast<size_t>(-1)) {
+		return static_cast<std::byte>(-1);
+	}
+	checksum_.update(scratch_[0]);
+	++count_;
+	return scratch_[0];
+}
+
+/// \brief Reads into a buffer and adds the bytes read to the checksum.
+/// \param buffer The destination buffer.
+/// \return The number of bytes read, or -1 at the end of the stream.
+auto ChecksumInputStream::read(std::vector<std::byte>& buffer) -> size_t {
+	return read(buffer, 0, buffer.size());
+}
+
+/// \brief Reads into a range of a buffer and adds the bytes read to the checksum.
+/// \param buffer The destination buffer.
+/// \param offset The offset in the buffer where to store the first byte.
+/// \param len The maximum number of bytes to read.
+/// \return The number of bytes read, or -1 at the end of the stream.
+auto ChecksumInputStream::read(std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> size_t {
+	const size_t bytesRead = inputStream_->read(buffer, offset, len);
+	if (bytesRead != 0 && bytesRead != static_cast<size_t>(-1)) {
+		checksum_.update(std::span(buffer).subspan(offset, bytesRead));
+		count_ += bytesRead;
+	}
+	return bytesRead;
+}
+
+/// \brief Resetting is not supported.
+/// \throws std::runtime_error Always.
+auto ChecksumInputStream::reset() -> void {
+	AbstractInputStream::reset();
+}
+
+/// \brief Reads and checksums \p n bytes, discarding them.
+/// \param n The number of bytes to skip.
+/// \return The number of bytes skipped, less than \p n if the stream ended.
+auto ChecksumInputStream::skip(const size_t n) -> size_t {
+	scratch_.resize(std::min(n, SKIP_BUFFER_SIZE));
+	size_t skipped = 0;
+	while (skipped < n) {
+		const size_t bytesRead = read(scratch_, 0, std::min(n - skipped, scratch_.size()));
+		if (bytesRead == 0 || bytesRead == static_cast<size_t>(-1)) {
+			break;
+		}
+		skipped += bytesRead;
+	}
+	return skipped;
+}
+
+/// \brief Returns the checksum of the bytes read since construction or the last reset.
+/// \return The checksum.
+auto ChecksumInputStream::getChecksum() const -> uint64_t {
+	return checksum_.value();
+}
+
+/// \brief Returns the number of bytes read since construction or the last reset.
+/// \return The byte count.
+auto ChecksumInputStream::getCount() const -> uint64_t {
+	return count_;
+}
+
+/// \brief Restarts the checksum, for example at the start of the next payload.
+auto ChecksumInputStream::resetChecksum() -> void {
+	checksum_.reset();
+	count_ = 0;
+}
+}
@@ -0,0 +1,35 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include "Checksum.hpp"
+#include "FilterInputStream.hpp"
+
+namespace common::io
+{
+/// \brief An input stream that checksums the bytes passing through it.
+/// \details Every byte read from the underlying stream is added to a running checksum as it is handed out, so a
+/// payload can be verified without a second pass. Skipped bytes are read and checksummed too.
+/// \remark Mark and reset are not supported, as rereading would count bytes twice.
+class ChecksumInputStream final : public FilterInputStream
+{
+public:
+	explicit ChecksumInputStream(std::unique_ptr<AbstractInputStream> inputStream, Checksum::Algorithm algorithm = Checksum::Algorithm::CRC32C);
+	~ChecksumInputStream() override;
+	auto mark(int readLimit) -> void override;
+	[[nodiscard]] auto markSupported() const -> bool override;
+	auto read() -> std::byte override;
+	auto read(std::vector<std::byte>& buffer) -> size_t override;
+	auto read(std::vector<std::byte>& buffer, size_t offset, size_t len) -> size_t override;
+	auto reset() -> void override;
+	auto skip(size_t n) -> size_t override;
+	[[nodiscard]] auto getChecksum() const -> uint64_t;
+	[[nodiscard]] auto getCount() const -> uint64_t;
+	auto resetChecksum() -> void;
+
+private:
+	static constexpr size_t SKIP_BUFFER_SIZE = 8192;
+	Checksum checksum_;
+	uint64_t count_{0};
+	std::vector<std::byte> scratch_;
+};
+}
@@ -0,0 +1,64 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "ChecksumOutputStream.hpp"
+
+namespace common::io
+{
+/// \brief Constructs a checksumming stream.
+/// \param outputStream The underlying output stream.
+/// \param algorithm The checksum algorithm.
+/// \throws std::invalid_argument If the stream is null.
+ChecksumOutputStream::ChecksumOutputStream(std::shared_ptr<AbstractOutputStream> outputStream, const Checksum::Algorithm algorithm): FilterOutputStream(std::move(outputStream)), checksum_(algorithm) {
+	if (!outputStream_) {
+		throw std::invalid_argument("Output stream cannot be null");
+	}
+}
+
+ChecksumOutputStream::~ChecksumOutputStream() = default;
+
+/// \brief Writes a byte and adds it to the checksum.
+/// \param b The byte to write.
+auto ChecksumOutputStream::write(const std::byte b) -> void {
+	outputStream_->write(b);
+	checksum_.update(b);
+	++count_;
+}
+
+/// \brief Writes a buffer and adds it to the checksum.
+/// \param buffer The bytes to write.
+auto ChecksumOutputStream::write(const std::vector<std::byte>& buffer) -> void {
+	write(buffer, 0, buffer.size());
+}
+
+/// \brief Writes a range of a buffer and adds it to the checksum.
+/// \param buffer The source buffer.
+/// \param offset The offset of the first byte to write.
+/// \param len The number of bytes to write.
+/// \throws std::out_of_range If the range exceeds the buffer.
+auto ChecksumOutputStream::write(const std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> void {
+	if (offset > buffer.size() || len > buffer.size() - offset) {
+		throw std::out_of_range("Buffer offset/length out of range");
+	}
+	outputStream_->write(buffer, offset, len);
+	checksum_.update(std::span(buffer).subspan(offset, len));
+	count_ += len;
+}
+
+/// \brief Returns the checksum of the bytes written since construction or the last reset.
+/// \return The checksum.
+auto ChecksumOutputStream::getChecksum() const -> uint64_t {
+	return checksum_.value();
+}
+
+/// \brief Returns the number of bytes written since construction or the last reset.
+/// \return The byte count.
+auto ChecksumOutputStream::getCount() const -> uint64_t {
+	return count_;
+}
+
+/// \brief Restarts the checksum, for example at the start of the next payload.
+auto ChecksumOutputStream::resetChecksum() -> void {
+	checksum_.reset();
+	count_ = 0;
+}
+}
@@ -0,0 +1,29 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include "Checksum.hpp"
+#include "FilterOutputStream.hpp"
+
+namespace common::io
+{
+/// \brief An output stream that checksums the bytes passing through it.
+/// \details Every byte written to the underlying stream is added to a running checksum in the same pass, while it
+/// is still in cache, so the payload does not have to be read back to be checksummed. Bytes are added only after
+/// the underlying stream accepted them.
+class ChecksumOutputStream final : public FilterOutputStream
+{
+public:
+	explicit ChecksumOutputStream(std::shared_ptr<AbstractOutputStream> outputStream, Checksum::Algorithm algorithm = Checksum::Algorithm::CRC32C);
+	~ChecksumOutputStream() override;
+	auto write(std::byte b) -> void override;
+	auto write(const std::vector<std::byte>& buffer) -> void override;
+	auto write(const std::vector<std::byte>& buffer, size_t offset, size_t len) -> void override;
+	[[nodiscard]] auto getChecksum() const -> uint64_t;
+	[[nodiscard]] auto getCount() const -> uint64_t;
+	auto resetChecksum() -> void;
+
+private:
+	Checksum checksum_;
+	uint64_t count_{0};
+};
+}
@@ -0,0 +1,143 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "Crc32c.hpp"
+#include <array>
+#include <cstring>
+#if defined(__x86_64__) || defined(_M_X64)
+#define CRC32C_X86 1
+#include <nmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define CRC32C_TARGET
+#else
+#define CRC32C_TARGET __attribute__((target("sse4.2")))
+#endif
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define CRC32C_ARM 1
+#include <arm_acle.h>
+#endif
+
+namespace common::io
+{
+/// \brief The reflected Castagnoli polynomial.
+constexpr uint32_t POLYNOMIAL = 0x82F63B78;
+
+/// \brief The slicing-by-8 tables: TABLE[k][b] is the CRC of byte b followed by k zero bytes.
+constexpr auto TABLE = [] {
+	std::array<std::array<uint32_t, 256>, 8> table{};
+	for (uint32_t i = 0; i < 256; ++i) {
+		uint32_t crc = i;
+		for (int bit = 0; bit < 8; ++bit) {
+			crc = (crc >> 1) ^ (POLYNOMIAL & (0U - (crc & 1U)));
+		}
+		table[0][i] = crc;
+	}
+	for (uint32_t i = 0; i < 256; ++i) {
+		for (size_t slice = 1; slice < table.size(); ++slice) {
+			table[slice][i] = (table[slice - 1][i] >> 8) ^ table[0][table[slice - 1][i] & 0xFF];
+		}
+	}
+	return table;
+}();
+
+/// \brief Computes the CRC-32C of a block of bytes.
+/// \param data The bytes to checksum.
+/// \return The checksum.
+auto Crc32c::compute(const std::span<const std::byte> data) -> uint32_t {
+	return update(0, data);
+}
+
+/// \brief Extends a checksum with more bytes.
+/// \details update(update(0, a), b) equals compute(a followed by b), so data can be checksummed piecewise.
+/// \param crc The checksum of the preceding bytes, or 0 to start.
+/// \param data The bytes to add.
+/// \return The checksum of the preceding bytes followed by \p data.
+auto Crc32c::update(const uint32_t crc, const std::span<const std::byte> data) -> uint32_t {
+	const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+	if (hardwareAccelerated()) {
+		return ~updateHardware(~crc, bytes, data.size());
+	}
+	return ~updateTable(~crc, bytes, data.size());
+}
+
+/// \brief Checks if the checksum is computed by a CPU instruction.
+/// \return true if SSE4.2 or the ARMv8 CRC extension is used.
+auto Crc32c::hardwareAccelerated() -> bool {
+#if defined(CRC32C_X86)
+	static const bool supported = [] {
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 1);
+		return (info[2] & (1 << 20)) != 0;
+#else
+		return __builtin_cpu_supports("sse4.2") != 0;
+#endif
+	}();
+	return supported;
+#elif defined(CRC32C_ARM)
+	return true;
+#else
+	return false;
+#endif
+}
+
+/// \brief Extends a raw, non-inverted CRC with the slicing-by-8 tables.
+/// \param crc The raw CRC of the preceding bytes.
+/// \param data The bytes to add.
+/// \param length The number of bytes to add.
+/// \return The raw CRC.
+auto Crc32c::updateTable(uint32_t crc, const unsigned char* data, size_t length) -> uint32_t {
+	while (length >= 8) {
+		const uint32_t low = crc ^ (static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 | static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24);
+		const uint32_t high = static_cast<uint32_t>(data[4]) | static_cast<uint32_t>(data[5]) << 8 | static_cast<uint32_t>(data[6]) << 16 | static_cast<uint32_t>(data[7]) << 24;
+		crc = TABLE[7][low & 0xFF] ^ TABLE[6][(low >> 8) & 0xFF] ^ TABLE[5][(low >> 16) & 0xFF] ^ TABLE[4][low >> 24] ^ TABLE[3][high & 0xFF] ^ TABLE[2][(high >> 8) & 0xFF] ^ TABLE[1][(high >> 16) & 0xFF] ^ TABLE[0][high >> 24];
+		data += 8;
+		length -= 8;
+	}
+	while (length-- > 0) {
+		crc = (crc >> 8) ^ TABLE[0][(crc ^ *data++) & 0xFF];
+	}
+	return crc;
+}
+
+/// \brief Extends a raw, non-inverted CRC with the CRC32 instruction, eight bytes at a time.
+/// \param crc The raw CRC of the preceding bytes.
+/// \param data The bytes to add.
+/// \param length The number of bytes to add.
+/// \return The raw CRC.
+#if defined(CRC32C_X86)
+CRC32C_TARGET auto Crc32c::updateHardware(uint32_t crc, const unsigned char* data, size_t length) -> uint32_t {
+	uint64_t value = crc;
+	while (length >= 8) {
+		uint64_t word;
+		std::memcpy(&word, data, sizeof(word));
+		value = _mm_crc32_u64(value, word);
+		data += 8;
+		length -= 8;
+	}
+	crc = static_cast<uint32_t>(value);
+	while (length-- > 0) {
+		crc = _mm_crc32_u8(crc, *data++);
+	}
+	return crc;
+}
+#elif defined(CRC32C_ARM)
+auto Crc32c::updateHardware(uint32_t crc, const unsigned char* data, size_t length) -> uint32_t {
+	while (length >= 8) {
+		uint64_t word;
+		std::memcpy(&word, data, sizeof(word));
+		crc = __crc32cd(crc, word);
+		data += 8;
+		length -= 8;
+	}
+	while (length-- > 0) {
+		crc = __crc32cb(crc, *data++);
+	}
+	return crc;
+}
+#else
+auto Crc32c::updateHardware(const uint32_t crc, const unsigned char* data, const size_t length) -> uint32_t {
+	return updateTable(crc, data, length);
+}
+#endif
+}
@@ -0,0 +1,26 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace common::io
+{
+/// \brief Computes CRC-32C (Castagnoli) checksums.
+/// \details Uses the CRC32 instruction of SSE4.2 on x86-64, chosen at run time, and of the CRC extension on AArch64
+/// when the compiler targets it. Otherwise a slicing-by-8 table implementation processes eight bytes per step.
+/// All paths produce the same checksums.
+class Crc32c final
+{
+public:
+	Crc32c() = delete;
+	static auto compute(std::span<const std::byte> data) -> uint32_t;
+	static auto update(uint32_t crc, std::span<const std::byte> data) -> uint32_t;
+	static auto hardwareAccelerated() -> bool;
+
+private:
+	static auto updateTable(uint32_t crc, const unsigned char* data, size_t length) -> uint32_t;
+	static auto updateHardware(uint32_t crc, const unsigned char* data, size_t length) -> uint32_t;
+};
+}
@@ -0,0 +1,144 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "DeflateOutputStream.hpp"
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <zlib.h>
+
+namespace common::io
+{
+DeflateOutputStream::DeflateOutputStream(std::shared_ptr<AbstractOutputStream> outputStream, const int level, const bool gzip, const size_t chunkSize): FilterOutputStream(std::move(outputStream)), stream_(std::make_unique<z_stream>()), inBuf_(chunkSize), outBuf_(chunkSize) {
+	if (!outputStream_) {
+		throw std::invalid_argument("Output stream cannot be null");
+	}
+	if (chunkSize == 0) {
+		throw std::invalid_argument("Chunk size must be greater than 0");
+	}
+	if (level < Z_DEFAULT_COMPRESSION || level > Z_BEST_COMPRESSION) {
+		throw std::invalid_argument("Compression level must be between -1 and 9");
+	}
+	if (deflateInit2(stream_.get(), level, Z_DEFLATED, gzip ? MAX_WBITS + 16 : MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+		throw std::runtime_error("Failed to initialize deflate stream");
+	}
+}
+
+DeflateOutputStream::~DeflateOutputStream() {
+	try {
+		finish();
+	}
+	catch (...) {
+		// Suppress exceptions in destructors
+	}
+	deflateEnd(stream_.get());
+}
+
+/// \brief Writes a single byte to the stream.
+/// \details The byte is added to the current chunk, which is compressed once it is full.
+/// \param b The byte to write.
+/// \throws std::runtime_error If the stream has already been finished.
+auto DeflateOutputStream::write(const std::byte b) -> void {
+	if (finished_) {
+		throw std::runtime_error("Deflate stream is finished");
+	}
+	inBuf_[inCount_++] = b;
+	if (inCount_ == inBuf_.size()) {
+		deflateChunk(inBuf_.data(), inCount_, Z_NO_FLUSH);
+		inCount_ = 0;
+	}
+}
+
+/// \brief Writes a portion of a byte array to the stream.
+/// \details Small writes are appended to the current chunk. A write that does not fit is compressed directly from
+/// \p buffer after the pending chunk, without copying it first.
+/// \param buffer The buffer containing the data to write.
+/// \param offset The offset in the buffer at which to start writing.
+/// \param len The number of bytes to write.
+/// \throws std::out_of_range If the offset and length exceed the buffer size.
+/// \throws std::runtime_error If the stream has already been finished.
+auto DeflateOutputStream::write(const std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> void {
+	if (offset + len > buffer.size()) {
+		throw std::out_of_range("Buffer overflow");
+	}
+	if (finished_) {
+		throw std::runtime_error("Deflate stream is finished");
+	}
+	if (inCount_ + len < inBuf_.size()) {
+		std::memcpy(inBuf_.data() + inCount_, buffer.data() + offset, len);
+		inCount_ += len;
+		return;
+	}
+	if (inCount_ > 0) {
+		deflateChunk(inBuf_.data(), inCount_, Z_NO_FLUSH);
+		inCount_ = 0;
+	}
+	deflateChunk(buffer.data() + offset, len, Z_NO_FLUSH);
+}
+
+/// \brief Flushes the stream.
+/// \details Compresses the pending chunk with a sync flush, so that everything written so far can be decompressed
+/// by the reader, then flushes the underlying stream. Frequent flushes reduce the compression ratio.
+auto DeflateOutputStream::flush() -> void {
+	if (!finished_) {
+		deflateChunk(inBuf_.data(), inCount_, Z_SYNC_FLUSH);
+		inCount_ = 0;
+	}
+	FilterOutputStream::flush();
+}
+
+/// \brief Finishes the compressed stream and closes the underlying stream.
+auto DeflateOutputStream::close() -> void {
+	finish();
+	FilterOutputStream::close();
+}
+
+/// \brief Finishes the compressed stream without closing the underlying stream.
+/// \details Compresses the pending chunk and writes the stream trailer. Further writes are rejected.
+auto DeflateOutputStream::finish() -> void {
+	if (finished_) {
+		return;
+	}
+	deflateChunk(inBuf_.data(), inCount_, Z_FINISH);
+	inCount_ = 0;
+	finished_ = true;
+}
+
+/// \brief Returns the number of uncompressed bytes consumed so far.
+/// \return The total input size.
+auto DeflateOutputStream::bytesIn() const -> size_t {
+	return stream_->total_in + inCount_;
+}
+
+/// \brief Returns the number of compressed bytes produced so far.
+/// \return The total output size.
+auto DeflateOutputStream::bytesOut() const -> size_t {
+	return stream_->total_out;
+}
+
+/// \brief Compresses a block of data and writes the result to the underlying stream.
+/// \param data The bytes to compress.
+/// \param len The number of bytes to compress.
+/// \param flushMode The zlib flush mode.
+auto DeflateOutputStream::deflateChunk(const std::byte* data, size_t len, const int flushMode) -> void {
+	do {
+		const size_t step = std::min<size_t>(len, UINT_MAX);
+		const bool last = step == len;
+		stream_->next_in = reinterpret_cast<Bytef*>(const_cast<std::byte*>(data));
+		stream_->avail_in = static_cast<uInt>(step);
+		do {
+			stream_->next_out = reinterpret_cast<Bytef*>(outBuf_.data());
+			stream_->avail_out = static_cast<uInt>(outBuf_.size());
+			if (deflate(stream_.get(), last ? flushMode : Z_NO_FLUSH) == Z_STREAM_ERROR) {
+				throw std::runtime_error("Failed to deflate data");
+			}
+			if (const size_t produced = outBuf_.size() - stream_->avail_out; produced > 0) {
+				outputStream_->write(outBuf_, 0, produced);
+			}
+		}
+		while (stream_->avail_out == 0);
+		data += step;
+		len -= step;
+	}
+	while (len > 0);
+}
+}
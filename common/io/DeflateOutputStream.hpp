@@ -0,0 +1,41 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <memory>
+#include <vector>
+#include "FilterOutputStream.hpp"
+
+struct z_stream_s;
+
+namespace common::io
+{
+/// \brief An output stream filter that compresses data with deflate.
+/// \details Bytes written to the stream are collected into a chunk and compressed with zlib as the chunk fills up;
+/// writes larger than the chunk are compressed straight from the caller's buffer. The compressed bytes are written to
+/// the underlying stream as they are produced, so memory use does not depend on the amount of data. The output is a
+/// zlib stream, or a gzip member when requested, and is completed by finish() or close().
+/// \remark The compression level follows zlib: 0 stores, 1 is fastest, 9 compresses best and -1 selects the default.
+class DeflateOutputStream final : public FilterOutputStream
+{
+public:
+	static constexpr int DEFAULT_LEVEL = -1;
+	explicit DeflateOutputStream(std::shared_ptr<AbstractOutputStream> outputStream, int level = DEFAULT_LEVEL, bool gzip = false, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+	~DeflateOutputStream() override;
+	auto write(std::byte b) -> void override;
+	auto write(const std::vector<std::byte>& buffer, size_t offset, size_t len) -> void override;
+	auto flush() -> void override;
+	auto close() -> void override;
+	auto finish() -> void;
+	[[nodiscard]] auto bytesIn() const -> size_t;
+	[[nodiscard]] auto bytesOut() const -> size_t;
+
+private:
+	static constexpr size_t DEFAULT_CHUNK_SIZE = 65536;
+	std::unique_ptr<z_stream_s> stream_;
+	std::vector<std::byte> inBuf_;
+	size_t inCount_{0};
+	std::vector<std::byte> outBuf_;
+	bool finished_{false};
+	auto deflateChunk(const std::byte* data, size_t len, int flushMode) -> void;
+};
+}
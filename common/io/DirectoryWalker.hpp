@@ -0,0 +1,53 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "FileMetadata.hpp"
+#include "thread/ThreadPool.hpp"
+
+namespace common::io
+{
+/// \brief Walks a directory tree in parallel on a thread pool.
+/// \details Every directory is scanned by its own pool task, and every subdirectory found is submitted as a new
+/// task, so wide trees are read by all workers at once. On Linux a directory is read in large batches with
+/// getdents64 and each entry is inspected with one statx relative to the open directory; elsewhere the walker falls
+/// back to std::filesystem::directory_iterator. Each entry is reported once as a FileMetadata snapshot.
+/// Symbolic links are reported but not followed. Subdirectories that cannot be opened are skipped; only a root that
+/// cannot be opened is an error.
+/// \remark The visitor is called concurrently from the pool threads and must be thread-safe. walk() blocks until
+/// the tree is done, so it must not be called from a task running on the same pool.
+class DirectoryWalker final
+{
+public:
+	using Visitor = std::function<void(const FileMetadata&)>;
+	explicit DirectoryWalker(std::shared_ptr<thread::ThreadPool> pool, bool statEntries = true);
+	auto walk(const std::filesystem::path& root, const Visitor& visitor) -> size_t;
+	auto collect(const std::filesystem::path& root) -> std::vector<FileMetadata>;
+	static auto list(const std::filesystem::path& directory, bool statEntries = true) -> std::vector<FileMetadata>;
+
+private:
+	struct Walk
+	{
+		explicit Walk(const Visitor& visitor): visitor(visitor) {}
+		const Visitor& visitor;
+		std::atomic<size_t> pending{0};
+		std::atomic<size_t> visited{0};
+		std::mutex mutex;
+		std::condition_variable done;
+		std::exception_ptr error;
+	};
+
+	auto schedule(const std::shared_ptr<Walk>& walk, std::filesystem::path directory) -> void;
+	auto scan(const std::shared_ptr<Walk>& walk, const std::filesystem::path& directory) -> void;
+	static auto readDirectory(const std::filesystem::path& directory, bool statEntries, const std::function<void(FileMetadata&&)>& sink) -> bool;
+	std::shared_ptr<thread::ThreadPool> pool_;
+	bool statEntries_;
+};
+}
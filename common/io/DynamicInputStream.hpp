@@ -0,0 +1,83 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <utility>
+#include "AbstractInputStream.hpp"
+#include "StaticStream.hpp"
+
+namespace common::io
+{
+/// \brief Exposes a stream stack composed at compile time as an AbstractInputStream.
+/// \details The whole stack sits behind a single virtual call, so code written against the virtual hierarchy pays
+/// one dispatch per call while the layers inside stay inlined.
+/// \tparam Stream The composed stack, for example StaticBufferedInputStream<FileInputStream>.
+template <ByteSource Stream> class DynamicInputStream final : public AbstractInputStream
+{
+public:
+	template <typename... Args> explicit DynamicInputStream(Args&&... args);
+	[[nodiscard]] auto available() -> size_t override;
+	auto read() -> std::byte override;
+	auto read(std::vector<std::byte>& buffer, size_t offset, size_t len) -> size_t override;
+	auto skip(size_t n) -> size_t override;
+	auto close() -> void override;
+	auto stream() -> Stream&;
+
+private:
+	Stream stream_;
+};
+
+/// \brief Constructs the adapter and the stack it exposes.
+/// \param args The arguments forwarded to the constructor of the stack.
+template <ByteSource Stream> template <typename... Args> DynamicInputStream<Stream>::DynamicInputStream(Args&&... args) : stream_(std::forward<Args>(args)...) {}
+
+/// \brief Returns the number of bytes that can be read without blocking.
+/// \return The value reported by the stack, or 0 if it does not report one.
+template <ByteSource Stream> auto DynamicInputStream<Stream>::available() -> size_t {
+	if constexpr (requires { stream_.available(); }) {
+		return stream_.available();
+	}
+	else {
+		return 0;
+	}
+}
+
+/// \brief Reads the next byte of data.
+/// \return The next byte, or -1 converted to std::byte at the end of the stream, as in the rest of the hierarchy.
+template <ByteSource Stream> auto DynamicInputStream<Stream>::read() -> std::byte {
+	return static_cast<std::byte>(stream_.read());
+}
+
+/// \brief Reads up to \p len bytes into the given range of \p buffer.
+/// \param buffer The destination array.
+/// \param offset The offset in the destination array where to start writing.
+/// \param len The maximum number of bytes to read.
+/// \return The number of bytes read.
+template <ByteSource Stream> auto DynamicInputStream<Stream>::read(std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> size_t {
+	return stream_.read(buffer, offset, len);
+}
+
+/// \brief Skips over and discards up to \p n bytes.
+/// \param n The number of bytes to skip.
+/// \return The number of bytes skipped.
+template <ByteSource Stream> auto DynamicInputStream<Stream>::skip(const size_t n) -> size_t {
+	if constexpr (requires { stream_.skip(n); }) {
+		return stream_.skip(n);
+	}
+	else {
+		return AbstractInputStream::skip(n);
+	}
+}
+
+/// \brief Closes the stack, if it can be closed.
+template <ByteSource Stream> auto DynamicInputStream<Stream>::close() -> void {
+	if constexpr (requires { stream_.close(); }) {
+		stream_.close();
+	}
+}
+
+/// \brief Returns the exposed stack.
+/// \return The stack.
+template <ByteSource Stream> auto DynamicInputStream<Stream>::stream() -> Stream& {
+	return stream_;
+}
+}
@@ -1,6 +1,7 @@
 // Created by author ethereal on 2024/12/3.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #include "File.hpp"
+#include "DirectoryWalker.hpp"
 #include <fstream>
 #include <windows.h>
 
@@ -253,6 +254,22 @@ auto File::list() const -> std::vector<std::string> {
 	return entries;
 }
 
+/// \brief Lists the entries of the directory together with their metadata.
+/// \details Unlike list(), the metadata of every entry is captured while the directory is read, so no further
+/// system call is needed to query it.
+/// \return The entries of the directory, or an empty vector if this is not a directory.
+auto File::listFiles() const -> std::vector<FileMetadata> {
+	return DirectoryWalker::list(filePath_);
+}
+
+/// \brief Takes a snapshot of the metadata of the file.
+/// \details Use the snapshot instead of the individual queries when several attributes are needed; it costs a
+/// single system call.
+/// \return The metadata snapshot.
+auto File::metadata() const -> FileMetadata {
+	return FileMetadata::of(filePath_);
+}
+
 /// \brief Converts the File object to a string.
 /// \return The string representation of the File object.
 /// \details This function converts the File object to a string using the std::format function.
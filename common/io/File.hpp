@@ -5,6 +5,7 @@
 #include <filesystem>
 #include <string>
 #include <vector>
+#include "FileMetadata.hpp"
 #include "entity/interface/IfaceComparable.hpp"
 
 namespace common::io
@@ -47,6 +48,8 @@ public:
 	[[nodiscard]] auto length() const -> long long;
 	[[nodiscard]] auto lastModified() const -> long long;
 	[[nodiscard]] auto list() const -> std::vector<std::string>;
+	[[nodiscard]] auto listFiles() const -> std::vector<FileMetadata>;
+	[[nodiscard]] auto metadata() const -> FileMetadata;
 	[[nodiscard]] auto toString() const -> std::string;
 	[[nodiscard]] auto toURI() const -> std::string;
 
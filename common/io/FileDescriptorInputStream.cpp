@@ -0,0 +1,141 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "FileDescriptorInputStream.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include "FileDescriptorOutputStream.hpp"
+#include "FileTransfer.hpp"
+#ifdef _WIN32
+#include <climits>
+#include <io.h>
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace common::io
+{
+/// \brief Constructs a stream reading from an open descriptor.
+/// \param descriptor The descriptor to read from.
+/// \param owned Whether close() closes the descriptor.
+/// \throws std::invalid_argument If the descriptor is negative.
+FileDescriptorInputStream::FileDescriptorInputStream(const int descriptor, const bool owned): descriptor_(descriptor), owned_(owned) {
+	if (descriptor_ < 0) {
+		throw std::invalid_argument("Invalid file descriptor");
+	}
+}
+
+/// \brief Opens a file for reading.
+/// \param file The file to read.
+/// \throws std::ios_base::failure If the file cannot be opened.
+FileDescriptorInputStream::FileDescriptorInputStream(const std::filesystem::path& file): owned_(true) {
+#ifdef _WIN32
+	descriptor_ = ::_wopen(file.c_str(), _O_RDONLY | _O_BINARY);
+#else
+	descriptor_ = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+	if (descriptor_ < 0) {
+		throw std::ios_base::failure("FileNotFoundException: Unable to open file.", std::error_code(errno, std::system_category()));
+	}
+}
+
+FileDescriptorInputStream::~FileDescriptorInputStream() {
+	try {
+		close();
+	}
+	catch (...) {
+		// Suppress exceptions in destructors
+	}
+}
+
+/// \brief Reads up to len bytes with one read from the descriptor.
+/// \param buffer The buffer into which the data is read.
+/// \param offset The starting offset in the buffer.
+/// \param len The maximum number of bytes to read.
+/// \return The number of bytes read, or 0 at the end of the stream.
+/// \throws std::out_of_range If the offset and length exceed the buffer.
+/// \throws std::ios_base::failure If the stream is closed or the read fails.
+auto FileDescriptorInputStream::read(std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> size_t {
+	if (offset > buffer.size() || len > buffer.size() - offset) {
+		throw std::out_of_range("Buffer offset/length out of range");
+	}
+	if (descriptor_ < 0) {
+		throw std::ios_base::failure("Stream closed");
+	}
+	while (true) {
+#ifdef _WIN32
+		const int bytesRead = ::_read(descriptor_, buffer.data() + offset, static_cast<unsigned>(std::min<size_t>(len, INT_MAX)));
+#else
+		const ssize_t bytesRead = ::read(descriptor_, buffer.data() + offset, len);
+#endif
+		if (bytesRead >= 0) {
+			return static_cast<size_t>(bytesRead);
+		}
+		if (errno != EINTR) {
+			throw std::ios_base::failure("Read failed", std::error_code(errno, std::system_category()));
+		}
+	}
+}
+
+/// \brief Returns the number of bytes that can be read without blocking.
+/// \details Pipes and sockets report the bytes queued; files report the bytes after the position.
+/// \return The number of available bytes, or 0 if unknown.
+auto FileDescriptorInputStream::available() -> size_t {
+	if (descriptor_ < 0) {
+		return 0;
+	}
+#ifdef _WIN32
+	const int64_t current = ::_telli64(descriptor_);
+	const int64_t end = ::_filelengthi64(descriptor_);
+	return current >= 0 && end > current ? static_cast<size_t>(end - current) : 0;
+#else
+	int queued = 0;
+	return ::ioctl(descriptor_, FIONREAD, &queued) == 0 && queued > 0 ? static_cast<size_t>(queued) : 0;
+#endif
+}
+
+/// \brief Closes the descriptor if the stream owns it; a borrowed descriptor is only released.
+auto FileDescriptorInputStream::close() -> void {
+	if (descriptor_ < 0) {
+		return;
+	}
+	if (owned_) {
+#ifdef _WIN32
+		::_close(descriptor_);
+#else
+		::close(descriptor_);
+#endif
+	}
+	descriptor_ = -1;
+}
+
+/// \brief Copies the rest of the stream to an output stream.
+/// \details When the output is a FileDescriptorOutputStream the kernel copies the bytes with FileTransfer; otherwise,
+/// or for whatever the kernel cannot copy, the bytes go through a buffer.
+/// \param out The stream receiving the bytes.
+/// \return The number of bytes transferred.
+/// \throws std::ios_base::failure If the stream is closed or a read or write fails.
+auto FileDescriptorInputStream::transferTo(AbstractOutputStream& out) -> uint64_t {
+	if (descriptor_ < 0) {
+		throw std::ios_base::failure("Stream closed");
+	}
+	uint64_t transferred = 0;
+	if (const auto* target = dynamic_cast<FileDescriptorOutputStream*>(&out); target != nullptr && target->descriptor() >= 0) {
+		const auto [bytes, complete] = FileTransfer::copy(descriptor_, nullptr, target->descriptor());
+		if (complete) {
+			return bytes;
+		}
+		transferred = bytes;
+	}
+	return transferred + AbstractInputStream::transferTo(out);
+}
+
+/// \brief Returns the descriptor read from.
+/// \return The descriptor, or -1 once closed.
+auto FileDescriptorInputStream::descriptor() const -> int {
+	return descriptor_;
+}
+}
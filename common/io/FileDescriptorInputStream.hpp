@@ -0,0 +1,33 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <filesystem>
+#include <vector>
+#include "AbstractInputStream.hpp"
+
+namespace common::io
+{
+/// \brief Reads bytes from a file descriptor: a file, a pipe or a socket.
+/// \details Reads go straight to the descriptor and advance its own position, so the stream can read pipes and
+/// sockets that have no offset. transferTo() a FileDescriptorOutputStream copies inside the kernel.
+/// \remark read() of a single byte costs one system call; wrap the stream in a BufferedInputStream for byte-wise use.
+class FileDescriptorInputStream final : public AbstractInputStream
+{
+public:
+	explicit FileDescriptorInputStream(int descriptor, bool owned = false);
+	explicit FileDescriptorInputStream(const std::filesystem::path& file);
+	~FileDescriptorInputStream() override;
+	FileDescriptorInputStream(const FileDescriptorInputStream&) = delete;
+	auto operator=(const FileDescriptorInputStream&) -> FileDescriptorInputStream& = delete;
+	using AbstractInputStream::read;
+	auto read(std::vector<std::byte>& buffer, size_t offset, size_t len) -> size_t override;
+	auto available() -> size_t override;
+	auto close() -> void override;
+	auto transferTo(AbstractOutputStream& out) -> uint64_t override;
+	[[nodiscard]] auto descriptor() const -> int;
+
+private:
+	int descriptor_;
+	bool owned_;
+};
+}
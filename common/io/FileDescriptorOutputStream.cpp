@@ -0,0 +1,127 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "FileDescriptorOutputStream.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#ifdef _WIN32
+#include <climits>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace common::io
+{
+/// \brief Constructs a stream writing to an open descriptor.
+/// \param descriptor The descriptor to write to.
+/// \param owned Whether close() closes the descriptor.
+/// \throws std::invalid_argument If the descriptor is negative.
+FileDescriptorOutputStream::FileDescriptorOutputStream(const int descriptor, const bool owned): descriptor_(descriptor), owned_(owned) {
+	if (descriptor_ < 0) {
+		throw std::invalid_argument("Invalid file descriptor");
+	}
+}
+
+/// \brief Opens a file for writing, creating it if needed.
+/// \param file The file to write.
+/// \param append Whether to append to the file instead of truncating it.
+/// \throws std::ios_base::failure If the file cannot be opened.
+FileDescriptorOutputStream::FileDescriptorOutputStream(const std::filesystem::path& file, const bool append): owned_(true) {
+#ifdef _WIN32
+	descriptor_ = ::_wopen(file.c_str(), _O_WRONLY | _O_CREAT | _O_BINARY | (append ? _O_APPEND : _O_TRUNC), _S_IREAD | _S_IWRITE);
+#else
+	descriptor_ = ::open(file.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC), 0644);
+#endif
+	if (descriptor_ < 0) {
+		throw std::ios_base::failure("Unable to open file: " + file.string(), std::error_code(errno, std::system_category()));
+	}
+}
+
+FileDescriptorOutputStream::~FileDescriptorOutputStream() {
+	try {
+		close();
+	}
+	catch (...) {
+		// Suppress exceptions in destructors
+	}
+}
+
+/// \brief Writes a single byte.
+/// \param b The byte to write.
+/// \throws std::ios_base::failure If the stream is closed or the write fails.
+auto FileDescriptorOutputStream::write(const std::byte b) -> void {
+	writeFully(&b, 1);
+}
+
+/// \brief Writes the entire buffer.
+/// \param buffer The buffer to write.
+/// \throws std::ios_base::failure If the stream is closed or the write fails.
+auto FileDescriptorOutputStream::write(const std::vector<std::byte>& buffer) -> void {
+	writeFully(buffer.data(), buffer.size());
+}
+
+/// \brief Writes len bytes of the buffer starting at offset.
+/// \param buffer The buffer to write from.
+/// \param offset The starting offset in the buffer.
+/// \param len The number of bytes to write.
+/// \throws std::out_of_range If the offset and length exceed the buffer.
+/// \throws std::ios_base::failure If the stream is closed or the write fails.
+auto FileDescriptorOutputStream::write(const std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> void {
+	if (offset > buffer.size() || len > buffer.size() - offset) {
+		throw std::out_of_range("Buffer offset/length out of range");
+	}
+	writeFully(buffer.data() + offset, len);
+}
+
+/// \brief Closes the descriptor if the stream owns it; a borrowed descriptor is only released.
+auto FileDescriptorOutputStream::close() -> void {
+	if (descriptor_ < 0) {
+		return;
+	}
+	if (owned_) {
+#ifdef _WIN32
+		::_close(descriptor_);
+#else
+		::close(descriptor_);
+#endif
+	}
+	descriptor_ = -1;
+}
+
+/// \brief Does nothing, as the stream keeps no buffer.
+auto FileDescriptorOutputStream::flush() -> void {}
+
+/// \brief Returns the descriptor written to.
+/// \return The descriptor, or -1 once closed.
+auto FileDescriptorOutputStream::descriptor() const -> int {
+	return descriptor_;
+}
+
+/// \brief Writes a block of bytes, repeating the call after short writes and interruptions.
+/// \param data The bytes to write.
+/// \param length The number of bytes to write.
+/// \throws std::ios_base::failure If the stream is closed or the write fails.
+auto FileDescriptorOutputStream::writeFully(const std::byte* data, size_t length) -> void {
+	if (descriptor_ < 0) {
+		throw std::ios_base::failure("Stream closed");
+	}
+	while (length > 0) {
+#ifdef _WIN32
+		const int written = ::_write(descriptor_, data, static_cast<unsigned>(std::min<size_t>(length, INT_MAX)));
+#else
+		const ssize_t written = ::write(descriptor_, data, length);
+#endif
+		if (written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			throw std::ios_base::failure("Write failed", std::error_code(errno, std::system_category()));
+		}
+		data += written;
+		length -= static_cast<size_t>(written);
+	}
+}
+}
@@ -0,0 +1,35 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "AbstractOutputStream.hpp"
+
+namespace common::io
+{
+/// \brief Writes bytes to a file descriptor: a file, a pipe or a socket.
+/// \details Writes go straight to the descriptor without a user-space buffer, so flush() has nothing to do; wrap the
+/// stream in a BufferedOutputStream for small writes. An input stream backed by a descriptor recognizes this stream
+/// in transferTo() and lets the kernel copy the bytes.
+class FileDescriptorOutputStream final : public AbstractOutputStream
+{
+public:
+	explicit FileDescriptorOutputStream(int descriptor, bool owned = false);
+	explicit FileDescriptorOutputStream(const std::filesystem::path& file, bool append = false);
+	~FileDescriptorOutputStream() override;
+	FileDescriptorOutputStream(const FileDescriptorOutputStream&) = delete;
+	auto operator=(const FileDescriptorOutputStream&) -> FileDescriptorOutputStream& = delete;
+	auto write(std::byte b) -> void override;
+	auto write(const std::vector<std::byte>& buffer) -> void override;
+	auto write(const std::vector<std::byte>& buffer, size_t offset, size_t len) -> void override;
+	auto close() -> void override;
+	auto flush() -> void override;
+	[[nodiscard]] auto descriptor() const -> int;
+
+private:
+	auto writeFully(const std::byte* data, size_t length) -> void;
+	int descriptor_;
+	bool owned_;
+};
+}
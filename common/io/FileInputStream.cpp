@@ -32,8 +32,10 @@ FileInputStream::~FileInputStream() {
 /// This method blocks until input data is available, the end of the stream is detected, or an exception is thrown.
 /// \return the next byte of data, or -1 if the end of the stream is reached.
 auto FileInputStream::read() -> std::byte {
+	std::lock_guard lock(mutex_);
 	std::byte byte;
 	if (fileStream_.read(reinterpret_cast<char*>(&byte), 1)) {
+		++position_;
 		return byte;
 	}
 	return static_cast<std::byte>(-1);
@@ -65,28 +67,19 @@ auto FileInputStream::read(std::vector<std::byte>& buffer, const size_t offset,
 	if (offset + len > buffer.size()) {
 		throw std::invalid_argument("Invalid buffer, offset, or length.");
 	}
+	std::lock_guard lock(mutex_);
 	fileStream_.read(reinterpret_cast<char*>(buffer.data() + offset), static_cast<std::streamsize>(len));
-	return fileStream_.gcount();
-}
-
-/// \brief Skips over and discards n bytes of data from this input stream.
-/// \details The skip method may, for a variety of reasons, end before skipping n bytes.
-/// \param n The number of bytes to skip.
-/// \return The number of bytes actually skipped.
-auto FileInputStream::skip(const size_t n) -> size_t {
-	fileStream_.seekg(static_cast<std::streamoff>(n), std::ios::cur);
-	return fileStream_.good() ? static_cast<std::streamoff>(n) : 0;
+	const auto bytesRead = static_cast<size_t>(fileStream_.gcount());
+	position_ += bytesRead;
+	return bytesRead;
 }
 
 /// \brief Returns the number of bytes that can be read (or skipped over) from this input stream without blocking by the next caller of a method for this input stream.
 /// \details The available method for class FileInputStream returns the number of bytes that can be read from this file input stream without blocking.
 /// \return The number of available bytes.
 auto FileInputStream::available() -> size_t {
-	const auto current = fileStream_.tellg();
-	fileStream_.seekg(0, std::ios::end);
-	const auto end = fileStream_.tellg();
-	fileStream_.seekg(current, std::ios::beg);
-	return end - current;
+	const uint64_t end = size();
+	return end > position_ ? static_cast<size_t>(end - position_) : 0;
 }
 
 /// \brief Closes this input stream and releases any system resources associated with the stream.
@@ -105,4 +98,50 @@ auto FileInputStream::close() -> void {
 [[nodiscard]] auto FileInputStream::markSupported() const -> bool {
 	return false;
 }
+
+/// \brief Returns the offset of the next byte read() returns.
+/// \return The read position.
+auto FileInputStream::position() const -> uint64_t {
+	return position_;
+}
+
+/// \brief Moves the read position.
+/// \details The position may be set past the end of the file, in which case reads return end of stream.
+/// \param position The new offset from the start of the file.
+/// \throws std::ios_base::failure If the stream is closed.
+auto FileInputStream::seek(const uint64_t position) -> void {
+	std::lock_guard lock(mutex_);
+	if (!fileStream_.is_open()) {
+		throw std::ios_base::failure("Stream closed");
+	}
+	fileStream_.clear();
+	fileStream_.seekg(static_cast<std::streamoff>(position));
+	position_ = position;
+}
+
+/// \brief Reads bytes at an offset without moving the read position.
+/// \details The file handle is repositioned for the read and restored afterwards under the stream lock.
+/// \param offset The offset of the first byte to read.
+/// \param buffer Receives the bytes.
+/// \return The number of bytes read, less than the buffer size only at the end of the file.
+/// \throws std::ios_base::failure If the stream is closed.
+auto FileInputStream::readAt(const uint64_t offset, const std::span<std::byte> buffer) -> size_t {
+	std::lock_guard lock(mutex_);
+	if (!fileStream_.is_open()) {
+		throw std::ios_base::failure("Stream closed");
+	}
+	fileStream_.clear();
+	fileStream_.seekg(static_cast<std::streamoff>(offset));
+	fileStream_.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+	const auto bytesRead = static_cast<size_t>(fileStream_.gcount());
+	fileStream_.clear();
+	fileStream_.seekg(static_cast<std::streamoff>(position_));
+	return bytesRead;
+}
+
+/// \brief Returns the current length of the file.
+/// \return The file size in bytes.
+auto FileInputStream::size() const -> uint64_t {
+	return std::filesystem::file_size(fileName_);
+}
 }
@@ -3,8 +3,9 @@
 #pragma once
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <vector>
-#include "AbstractInputStream.hpp"
+#include "SeekableInputStream.hpp"
 
 namespace common::io
 {
@@ -15,7 +16,9 @@ namespace common::io
 /// The constructor takes a std::filesystem::path object as a parameter, which is the path to the file to read from.
 /// The class provides methods to read single bytes, blocks of bytes, and to skip over bytes.
 /// The class also provides methods to check the number of bytes available to read and to close the file.
-class FileInputStream final : public AbstractInputStream
+/// \remark The stream is seekable. readAt() shares the file handle with the sequential reads, so concurrent calls are
+/// serialized; RandomAccessInputStream reads without a lock.
+class FileInputStream final : public SeekableInputStream
 {
 public:
 	explicit FileInputStream(const std::string& name);
@@ -25,13 +28,18 @@ public:
 	auto read() -> std::byte override;
 	auto read(std::vector<std::byte>& buffer) -> size_t override;
 	auto read(std::vector<std::byte>& buffer, size_t offset, size_t len) -> size_t override;
-	auto skip(size_t n) -> size_t override;
 	auto available() -> size_t override;
 	auto close() -> void override;
 	[[nodiscard]] auto markSupported() const -> bool override;
+	[[nodiscard]] auto position() const -> uint64_t override;
+	auto seek(uint64_t position) -> void override;
+	auto readAt(uint64_t offset, std::span<std::byte> buffer) -> size_t override;
+	[[nodiscard]] auto size() const -> uint64_t override;
 
 private:
 	std::ifstream fileStream_;
 	std::string fileName_;
+	uint64_t position_{0};
+	std::mutex mutex_;
 };
 }
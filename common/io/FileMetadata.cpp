@@ -0,0 +1,189 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "FileMetadata.hpp"
+#include <chrono>
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/stat.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace common::io
+{
+FileMetadata::FileMetadata(std::filesystem::path path, const Type type, const uint64_t size, const std::chrono::nanoseconds lastModified, const std::filesystem::perms permissions, const bool hidden, const std::chrono::nanoseconds lastStatusChange): path_(std::move(path)), type_(type), size_(size), lastModified_(lastModified), lastStatusChange_(lastStatusChange), permissions_(permissions), hidden_(hidden) {}
+
+/// \brief Takes a snapshot of the metadata of the given path.
+/// \details Symbolic links are not followed. On Linux the snapshot costs one statx call; elsewhere it uses the
+/// attributes std::filesystem obtains for a directory entry.
+/// \param path The path to inspect.
+/// \return The snapshot; its type is NOT_FOUND if the path cannot be inspected.
+auto FileMetadata::of(const std::filesystem::path& path) -> FileMetadata {
+#ifdef __linux__
+	return of(AT_FDCWD, path.c_str(), path);
+#else
+	std::error_code ec;
+	return of(std::filesystem::directory_entry(path, ec));
+#endif
+}
+
+/// \brief Takes a snapshot of the metadata of a directory entry.
+/// \details Uses the attributes cached in the entry where the platform provides them with the directory listing,
+/// as Windows does. On Windows the hidden attribute is not among them and costs one GetFileAttributesW call; on
+/// other platforms a file is hidden when its name starts with a dot. The status change time is not available
+/// through std::filesystem and is left at 0.
+/// \param entry The directory entry to inspect.
+/// \return The snapshot; its type is NOT_FOUND if the entry cannot be inspected.
+auto FileMetadata::of(const std::filesystem::directory_entry& entry) -> FileMetadata {
+	std::error_code ec;
+	const auto status = entry.symlink_status(ec);
+	if (ec || !std::filesystem::exists(status)) {
+		return {entry.path(), Type::NOT_FOUND, 0, {}, std::filesystem::perms::none};
+	}
+	Type type = Type::OTHER;
+	if (std::filesystem::is_regular_file(status)) type = Type::REGULAR;
+	else if (std::filesystem::is_directory(status)) type = Type::DIRECTORY;
+	else if (std::filesystem::is_symlink(status)) type = Type::SYMLINK;
+	const uint64_t size = type == Type::REGULAR ? entry.file_size(ec) : 0;
+	const uint64_t validSize = ec ? 0 : size;
+	const auto lastWriteTime = entry.last_write_time(ec);
+	const auto lastModified = ec ? std::chrono::nanoseconds{} : std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::file_clock::to_sys(lastWriteTime).time_since_epoch());
+#ifdef _WIN32
+	const DWORD attributes = GetFileAttributesW(entry.path().c_str());
+	const bool hidden = attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_HIDDEN) != 0;
+#else
+	const std::string name = entry.path().filename().string();
+	const bool hidden = !name.empty() && name.front() == '.' && name != "." && name != "..";
+#endif
+	return {entry.path(), type, validSize, lastModified, status.permissions(), hidden};
+}
+
+#ifdef __linux__
+/// \brief Takes a snapshot of the metadata of a file relative to an open directory.
+/// \details Costs exactly one statx call; resolving the name against an open directory spares the kernel the walk
+/// along the full path, which is what DirectoryWalker relies on. Linux has no hidden attribute, so a file is hidden
+/// when its name starts with a dot.
+/// \param directoryFd The open directory, or AT_FDCWD.
+/// \param name The name of the file relative to the directory.
+/// \param path The full path recorded in the snapshot.
+/// \return The snapshot; its type is NOT_FOUND if the file cannot be inspected.
+auto FileMetadata::of(const int directoryFd, const char* name, std::filesystem::path path) -> FileMetadata {
+	struct statx stx{};
+	if (statx(directoryFd, name, AT_SYMLINK_NOFOLLOW, STATX_TYPE | STATX_MODE | STATX_SIZE | STATX_MTIME | STATX_CTIME, &stx) != 0) {
+		return {std::move(path), Type::NOT_FOUND, 0, {}, std::filesystem::perms::none};
+	}
+	Type type = Type::OTHER;
+	if (S_ISREG(stx.stx_mode)) type = Type::REGULAR;
+	else if (S_ISDIR(stx.stx_mode)) type = Type::DIRECTORY;
+	else if (S_ISLNK(stx.stx_mode)) type = Type::SYMLINK;
+	const std::string fileName = path.filename().string();
+	const bool hidden = !fileName.empty() && fileName.front() == '.' && fileName != "." && fileName != "..";
+	const auto nanoseconds = [](const statx_timestamp& time) {
+		return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+	};
+	return {std::move(path), type, stx.stx_size, nanoseconds(stx.stx_mtime), static_cast<std::filesystem::perms>(stx.stx_mode & 07777), hidden, nanoseconds(stx.stx_ctime)};
+}
+#endif
+
+/// \brief Returns the path the snapshot was taken of.
+/// \return The path.
+auto FileMetadata::getPath() const -> const std::filesystem::path& {
+	return path_;
+}
+
+/// \brief Returns the name of the file.
+/// \return The last component of the path.
+auto FileMetadata::getName() const -> std::string {
+	return path_.filename().string();
+}
+
+/// \brief Returns the type of the file.
+/// \return The file type.
+auto FileMetadata::type() const -> Type {
+	return type_;
+}
+
+/// \brief Checks if the file existed when the snapshot was taken.
+/// \return true if the file existed.
+auto FileMetadata::exists() const -> bool {
+	return type_ != Type::NOT_FOUND;
+}
+
+/// \brief Checks if the file is a directory.
+/// \return true if the file is a directory.
+auto FileMetadata::isDirectory() const -> bool {
+	return type_ == Type::DIRECTORY;
+}
+
+/// \brief Checks if the file is a regular file.
+/// \return true if the file is a regular file.
+auto FileMetadata::isFile() const -> bool {
+	return type_ == Type::REGULAR;
+}
+
+/// \brief Checks if the file is a symbolic link.
+/// \return true if the file is a symbolic link.
+auto FileMetadata::isSymbolicLink() const -> bool {
+	return type_ == Type::SYMLINK;
+}
+
+/// \brief Checks if the file is hidden.
+/// \details On Windows this is the FILE_ATTRIBUTE_HIDDEN attribute, as File::isHidden() reports it; elsewhere it is
+/// the convention of a name starting with a dot.
+/// \return true if the file was hidden when the snapshot was taken.
+auto FileMetadata::isHidden() const -> bool {
+	return hidden_;
+}
+
+/// \brief Returns the size of the file in bytes.
+/// \return The size of the file if it is a regular file, 0 otherwise.
+auto FileMetadata::length() const -> long long {
+	return type_ == Type::REGULAR ? static_cast<long long>(size_) : 0;
+}
+
+/// \brief Returns the last modified time of the file in seconds since the Unix epoch.
+/// \return The last modified time, or 0 if the file did not exist.
+auto FileMetadata::lastModified() const -> long long {
+	return std::chrono::floor<std::chrono::seconds>(lastModified_).count();
+}
+
+/// \brief Returns the last modified time of the file at the resolution the file system records.
+/// \return The time since the Unix epoch, or 0 if the file did not exist.
+auto FileMetadata::lastModifiedTime() const -> std::chrono::nanoseconds {
+	return lastModified_;
+}
+
+/// \brief Returns the last time the data or the attributes of the file changed (ctime).
+/// \details Unlike the modification time, it cannot be set back by the writer, so it catches rewrites that restore
+/// the old modification time.
+/// \return The time since the Unix epoch, or 0 where the platform does not report it.
+auto FileMetadata::lastStatusChangeTime() const -> std::chrono::nanoseconds {
+	return lastStatusChange_;
+}
+
+/// \brief Returns the permission bits of the file.
+/// \return The permission bits.
+auto FileMetadata::permissions() const -> std::filesystem::perms {
+	return permissions_;
+}
+
+/// \brief Checks the owner read bit of the file.
+/// \details Unlike File::canRead(), the file is not opened; see the class remark.
+/// \return true if the owner read bit is set.
+auto FileMetadata::ownerCanRead() const -> bool {
+	return (permissions_ & std::filesystem::perms::owner_read) != std::filesystem::perms::none;
+}
+
+/// \brief Checks the owner write bit of the file.
+/// \details Unlike File::canWrite(), the file is not opened; see the class remark.
+/// \return true if the owner write bit is set.
+auto FileMetadata::ownerCanWrite() const -> bool {
+	return (permissions_ & std::filesystem::perms::owner_write) != std::filesystem::perms::none;
+}
+
+/// \brief Checks the owner execute bit of the file.
+/// \return true if the file is not a directory and the owner execute bit is set.
+auto FileMetadata::ownerCanExecute() const -> bool {
+	return type_ != Type::DIRECTORY && (permissions_ & std::filesystem::perms::owner_exec) != std::filesystem::perms::none;
+}
+}
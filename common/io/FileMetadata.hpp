@@ -0,0 +1,55 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace common::io
+{
+/// \brief An immutable snapshot of the metadata of a file.
+/// \details The attributes that File queries with one system call each are captured together: a single statx on
+/// Linux, a single status query elsewhere. Repeated attribute queries on the snapshot never touch the file system
+/// again, so they reflect the file as it was when the snapshot was taken.
+/// \remark The snapshot answers access questions from the permission bits of the owner, which is why those methods
+/// are named ownerCanRead() and so on: unlike File::canRead() and File::canWrite(), they do not try to open the
+/// file, so ACLs, group or other bits and read-only mounts are not taken into account.
+class FileMetadata final
+{
+public:
+	enum class Type { NOT_FOUND, REGULAR, DIRECTORY, SYMLINK, OTHER };
+	FileMetadata() = default;
+	FileMetadata(std::filesystem::path path, Type type, uint64_t size, std::chrono::nanoseconds lastModified, std::filesystem::perms permissions, bool hidden = false, std::chrono::nanoseconds lastStatusChange = {});
+	static auto of(const std::filesystem::path& path) -> FileMetadata;
+	static auto of(const std::filesystem::directory_entry& entry) -> FileMetadata;
+#ifdef __linux__
+	static auto of(int directoryFd, const char* name, std::filesystem::path path) -> FileMetadata;
+#endif
+	[[nodiscard]] auto getPath() const -> const std::filesystem::path&;
+	[[nodiscard]] auto getName() const -> std::string;
+	[[nodiscard]] auto type() const -> Type;
+	[[nodiscard]] auto exists() const -> bool;
+	[[nodiscard]] auto isDirectory() const -> bool;
+	[[nodiscard]] auto isFile() const -> bool;
+	[[nodiscard]] auto isSymbolicLink() const -> bool;
+	[[nodiscard]] auto isHidden() const -> bool;
+	[[nodiscard]] auto length() const -> long long;
+	[[nodiscard]] auto lastModified() const -> long long;
+	[[nodiscard]] auto lastModifiedTime() const -> std::chrono::nanoseconds;
+	[[nodiscard]] auto lastStatusChangeTime() const -> std::chrono::nanoseconds;
+	[[nodiscard]] auto permissions() const -> std::filesystem::perms;
+	[[nodiscard]] auto ownerCanRead() const -> bool;
+	[[nodiscard]] auto ownerCanWrite() const -> bool;
+	[[nodiscard]] auto ownerCanExecute() const -> bool;
+
+private:
+	std::filesystem::path path_;
+	Type type_{Type::NOT_FOUND};
+	uint64_t size_{0};
+	std::chrono::nanoseconds lastModified_{0};
+	std::chrono::nanoseconds lastStatusChange_{0};
+	std::filesystem::perms permissions_{std::filesystem::perms::none};
+	bool hidden_{false};
+};
+}
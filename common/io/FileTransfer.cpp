@@ -0,0 +1,109 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "FileTransfer.hpp"
+#include <ios>
+#include <string>
+#include <system_error>
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+#endif
+
+namespace common::io
+{
+#ifdef __linux__
+/// \brief The largest count passed to one copy_file_range or sendfile call.
+constexpr size_t FILE_CHUNK = 1 << 30;
+/// \brief The count passed to one splice call, about a full pipe.
+constexpr size_t PIPE_CHUNK = 1 << 20;
+
+/// \brief Checks if an error means the call does not support the descriptors, rather than that the copy failed.
+/// \param error The errno of the call.
+/// \return true if another method may be tried.
+static auto unsupported(const int error) -> bool {
+	return error == EINVAL || error == ENOSYS || error == EXDEV || error == EBADF || error == EOPNOTSUPP || error == ESPIPE;
+}
+#endif
+
+/// \brief Copies everything from one descriptor to another until the input ends.
+/// \details A method is abandoned when its first call reports the descriptors unsupported; a method that has already
+/// moved bytes is not, so the result is either complete or holds the bytes moved before no method applied.
+/// \param in The descriptor to read from.
+/// \param offset The file offset to read at, advanced by the bytes copied; null to read at and advance the file
+/// position of \p in.
+/// \param out The descriptor to write to, at its file position.
+/// \return The number of bytes copied, and whether the end of the input was reached. When it was not, the caller
+/// copies the rest itself from the advanced position.
+/// \throws std::ios_base::failure If a read or write fails.
+auto FileTransfer::copy(const int in, int64_t* offset, const int out) -> Result {
+	uint64_t total = 0;
+#ifdef __linux__
+	const auto fail = [](const char* call) {
+		throw std::ios_base::failure(std::string(call) + " failed", std::error_code(errno, std::system_category()));
+	};
+	auto* position = reinterpret_cast<loff_t*>(offset);
+	static_assert(sizeof(loff_t) == sizeof(int64_t));
+	bool first = true;
+	while (true) {
+		const ssize_t copied = ::copy_file_range(in, position, out, nullptr, FILE_CHUNK, 0);
+		if (copied < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			if (first && unsupported(errno)) {
+				break;
+			}
+			fail("copy_file_range");
+		}
+		if (copied == 0) {
+			if (first) {
+				// Some file systems report 0 for files they cannot copy, so let the next method decide.
+				break;
+			}
+			return {total, true};
+		}
+		first = false;
+		total += static_cast<uint64_t>(copied);
+	}
+	first = true;
+	while (true) {
+		const ssize_t copied = ::sendfile(out, in, reinterpret_cast<off_t*>(position), FILE_CHUNK);
+		if (copied < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			if (first && unsupported(errno)) {
+				break;
+			}
+			fail("sendfile");
+		}
+		if (copied == 0) {
+			return {total, true};
+		}
+		first = false;
+		total += static_cast<uint64_t>(copied);
+	}
+	first = true;
+	while (true) {
+		const ssize_t copied = ::splice(in, position, out, nullptr, PIPE_CHUNK, SPLICE_F_MOVE);
+		if (copied < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			if (first && unsupported(errno)) {
+				break;
+			}
+			fail("splice");
+		}
+		if (copied == 0) {
+			return {total, true};
+		}
+		first = false;
+		total += static_cast<uint64_t>(copied);
+	}
+#endif
+	return {total, false};
+}
+}
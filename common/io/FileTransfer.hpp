@@ -0,0 +1,24 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <cstdint>
+
+namespace common::io
+{
+/// \brief Copies bytes between file descriptors inside the kernel.
+/// \details copy() tries copy_file_range, then sendfile, then splice, taking the first one the pair of descriptors
+/// supports, so the bytes never pass through user space. Only Linux has these calls; elsewhere copy() transfers
+/// nothing and the caller copies through a buffer.
+class FileTransfer final
+{
+public:
+	struct Result
+	{
+		uint64_t bytes;
+		bool complete;
+	};
+
+	FileTransfer() = delete;
+	static auto copy(int in, int64_t* offset, int out) -> Result;
+};
+}
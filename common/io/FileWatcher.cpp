@@ -0,0 +1,454 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "FileWatcher.hpp"
+#include <ranges>
+#include <system_error>
+#include "DirectoryWalker.hpp"
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace common::io
+{
+#ifdef __linux__
+/// \brief The inotify events that may change what a watched directory contains.
+constexpr uint32_t WATCH_MASK = IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR | IN_EXCL_UNLINK;
+#endif
+
+/// \brief Constructs a watcher and starts its background thread.
+/// \param pool The pool on which the callbacks run.
+/// \param debounce The interval within which changes are coalesced into one batch.
+/// \throws std::invalid_argument if the pool is null.
+/// \throws std::runtime_error if the inotify instance cannot be created.
+FileWatcher::FileWatcher(std::shared_ptr<thread::ThreadPool> pool, const std::chrono::milliseconds debounce): pool_(std::move(pool)), debounce_(debounce) {
+	if (!pool_) {
+		throw std::invalid_argument("Thread pool cannot be null");
+	}
+#ifdef __linux__
+	inotifyFd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotifyFd_ < 0) {
+		throw std::runtime_error("Failed to initialize inotify");
+	}
+	eventFd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (eventFd_ < 0) {
+		::close(inotifyFd_);
+		throw std::runtime_error("Failed to create the wakeup event");
+	}
+#endif
+	thread_ = std::thread(&FileWatcher::run, this);
+}
+
+FileWatcher::~FileWatcher() {
+	try {
+		close();
+	}
+	catch (...) {
+		// Suppress exceptions in destructors
+	}
+}
+
+/// \brief Starts watching a file or a directory.
+/// \details Watching a file reports its creation, modification and deletion. Watching a directory reports the
+/// changes of its entries, and with \p recursive the changes of every entry of the tree below it.
+/// \param path The file or directory to watch. A file does not need to exist yet, but its parent directory does.
+/// \param callback The callback receiving the batches of changes.
+/// \param recursive Whether to watch the whole tree below a directory.
+/// \return The id of the subscription, to be passed to unwatch().
+/// \throws std::invalid_argument if the callback is empty.
+/// \throws std::filesystem::filesystem_error if the directory to watch cannot be watched.
+/// \throws std::runtime_error if the watcher is closed.
+/// \throws Any exception that stopped the background thread, such as std::system_error for a failed poll().
+auto FileWatcher::watch(const std::filesystem::path& path, Callback callback, const bool recursive) -> int {
+	if (!callback) {
+		throw std::invalid_argument("Callback cannot be empty");
+	}
+	if (closed_) {
+		throw std::runtime_error("File watcher is closed");
+	}
+	std::lock_guard lock(mutex_);
+	if (error_) {
+		std::rethrow_exception(error_);
+	}
+	const int id = ++nextId_;
+	Subscription subscription;
+	subscription.root = path;
+	subscription.recursive = recursive;
+	subscription.callback = std::move(callback);
+	bool watched;
+	if (const auto metadata = FileMetadata::of(path); metadata.isDirectory()) {
+		watched = scan(id, subscription, path, subscription.files);
+	}
+	else {
+		subscription.name = path.filename().native();
+		const auto parent = path.has_parent_path() ? path.parent_path() : std::filesystem::path(".");
+		watched = addWatch(id, subscription, parent);
+		if (metadata.exists()) {
+			subscription.files.emplace(path.native(), metadata);
+		}
+	}
+	if (!watched) {
+		throw std::filesystem::filesystem_error("Cannot watch path", path, std::make_error_code(std::errc::no_such_file_or_directory));
+	}
+	subscriptions_.emplace(id, std::move(subscription));
+	return id;
+}
+
+/// \brief Stops watching for a subscription.
+/// \details Batches already handed to the pool are still delivered.
+/// \param id The id returned by watch(); unknown ids are ignored.
+auto FileWatcher::unwatch(const int id) -> void {
+	std::lock_guard lock(mutex_);
+	const auto it = subscriptions_.find(id);
+	if (it == subscriptions_.end()) {
+		return;
+	}
+#ifdef __linux__
+	for (const int descriptor : it->second.descriptors) {
+		const auto directory = directories_.find(descriptor);
+		if (directory == directories_.end()) {
+			continue;
+		}
+		std::erase(directory->second.subscriptions, id);
+		if (directory->second.subscriptions.empty()) {
+			::inotify_rm_watch(inotifyFd_, descriptor);
+			directories_.erase(directory);
+		}
+	}
+#endif
+	subscriptions_.erase(it);
+}
+
+/// \brief Stops the background thread and releases all watches.
+/// \details Pending changes that have not reached the end of their debounce interval are dropped.
+/// \throws Any exception that stopped the background thread before it was closed.
+auto FileWatcher::close() -> void {
+	if (closed_.exchange(true)) {
+		return;
+	}
+#ifdef __linux__
+	constexpr uint64_t signal = 1;
+	static_cast<void>(::write(eventFd_, &signal, sizeof(signal)));
+#else
+	{
+		std::lock_guard lock(mutex_);
+	}
+	wakeup_.notify_all();
+#endif
+	if (thread_.joinable()) {
+		thread_.join();
+	}
+#ifdef __linux__
+	::close(inotifyFd_);
+	::close(eventFd_);
+#endif
+	std::lock_guard lock(mutex_);
+	subscriptions_.clear();
+#ifdef __linux__
+	directories_.clear();
+#endif
+	if (error_) {
+		std::rethrow_exception(error_);
+	}
+}
+
+/// \brief The loop of the background thread.
+/// \details Waits for kernel events or the next debounce deadline, whichever comes first, then hands the due
+/// batches to the pool. The lock is released while the batches are dispatched. An exception ends the loop and is
+/// kept for the owner, who gets it from the next watch() or close().
+auto FileWatcher::run() -> void {
+	try {
+		loop();
+	}
+	catch (...) {
+		std::lock_guard lock(mutex_);
+		error_ = std::current_exception();
+	}
+}
+
+/// \brief Runs the event loop until the watcher is closed.
+/// \throws std::system_error if poll() fails with anything other than EINTR.
+auto FileWatcher::loop() -> void {
+	std::optional<Clock::time_point> deadline;
+#ifdef __linux__
+	std::vector<char> buffer(64 * 1024);
+	pollfd descriptors[2] = {{inotifyFd_, POLLIN, 0}, {eventFd_, POLLIN, 0}};
+	while (!closed_) {
+		int timeout = -1;
+		if (deadline) {
+			const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(*deadline - Clock::now()).count();
+			timeout = static_cast<int>(std::max<long long>(remaining, 0));
+		}
+		if (::poll(descriptors, 2, timeout) < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			throw std::system_error(errno, std::generic_category(), "Failed to poll for file changes");
+		}
+		if (descriptors[1].revents & POLLIN) {
+			break;
+		}
+		std::vector<Batch> batches;
+		{
+			std::lock_guard lock(mutex_);
+			if (descriptors[0].revents & POLLIN) {
+				long length;
+				while ((length = ::read(inotifyFd_, buffer.data(), buffer.size())) > 0) {
+					process(buffer.data(), length);
+				}
+			}
+			deadline = flush(Clock::now(), batches);
+		}
+		for (auto& batch : batches) {
+			dispatch(std::move(batch));
+		}
+	}
+#else
+	std::unique_lock lock(mutex_);
+	while (!closed_) {
+		wakeup_.wait_for(lock, debounce_, [this] {
+			return closed_.load();
+		});
+		if (closed_) {
+			break;
+		}
+		for (auto& [id, subscription] : subscriptions_) {
+			rescan(id, subscription);
+		}
+		std::vector<Batch> batches;
+		deadline = flush(Clock::now(), batches);
+		lock.unlock();
+		for (auto& batch : batches) {
+			dispatch(std::move(batch));
+		}
+		lock.lock();
+	}
+#endif
+}
+
+#ifdef __linux__
+/// \brief Applies a buffer of inotify events to the subscriptions.
+/// \details Events of a directory are marked as pending for every subscription watching it. A directory created in
+/// a recursively watched tree is scanned and watched immediately, and everything already inside it is marked too,
+/// since it may have been created before the watch was in place. An overflow of the kernel queue rescans everything.
+/// \param buffer The events read from the inotify descriptor.
+/// \param length The number of bytes in the buffer.
+auto FileWatcher::process(const char* buffer, const long length) -> void {
+	for (long offset = 0; offset < length;) {
+		const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+		offset += static_cast<long>(sizeof(inotify_event) + event->len);
+		if (event->mask & IN_Q_OVERFLOW) {
+			for (auto& [id, subscription] : subscriptions_) {
+				rescan(id, subscription);
+			}
+			continue;
+		}
+		const auto directory = directories_.find(event->wd);
+		if (directory == directories_.end()) {
+			continue;
+		}
+		if (event->mask & IN_IGNORED) {
+			for (const int id : directory->second.subscriptions) {
+				if (const auto subscription = subscriptions_.find(id); subscription != subscriptions_.end()) {
+					std::erase(subscription->second.descriptors, event->wd);
+				}
+			}
+			directories_.erase(directory);
+			continue;
+		}
+		if (event->len == 0) {
+			continue;
+		}
+		const std::filesystem::path path = directory->second.path / event->name;
+		const Key name = path.filename().native();
+		const auto ids = directory->second.subscriptions;
+		for (const int id : ids) {
+			const auto it = subscriptions_.find(id);
+			if (it == subscriptions_.end()) {
+				continue;
+			}
+			auto& subscription = it->second;
+			if (!subscription.name.empty() && subscription.name != name) {
+				continue;
+			}
+			mark(subscription, path.native());
+			if (subscription.recursive && (event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO))) {
+				Snapshot found;
+				scan(id, subscription, path, found);
+				for (const auto& key : found | std::views::keys) {
+					mark(subscription, key);
+				}
+			}
+		}
+	}
+}
+#endif
+
+/// \brief Registers a directory with the kernel for a subscription.
+/// \param id The id of the subscription.
+/// \param subscription The subscription.
+/// \param directory The directory to watch.
+/// \return false if the directory cannot be watched.
+auto FileWatcher::addWatch(const int id, Subscription& subscription, const std::filesystem::path& directory) -> bool {
+#ifdef __linux__
+	const int descriptor = ::inotify_add_watch(inotifyFd_, directory.c_str(), WATCH_MASK);
+	if (descriptor < 0) {
+		return false;
+	}
+	auto& [path, subscriptions] = directories_[descriptor];
+	path = directory;
+	if (std::ranges::find(subscriptions, id) == subscriptions.end()) {
+		subscriptions.push_back(id);
+		subscription.descriptors.push_back(descriptor);
+	}
+	return true;
+#else
+	static_cast<void>(id);
+	static_cast<void>(subscription);
+	return std::filesystem::is_directory(directory);
+#endif
+}
+
+/// \brief Watches a directory of a subscription and records its entries.
+/// \details Descends into subdirectories if the subscription is recursive.
+/// \param id The id of the subscription.
+/// \param subscription The subscription.
+/// \param directory The directory to scan.
+/// \param files The snapshot receiving the entries found.
+/// \return false if \p directory itself cannot be watched.
+auto FileWatcher::scan(const int id, Subscription& subscription, const std::filesystem::path& directory, Snapshot& files) -> bool {
+	if (!addWatch(id, subscription, directory)) {
+		return false;
+	}
+	for (auto& metadata : DirectoryWalker::list(directory)) {
+		if (subscription.recursive && metadata.isDirectory()) {
+			scan(id, subscription, metadata.getPath(), files);
+		}
+		auto key = metadata.getPath().native();
+		files.insert_or_assign(std::move(key), std::move(metadata));
+	}
+	return true;
+}
+
+/// \brief Compares a subscription with the file system and marks every difference as pending.
+/// \details Used after an overflow of the kernel queue, when events may have been lost, and as the polling step on
+/// platforms without inotify. Lost subdirectories of a recursive watch are watched again.
+/// \param id The id of the subscription.
+/// \param subscription The subscription.
+auto FileWatcher::rescan(const int id, Subscription& subscription) -> void {
+	Snapshot current;
+	if (subscription.name.empty()) {
+		if (!subscription.root.empty()) {
+			scan(id, subscription, subscription.root, current);
+		}
+	}
+	else if (auto metadata = FileMetadata::of(subscription.root); metadata.exists()) {
+		current.emplace(subscription.root.native(), std::move(metadata));
+	}
+	for (const auto& [key, before] : subscription.files) {
+		const auto after = current.find(key);
+		if (after == current.end() || changed(before, after->second)) {
+			mark(subscription, key);
+		}
+	}
+	for (const auto& key : current | std::views::keys) {
+		if (!subscription.files.contains(key)) {
+			mark(subscription, key);
+		}
+	}
+}
+
+/// \brief Marks a path of a subscription as changed.
+/// \details The first mark of an interval starts the debounce interval of the subscription.
+/// \param subscription The subscription.
+/// \param key The changed path.
+auto FileWatcher::mark(Subscription& subscription, const Key& key) const -> void {
+	if (subscription.pending.empty()) {
+		subscription.deadline = Clock::now() + debounce_;
+	}
+	subscription.pending.insert(key);
+}
+
+/// \brief Turns the pending paths of every due subscription into a batch of events.
+/// \details Each pending path is inspected once and compared with the snapshot: a path that appeared is CREATED, a
+/// path that is gone is DELETED, together with everything the snapshot holds below it, and any other path is
+/// MODIFIED. The snapshot is updated accordingly.
+/// \param now The current time.
+/// \param batches Receives the batches to dispatch.
+/// \return The earliest deadline of the subscriptions that are not due yet.
+auto FileWatcher::flush(const Clock::time_point now, std::vector<Batch>& batches) -> std::optional<Clock::time_point> {
+	std::optional<Clock::time_point> next;
+	for (auto& subscription : subscriptions_ | std::views::values) {
+		if (subscription.pending.empty()) {
+			continue;
+		}
+		if (subscription.deadline > now) {
+			next = next ? std::min(*next, subscription.deadline) : subscription.deadline;
+			continue;
+		}
+		std::vector<Event> events;
+		auto& files = subscription.files;
+		for (const auto& key : subscription.pending) {
+			const auto before = files.find(key);
+			auto after = FileMetadata::of(std::filesystem::path(key));
+			if (after.exists()) {
+				events.push_back({key, before == files.end() ? Change::CREATED : Change::MODIFIED});
+				files.insert_or_assign(key, std::move(after));
+				continue;
+			}
+			if (before == files.end()) {
+				continue;
+			}
+			const bool directory = before->second.isDirectory();
+			files.erase(before);
+			events.push_back({key, Change::DELETED});
+			if (directory) {
+				const Key prefix = key + std::filesystem::path::preferred_separator;
+				for (auto it = files.lower_bound(prefix); it != files.end() && it->first.starts_with(prefix);) {
+					events.push_back({it->first, Change::DELETED});
+					it = files.erase(it);
+				}
+			}
+		}
+		subscription.pending.clear();
+		if (!events.empty()) {
+			batches.emplace_back(subscription.callback, std::move(events));
+		}
+	}
+	return next;
+}
+
+/// \brief Hands a batch to the pool.
+/// \details When the pool queue is full the callback runs on the watcher thread instead, so no batch is lost.
+/// Exceptions thrown by a callback are discarded.
+/// \param batch The callback and the events to deliver.
+auto FileWatcher::dispatch(Batch batch) const -> void {
+	const auto shared = std::make_shared<const Batch>(std::move(batch));
+	try {
+		static_cast<void>(pool_->Submit([shared] {
+			shared->first(shared->second);
+		}));
+	}
+	catch (const std::runtime_error&) {
+		try {
+			shared->first(shared->second);
+		}
+		catch (...) {
+			// Callback failures must not stop the watcher
+		}
+	}
+}
+
+/// \brief Checks if a file differs between two snapshots.
+/// \param before The older snapshot.
+/// \param after The newer snapshot.
+/// \details Times are compared at full resolution, so a rewrite that keeps the size within the same second is still
+/// seen, and the status change time catches a rewrite that restores the old modification time.
+/// \return true if the type, size, modification time or status change time differs.
+auto FileWatcher::changed(const FileMetadata& before, const FileMetadata& after) -> bool {
+	return before.type() != after.type() || before.length() != after.length() || before.lastModifiedTime() != after.lastModifiedTime() || before.lastStatusChangeTime() != after.lastStatusChangeTime();
+}
+}
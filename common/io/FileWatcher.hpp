@@ -0,0 +1,112 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "FileMetadata.hpp"
+#include "thread/ThreadPool.hpp"
+
+namespace common::io
+{
+/// \brief Watches files and directory trees and reports their changes to callbacks on a thread pool.
+/// \details On Linux the watcher is driven by inotify: a single background thread sleeps in poll() until the kernel
+/// reports an event, so watching costs nothing while nothing changes. A file is watched through its parent directory,
+/// which keeps the watch alive when an editor replaces the file by renaming a new one over it; a recursive directory
+/// watch adds a watch to every subdirectory, including those created later. Other platforms fall back to comparing
+/// metadata snapshots once per debounce interval.
+///
+/// Events are coalesced per subscription: all changes arriving within the debounce interval after the first one are
+/// delivered as one batch, with at most one event per path. The kind of each event is decided against the snapshot
+/// taken when the path was last reported, so a file created and deleted within one interval is not reported at all.
+/// When the kernel event queue overflows (IN_Q_OVERFLOW), every subscription is rescanned and its differences to the
+/// snapshot are reported as regular events.
+///
+/// If the background thread fails, for instance because poll() reports an error, it stops and keeps the error; the
+/// next call to watch() or close() rethrows it.
+/// \remark Callbacks of one subscription may run concurrently on the pool if batches follow each other quickly.
+class FileWatcher final
+{
+public:
+	enum class Change { CREATED, MODIFIED, DELETED };
+
+	struct Event
+	{
+		std::filesystem::path path;
+		Change change;
+	};
+
+	using Callback = std::function<void(const std::vector<Event>&)>;
+	static constexpr auto DEFAULT_DEBOUNCE = std::chrono::milliseconds(100);
+	explicit FileWatcher(std::shared_ptr<thread::ThreadPool> pool, std::chrono::milliseconds debounce = DEFAULT_DEBOUNCE);
+	~FileWatcher();
+	FileWatcher(const FileWatcher&) = delete;
+	auto operator=(const FileWatcher&) -> FileWatcher& = delete;
+	auto watch(const std::filesystem::path& path, Callback callback, bool recursive = false) -> int;
+	auto unwatch(int id) -> void;
+	auto close() -> void;
+
+private:
+	using Key = std::filesystem::path::string_type;
+	using Snapshot = std::map<Key, FileMetadata>;
+	using Clock = std::chrono::steady_clock;
+	using Batch = std::pair<Callback, std::vector<Event>>;
+
+	struct Subscription
+	{
+		std::filesystem::path root;
+		Key name;
+		bool recursive{false};
+		Callback callback;
+		Snapshot files;
+		std::set<Key> pending;
+		Clock::time_point deadline;
+		std::vector<int> descriptors;
+	};
+
+	auto run() -> void;
+	auto loop() -> void;
+	auto addWatch(int id, Subscription& subscription, const std::filesystem::path& directory) -> bool;
+	auto scan(int id, Subscription& subscription, const std::filesystem::path& directory, Snapshot& files) -> bool;
+	auto rescan(int id, Subscription& subscription) -> void;
+	auto mark(Subscription& subscription, const Key& key) const -> void;
+	auto flush(Clock::time_point now, std::vector<Batch>& batches) -> std::optional<Clock::time_point>;
+	auto dispatch(Batch batch) const -> void;
+	static auto changed(const FileMetadata& before, const FileMetadata& after) -> bool;
+	std::shared_ptr<thread::ThreadPool> pool_;
+	std::chrono::milliseconds debounce_;
+	std::mutex mutex_;
+	std::map<int, Subscription> subscriptions_;
+	int nextId_{0};
+	std::atomic<bool> closed_{false};
+	std::exception_ptr error_;
+#ifdef __linux__
+	auto process(const char* buffer, long length) -> void;
+
+	struct Directory
+	{
+		std::filesystem::path path;
+		std::vector<int> subscriptions;
+	};
+
+	std::unordered_map<int, Directory> directories_;
+	int inotifyFd_{-1};
+	int eventFd_{-1};
+#else
+	std::condition_variable wakeup_;
+#endif
+	std::thread thread_;
+};
+}
@@ -0,0 +1,153 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "InflateInputStream.hpp"
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <zlib.h>
+
+namespace common::io
+{
+InflateInputStream::InflateInputStream(std::unique_ptr<AbstractInputStream> inputStream, const size_t chunkSize): FilterInputStream(std::move(inputStream)), stream_(std::make_unique<z_stream>()), inBuf_(std::min<size_t>(chunkSize, UINT_MAX)), outBuf_(std::min<size_t>(chunkSize, UINT_MAX)) {
+	if (!inputStream_) {
+		throw std::invalid_argument("Input stream cannot be null");
+	}
+	if (chunkSize == 0) {
+		throw std::invalid_argument("Chunk size must be greater than 0");
+	}
+	if (inflateInit2(stream_.get(), MAX_WBITS + 32) != Z_OK) {
+		throw std::runtime_error("Failed to initialize inflate stream");
+	}
+}
+
+InflateInputStream::~InflateInputStream() {
+	inflateEnd(stream_.get());
+}
+
+/// \brief Returns the number of decompressed bytes that can be read without inflating more input.
+/// \return The number of available bytes.
+auto InflateInputStream::available() -> size_t {
+	return outCount_ - outPos_;
+}
+
+/// \brief Marks the current position in the stream (not supported).
+/// \throws std::runtime_error Always, as a compressed stream cannot be rewound.
+auto InflateInputStream::mark(int) -> void {
+	throw std::runtime_error("mark not supported");
+}
+
+/// \brief Tests if this input stream supports the mark and reset methods.
+/// \return false, as a compressed stream cannot be rewound.
+auto InflateInputStream::markSupported() const -> bool {
+	return false;
+}
+
+/// \brief Reads the next decompressed byte.
+/// \return The next byte, or -1 if the end of the compressed stream has been reached.
+auto InflateInputStream::read() -> std::byte {
+	if (outPos_ == outCount_) {
+		outPos_ = 0;
+		outCount_ = inflateInto(outBuf_.data(), outBuf_.size());
+		if (outCount_ == 0) {
+			return static_cast<std::byte>(-1);
+		}
+	}
+	return outBuf_[outPos_++];
+}
+
+/// \brief Reads decompressed bytes into the specified buffer.
+/// \param buffer The buffer into which the data is read.
+/// \return The number of bytes read, or 0 if the end of the compressed stream has been reached.
+auto InflateInputStream::read(std::vector<std::byte>& buffer) -> size_t {
+	return read(buffer, 0, buffer.size());
+}
+
+/// \brief Reads up to len decompressed bytes into the specified buffer.
+/// \details Bytes left over from a single-byte read are returned first; otherwise the data is inflated directly into
+/// \p buffer.
+/// \param buffer The buffer into which the data is read.
+/// \param offset The starting position in the buffer.
+/// \param len The maximum number of bytes to read.
+/// \return The number of bytes read, or 0 if the end of the compressed stream has been reached.
+/// \throws std::out_of_range If the offset and length exceed the buffer size.
+/// \throws std::runtime_error If the compressed data is corrupt or truncated.
+auto InflateInputStream::read(std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> size_t {
+	if (offset + len > buffer.size()) {
+		throw std::out_of_range("Buffer overflow");
+	}
+	if (outPos_ < outCount_) {
+		const size_t count = std::min(len, outCount_ - outPos_);
+		std::memcpy(buffer.data() + offset, outBuf_.data() + outPos_, count);
+		outPos_ += count;
+		return count;
+	}
+	return inflateInto(buffer.data() + offset, len);
+}
+
+/// \brief Resets the stream to the last mark (not supported).
+/// \throws std::runtime_error Always, as a compressed stream cannot be rewound.
+auto InflateInputStream::reset() -> void {
+	throw std::runtime_error("reset not supported");
+}
+
+/// \brief Skips over and discards n decompressed bytes.
+/// \param n The number of bytes to skip.
+/// \return The number of bytes actually skipped.
+auto InflateInputStream::skip(size_t n) -> size_t {
+	size_t skipped = 0;
+	while (n > 0) {
+		if (outPos_ == outCount_) {
+			outPos_ = 0;
+			outCount_ = inflateInto(outBuf_.data(), outBuf_.size());
+			if (outCount_ == 0) {
+				break;
+			}
+		}
+		const size_t count = std::min(n, outCount_ - outPos_);
+		outPos_ += count;
+		skipped += count;
+		n -= count;
+	}
+	return skipped;
+}
+
+/// \brief Inflates compressed input into the given memory.
+/// \details Reads more compressed input from the underlying stream whenever the decoder runs dry and returns as soon
+/// as at least one byte has been produced.
+/// \param dst The destination memory.
+/// \param len The capacity of the destination.
+/// \return The number of bytes produced, or 0 at the end of the compressed stream.
+/// \throws std::runtime_error If the compressed data is corrupt or truncated.
+auto InflateInputStream::inflateInto(std::byte* dst, const size_t len) -> size_t {
+	if (len == 0 || streamEnded_) {
+		return 0;
+	}
+	stream_->next_out = reinterpret_cast<Bytef*>(dst);
+	stream_->avail_out = static_cast<uInt>(std::min<size_t>(len, UINT_MAX));
+	const uInt capacity = stream_->avail_out;
+	while (stream_->avail_out == capacity) {
+		if (stream_->avail_in == 0) {
+			if (inputEnded_) {
+				throw std::runtime_error("Unexpected end of compressed stream");
+			}
+			const size_t bytesRead = inputStream_->read(inBuf_, 0, inBuf_.size());
+			if (bytesRead == 0 || bytesRead == static_cast<size_t>(-1)) {
+				inputEnded_ = true;
+			}
+			else {
+				stream_->next_in = reinterpret_cast<Bytef*>(inBuf_.data());
+				stream_->avail_in = static_cast<uInt>(bytesRead);
+			}
+		}
+		const int ret = inflate(stream_.get(), Z_NO_FLUSH);
+		if (ret == Z_STREAM_END) {
+			streamEnded_ = true;
+			break;
+		}
+		if (ret != Z_OK && ret != Z_BUF_ERROR) {
+			throw std::runtime_error("Failed to inflate data");
+		}
+	}
+	return capacity - stream_->avail_out;
+}
+}
@@ -0,0 +1,41 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <memory>
+#include <vector>
+#include "FilterInputStream.hpp"
+
+struct z_stream_s;
+
+namespace common::io
+{
+/// \brief An input stream filter that decompresses deflate data.
+/// \details Compressed bytes are read from the underlying stream one chunk at a time and inflated on demand. Bulk
+/// reads inflate straight into the caller's buffer; single-byte reads are served from a small output chunk. Both
+/// zlib and gzip input are accepted and detected from the header.
+class InflateInputStream final : public FilterInputStream
+{
+public:
+	explicit InflateInputStream(std::unique_ptr<AbstractInputStream> inputStream, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+	~InflateInputStream() override;
+	[[nodiscard]] auto available() -> size_t override;
+	auto mark(int readLimit) -> void override;
+	[[nodiscard]] auto markSupported() const -> bool override;
+	auto read() -> std::byte override;
+	auto read(std::vector<std::byte>& buffer) -> size_t override;
+	auto read(std::vector<std::byte>& buffer, size_t offset, size_t len) -> size_t override;
+	auto reset() -> void override;
+	auto skip(size_t n) -> size_t override;
+
+private:
+	static constexpr size_t DEFAULT_CHUNK_SIZE = 65536;
+	std::unique_ptr<z_stream_s> stream_;
+	std::vector<std::byte> inBuf_;
+	std::vector<std::byte> outBuf_;
+	size_t outPos_{0};
+	size_t outCount_{0};
+	bool inputEnded_{false};
+	bool streamEnded_{false};
+	auto inflateInto(std::byte* dst, size_t len) -> size_t;
+};
+}
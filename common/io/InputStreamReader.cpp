@@ -1,16 +1,17 @@
 // Created by author ethereal on 2024/12/12.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #include "InputStreamReader.hpp"
+#include <cstring>
 
 namespace common::io
 {
-InputStreamReader::InputStreamReader(std::shared_ptr<AbstractReader> input) : reader_(std::move(input)) {
+InputStreamReader::InputStreamReader(std::shared_ptr<AbstractReader> input) : reader_(std::move(input)), inBuf_(DEFAULT_BUFFER_SIZE) {
 	if (!reader_) {
 		throw std::invalid_argument("Input stream cannot be null");
 	}
 }
 
-InputStreamReader::InputStreamReader(std::shared_ptr<AbstractReader> input, const std::string& charsetName) : reader_(std::move(input)) {
+InputStreamReader::InputStreamReader(std::shared_ptr<AbstractReader> input, const std::string& charsetName) : reader_(std::move(input)), inBuf_(DEFAULT_BUFFER_SIZE) {
 	if (!reader_) {
 		throw std::invalid_argument("Input stream cannot be null");
 	}
@@ -22,31 +23,42 @@ InputStreamReader::InputStreamReader(std::shared_ptr<AbstractReader> input, cons
 InputStreamReader::~InputStreamReader() = default;
 
 /// \brief Reads a single character from the input stream.
-/// \return The character read from the input stream, or -1 if the end of the stream is reached.
+/// \details Bytes are fed to an incremental decoder until a whole code point is available, refilling the staging
+/// buffer as many times as the sequence requires.
+/// \return The code point read from the input stream, or -1 if the end of the stream is reached.
 /// \throws std::runtime_error if the input stream is not available.
 /// \throws std::runtime_error if failed to decode byte to character.
 int InputStreamReader::read() {
 	if (!reader_) {
 		throw std::runtime_error("Input stream is not available");
 	}
-	std::vector<char> byteBuffer(4, 0);
-	if (const size_t bytesRead = reader_->read(byteBuffer, 0, 1); bytesRead == 0) {
-		return -1;
-	}
-	try {
-		const char32_t charValue = converter_.from_bytes(byteBuffer.data())[0];
-		return static_cast<int>(charValue);
-	}
-	catch (const std::exception&) {
-		throw std::runtime_error("Failed to decode byte to character");
+	while (true) {
+		if (inPos_ >= inCount_ && !fillBuffer()) {
+			if (decoder_.pending()) {
+				decoder_.reset();
+				throw std::runtime_error("Failed to decode byte to character");
+			}
+			return -1;
+		}
+		try {
+			if (const int codePoint = decoder_.feed(static_cast<unsigned char>(inBuf_[inPos_++])); codePoint != Utf8Decoder::INCOMPLETE) {
+				return codePoint;
+			}
+		}
+		catch (const std::exception&) {
+			throw std::runtime_error("Failed to decode byte to character");
+		}
 	}
 }
 
 /// \brief Reads characters into a buffer from the input stream.
+/// \details The staged bytes are validated in place and copied to \p cBuf with a single memcpy per run, so the
+/// buffer only ever receives complete UTF-8 sequences. A sequence that does not fit in the remaining \p len is left
+/// for the next call, so a \p len shorter than the next sequence reads nothing and returns 0.
 /// \param cBuf The buffer to fill with characters.
 /// \param off The offset in the buffer at which to start filling.
 /// \param len The number of characters to read.
-/// \return The number of characters read, or -1 if the end of the stream is reached.
+/// \return The number of characters read, or -1 if the end of the stream is reached before any character is read.
 /// \throws std::runtime_error if the input stream is not available.
 /// \throws std::out_of_range if the buffer overflows.
 /// \throws std::runtime_error if failed to decode bytes to characters.
@@ -57,20 +69,42 @@ auto InputStreamReader::read(std::vector<char>& cBuf, const size_t off, const si
 	if (off + len > cBuf.size()) {
 		throw std::out_of_range("Buffer overflow");
 	}
-	std::vector<char> byteBuffer(len, 0);
-	const size_t bytesRead = reader_->read(byteBuffer, 0, len);
-	if (bytesRead == 0) {
-		return -1;
-	}
-	try {
-		auto chars = converter_.from_bytes(byteBuffer.data(), byteBuffer.data() + bytesRead);
-		const size_t charsToCopy = std::min(chars.size(), len);
-		std::copy_n(chars.begin(), charsToCopy, cBuf.begin() + static_cast<std::vector<char>::difference_type>(off));
-		return charsToCopy;
-	}
-	catch (const std::exception&) {
+	if (decoder_.pending()) {
 		throw std::runtime_error("Failed to decode bytes to characters");
 	}
+	size_t total = 0;
+	bool endOfStream = false;
+	while (total < len) {
+		if (inPos_ >= inCount_ && !fillBuffer()) {
+			endOfStream = true;
+			break;
+		}
+		const size_t staged = inCount_ - inPos_;
+		const size_t window = std::min(staged, len - total);
+		size_t complete;
+		try {
+			complete = Utf8Decoder::completePrefix(inBuf_.data() + inPos_, window);
+		}
+		catch (const std::exception&) {
+			throw std::runtime_error("Failed to decode bytes to characters");
+		}
+		if (complete == 0) {
+			if (window < staged) {
+				break;
+			}
+			if (!fillBuffer()) {
+				if (total > 0) {
+					break;
+				}
+				throw std::runtime_error("Failed to decode bytes to characters");
+			}
+			continue;
+		}
+		std::memcpy(cBuf.data() + off + total, inBuf_.data() + inPos_, complete);
+		inPos_ += complete;
+		total += complete;
+	}
+	return endOfStream && total == 0 ? static_cast<size_t>(-1) : total;
 }
 
 /// \brief Checks if the input stream is ready to be read.
@@ -80,7 +114,7 @@ bool InputStreamReader::ready() const {
 	if (!reader_) {
 		throw std::runtime_error("Input stream is not available");
 	}
-	return reader_->ready();
+	return inPos_ < inCount_ || reader_->ready();
 }
 
 /// \brief Closes the input stream.
@@ -103,4 +137,23 @@ auto InputStreamReader::mark(size_t) -> void {
 auto InputStreamReader::reset() -> void {
 	throw std::runtime_error("Reset not supported");
 }
+
+/// \brief Refills the staging buffer from the underlying reader.
+/// \details Unconsumed bytes, such as the head of a sequence split by the previous read, are moved to the front of
+/// the buffer before new bytes are appended after them.
+/// \return true if new bytes were read, false at the end of the stream.
+auto InputStreamReader::fillBuffer() -> bool {
+	const size_t leftover = inCount_ - inPos_;
+	if (leftover > 0 && inPos_ > 0) {
+		std::memmove(inBuf_.data(), inBuf_.data() + inPos_, leftover);
+	}
+	inPos_ = 0;
+	inCount_ = leftover;
+	const size_t bytesRead = reader_->read(inBuf_, inCount_, inBuf_.size() - inCount_);
+	if (bytesRead == 0 || bytesRead == static_cast<size_t>(-1)) {
+		return false;
+	}
+	inCount_ += bytesRead;
+	return true;
+}
 }
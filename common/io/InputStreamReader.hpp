@@ -1,15 +1,17 @@
 // Created by author ethereal on 2024/12/12.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #pragma once
-#define _SILENCE_CXX17_CODECVT_HEADER_DEPRECATION_WARNING
-#include <codecvt>
+#include <memory>
 #include "AbstractReader.hpp"
+#include "Utf8Decoder.hpp"
 
 namespace common::io
 {
 /// \brief A class for converting byte input streams into character streams using a specified charset.
 /// \details The InputStreamReader class reads bytes from an input stream and converts them to characters based on the specified charset.
 /// It inherits from AbstractReader and implements the necessary methods for reading characters, marking, resetting, and closing the stream.
+/// Input is staged in a fixed buffer allocated once per reader; a multibyte sequence split by a refill is kept at the
+/// front of the buffer until its remaining bytes arrive. Bulk reads hand out validated UTF-8 aligned to code points.
 class InputStreamReader final : public AbstractReader
 {
 public:
@@ -24,7 +26,12 @@ public:
 	auto reset() -> void override;
 
 private:
+	static constexpr size_t DEFAULT_BUFFER_SIZE = 8192;
 	std::shared_ptr<AbstractReader> reader_;
-	std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> converter_;
+	std::vector<char> inBuf_;
+	size_t inPos_{0};
+	size_t inCount_{0};
+	Utf8Decoder decoder_;
+	auto fillBuffer() -> bool;
 };
 }
@@ -0,0 +1,44 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+
+namespace common::io
+{
+/// \brief Stores and loads integers in little-endian byte order, independent of the host.
+/// \details On little-endian hosts both directions compile to a single unaligned move.
+class LittleEndian final
+{
+public:
+	LittleEndian() = delete;
+	template <std::integral T> static auto store(std::byte* out, T value) -> void;
+	template <std::integral T> static auto load(const std::byte* in) -> T;
+};
+
+/// \brief Stores an integer.
+/// \tparam T The integer type.
+/// \param out The destination; must have room for sizeof(T) bytes.
+/// \param value The value to store.
+template <std::integral T> auto LittleEndian::store(std::byte* out, T value) -> void {
+	if constexpr (std::endian::native == std::endian::big) {
+		value = std::byteswap(value);
+	}
+	std::memcpy(out, &value, sizeof(T));
+}
+
+/// \brief Loads an integer.
+/// \tparam T The integer type.
+/// \param in The source; must hold sizeof(T) bytes.
+/// \return The loaded value.
+template <std::integral T> auto LittleEndian::load(const std::byte* in) -> T {
+	T value;
+	std::memcpy(&value, in, sizeof(T));
+	if constexpr (std::endian::native == std::endian::big) {
+		value = std::byteswap(value);
+	}
+	return value;
+}
+}
@@ -0,0 +1,184 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "Lz4Codec.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace common::io
+{
+/// \brief Returns the worst-case compressed size of a block.
+/// \param srcLen The uncompressed size.
+/// \return The capacity that is always enough for compress().
+auto Lz4Codec::compressBound(const size_t srcLen) -> size_t {
+	return srcLen + srcLen / 255 + 16;
+}
+
+/// \brief Compresses one block.
+/// \param src The data to compress.
+/// \param srcLen The number of bytes to compress.
+/// \param dst The destination for the compressed block.
+/// \param dstCapacity The capacity of the destination.
+/// \param acceleration Values above 1 probe fewer positions on incompressible data, trading ratio for speed.
+/// \return The compressed size, or 0 if the block does not fit into \p dstCapacity.
+auto Lz4Codec::compress(const std::byte* src, const size_t srcLen, std::byte* dst, const size_t dstCapacity, const int acceleration) -> size_t {
+	std::byte* op = dst;
+	const std::byte* end = dst + dstCapacity;
+	size_t anchor = 0;
+	if (srcLen > MF_LIMIT) {
+		std::array<uint32_t, 1 << HASH_LOG> table{};
+		const size_t matchLimit = srcLen - MF_LIMIT;
+		const size_t stepBase = static_cast<size_t>(acceleration < 1 ? 1 : acceleration) << 6;
+		size_t searchCount = stepBase;
+		size_t ip = 0;
+		while (ip < matchLimit) {
+			const uint32_t sequence = read32(src + ip);
+			const uint32_t h = hash(sequence);
+			size_t candidate = table[h];
+			table[h] = static_cast<uint32_t>(ip);
+			if (candidate >= ip || ip - candidate > MAX_OFFSET || read32(src + candidate) != sequence) {
+				ip += searchCount++ >> 6;
+				continue;
+			}
+			while (ip > anchor && candidate > 0 && src[ip - 1] == src[candidate - 1]) {
+				--ip;
+				--candidate;
+			}
+			size_t matchLen = MIN_MATCH;
+			while (ip + matchLen < srcLen - LAST_LITERALS && src[ip + matchLen] == src[candidate + matchLen]) {
+				++matchLen;
+			}
+			if (!writeSequence(op, end, src + anchor, ip - anchor, ip - candidate, matchLen)) {
+				return 0;
+			}
+			ip += matchLen;
+			anchor = ip;
+			if (ip < matchLimit) {
+				table[hash(read32(src + ip - 2))] = static_cast<uint32_t>(ip - 2);
+			}
+			searchCount = stepBase;
+		}
+	}
+	if (!writeSequence(op, end, src + anchor, srcLen - anchor, 0, 0)) {
+		return 0;
+	}
+	return static_cast<size_t>(op - dst);
+}
+
+/// \brief Decompresses one block.
+/// \param src The compressed block.
+/// \param srcLen The size of the compressed block.
+/// \param dst The destination for the decompressed data.
+/// \param dstLen The exact decompressed size.
+/// \return The number of bytes written, always \p dstLen.
+/// \throws std::runtime_error If the block is malformed or does not decompress to exactly \p dstLen bytes.
+auto Lz4Codec::decompress(const std::byte* src, const size_t srcLen, std::byte* dst, const size_t dstLen) -> size_t {
+	const std::byte* ip = src;
+	const std::byte* ipEnd = src + srcLen;
+	std::byte* op = dst;
+	const std::byte* opEnd = dst + dstLen;
+	while (ip < ipEnd) {
+		const auto token = static_cast<size_t>(*ip++);
+		size_t literalLen = token >> 4;
+		if (literalLen == 15) {
+			literalLen += readLength(ip, ipEnd);
+		}
+		if (static_cast<size_t>(ipEnd - ip) < literalLen || static_cast<size_t>(opEnd - op) < literalLen) {
+			throw std::runtime_error("Malformed LZ4 block");
+		}
+		std::memcpy(op, ip, literalLen);
+		ip += literalLen;
+		op += literalLen;
+		if (ip == ipEnd) {
+			break;
+		}
+		if (ipEnd - ip < 2) {
+			throw std::runtime_error("Malformed LZ4 block");
+		}
+		const size_t offset = static_cast<size_t>(ip[0]) | static_cast<size_t>(ip[1]) << 8;
+		ip += 2;
+		size_t matchLen = (token & 0x0F) + MIN_MATCH;
+		if ((token & 0x0F) == 15) {
+			matchLen += readLength(ip, ipEnd);
+		}
+		if (offset == 0 || offset > static_cast<size_t>(op - dst) || static_cast<size_t>(opEnd - op) < matchLen) {
+			throw std::runtime_error("Malformed LZ4 block");
+		}
+		const std::byte* match = op - offset;
+		if (offset >= matchLen) {
+			std::memcpy(op, match, matchLen);
+			op += matchLen;
+		}
+		else {
+			while (matchLen > 0) {
+				const size_t count = std::min(static_cast<size_t>(op - match), matchLen);
+				std::memcpy(op, match, count);
+				op += count;
+				matchLen -= count;
+			}
+		}
+	}
+	if (op != opEnd) {
+		throw std::runtime_error("Malformed LZ4 block");
+	}
+	return dstLen;
+}
+
+/// \brief Loads four bytes without alignment requirements.
+auto Lz4Codec::read32(const std::byte* p) -> uint32_t {
+	uint32_t value;
+	std::memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+/// \brief Hashes a four-byte sequence into the match table.
+auto Lz4Codec::hash(const uint32_t sequence) -> uint32_t {
+	return sequence * 2654435761U >> (32 - HASH_LOG);
+}
+
+/// \brief Writes the 255-run continuation bytes of a literal or match length.
+auto Lz4Codec::writeLength(std::byte*& op, const std::byte* end, size_t len) -> bool {
+	while (len >= 255) {
+		if (op >= end) return false;
+		*op++ = std::byte{255};
+		len -= 255;
+	}
+	if (op >= end) return false;
+	*op++ = static_cast<std::byte>(len);
+	return true;
+}
+
+/// \brief Emits one sequence: a token, the literals from \p anchor and, if \p matchLen is non-zero, the match.
+auto Lz4Codec::writeSequence(std::byte*& op, const std::byte* end, const std::byte* anchor, const size_t literalLen, const size_t offset, const size_t matchLen) -> bool {
+	if (op >= end) return false;
+	std::byte* token = op++;
+	const size_t matchCode = matchLen == 0 ? 0 : matchLen - MIN_MATCH;
+	*token = static_cast<std::byte>((literalLen >= 15 ? 15 : literalLen) << 4 | (matchCode >= 15 ? 15 : matchCode));
+	if (literalLen >= 15 && !writeLength(op, end, literalLen - 15)) return false;
+	if (static_cast<size_t>(end - op) < literalLen) return false;
+	std::memcpy(op, anchor, literalLen);
+	op += literalLen;
+	if (matchLen == 0) return true;
+	if (end - op < 2) return false;
+	*op++ = static_cast<std::byte>(offset & 0xFF);
+	*op++ = static_cast<std::byte>(offset >> 8);
+	return matchCode < 15 || writeLength(op, end, matchCode - 15);
+}
+
+/// \brief Reads the 255-run continuation bytes of a literal or match length.
+auto Lz4Codec::readLength(const std::byte*& ip, const std::byte* end) -> size_t {
+	size_t len = 0;
+	std::byte b;
+	do {
+		if (ip >= end) {
+			throw std::runtime_error("Malformed LZ4 block");
+		}
+		b = *ip++;
+		len += static_cast<size_t>(b);
+	}
+	while (b == std::byte{255});
+	return len;
+}
+}
@@ -0,0 +1,33 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace common::io
+{
+/// \brief A fast LZ77 block codec producing the LZ4 block format.
+/// \details The compressor is a greedy single-probe hash matcher over a 4 KiB-entry table, trading ratio for speed
+/// in the way LZ4 does; its acceleration factor makes it skip faster through incompressible data. Blocks are
+/// independent and are limited to 64 KiB match offsets.
+class Lz4Codec abstract
+{
+public:
+	static constexpr int DEFAULT_ACCELERATION = 1;
+	[[nodiscard]] static auto compressBound(size_t srcLen) -> size_t;
+	static auto compress(const std::byte* src, size_t srcLen, std::byte* dst, size_t dstCapacity, int acceleration = DEFAULT_ACCELERATION) -> size_t;
+	static auto decompress(const std::byte* src, size_t srcLen, std::byte* dst, size_t dstLen) -> size_t;
+
+private:
+	static constexpr size_t MIN_MATCH = 4;
+	static constexpr size_t LAST_LITERALS = 5;
+	static constexpr size_t MF_LIMIT = 12;
+	static constexpr size_t MAX_OFFSET = 65535;
+	static constexpr int HASH_LOG = 12;
+	static auto read32(const std::byte* p) -> uint32_t;
+	static auto hash(uint32_t sequence) -> uint32_t;
+	static auto writeLength(std::byte*& op, const std::byte* end, size_t len) -> bool;
+	static auto writeSequence(std::byte*& op, const std::byte* end, const std::byte* anchor, size_t literalLen, size_t offset, size_t matchLen) -> bool;
+	static auto readLength(const std::byte*& ip, const std::byte* end) -> size_t;
+};
+}
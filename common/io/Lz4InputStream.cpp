@@ -0,0 +1,195 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "Lz4InputStream.hpp"
+#include <cstring>
+#include <stdexcept>
+#include "Lz4Codec.hpp"
+#include "Lz4OutputStream.hpp"
+
+namespace common::io
+{
+Lz4InputStream::Lz4InputStream(std::unique_ptr<AbstractInputStream> inputStream): FilterInputStream(std::move(inputStream)), header_(8) {
+	if (!inputStream_) {
+		throw std::invalid_argument("Input stream cannot be null");
+	}
+}
+
+/// \brief Returns the number of decompressed bytes that can be read without decoding another block.
+/// \return The number of available bytes.
+auto Lz4InputStream::available() -> size_t {
+	return blockCount_ - blockPos_;
+}
+
+/// \brief Marks the current position in the stream (not supported).
+/// \throws std::runtime_error Always, as a compressed stream cannot be rewound.
+auto Lz4InputStream::mark(int) -> void {
+	throw std::runtime_error("mark not supported");
+}
+
+/// \brief Tests if this input stream supports the mark and reset methods.
+/// \return false, as a compressed stream cannot be rewound.
+auto Lz4InputStream::markSupported() const -> bool {
+	return false;
+}
+
+/// \brief Reads the next decompressed byte.
+/// \return The next byte, or -1 if the end of the compressed stream has been reached.
+auto Lz4InputStream::read() -> std::byte {
+	if (blockPos_ == blockCount_ && !fillBlock()) {
+		return static_cast<std::byte>(-1);
+	}
+	return block_[blockPos_++];
+}
+
+/// \brief Reads decompressed bytes into the specified buffer.
+/// \param buffer The buffer into which the data is read.
+/// \return The number of bytes read, or 0 if the end of the compressed stream has been reached.
+auto Lz4InputStream::read(std::vector<std::byte>& buffer) -> size_t {
+	return read(buffer, 0, buffer.size());
+}
+
+/// \brief Reads up to len decompressed bytes into the specified buffer.
+/// \details Bytes left in the current block are returned first. Otherwise the next block is decompressed, directly
+/// into \p buffer when it fits.
+/// \param buffer The buffer into which the data is read.
+/// \param offset The starting position in the buffer.
+/// \param len The maximum number of bytes to read.
+/// \return The number of bytes read, or 0 if the end of the compressed stream has been reached.
+/// \throws std::out_of_range If the offset and length exceed the buffer size.
+/// \throws std::runtime_error If the compressed data is corrupt or truncated.
+auto Lz4InputStream::read(std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> size_t {
+	if (offset + len > buffer.size()) {
+		throw std::out_of_range("Buffer overflow");
+	}
+	if (len == 0) {
+		return 0;
+	}
+	if (blockPos_ == blockCount_) {
+		uint32_t rawSize;
+		uint32_t storedSize;
+		if (!readHeader(rawSize, storedSize)) {
+			return 0;
+		}
+		if (rawSize <= len) {
+			decodeBlock(rawSize, storedSize, buffer.data() + offset);
+			return rawSize;
+		}
+		block_.resize(rawSize);
+		decodeBlock(rawSize, storedSize, block_.data());
+		blockPos_ = 0;
+		blockCount_ = rawSize;
+	}
+	const size_t count = std::min(len, blockCount_ - blockPos_);
+	std::memcpy(buffer.data() + offset, block_.data() + blockPos_, count);
+	blockPos_ += count;
+	return count;
+}
+
+/// \brief Resets the stream to the last mark (not supported).
+/// \throws std::runtime_error Always, as a compressed stream cannot be rewound.
+auto Lz4InputStream::reset() -> void {
+	throw std::runtime_error("reset not supported");
+}
+
+/// \brief Skips over and discards n decompressed bytes.
+/// \param n The number of bytes to skip.
+/// \return The number of bytes actually skipped.
+auto Lz4InputStream::skip(size_t n) -> size_t {
+	size_t skipped = 0;
+	while (n > 0) {
+		if (blockPos_ == blockCount_ && !fillBlock()) {
+			break;
+		}
+		const size_t count = std::min(n, blockCount_ - blockPos_);
+		blockPos_ += count;
+		skipped += count;
+		n -= count;
+	}
+	return skipped;
+}
+
+/// \brief Reads the header of the next block.
+/// \param rawSize Receives the uncompressed size of the block.
+/// \param storedSize Receives the stored size of the block, including the stored flag.
+/// \return false at the end marker.
+/// \throws std::runtime_error If the stream is truncated or the header is invalid.
+auto Lz4InputStream::readHeader(uint32_t& rawSize, uint32_t& storedSize) -> bool {
+	if (ended_) {
+		return false;
+	}
+	if (readFully(header_, 8) != 8) {
+		throw std::runtime_error("Unexpected end of compressed stream");
+	}
+	rawSize = 0;
+	storedSize = 0;
+	for (int i = 0; i < 4; ++i) {
+		rawSize |= static_cast<uint32_t>(header_[i]) << 8 * i;
+		storedSize |= static_cast<uint32_t>(header_[4 + i]) << 8 * i;
+	}
+	if (rawSize == 0) {
+		ended_ = true;
+		return false;
+	}
+	const uint32_t payload = storedSize & ~Lz4OutputStream::STORED_FLAG;
+	if (rawSize > Lz4OutputStream::MAX_BLOCK_SIZE || payload > Lz4Codec::compressBound(rawSize)) {
+		throw std::runtime_error("Malformed LZ4 block header");
+	}
+	return true;
+}
+
+/// \brief Reads the payload of a block and decodes it.
+/// \param rawSize The uncompressed size of the block.
+/// \param storedSize The stored size of the block, including the stored flag.
+/// \param dst The destination, at least \p rawSize bytes long.
+/// \throws std::runtime_error If the stream is truncated or the block is corrupt.
+auto Lz4InputStream::decodeBlock(const uint32_t rawSize, const uint32_t storedSize, std::byte* dst) -> void {
+	const uint32_t payload = storedSize & ~Lz4OutputStream::STORED_FLAG;
+	if (compressed_.size() < payload) {
+		compressed_.resize(payload);
+	}
+	if (readFully(compressed_, payload) != payload) {
+		throw std::runtime_error("Unexpected end of compressed stream");
+	}
+	if ((storedSize & Lz4OutputStream::STORED_FLAG) != 0) {
+		if (payload != rawSize) {
+			throw std::runtime_error("Malformed LZ4 block header");
+		}
+		std::memcpy(dst, compressed_.data(), rawSize);
+		return;
+	}
+	Lz4Codec::decompress(compressed_.data(), payload, dst, rawSize);
+}
+
+/// \brief Decodes the next block into the internal block buffer.
+/// \return false at the end of the compressed stream.
+auto Lz4InputStream::fillBlock() -> bool {
+	uint32_t rawSize;
+	uint32_t storedSize;
+	if (!readHeader(rawSize, storedSize)) {
+		return false;
+	}
+	if (block_.size() < rawSize) {
+		block_.resize(rawSize);
+	}
+	decodeBlock(rawSize, storedSize, block_.data());
+	blockPos_ = 0;
+	blockCount_ = rawSize;
+	return true;
+}
+
+/// \brief Reads exactly len bytes from the underlying stream unless it ends first.
+/// \param buffer The destination buffer.
+/// \param len The number of bytes to read.
+/// \return The number of bytes read.
+auto Lz4InputStream::readFully(std::vector<std::byte>& buffer, const size_t len) -> size_t {
+	size_t total = 0;
+	while (total < len) {
+		const size_t bytesRead = inputStream_->read(buffer, total, len - total);
+		if (bytesRead == 0 || bytesRead == static_cast<size_t>(-1)) {
+			break;
+		}
+		total += bytesRead;
+	}
+	return total;
+}
+}
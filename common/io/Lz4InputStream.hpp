@@ -0,0 +1,38 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <memory>
+#include <vector>
+#include "FilterInputStream.hpp"
+
+namespace common::io
+{
+/// \brief An input stream filter that decompresses data written by Lz4OutputStream.
+/// \details Blocks are read and decompressed one at a time; a read that asks for at least a whole block is
+/// decompressed straight into the caller's buffer.
+class Lz4InputStream final : public FilterInputStream
+{
+public:
+	explicit Lz4InputStream(std::unique_ptr<AbstractInputStream> inputStream);
+	[[nodiscard]] auto available() -> size_t override;
+	auto mark(int readLimit) -> void override;
+	[[nodiscard]] auto markSupported() const -> bool override;
+	auto read() -> std::byte override;
+	auto read(std::vector<std::byte>& buffer) -> size_t override;
+	auto read(std::vector<std::byte>& buffer, size_t offset, size_t len) -> size_t override;
+	auto reset() -> void override;
+	auto skip(size_t n) -> size_t override;
+
+private:
+	std::vector<std::byte> header_;
+	std::vector<std::byte> compressed_;
+	std::vector<std::byte> block_;
+	size_t blockPos_{0};
+	size_t blockCount_{0};
+	bool ended_{false};
+	auto readHeader(uint32_t& rawSize, uint32_t& storedSize) -> bool;
+	auto decodeBlock(uint32_t rawSize, uint32_t storedSize, std::byte* dst) -> void;
+	auto fillBlock() -> bool;
+	auto readFully(std::vector<std::byte>& buffer, size_t len) -> size_t;
+};
+}
@@ -0,0 +1,127 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "Lz4OutputStream.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace common::io
+{
+Lz4OutputStream::Lz4OutputStream(std::shared_ptr<AbstractOutputStream> outputStream, const int acceleration, const size_t blockSize): FilterOutputStream(std::move(outputStream)), acceleration_(acceleration), block_(blockSize), compressed_(8 + Lz4Codec::compressBound(blockSize)) {
+	if (!outputStream_) {
+		throw std::invalid_argument("Output stream cannot be null");
+	}
+	if (blockSize == 0 || blockSize > MAX_BLOCK_SIZE) {
+		throw std::invalid_argument("Block size must be between 1 and 4 MiB");
+	}
+}
+
+Lz4OutputStream::~Lz4OutputStream() {
+	try {
+		finish();
+	}
+	catch (...) {
+		// Suppress exceptions in destructors
+	}
+}
+
+/// \brief Writes a single byte to the stream.
+/// \param b The byte to write.
+/// \throws std::runtime_error If the stream has already been finished.
+auto Lz4OutputStream::write(const std::byte b) -> void {
+	if (finished_) {
+		throw std::runtime_error("LZ4 stream is finished");
+	}
+	block_[blockCount_++] = b;
+	if (blockCount_ == block_.size()) {
+		writeBlock();
+	}
+}
+
+/// \brief Writes a portion of a byte array to the stream.
+/// \details The data is copied into the current block, which is compressed every time it fills up.
+/// \param buffer The buffer containing the data to write.
+/// \param offset The offset in the buffer at which to start writing.
+/// \param len The number of bytes to write.
+/// \throws std::out_of_range If the offset and length exceed the buffer size.
+/// \throws std::runtime_error If the stream has already been finished.
+auto Lz4OutputStream::write(const std::vector<std::byte>& buffer, size_t offset, size_t len) -> void {
+	if (offset + len > buffer.size()) {
+		throw std::out_of_range("Buffer overflow");
+	}
+	if (finished_) {
+		throw std::runtime_error("LZ4 stream is finished");
+	}
+	while (len > 0) {
+		const size_t count = std::min(len, block_.size() - blockCount_);
+		std::memcpy(block_.data() + blockCount_, buffer.data() + offset, count);
+		blockCount_ += count;
+		offset += count;
+		len -= count;
+		if (blockCount_ == block_.size()) {
+			writeBlock();
+		}
+	}
+}
+
+/// \brief Flushes the stream.
+/// \details Compresses the pending partial block, then flushes the underlying stream.
+auto Lz4OutputStream::flush() -> void {
+	if (blockCount_ > 0) {
+		writeBlock();
+	}
+	FilterOutputStream::flush();
+}
+
+/// \brief Finishes the compressed stream and closes the underlying stream.
+auto Lz4OutputStream::close() -> void {
+	finish();
+	FilterOutputStream::close();
+}
+
+/// \brief Finishes the compressed stream without closing the underlying stream.
+/// \details Writes the pending block and the end marker. Further writes are rejected.
+auto Lz4OutputStream::finish() -> void {
+	if (finished_) {
+		return;
+	}
+	if (blockCount_ > 0) {
+		writeBlock();
+	}
+	std::memset(compressed_.data(), 0, 8);
+	outputStream_->write(compressed_, 0, 8);
+	bytesOut_ += 8;
+	finished_ = true;
+}
+
+/// \brief Returns the number of uncompressed bytes written so far.
+/// \return The total input size.
+auto Lz4OutputStream::bytesIn() const -> size_t {
+	return bytesIn_ + blockCount_;
+}
+
+/// \brief Returns the number of compressed bytes produced so far.
+/// \return The total output size, including block headers.
+auto Lz4OutputStream::bytesOut() const -> size_t {
+	return bytesOut_;
+}
+
+/// \brief Compresses the current block and writes it with its header.
+auto Lz4OutputStream::writeBlock() -> void {
+	const auto rawSize = static_cast<uint32_t>(blockCount_);
+	size_t payload = Lz4Codec::compress(block_.data(), blockCount_, compressed_.data() + 8, compressed_.size() - 8, acceleration_);
+	uint32_t storedSize = static_cast<uint32_t>(payload);
+	if (payload == 0 || payload >= blockCount_) {
+		std::memcpy(compressed_.data() + 8, block_.data(), blockCount_);
+		payload = blockCount_;
+		storedSize = rawSize | STORED_FLAG;
+	}
+	for (int i = 0; i < 4; ++i) {
+		compressed_[i] = static_cast<std::byte>(rawSize >> 8 * i);
+		compressed_[4 + i] = static_cast<std::byte>(storedSize >> 8 * i);
+	}
+	outputStream_->write(compressed_, 0, 8 + payload);
+	bytesIn_ += blockCount_;
+	bytesOut_ += 8 + payload;
+	blockCount_ = 0;
+}
+}
@@ -0,0 +1,44 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <memory>
+#include <vector>
+#include "FilterOutputStream.hpp"
+#include "Lz4Codec.hpp"
+
+namespace common::io
+{
+/// \brief An output stream filter that compresses data with the fast LZ4 block codec.
+/// \details Bytes are collected into blocks which are compressed independently once full. Each block is written as an
+/// 8-byte header holding the little-endian uncompressed size and stored size, followed by the payload; a block that
+/// does not shrink is stored as is and flagged by the top bit of the stored size. A zero-length header marks the end
+/// of the stream. The format is read back by Lz4InputStream.
+/// \remark The acceleration factor plays the role of an inverted compression level: 1 gives the best ratio, larger
+/// values skip faster over incompressible data.
+class Lz4OutputStream final : public FilterOutputStream
+{
+public:
+	static constexpr size_t DEFAULT_BLOCK_SIZE = 65536;
+	static constexpr size_t MAX_BLOCK_SIZE = 4 * 1024 * 1024;
+	static constexpr uint32_t STORED_FLAG = 0x80000000U;
+	explicit Lz4OutputStream(std::shared_ptr<AbstractOutputStream> outputStream, int acceleration = Lz4Codec::DEFAULT_ACCELERATION, size_t blockSize = DEFAULT_BLOCK_SIZE);
+	~Lz4OutputStream() override;
+	auto write(std::byte b) -> void override;
+	auto write(const std::vector<std::byte>& buffer, size_t offset, size_t len) -> void override;
+	auto flush() -> void override;
+	auto close() -> void override;
+	auto finish() -> void;
+	[[nodiscard]] auto bytesIn() const -> size_t;
+	[[nodiscard]] auto bytesOut() const -> size_t;
+
+private:
+	int acceleration_;
+	std::vector<std::byte> block_;
+	size_t blockCount_{0};
+	std::vector<std::byte> compressed_;
+	size_t bytesIn_{0};
+	size_t bytesOut_{0};
+	bool finished_{false};
+	auto writeBlock() -> void;
+};
+}
@@ -0,0 +1,114 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "MappedFile.hpp"
+#include <ios>
+#include <system_error>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace common::io
+{
+/// \brief Maps a file.
+/// \param file The file to map.
+/// \param access The expected access pattern, passed to the kernel as a readahead hint.
+/// \throws std::ios_base::failure If the file cannot be opened or mapped.
+MappedFile::MappedFile(const std::filesystem::path& file, const Access access) {
+#ifdef _WIN32
+	const DWORD flags = access == Access::SEQUENTIAL ? FILE_FLAG_SEQUENTIAL_SCAN : access == Access::RANDOM ? FILE_FLAG_RANDOM_ACCESS : FILE_ATTRIBUTE_NORMAL;
+	file_ = CreateFileW(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+	if (file_ == INVALID_HANDLE_VALUE) {
+		file_ = nullptr;
+		throw std::ios_base::failure("Cannot open file: " + file.string());
+	}
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file_, &size)) {
+		close();
+		throw std::ios_base::failure("Cannot query file size: " + file.string());
+	}
+	size_ = static_cast<size_t>(size.QuadPart);
+	if (size_ == 0) {
+		return;
+	}
+	mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	const void* view = mapping_ != nullptr ? MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (view == nullptr) {
+		close();
+		throw std::ios_base::failure("Cannot map file: " + file.string());
+	}
+	data_ = static_cast<const std::byte*>(view);
+#else
+	const int fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		throw std::ios_base::failure("Cannot open file: " + file.string(), std::error_code(errno, std::system_category()));
+	}
+	struct stat status{};
+	if (::fstat(fd, &status) != 0) {
+		const int error = errno;
+		::close(fd);
+		throw std::ios_base::failure("Cannot query file size: " + file.string(), std::error_code(error, std::system_category()));
+	}
+	size_ = static_cast<size_t>(status.st_size);
+	if (size_ == 0) {
+		::close(fd);
+		return;
+	}
+	void* view = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+	const int error = errno;
+	::close(fd);
+	if (view == MAP_FAILED) {
+		size_ = 0;
+		throw std::ios_base::failure("Cannot map file: " + file.string(), std::error_code(error, std::system_category()));
+	}
+	if (access != Access::NORMAL) {
+		::madvise(view, size_, access == Access::SEQUENTIAL ? MADV_SEQUENTIAL : MADV_RANDOM);
+	}
+	data_ = static_cast<const std::byte*>(view);
+#endif
+}
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+/// \brief Returns the mapped bytes.
+/// \return The content of the file, or an empty span once closed.
+auto MappedFile::bytes() const -> std::span<const std::byte> {
+	return {data_, size_};
+}
+
+/// \brief Returns the size of the mapping.
+/// \return The file size in bytes, or 0 once closed.
+auto MappedFile::size() const -> size_t {
+	return size_;
+}
+
+/// \brief Unmaps the file; the bytes returned before become invalid.
+auto MappedFile::close() -> void {
+#ifdef _WIN32
+	if (data_ != nullptr) {
+		UnmapViewOfFile(data_);
+	}
+	if (mapping_ != nullptr) {
+		CloseHandle(mapping_);
+		mapping_ = nullptr;
+	}
+	if (file_ != nullptr) {
+		CloseHandle(file_);
+		file_ = nullptr;
+	}
+#else
+	if (data_ != nullptr) {
+		::munmap(const_cast<std::byte*>(data_), size_);
+	}
+#endif
+	data_ = nullptr;
+	size_ = 0;
+}
+}
@@ -0,0 +1,35 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include "interface/IfaceCloseable.hpp"
+
+namespace common::io
+{
+/// \brief Maps a file into memory read-only.
+/// \details The pages are loaded by the kernel on first access and shared with the page cache, so a large file can
+/// be read without copying it into the process and only the touched parts occupy memory. The bytes stay valid until
+/// the mapping is closed or destroyed. An empty file maps to an empty span.
+class MappedFile final : public interface::IfaceCloseable
+{
+public:
+	enum class Access { NORMAL, SEQUENTIAL, RANDOM };
+	explicit MappedFile(const std::filesystem::path& file, Access access = Access::NORMAL);
+	~MappedFile() override;
+	MappedFile(const MappedFile&) = delete;
+	auto operator=(const MappedFile&) -> MappedFile& = delete;
+	[[nodiscard]] auto bytes() const -> std::span<const std::byte>;
+	[[nodiscard]] auto size() const -> size_t;
+	auto close() -> void override;
+
+private:
+	const std::byte* data_{nullptr};
+	size_t size_{0};
+#ifdef _WIN32
+	void* file_{nullptr};
+	void* mapping_{nullptr};
+#endif
+};
+}
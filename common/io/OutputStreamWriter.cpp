@@ -5,9 +5,19 @@
 namespace common::io
 {
 OutputStreamWriter::OutputStreamWriter(std::unique_ptr<AbstractWriter> outputStream, const std::string& charsetName): outputWriter_(std::move(outputStream)), charset_(charsetName), closed_(false) {
-	if (charsetName != "UTF-8") {
+	if (charsetName == "UTF-16LE") {
+		encoding_ = Encoding::UTF16LE;
+	}
+	else if (charsetName == "UTF-16BE" || charsetName == "UTF-16") {
+		encoding_ = Encoding::UTF16BE;
+		bomPending_ = charsetName == "UTF-16";
+	}
+	else if (charsetName != "UTF-8") {
 		throw std::invalid_argument("Unsupported encoding: " + charsetName);
 	}
+	if (encoding_ != Encoding::UTF8) {
+		staging_.resize(STAGING_SIZE);
+	}
 }
 
 OutputStreamWriter::OutputStreamWriter(std::unique_ptr<AbstractWriter> outputStream): OutputStreamWriter(std::move(outputStream), "UTF-8") {}
@@ -23,11 +33,11 @@ auto OutputStreamWriter::getEncoding() const -> std::string {
 }
 
 /// \brief Writes a single character to the stream.
-/// \details This method writes a single character to the stream.
+/// \details This method writes a single character to the stream without building a temporary string.
 /// If the stream is closed, an exception is thrown.
 /// \param c The character to write.
 void OutputStreamWriter::write(const char c) {
-	write(std::string(1, c));
+	write(std::string_view(&c, 1));
 }
 
 /// \brief Writes a portion of a character buffer to the stream.
@@ -39,16 +49,10 @@ void OutputStreamWriter::write(const char c) {
 /// \throws std::ios_base::failure If the stream is closed or if writing fails.
 /// \throws std::out_of_range If the offset and length exceed the buffer size.
 auto OutputStreamWriter::write(const std::vector<char>& cBuf, const size_t off, const size_t len) -> void {
-	if (closed_) {
-		throw std::ios_base::failure("Stream is closed");
-	}
 	if (off + len > cBuf.size()) {
 		throw std::out_of_range("Offset and length exceed buffer size");
 	}
-	outputWriter_->write(cBuf, off, len);
-	if (!outputWriter_) {
-		throw std::ios_base::failure("Failed to write to stream");
-	}
+	write(std::string_view(cBuf.data() + off, len));
 }
 
 /// \brief Writes the entire content of a character buffer to the stream.
@@ -61,12 +65,12 @@ void OutputStreamWriter::write(const std::vector<char>& cBuf) {
 }
 
 /// \brief Writes the entire content of a string to the stream.
-/// \details This method converts the given string \p str to a character buffer and writes it to the stream.
+/// \details This method passes the given string \p str to the stream as a view, without copying it.
 /// If the stream is closed or if writing fails, an exception is thrown.
 /// \param str The string to be written.
 /// \throws std::ios_base::failure If the stream is closed or if writing fails.
 void OutputStreamWriter::write(const std::string& str) {
-	write(std::vector<char>(str.begin(), str.end()));
+	write(std::string_view(str));
 }
 
 /// \brief Writes a portion of a string to the stream.
@@ -81,16 +85,36 @@ void OutputStreamWriter::write(const std::string& str, const size_t off, const s
 	if (off + len > str.size()) {
 		throw std::out_of_range("Offset and length exceed string size");
 	}
-	write(std::vector(str.begin() + static_cast<std::string::difference_type>(off), str.begin() + static_cast<std::string::difference_type>(off + len)));
+	write(std::string_view(str).substr(off, len));
+}
+
+/// \brief Writes a view of characters to the stream.
+/// \details With the UTF-8 charset the view is passed through to the underlying writer unchanged; otherwise the
+/// characters are transcoded to UTF-16 in the configured byte order.
+/// \param str The UTF-8 characters to be written.
+/// \throws std::ios_base::failure If the stream is closed.
+/// \throws std::runtime_error If the input is not valid UTF-8 and has to be transcoded.
+auto OutputStreamWriter::write(const std::string_view str) -> void {
+	if (closed_) {
+		throw std::ios_base::failure("Stream is closed");
+	}
+	if (encoding_ == Encoding::UTF8) {
+		outputWriter_->write(str);
+	}
+	else {
+		transcode(str);
+	}
 }
 
 /// \brief Flushes the stream.
 /// \details This method flushes the stream. If the stream is closed or if flushing fails, an exception is thrown.
+/// A UTF-8 sequence left incomplete by the last write stays pending, so that the next write can complete it.
 /// \throws std::ios_base::failure If the stream is closed or if flushing fails.
 auto OutputStreamWriter::flush() -> void {
 	if (closed_) {
 		throw std::ios_base::failure("Stream is closed");
 	}
+	drainStaging();
 	outputWriter_->flush();
 	if (!outputWriter_) {
 		throw std::ios_base::failure("Failed to flush stream");
@@ -99,11 +123,17 @@ auto OutputStreamWriter::flush() -> void {
 
 /// \brief Closes the stream.
 /// \details This method closes the stream. If the stream is already closed, the method does nothing.
+/// A UTF-8 sequence still incomplete when transcoding to UTF-16 can no longer be completed, so it is written as
+/// U+FFFD REPLACEMENT CHARACTER instead of being dropped.
 /// \throws std::ios_base::failure If the stream is closed or if closing fails.
 auto OutputStreamWriter::close() -> void {
 	if (closed_) {
 		return;
 	}
+	if (decoder_.pending()) {
+		decoder_.reset();
+		putCodeUnit(u'\uFFFD');
+	}
 	flush();
 	closed_ = true;
 }
@@ -156,4 +186,60 @@ auto OutputStreamWriter::toString() const -> std::string {
 	}
 	return outputWriter_->toString();
 }
+
+/// \brief Transcodes UTF-8 input to UTF-16 code units in the staging buffer.
+/// \details Runs of ASCII are found with Utf8Decoder::asciiPrefix and widened without decoding; other bytes go
+/// through the incremental decoder, which keeps a partial sequence until the next call. The staging buffer is
+/// written to the underlying writer whenever it fills up and at the end of the call.
+/// \param str The UTF-8 characters to transcode.
+/// \throws std::runtime_error If the input is not valid UTF-8.
+auto OutputStreamWriter::transcode(const std::string_view str) -> void {
+	if (bomPending_) {
+		bomPending_ = false;
+		putCodeUnit(u'\uFEFF');
+	}
+	size_t i = 0;
+	while (i < str.size()) {
+		if (!decoder_.pending()) {
+			const size_t ascii = Utf8Decoder::asciiPrefix(str.data() + i, str.size() - i);
+			for (size_t k = 0; k < ascii; ++k) {
+				putCodeUnit(static_cast<char16_t>(str[i + k]));
+			}
+			i += ascii;
+			if (i == str.size()) {
+				break;
+			}
+		}
+		if (const int codePoint = decoder_.feed(static_cast<unsigned char>(str[i++])); codePoint != Utf8Decoder::INCOMPLETE) {
+			if (codePoint >= 0x10000) {
+				putCodeUnit(static_cast<char16_t>(0xD800 + ((codePoint - 0x10000) >> 10)));
+				putCodeUnit(static_cast<char16_t>(0xDC00 + ((codePoint - 0x10000) & 0x3FF)));
+			}
+			else {
+				putCodeUnit(static_cast<char16_t>(codePoint));
+			}
+		}
+	}
+	drainStaging();
+}
+
+/// \brief Stores one UTF-16 code unit in the staging buffer in the configured byte order.
+/// \param unit The code unit to store.
+auto OutputStreamWriter::putCodeUnit(const char16_t unit) -> void {
+	if (stagingCount_ + 2 > staging_.size()) {
+		drainStaging();
+	}
+	const auto high = static_cast<char>(unit >> 8);
+	const auto low = static_cast<char>(unit & 0xFF);
+	staging_[stagingCount_++] = encoding_ == Encoding::UTF16LE ? low : high;
+	staging_[stagingCount_++] = encoding_ == Encoding::UTF16LE ? high : low;
+}
+
+/// \brief Writes the staged bytes to the underlying writer.
+auto OutputStreamWriter::drainStaging() -> void {
+	if (stagingCount_ > 0) {
+		outputWriter_->write(std::string_view(staging_.data(), stagingCount_));
+		stagingCount_ = 0;
+	}
+}
 }
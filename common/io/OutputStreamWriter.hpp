@@ -1,9 +1,8 @@
 // Created by author ethereal on 2024/12/12.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #pragma once
-#define _SILENCE_CXX17_CODECVT_HEADER_DEPRECATION_WARNING
-#include <codecvt>
 #include "AbstractWriter.hpp"
+#include "Utf8Decoder.hpp"
 
 namespace common::io
 {
@@ -13,6 +12,10 @@ namespace common::io
 /// The class also supports flushing and closing the stream, as well as appending characters and strings.
 /// It uses a specified charset for encoding the characters into bytes.
 /// The class is useful for writing text data to a stream with a specified character encoding.
+/// Input text is UTF-8. With the UTF-8 charset it is handed to the underlying writer as a view without any copy;
+/// with UTF-16LE, UTF-16BE or UTF-16 (big-endian with a byte order mark) it is transcoded through a reusable
+/// staging buffer, expanding runs of ASCII without decoding them. A code point split across calls is completed by
+/// the next write; one still incomplete at close() is written as U+FFFD.
 /// \remark Instances of this class are not thread-safe. Synchronization is needed for concurrent access.
 class OutputStreamWriter final : public AbstractWriter
 {
@@ -21,11 +24,13 @@ public:
 	explicit OutputStreamWriter(std::unique_ptr<AbstractWriter> outputStream);
 	~OutputStreamWriter() override;
 	[[nodiscard]] auto getEncoding() const -> std::string;
+	using AbstractWriter::write;
 	auto write(char c) -> void override;
 	auto write(const std::vector<char>& cBuf, size_t off, size_t len) -> void override;
 	auto write(const std::vector<char>& cBuf) -> void override;
 	auto write(const std::string& str) -> void override;
 	auto write(const std::string& str, size_t off, size_t len) -> void override;
+	auto write(std::string_view str) -> void override;
 	auto flush() -> void override;
 	auto close() -> void override;
 	auto append(char c) -> AbstractWriter& override;
@@ -34,9 +39,18 @@ public:
 	[[nodiscard]] auto toString() const -> std::string override;
 
 private:
+	enum class Encoding { UTF8, UTF16LE, UTF16BE };
+	static constexpr size_t STAGING_SIZE = 8192;
+	auto transcode(std::string_view str) -> void;
+	auto putCodeUnit(char16_t unit) -> void;
+	auto drainStaging() -> void;
 	std::unique_ptr<AbstractWriter> outputWriter_;
-	std::wstring_convert<std::codecvt_utf8<char16_t>, char16_t> converter_;
 	std::string charset_;
+	Encoding encoding_{Encoding::UTF8};
+	bool bomPending_{false};
+	Utf8Decoder decoder_;
+	std::vector<char> staging_;
+	size_t stagingCount_{0};
 	bool closed_;
 };
 }
@@ -1,12 +1,14 @@
 // Created by author ethereal on 2024/12/14.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #include "PipedInputStream.hpp"
+#include <bit>
+#include <cstring>
 
 namespace common::io
 {
 PipedInputStream::PipedInputStream(): PipedInputStream(PIPE_SIZE) {}
 
-PipedInputStream::PipedInputStream(const size_t pipeSize): buffer_(pipeSize) {}
+PipedInputStream::PipedInputStream(const size_t pipeSize): buffer_(std::bit_ceil(std::max<size_t>(pipeSize, 2))), mask_(buffer_.size() - 1) {}
 
 PipedInputStream::PipedInputStream(const std::shared_ptr<PipedOutputStream>& src) : PipedInputStream(src, PIPE_SIZE) {}
 
@@ -19,54 +21,94 @@ PipedInputStream::~PipedInputStream() {
 }
 
 /// \brief Closes this piped input stream and releases any system resources associated with it.
-/// \details Clears the buffer and resets the in and out indices to zero.
-/// \note This method is thread-safe as it locks the mutex before performing operations.
+/// \details Marks the pipe as closed by the reader and wakes a writer blocked on a full pipe, which then fails.
+/// \note This method may be called from either side of the pipe.
 auto PipedInputStream::close() -> void {
-	std::lock_guard lock(mutex_);
-	buffer_.clear();
-	in_ = out_ = 0;
+	closedByReader_.store(true);
+	dataEvent_.fetch_add(1);
+	dataEvent_.notify_all();
+	spaceEvent_.fetch_add(1);
+	spaceEvent_.notify_all();
 }
 
 /// \brief Returns the number of bytes that can be read from this input stream without blocking.
 /// \details Returns the number of bytes that can be read from this input stream without blocking.
 /// \return The number of bytes that can be read from this input stream without blocking.
 auto PipedInputStream::available() -> size_t {
-	std::lock_guard lock(mutex_);
-	return (in_ + buffer_.size() - out_) % buffer_.size();
+	return in_.load(std::memory_order_acquire) - out_.load(std::memory_order_relaxed);
 }
 
 /// \brief Reads the next byte of data from this input stream.
-/// \details Reads the next byte of data from this input stream.
-/// \return The next byte of data from this input stream.
-/// \throw std::runtime_error If the end of the stream has been reached.
-/// \note This method is thread-safe as it locks the mutex before performing operations.
+/// \details Blocks while the pipe is empty and the writer has not closed its end.
+/// \return The next byte of data from this input stream, or -1 if the writer closed the pipe and it is drained.
+/// \throw std::runtime_error If the pipe has been closed by the reader.
+/// \note Only one thread may read from the pipe at a time.
 auto PipedInputStream::read() -> std::byte {
-	std::lock_guard lock(mutex_);
-	if (in_ == out_) {
-		throw std::runtime_error("PipedInputStream is empty");
+	const size_t out = out_.load(std::memory_order_relaxed);
+	if (awaitData(out) == out) {
+		return static_cast<std::byte>(-1);
 	}
-	const auto result = buffer_[out_];
-	out_ = (out_ + 1) % buffer_.size();
+	const auto result = buffer_[out & mask_];
+	out_.store(out + 1, std::memory_order_release);
+	signal(spaceEvent_, writerWaiting_);
 	return result;
 }
 
 /// \brief Reads up to \a len bytes of data from this input stream into the given array.
-/// \details Reads up to \a len bytes of data from this input stream into the given array starting at \a offset.
+/// \details Reads into the given range of \p buffer through the span-based bulk read.
 /// \param[out] buffer The destination array.
 /// \param[in] offset The offset in the destination array where to start writing.
 /// \param[in] len The maximum number of bytes to read.
-/// \return The number of bytes read.
-/// \throw std::runtime_error If the end of the stream has been reached.
-/// \note This method is thread-safe as it locks the mutex before performing operations.
+/// \return The number of bytes read, or 0 if the writer closed the pipe and it is drained.
+/// \throw std::out_of_range If the offset and length exceed the buffer size.
+/// \throw std::runtime_error If the pipe has been closed by the reader.
+/// \note Only one thread may read from the pipe at a time.
 size_t PipedInputStream::read(std::vector<std::byte>& buffer, const size_t offset, const size_t len) {
-	std::lock_guard lock(mutex_);
-	size_t bytesRead{0};
-	while (bytesRead < len && out_ != in_) {
-		buffer_[offset + bytesRead] = buffer_[out_];
-		++bytesRead;
-		out_ = (out_ + 1) % buffer_.size();
+	if (offset + len > buffer.size()) {
+		throw std::out_of_range("Buffer overflow");
+	}
+	return read(std::span(buffer).subspan(offset, len));
+}
+
+/// \brief Reads up to \a buffer.size() bytes of data from this input stream into the given span.
+/// \details Blocks until at least one byte is available, then copies everything that is ready, up to the span size,
+/// with one memcpy per contiguous segment of the ring: one when the data does not wrap, two when it does.
+/// \param[out] buffer The destination range.
+/// \return The number of bytes read, or 0 if the writer closed the pipe and it is drained.
+/// \throw std::runtime_error If the pipe has been closed by the reader.
+/// \note Only one thread may read from the pipe at a time.
+auto PipedInputStream::read(const std::span<std::byte> buffer) -> size_t {
+	if (buffer.empty()) {
+		return 0;
 	}
-	return bytesRead;
+	const size_t out = out_.load(std::memory_order_relaxed);
+	const size_t count = std::min(awaitData(out) - out, buffer.size());
+	const size_t start = out & mask_;
+	const size_t first = std::min(count, buffer_.size() - start);
+	std::memcpy(buffer.data(), buffer_.data() + start, first);
+	if (count > first) {
+		std::memcpy(buffer.data() + first, buffer_.data(), count - first);
+	}
+	out_.store(out + count, std::memory_order_release);
+	signal(spaceEvent_, writerWaiting_);
+	return count;
+}
+
+/// \brief Skips over and discards up to \a n bytes of data from this input stream.
+/// \details Discards the bytes by advancing the read index, without copying them out of the ring. Blocks until at
+/// least one byte is available.
+/// \param n The number of bytes to skip.
+/// \return The number of bytes actually skipped, or 0 if the writer closed the pipe and it is drained.
+/// \throw std::runtime_error If the pipe has been closed by the reader.
+auto PipedInputStream::skip(const size_t n) -> size_t {
+	if (n == 0) {
+		return 0;
+	}
+	const size_t out = out_.load(std::memory_order_relaxed);
+	const size_t count = std::min(awaitData(out) - out, n);
+	out_.store(out + count, std::memory_order_release);
+	signal(spaceEvent_, writerWaiting_);
+	return count;
 }
 
 /// \brief Connects the piped input stream to the given piped output stream.
@@ -82,16 +124,116 @@ auto PipedInputStream::connect(std::shared_ptr<PipedOutputStream> src) -> void {
 }
 
 /// \brief Receives a single byte of data from the connected piped output stream.
-/// \details Receives a single byte of data from the connected piped output stream.
+/// \details Blocks while the pipe is full until the reader frees a slot.
 /// \param[in] b The byte of data to receive.
-/// \throw std::runtime_error If the piped input stream is not connected.
-/// \throw std::runtime_error If the piped input stream is already full.
+/// \throw std::runtime_error If the pipe has been closed.
+/// \note Only one thread may write to the pipe at a time.
 auto PipedInputStream::receive(const std::byte b) -> void {
-	std::lock_guard lock(mutex_);
-	if ((in_ + 1) % buffer_.size() == out_) {
-		throw std::runtime_error("PipedInputStream is overflow");
+	const size_t in = in_.load(std::memory_order_relaxed);
+	awaitSpace(in);
+	buffer_[in & mask_] = b;
+	in_.store(in + 1, std::memory_order_release);
+	signal(dataEvent_, readerWaiting_);
+}
+
+/// \brief Receives a block of data from the connected piped output stream.
+/// \details Forwards the given range of \p buffer to the span-based bulk receive.
+/// \param[in] buffer The source array.
+/// \param[in] offset The offset in the source array where to start reading.
+/// \param[in] len The number of bytes to receive.
+/// \throw std::out_of_range If the offset and length exceed the buffer size.
+/// \throw std::runtime_error If the pipe has been closed.
+/// \note Only one thread may write to the pipe at a time.
+auto PipedInputStream::receive(const std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> void {
+	if (offset + len > buffer.size()) {
+		throw std::out_of_range("Buffer overflow");
+	}
+	receive(std::span(buffer).subspan(offset, len));
+}
+
+/// \brief Receives a block of data from the connected piped output stream.
+/// \details Copies as much as fits into the free part of the ring with one memcpy per contiguous segment, publishes
+/// it to the reader and blocks for more space until the whole block has been transferred.
+/// \param[in] data The bytes to receive.
+/// \throw std::runtime_error If the pipe has been closed.
+/// \note Only one thread may write to the pipe at a time.
+auto PipedInputStream::receive(std::span<const std::byte> data) -> void {
+	while (!data.empty()) {
+		const size_t in = in_.load(std::memory_order_relaxed);
+		const size_t count = std::min(buffer_.size() - (in - awaitSpace(in)), data.size());
+		const size_t start = in & mask_;
+		const size_t first = std::min(count, buffer_.size() - start);
+		std::memcpy(buffer_.data() + start, data.data(), first);
+		if (count > first) {
+			std::memcpy(buffer_.data(), data.data() + first, count - first);
+		}
+		in_.store(in + count, std::memory_order_release);
+		signal(dataEvent_, readerWaiting_);
+		data = data.subspan(count);
+	}
+}
+
+/// \brief Notifies the pipe that the writer has closed its end.
+/// \details Bytes already in the pipe can still be read; once they are drained the reader sees the end of stream.
+auto PipedInputStream::receivedLast() -> void {
+	closedByWriter_.store(true);
+	dataEvent_.fetch_add(1);
+	dataEvent_.notify_all();
+}
+
+/// \brief Blocks until the pipe holds data beyond the given read index.
+/// \details The reader announces itself through readerWaiting_ before re-checking the write index, so a writer that
+/// publishes concurrently either is seen by the re-check or observes the flag and bumps the event.
+/// \param out The current read index.
+/// \return The current write index, equal to \p out only if the writer closed the pipe and it is drained.
+/// \throw std::runtime_error If the pipe has been closed by the reader.
+auto PipedInputStream::awaitData(const size_t out) -> size_t {
+	while (true) {
+		if (closedByReader_.load(std::memory_order_relaxed)) {
+			throw std::runtime_error("PipedInputStream is closed");
+		}
+		const uint32_t event = dataEvent_.load(std::memory_order_acquire);
+		readerWaiting_.store(true);
+		const size_t in = in_.load();
+		if (in != out || closedByWriter_.load()) {
+			readerWaiting_.store(false, std::memory_order_relaxed);
+			return in_.load(std::memory_order_acquire);
+		}
+		dataEvent_.wait(event, std::memory_order_acquire);
+		readerWaiting_.store(false, std::memory_order_relaxed);
+	}
+}
+
+/// \brief Blocks until the pipe has at least one free slot at the given write index.
+/// \param in The current write index.
+/// \return The current read index.
+/// \throw std::runtime_error If the pipe has been closed by either side.
+auto PipedInputStream::awaitSpace(const size_t in) -> size_t {
+	while (true) {
+		if (closedByReader_.load(std::memory_order_relaxed) || closedByWriter_.load(std::memory_order_relaxed)) {
+			throw std::runtime_error("PipedInputStream is closed");
+		}
+		const uint32_t event = spaceEvent_.load(std::memory_order_acquire);
+		writerWaiting_.store(true);
+		if (const size_t out = out_.load(); in - out < buffer_.size()) {
+			writerWaiting_.store(false, std::memory_order_relaxed);
+			return out_.load(std::memory_order_acquire);
+		}
+		spaceEvent_.wait(event, std::memory_order_acquire);
+		writerWaiting_.store(false, std::memory_order_relaxed);
+	}
+}
+
+/// \brief Wakes the other side of the pipe if it is parked.
+/// \details The fence pairs with the sequentially consistent flag store in awaitData/awaitSpace, so the common case
+/// of a peer that is not waiting costs a single load and no system call.
+/// \param event The event counter the peer waits on.
+/// \param waiting The flag the peer raises before waiting.
+auto PipedInputStream::signal(std::atomic<uint32_t>& event, const std::atomic<bool>& waiting) -> void {
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (waiting.load(std::memory_order_relaxed)) {
+		event.fetch_add(1, std::memory_order_release);
+		event.notify_one();
 	}
-	buffer_[in_] = b;
-	in_ = (in_ + 1) % buffer_.size();
 }
 }
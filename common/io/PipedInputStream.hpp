@@ -1,7 +1,10 @@
 // Created by author ethereal on 2024/12/14.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #pragma once
+#include <atomic>
 #include <mutex>
+#include <new>
+#include <span>
 #include <vector>
 #include "AbstractInputStream.hpp"
 #include "PipedOutputStream.hpp"
@@ -13,7 +16,11 @@ class PipedOutputStream;
 /// \brief A class that reads bytes from a stream with pipe.
 /// \details It reads bytes from a stream with pipe. The read and skip methods are supported.
 /// The available and markSupported methods are also supported.
-/// \remark The pipe size can be specified in the constructor.
+/// The pipe is a lock-free single-producer/single-consumer ring: one thread writes through the connected
+/// PipedOutputStream while another reads. A reader blocks while the pipe is empty and a writer blocks while it is
+/// full; both are woken through std::atomic::wait/notify, and a notification is only issued when the other side is
+/// actually parked.
+/// \remark The pipe size can be specified in the constructor and is rounded up to a power of two.
 class PipedInputStream final : public AbstractInputStream
 {
 public:
@@ -26,15 +33,30 @@ public:
 	[[nodiscard]] auto available() -> size_t override;
 	auto read() -> std::byte override;
 	auto read(std::vector<std::byte>& buffer, size_t offset, size_t len) -> size_t override;
+	auto read(std::span<std::byte> buffer) -> size_t;
+	auto skip(size_t n) -> size_t override;
 	auto connect(std::shared_ptr<PipedOutputStream> src) -> void;
 	auto receive(std::byte b) -> void;
+	auto receive(const std::vector<std::byte>& buffer, size_t offset, size_t len) -> void;
+	auto receive(std::span<const std::byte> data) -> void;
+	auto receivedLast() -> void;
 
 protected:
-	std::vector<std::byte> buffer_{};
-	size_t in_{0};
-	size_t out_{0};
 	static constexpr size_t PIPE_SIZE = 1024;
+	std::vector<std::byte> buffer_{};
+	size_t mask_{0};
+	alignas(std::hardware_destructive_interference_size) std::atomic<size_t> in_{0};
+	std::atomic<uint32_t> dataEvent_{0};
+	std::atomic<bool> readerWaiting_{false};
+	alignas(std::hardware_destructive_interference_size) std::atomic<size_t> out_{0};
+	std::atomic<uint32_t> spaceEvent_{0};
+	std::atomic<bool> writerWaiting_{false};
+	alignas(std::hardware_destructive_interference_size) std::atomic<bool> closedByReader_{false};
+	std::atomic<bool> closedByWriter_{false};
 	std::mutex mutex_;
 	std::shared_ptr<PipedOutputStream> src_;
+	auto awaitData(size_t out) -> size_t;
+	auto awaitSpace(size_t in) -> size_t;
+	static auto signal(std::atomic<uint32_t>& event, const std::atomic<bool>& waiting) -> void;
 };
 }
@@ -20,7 +20,8 @@ PipedOutputStream::~PipedOutputStream() {
 /// \brief Closes the piped output stream.
 /// \details If the stream is already closed, this method does nothing.
 /// Otherwise, it flushes the stream and sets the closed flag.
-/// If the stream is connected, it also closes the connected input stream.
+/// If the stream is connected, it signals the end of stream to the connected input stream, which can still drain
+/// the bytes already in the pipe.
 auto PipedOutputStream::close() -> void {
 	if (closed_) {
 		return;
@@ -29,7 +30,7 @@ auto PipedOutputStream::close() -> void {
 	connected_ = false;
 	closed_ = true;
 	if (snk_) {
-		snk_->close();
+		snk_->receivedLast();
 	}
 }
 
@@ -56,7 +57,8 @@ auto PipedOutputStream::write(const std::byte b) -> void {
 
 /// \brief Writes a portion of a byte array to the piped output stream.
 /// \details If the stream is not connected or if the stream is closed, the method throws an exception.
-/// Otherwise, it writes the specified portion of the byte array to the connected input stream.
+/// Otherwise, it writes the specified portion of the byte array to the connected input stream in bulk, blocking
+/// while the pipe is full.
 void PipedOutputStream::write(const std::vector<std::byte>& buffer, const size_t offset, const size_t len) {
 	if (closed_ || !connected_ || !snk_) {
 		throw std::runtime_error("PipedOutputStream is not connected");
@@ -64,8 +66,6 @@ void PipedOutputStream::write(const std::vector<std::byte>& buffer, const size_t
 	if (offset + len > buffer.size()) {
 		throw std::out_of_range("Buffer overflow");
 	}
-	for (size_t i = 0; i < len; ++i) {
-		snk_->receive(buffer[offset + i]);
-	}
+	snk_->receive(buffer, offset, len);
 }
 }
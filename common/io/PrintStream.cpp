@@ -1,243 +1,348 @@
 // Created by author ethereal on 2024/12/15.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #include "PrintStream.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 
 namespace common::io
 {
-PrintStream::PrintStream(std::shared_ptr<AbstractOutputStream> outStream, const bool autoFlush, const std::locale& loc): FilterOutputStream(std::move(outStream)), autoFlush_(autoFlush), locale_(loc) {}
+/// \brief An output iterator that appends characters to the buffer of a PrintStream.
+/// \details Lets std::vformat_to write formatted output straight into the stream buffer.
+class PrintStream::Inserter
+{
+public:
+	using difference_type = std::ptrdiff_t;
+
+	explicit Inserter(PrintStream& stream): stream_(&stream) {}
 
-PrintStream::~PrintStream() = default;
+	auto operator*() -> Inserter& {
+		return *this;
+	}
+
+	auto operator++() -> Inserter& {
+		return *this;
+	}
+
+	auto operator++(int) -> Inserter {
+		return *this;
+	}
+
+	auto operator=(const char c) -> Inserter& {
+		stream_->put(c);
+		return *this;
+	}
+
+private:
+	PrintStream* stream_;
+};
+
+PrintStream::PrintStream(std::shared_ptr<AbstractOutputStream> outStream, const bool autoFlush, const std::locale& loc): PrintStream(std::move(outStream), autoFlush, DEFAULT_BUFFER_SIZE, loc) {}
+
+PrintStream::PrintStream(std::shared_ptr<AbstractOutputStream> outStream, const bool autoFlush, const size_t bufferSize, const std::locale& loc): FilterOutputStream(std::move(outStream)), autoFlush_(autoFlush), locale_(loc), buffer_(std::max(bufferSize, MIN_BUFFER_SIZE)) {}
+
+PrintStream::~PrintStream() {
+	try {
+		drainBuffer();
+	}
+	catch (...) {
+		// Suppress exceptions in destructors
+	}
+}
+
+/// \brief Writes a single byte to the stream.
+/// \details The byte goes through the internal buffer so that it stays ordered with printed text.
+/// \param b The byte to write.
+auto PrintStream::write(const std::byte b) -> void {
+	put(static_cast<char>(b));
+}
+
+/// \brief Writes a portion of a byte array to the stream.
+/// \details The bytes go through the internal buffer so that they stay ordered with printed text.
+/// \param buffer The buffer containing the data to write.
+/// \param offset The offset in the buffer at which to start writing.
+/// \param len The number of bytes to write.
+/// \throw std::out_of_range If the offset and length exceed the buffer size.
+auto PrintStream::write(const std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> void {
+	if (offset + len > buffer.size()) {
+		throw std::out_of_range("Buffer overflow");
+	}
+	put(reinterpret_cast<const char*>(buffer.data()) + offset, len);
+}
 
 /// \brief Appends a character to the stream.
 /// \details Writes the character to the stream and flushes if needed.
 /// \param c The character to append.
-auto PrintStream::append(char c) -> PrintStream& {
-	write(static_cast<std::byte>(c));
-	flushIfNeeded();
+auto PrintStream::append(const char c) -> PrintStream& {
+	put(c);
+	flushIfNeeded(c == '\n');
 	return *this;
 }
 
 /// \brief Appends a string to the stream.
-/// \details Writes the string to the stream and flushes if needed.
+/// \details Copies the string into the internal buffer and flushes if needed.
 /// \param str The string to append.
 auto PrintStream::append(const std::string& str) -> PrintStream& {
-	for (char c : str) {
-		write(static_cast<std::byte>(c));
-	}
-	flushIfNeeded();
+	print(str);
 	return *this;
 }
 
 /// \brief Appends a substring to the stream.
-/// \details Writes the substring to the stream and flushes if needed.
+/// \details Copies the substring into the internal buffer and flushes if needed.
 /// \param str The string to append.
 /// \param start The start of the substring.
 /// \param end The end of the substring.
-auto PrintStream::append(const std::string& str, size_t start, size_t end) -> PrintStream& {
-	for (size_t i = start; i < end; i++) {
-		write(static_cast<std::byte>(str[i]));
+/// \throw std::out_of_range If the range exceeds the string.
+auto PrintStream::append(const std::string& str, const size_t start, const size_t end) -> PrintStream& {
+	if (start > end || end > str.size()) {
+		throw std::out_of_range("Invalid substring range");
 	}
-	flushIfNeeded();
+	put(str.data() + start, end - start);
+	flushIfNeeded(std::memchr(str.data() + start, '\n', end - start) != nullptr);
 	return *this;
 }
 
 /// \brief Prints a boolean value to the stream.
 /// \details Writes the boolean value to the stream and flushes if needed.
 /// \param b The boolean value to print.
-auto PrintStream::print(const bool b) const -> void {
-	if (outputStream_) {
-		outputStream_->write(static_cast<std::byte>(b ? 1 : 0));
-	}
-	flushIfNeeded();
+auto PrintStream::print(const bool b) -> void {
+	put(static_cast<char>(b ? 1 : 0));
+	flushIfNeeded(false);
 }
 
 /// \brief Prints a character to the stream.
 /// \details Writes the character to the stream and flushes if needed.
 /// \param c The character to print.
-auto PrintStream::print(char c) const -> void {
-	if (outputStream_) {
-		outputStream_->write(static_cast<std::byte>(c));
-		flushIfNeeded();
-	}
+auto PrintStream::print(const char c) -> void {
+	put(c);
+	flushIfNeeded(c == '\n');
 }
 
 /// \brief Prints an integer value to the stream.
-/// \details Writes the integer value to the stream and flushes if needed.
+/// \details Formats the value with std::to_chars directly into the internal buffer.
 /// \param i The integer value to print.
-auto PrintStream::print(const int i) const -> void {
-	if (outputStream_) {
-		for (const auto buffer = std::to_string(i); char c : buffer) {
-			outputStream_->write(static_cast<std::byte>(c));
-		}
-		flushIfNeeded();
-	}
+auto PrintStream::print(const int i) -> void {
+	putNumber(i);
+	flushIfNeeded(false);
 }
 
 /// \brief Prints a long value to the stream.
-/// \details Writes the long value to the stream and flushes if needed.
+/// \details Formats the value with std::to_chars directly into the internal buffer.
 /// \param l The long value to print.
-auto PrintStream::print(const long l) const -> void {
-	if (outputStream_) {
-		for (const auto buffer = std::to_string(l); char c : buffer) {
-			outputStream_->write(static_cast<std::byte>(c));
-		}
-		flushIfNeeded();
-	}
+auto PrintStream::print(const long l) -> void {
+	putNumber(l);
+	flushIfNeeded(false);
 }
 
 /// \brief Prints a float value to the stream.
-/// \details Writes the float value to the stream and flushes if needed.
+/// \details Formats the value with std::to_chars in its shortest round-trip form directly into the internal buffer.
 /// \param f The float value to print.
-auto PrintStream::print(const float f) const -> void {
-	if (outputStream_) {
-		for (const auto buffer = std::to_string(f); char c : buffer) {
-			outputStream_->write(static_cast<std::byte>(c));
-		}
-		flushIfNeeded();
-	}
+auto PrintStream::print(const float f) -> void {
+	putNumber(f);
+	flushIfNeeded(false);
 }
 
 /// \brief Prints a double value to the stream.
-/// \details Writes the double value to the stream and flushes if needed.
+/// \details Formats the value with std::to_chars in its shortest round-trip form directly into the internal buffer.
 /// \param d The double value to print.
-auto PrintStream::print(const double d) const -> void {
-	if (outputStream_) {
-		for (const auto buffer = std::to_string(d); char c : buffer) {
-			outputStream_->write(static_cast<std::byte>(c));
-		}
-		flushIfNeeded();
-	}
+auto PrintStream::print(const double d) -> void {
+	putNumber(d);
+	flushIfNeeded(false);
 }
 
 /// \brief Prints a string to the stream.
 /// \details Writes the string to the stream and flushes if needed.
 /// \param s The string to print.
-auto PrintStream::print(const char* s) const -> void {
-	if (outputStream_ && s) {
-		while (*s) {
-			outputStream_->write(static_cast<std::byte>(*s++));
-		}
-		flushIfNeeded();
+auto PrintStream::print(const char* s) -> void {
+	if (s) {
+		const size_t len = std::strlen(s);
+		put(s, len);
+		flushIfNeeded(std::memchr(s, '\n', len) != nullptr);
 	}
 }
 
 /// \brief Prints a string to the stream.
 /// \details Writes the string to the stream and flushes if needed.
 /// \param s The string to print.
-auto PrintStream::print(const std::string& s) const -> void {
-	if (outputStream_) {
-		for (char c : s) {
-			outputStream_->write(static_cast<std::byte>(c));
-		}
-		flushIfNeeded();
-	}
+auto PrintStream::print(const std::string& s) -> void {
+	put(s.data(), s.size());
+	flushIfNeeded(s.find('\n') != std::string::npos);
 }
 
 /// \brief Prints a vector of characters to the stream.
 /// \details Writes the vector of characters to the stream and flushes if needed.
 /// \param v The vector of characters to print.
-auto PrintStream::print(const std::vector<char>& v) const -> void {
-	if (outputStream_) {
-		for (char c : v) {
-			outputStream_->write(static_cast<std::byte>(c));
-		}
-		flushIfNeeded();
-	}
+auto PrintStream::print(const std::vector<char>& v) -> void {
+	put(v.data(), v.size());
+	flushIfNeeded(std::ranges::find(v, '\n') != v.end());
 }
 
 /// \brief Prints a boolean value to the stream.
 /// \details Writes the boolean value to the stream and flushes if needed.
 /// \param b The boolean value to print.
-void PrintStream::println(const bool b) const {
+void PrintStream::println(const bool b) {
 	print(b);
-	print('\n');
+	put('\n');
+	flushIfNeeded(true);
 }
 
 /// \brief Prints a character to the stream.
 /// \details Writes the character to the stream and flushes if needed.
 /// \param c The character to print.
-void PrintStream::println(const char c) const {
+void PrintStream::println(const char c) {
 	print(c);
-	print('\n');
+	put('\n');
+	flushIfNeeded(true);
 }
 
 /// \brief Prints an integer value to the stream.
 /// \details Writes the integer value to the stream and flushes if needed.
 /// \param i The integer value to print.
-void PrintStream::println(const int i) const {
+void PrintStream::println(const int i) {
 	print(i);
-	print('\n');
+	put('\n');
+	flushIfNeeded(true);
 }
 
 /// \brief Prints a long value to the stream.
 /// \details Writes the long value to the stream and flushes if needed.
 /// \param l The long value to print.
-void PrintStream::println(long l) const {
+void PrintStream::println(long l) {
 	print(l);
-	print('\n');
+	put('\n');
+	flushIfNeeded(true);
 }
 
 /// \brief Prints a float value followed by a newline to the stream.
 /// \details Writes the float value to the stream, appends a newline character, and flushes if needed.
 /// \param f The float value to print.
-void PrintStream::println(float f) const {
+void PrintStream::println(float f) {
 	print(f);
-	print('\n');
+	put('\n');
+	flushIfNeeded(true);
 }
 
 /// \brief Prints a double value followed by a newline to the stream.
 /// \details Writes the double value to the stream, appends a newline character, and flushes if needed.
 /// \param d The double value to print.
-void PrintStream::println(double d) const {
+void PrintStream::println(double d) {
 	print(d);
-	print('\n');
+	put('\n');
+	flushIfNeeded(true);
 }
 
 /// \brief Prints a string followed by a newline to the stream.
 /// \details Writes the string to the stream, appends a newline character, and flushes if needed.
 /// \param s The string to print.
-void PrintStream::println(const char* s) const {
+void PrintStream::println(const char* s) {
 	print(s);
-	print('\n');
+	put('\n');
+	flushIfNeeded(true);
 }
 
 /// \brief Prints a string followed by a newline to the stream.
 /// \details Writes the string to the stream, appends a newline character, and flushes if needed.
 /// \param s The string to print.
-void PrintStream::println(const std::string& s) const {
+void PrintStream::println(const std::string& s) {
 	print(s);
-	print('\n');
+	put('\n');
+	flushIfNeeded(true);
 }
 
 /// \brief Prints a vector of characters followed by a newline to the stream.
 /// \details Writes the vector of characters to the stream, appends a newline character, and flushes if needed.
 /// \param v The vector of characters to print.
-void PrintStream::println(const std::vector<char>& v) const {
+void PrintStream::println(const std::vector<char>& v) {
 	print(v);
-	print('\n');
+	put('\n');
+	flushIfNeeded(true);
+}
+
+/// \brief Prints formatted output to the stream.
+/// \details Formats the arguments with std::vformat_to directly into the internal buffer and flushes if needed.
+/// \param fmt The std::format format string.
+/// \param args The type-erased arguments to format.
+/// \return A reference to this stream.
+auto PrintStream::vprintf(const std::string_view fmt, const std::format_args args) -> PrintStream& {
+	std::vformat_to(Inserter(*this), fmt, args);
+	flushIfNeeded(true);
+	return *this;
 }
 
 /// \brief Flushes the stream.
-/// \details Flushes the internal buffer of the output stream.
+/// \details Writes out the internal buffer and flushes the underlying output stream.
 auto PrintStream::flush() -> void {
+	drainBuffer();
 	if (outputStream_) {
 		outputStream_->flush();
 	}
 }
 
 /// \brief Closes the stream and its underlying stream.
-/// \details Closes the stream by closing the underlying output stream.
+/// \details Writes out the internal buffer and closes the underlying output stream.
 auto PrintStream::close() -> void {
+	drainBuffer();
 	if (outputStream_) {
 		outputStream_->close();
 	}
 }
 
-/// \brief Flushes the stream if autoFlush is enabled.
-/// \details Flushes the internal buffer of the output stream if autoFlush is enabled.
-auto PrintStream::flushIfNeeded() const -> void {
-	if (autoFlush_ && outputStream_) {
-		outputStream_->flush();
+/// \brief Flushes the stream if autoFlush is enabled and a line has been completed.
+/// \param newline Whether the printed data contained a newline or the call always terminates a line.
+auto PrintStream::flushIfNeeded(const bool newline) -> void {
+	if (autoFlush_ && newline) {
+		flush();
+	}
+}
+
+/// \brief Writes the buffered bytes to the underlying output stream.
+/// \details Without an underlying stream the buffered bytes are discarded.
+auto PrintStream::drainBuffer() -> void {
+	if (count_ > 0 && outputStream_) {
+		outputStream_->write(buffer_, 0, count_);
+	}
+	count_ = 0;
+}
+
+/// \brief Adds a single character to the internal buffer, writing the buffer out when it is full.
+/// \param c The character to add.
+auto PrintStream::put(const char c) -> void {
+	if (count_ == buffer_.size()) {
+		drainBuffer();
+	}
+	buffer_[count_++] = static_cast<std::byte>(c);
+}
+
+/// \brief Adds a block of characters to the internal buffer, writing the buffer out whenever it fills up.
+/// \param data The characters to add.
+/// \param len The number of characters to add.
+auto PrintStream::put(const char* data, size_t len) -> void {
+	while (len > 0) {
+		if (count_ == buffer_.size()) {
+			drainBuffer();
+		}
+		const size_t chunk = std::min(len, buffer_.size() - count_);
+		std::memcpy(buffer_.data() + count_, data, chunk);
+		count_ += chunk;
+		data += chunk;
+		len -= chunk;
+	}
+}
+
+/// \brief Formats a number with std::to_chars directly into the internal buffer.
+/// \details The buffer is written out first if fewer than MIN_BUFFER_SIZE bytes are free, which is enough for the
+/// longest representation of any supported arithmetic type.
+/// \tparam T The arithmetic type of the value.
+/// \param value The value to format.
+template <typename T> auto PrintStream::putNumber(const T value) -> void {
+	if (buffer_.size() - count_ < MIN_BUFFER_SIZE) {
+		drainBuffer();
+	}
+	char* first = reinterpret_cast<char*>(buffer_.data()) + count_;
+	const auto [ptr, ec] = std::to_chars(first, first + (buffer_.size() - count_), value);
+	if (ec != std::errc()) {
+		throw std::runtime_error("Failed to format number");
 	}
+	count_ += static_cast<size_t>(ptr - first);
 }
 }
@@ -1,6 +1,8 @@
 // Created by author ethereal on 2024/12/15.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #pragma once
+#include <format>
+#include <string_view>
 #include "File.hpp"
 #include "FilterOutputStream.hpp"
 #include "interface/IfaceAppendable.hpp"
@@ -12,39 +14,70 @@ namespace common::io
 /// It is a concrete implementation of the FilterOutputStream and IfaceAppendable interfaces.
 /// It supports printing of various types of data, including boolean, character, integer, long, float, double,
 /// string, and vector of characters. It also supports flushing and closing the stream.
+/// Output is collected in an internal buffer and handed to the underlying stream in blocks. Numbers are formatted
+/// with std::to_chars and printf() formats with std::format_to, both directly into that buffer, so printing does not
+/// create temporary strings or issue one virtual call per character.
+/// With autoFlush enabled the buffer is written out and the underlying stream flushed by println(), printf() and
+/// whenever a newline character is printed or appended.
 class PrintStream final : public FilterOutputStream, public interface::IfaceAppendable<PrintStream>
 {
 public:
 	explicit PrintStream(std::shared_ptr<AbstractOutputStream> outStream, bool autoFlush = true, const std::locale& loc = std::locale());
+	PrintStream(std::shared_ptr<AbstractOutputStream> outStream, bool autoFlush, size_t bufferSize, const std::locale& loc = std::locale());
 	~PrintStream() override;
+	auto write(std::byte b) -> void override;
+	auto write(const std::vector<std::byte>& buffer, size_t offset, size_t len) -> void override;
 	auto append(char c) -> PrintStream& override;
 	auto append(const std::string& str) -> PrintStream& override;
 	auto append(const std::string& str, size_t start, size_t end) -> PrintStream& override;
 	auto flush() -> void override;
 	auto close() -> void override;
-	void print(bool b) const;
-	void print(char c) const;
-	void print(int i) const;
-	void print(long l) const;
-	void print(float f) const;
-	void print(double d) const;
-	void print(const char* s) const;
-	void print(const std::string& s) const;
-	void print(const std::vector<char>& v) const;
-	void println(bool b) const;
-	void println(char c) const;
-	void println(int i) const;
-	void println(long l) const;
-	void println(float f) const;
-	void println(double d) const;
-	void println(const char* s) const;
-	void println(const std::string& s) const;
-	void println(const std::vector<char>& v) const;
+	void print(bool b);
+	void print(char c);
+	void print(int i);
+	void print(long l);
+	void print(float f);
+	void print(double d);
+	void print(const char* s);
+	void print(const std::string& s);
+	void print(const std::vector<char>& v);
+	void println(bool b);
+	void println(char c);
+	void println(int i);
+	void println(long l);
+	void println(float f);
+	void println(double d);
+	void println(const char* s);
+	void println(const std::string& s);
+	void println(const std::vector<char>& v);
+	template <typename... Args> auto printf(std::format_string<Args...> fmt, Args&&... args) -> PrintStream&;
+	auto vprintf(std::string_view fmt, std::format_args args) -> PrintStream&;
 
 protected:
-	void flushIfNeeded() const;
+	static constexpr size_t DEFAULT_BUFFER_SIZE = 8192;
+	static constexpr size_t MIN_BUFFER_SIZE = 64;
+	void flushIfNeeded(bool newline);
+	void drainBuffer();
+	void put(char c);
+	void put(const char* data, size_t len);
+	template <typename T> void putNumber(T value);
 	bool autoFlush_{false};
 	bool errorState_{false};
 	std::locale locale_;
+	std::vector<std::byte> buffer_;
+	size_t count_{0};
+
+private:
+	class Inserter;
 };
+
+/// \brief Prints formatted output to the stream.
+/// \details The format string is checked at compile time and the arguments are formatted straight into the internal
+/// buffer; no intermediate std::string is built.
+/// \param fmt The std::format format string.
+/// \param args The arguments to format.
+/// \return A reference to this stream.
+template <typename... Args> auto PrintStream::printf(std::format_string<Args...> fmt, Args&&... args) -> PrintStream& {
+	return vprintf(fmt.get(), std::make_format_args(args...));
+}
 }
@@ -0,0 +1,209 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "RandomAccessInputStream.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+#include "FileDescriptorOutputStream.hpp"
+#include "FileTransfer.hpp"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace common::io
+{
+/// \brief Opens a file for reading.
+/// \param file The file to read.
+/// \throws std::ios_base::failure If the file does not exist, is a directory or cannot be opened.
+RandomAccessInputStream::RandomAccessInputStream(const std::filesystem::path& file): fileName_(file.string()) {
+	if (!std::filesystem::exists(file)) {
+		throw std::ios_base::failure("FileNotFoundException: File does not exist.");
+	}
+	if (std::filesystem::is_directory(file)) {
+		throw std::ios_base::failure("FileNotFoundException: Path is a directory.");
+	}
+#ifdef _WIN32
+	const HANDLE handle = CreateFileW(file.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (handle == INVALID_HANDLE_VALUE) {
+		throw std::ios_base::failure("FileNotFoundException: Unable to open file.");
+	}
+	handle_ = handle;
+#else
+	fd_ = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd_ < 0) {
+		throw std::ios_base::failure("FileNotFoundException: Unable to open file.");
+	}
+#endif
+}
+
+RandomAccessInputStream::~RandomAccessInputStream() {
+	try {
+		close();
+	}
+	catch (...) {
+		// Suppress exceptions in destructors
+	}
+}
+
+/// \brief Reads up to len bytes at the read position and advances it.
+/// \param buffer The buffer into which the data is read.
+/// \param offset The starting offset in the buffer.
+/// \param len The maximum number of bytes to read.
+/// \return The number of bytes read, or 0 at the end of the file.
+/// \throws std::invalid_argument If the offset and length exceed the buffer.
+/// \throws std::ios_base::failure If the stream is closed or the read fails.
+auto RandomAccessInputStream::read(std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> size_t {
+	if (offset > buffer.size() || len > buffer.size() - offset) {
+		throw std::invalid_argument("Invalid buffer, offset, or length.");
+	}
+	const size_t bytesRead = readAt(position_, std::span(buffer.data() + offset, len));
+	position_ += bytesRead;
+	return bytesRead;
+}
+
+/// \brief Returns the number of bytes between the read position and the end of the file.
+/// \return The number of available bytes.
+auto RandomAccessInputStream::available() -> size_t {
+	const uint64_t end = size();
+	return end > position_ ? static_cast<size_t>(end - position_) : 0;
+}
+
+/// \brief Closes the file.
+auto RandomAccessInputStream::close() -> void {
+#ifdef _WIN32
+	if (handle_ != nullptr) {
+		CloseHandle(handle_);
+		handle_ = nullptr;
+	}
+#else
+	if (fd_ >= 0) {
+		::close(fd_);
+		fd_ = -1;
+	}
+#endif
+}
+
+/// \brief Returns the offset of the next byte read() returns.
+/// \return The read position.
+auto RandomAccessInputStream::position() const -> uint64_t {
+	return position_;
+}
+
+/// \brief Moves the read position.
+/// \details The position may be set past the end of the file, in which case reads return end of stream.
+/// \param position The new offset from the start of the file.
+/// \throws std::ios_base::failure If the stream is closed.
+auto RandomAccessInputStream::seek(const uint64_t position) -> void {
+	checkOpen();
+	position_ = position;
+}
+
+/// \brief Reads bytes at an offset without moving the read position.
+/// \details Short reads are retried, so the buffer is filled unless the file ends first. The call takes no lock and
+/// may run concurrently with other readAt() calls and with the sequential reads.
+/// \param offset The offset of the first byte to read.
+/// \param buffer Receives the bytes.
+/// \return The number of bytes read, less than the buffer size only at the end of the file.
+/// \throws std::ios_base::failure If the stream is closed or the read fails.
+auto RandomAccessInputStream::readAt(const uint64_t offset, const std::span<std::byte> buffer) -> size_t {
+	checkOpen();
+	size_t total = 0;
+	while (total < buffer.size()) {
+		const uint64_t at = offset + total;
+#ifdef _WIN32
+		OVERLAPPED overlapped{};
+		overlapped.Offset = static_cast<DWORD>(at);
+		overlapped.OffsetHigh = static_cast<DWORD>(at >> 32);
+		const auto chunk = static_cast<DWORD>(std::min<size_t>(buffer.size() - total, MAXDWORD));
+		DWORD bytesRead = 0;
+		if (!ReadFile(handle_, buffer.data() + total, chunk, &bytesRead, &overlapped)) {
+			if (GetLastError() == ERROR_HANDLE_EOF) {
+				break;
+			}
+			throw std::ios_base::failure("Read failed: " + fileName_, std::error_code(static_cast<int>(GetLastError()), std::system_category()));
+		}
+#else
+		const ssize_t bytesRead = ::pread(fd_, buffer.data() + total, buffer.size() - total, static_cast<off_t>(at));
+		if (bytesRead < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			throw std::ios_base::failure("Read failed: " + fileName_, std::error_code(errno, std::system_category()));
+		}
+#endif
+		if (bytesRead == 0) {
+			break;
+		}
+		total += static_cast<size_t>(bytesRead);
+	}
+	return total;
+}
+
+/// \brief Returns the current length of the file.
+/// \return The file size in bytes.
+/// \throws std::ios_base::failure If the stream is closed or the size cannot be queried.
+auto RandomAccessInputStream::size() const -> uint64_t {
+	checkOpen();
+#ifdef _WIN32
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(handle_, &size)) {
+		throw std::ios_base::failure("Cannot query file size: " + fileName_);
+	}
+	return static_cast<uint64_t>(size.QuadPart);
+#else
+	struct stat status{};
+	if (::fstat(fd_, &status) != 0) {
+		throw std::ios_base::failure("Cannot query file size: " + fileName_, std::error_code(errno, std::system_category()));
+	}
+	return static_cast<uint64_t>(status.st_size);
+#endif
+}
+
+/// \brief Copies the file from the read position to its end into an output stream.
+/// \details When the output is a FileDescriptorOutputStream the kernel copies the bytes with FileTransfer; otherwise,
+/// or for whatever the kernel cannot copy, the bytes go through a buffer. The read position ends at the end of file.
+/// \param out The stream receiving the bytes.
+/// \return The number of bytes transferred.
+/// \throws std::ios_base::failure If the stream is closed or a read or write fails.
+auto RandomAccessInputStream::transferTo(AbstractOutputStream& out) -> uint64_t {
+	checkOpen();
+	uint64_t transferred = 0;
+#ifndef _WIN32
+	if (const auto* target = dynamic_cast<FileDescriptorOutputStream*>(&out); target != nullptr && target->descriptor() >= 0) {
+		auto offset = static_cast<int64_t>(position_);
+		FileTransfer::Result result{};
+		try {
+			result = FileTransfer::copy(fd_, &offset, target->descriptor());
+		}
+		catch (...) {
+			position_ = static_cast<uint64_t>(offset);
+			throw;
+		}
+		position_ = static_cast<uint64_t>(offset);
+		if (result.complete) {
+			return result.bytes;
+		}
+		transferred = result.bytes;
+	}
+#endif
+	return transferred + SeekableInputStream::transferTo(out);
+}
+
+/// \brief Throws if the file is closed.
+/// \throws std::ios_base::failure If the stream is closed.
+auto RandomAccessInputStream::checkOpen() const -> void {
+#ifdef _WIN32
+	const bool open = handle_ != nullptr;
+#else
+	const bool open = fd_ >= 0;
+#endif
+	if (!open) {
+		throw std::ios_base::failure("Stream closed");
+	}
+}
+}
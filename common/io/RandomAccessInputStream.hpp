@@ -0,0 +1,44 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "SeekableInputStream.hpp"
+
+namespace common::io
+{
+/// \brief Reads bytes from a file with positional reads.
+/// \details Every read names its file offset (pread on POSIX, ReadFile with an OVERLAPPED offset on Windows), so the
+/// file handle carries no shared position. readAt() therefore needs no lock and any number of threads may read the
+/// same stream at once; the sequential read position is kept by the stream itself.
+/// transferTo() a FileDescriptorOutputStream copies inside the kernel on Linux.
+/// \remark read() of a single byte costs one system call; wrap the stream in a BufferedInputStream for byte-wise use.
+class RandomAccessInputStream final : public SeekableInputStream
+{
+public:
+	explicit RandomAccessInputStream(const std::filesystem::path& file);
+	~RandomAccessInputStream() override;
+	RandomAccessInputStream(const RandomAccessInputStream&) = delete;
+	auto operator=(const RandomAccessInputStream&) -> RandomAccessInputStream& = delete;
+	using SeekableInputStream::read;
+	auto read(std::vector<std::byte>& buffer, size_t offset, size_t len) -> size_t override;
+	auto available() -> size_t override;
+	auto close() -> void override;
+	[[nodiscard]] auto position() const -> uint64_t override;
+	auto seek(uint64_t position) -> void override;
+	auto readAt(uint64_t offset, std::span<std::byte> buffer) -> size_t override;
+	[[nodiscard]] auto size() const -> uint64_t override;
+	auto transferTo(AbstractOutputStream& out) -> uint64_t override;
+
+private:
+	auto checkOpen() const -> void;
+#ifdef _WIN32
+	void* handle_{nullptr};
+#else
+	int fd_{-1};
+#endif
+	uint64_t position_{0};
+	std::string fileName_;
+};
+}
@@ -0,0 +1,277 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "RecordInputStream.hpp"
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <future>
+#include "Crc32c.hpp"
+#include "LittleEndian.hpp"
+#include "RecordOutputStream.hpp"
+#include "Varint.hpp"
+
+namespace common::io
+{
+/// \brief Opens a record file and loads its index.
+/// \param path The file to read.
+/// \throws std::ios_base::failure If the file cannot be opened, is not a complete record file or its index is corrupt.
+RecordInputStream::RecordInputStream(std::filesystem::path path): path_(std::move(path)), in_(path_, std::ios::binary) {
+	if (!in_) {
+		throw std::ios_base::failure("Cannot open record file: " + path_.string());
+	}
+	loadIndex();
+}
+
+/// \brief Reads the next record.
+/// \param record Receives the bytes of the record; its capacity is reused.
+/// \return false at the end of the stream.
+/// \throws std::ios_base::failure If a block is corrupt.
+auto RecordInputStream::read(std::vector<std::byte>& record) -> bool {
+	if (position_ >= count_) {
+		return false;
+	}
+	if (!blockLoaded_ || block_.consumed == block_.count) {
+		load(blockLoaded_ ? blockNumber_ + 1 : 0);
+	}
+	const auto bytes = nextRecord(block_);
+	record.assign(bytes.begin(), bytes.end());
+	++position_;
+	return true;
+}
+
+/// \brief Moves to a record, so that the next read() returns it.
+/// \details The block holding the record is found with a binary search over the index; only that block is read,
+/// and only the records before the target within it are skipped.
+/// \param number The number of the record, counting from 0; count() moves to the end.
+/// \throws std::out_of_range If the number is beyond the end.
+/// \throws std::ios_base::failure If the block is corrupt.
+auto RecordInputStream::seek(const uint64_t number) -> void {
+	if (number > count_) {
+		throw std::out_of_range("Record number out of range");
+	}
+	position_ = number;
+	if (number == count_) {
+		return;
+	}
+	const auto it = std::ranges::upper_bound(index_, number, {}, &IndexEntry::firstRecord);
+	const auto block = static_cast<size_t>(it - index_.begin()) - 1;
+	if (!blockLoaded_ || blockNumber_ != block) {
+		load(block);
+	}
+	else if (block_.consumed > number - block_.firstRecord) {
+		block_.consumed = 0;
+		block_.next = 0;
+	}
+	while (block_.consumed < number - block_.firstRecord) {
+		static_cast<void>(nextRecord(block_));
+	}
+}
+
+/// \brief Returns the number of the record the next read() returns.
+/// \return The current record number.
+auto RecordInputStream::position() const -> uint64_t {
+	return position_;
+}
+
+/// \brief Returns the number of records in the file.
+/// \return The record count.
+auto RecordInputStream::count() const -> uint64_t {
+	return count_;
+}
+
+/// \brief Returns the number of blocks in the file.
+/// \return The block count.
+auto RecordInputStream::blocks() const -> size_t {
+	return index_.size();
+}
+
+/// \brief Decodes every record on a thread pool.
+/// \details The blocks are split into contiguous ranges, one task per range. Each task opens the file on its own and
+/// reports its records in order, but tasks run concurrently, so the visitor must be thread-safe and sees records of
+/// different ranges interleaved. When the pool queue is full a range is decoded on the calling thread. The call
+/// returns when every range is done, and the read position of this stream is not affected.
+/// \param pool The pool running the tasks.
+/// \param visitor The callback receiving each record and its number; the bytes are only valid during the call.
+/// \param partitions The number of ranges; 0 chooses twice the hardware concurrency.
+/// \throws std::ios_base::failure If a block is corrupt; the first error is rethrown once all tasks have finished.
+/// \throws Any exception thrown by the visitor, likewise.
+auto RecordInputStream::forEach(thread::ThreadPool& pool, const Visitor& visitor, size_t partitions) const -> void {
+	if (index_.empty()) {
+		return;
+	}
+	if (partitions == 0) {
+		partitions = 2 * std::max(1U, std::thread::hardware_concurrency());
+	}
+	partitions = std::min(partitions, index_.size());
+	const auto decode = [this, &visitor](const size_t first, const size_t last) {
+		std::ifstream in(path_, std::ios::binary);
+		if (!in) {
+			throw std::ios_base::failure("Cannot open record file: " + path_.string());
+		}
+		Block block;
+		for (size_t i = first; i < last; ++i) {
+			readBlock(in, i, block);
+			for (uint64_t record = 0; record < block.count; ++record) {
+				visitor(block.firstRecord + record, nextRecord(block));
+			}
+		}
+	};
+	std::vector<std::future<void>> futures;
+	std::exception_ptr error;
+	for (size_t partition = 0; partition < partitions; ++partition) {
+		const size_t first = index_.size() * partition / partitions;
+		const size_t last = index_.size() * (partition + 1) / partitions;
+		try {
+			futures.push_back(pool.Submit(decode, first, last));
+		}
+		catch (const std::runtime_error&) {
+			try {
+				decode(first, last);
+			}
+			catch (...) {
+				if (!error) {
+					error = std::current_exception();
+				}
+			}
+		}
+	}
+	for (auto& future : futures) {
+		try {
+			future.get();
+		}
+		catch (...) {
+			if (!error) {
+				error = std::current_exception();
+			}
+		}
+	}
+	if (error) {
+		std::rethrow_exception(error);
+	}
+}
+
+/// \brief Closes the file.
+auto RecordInputStream::close() -> void {
+	in_.close();
+	blockLoaded_ = false;
+	block_.payload.clear();
+}
+
+/// \brief Reads and verifies the trailer and the index.
+/// \throws std::ios_base::failure If the trailer or the index is missing or corrupt.
+auto RecordInputStream::loadIndex() -> void {
+	in_.seekg(0, std::ios::end);
+	const auto size = static_cast<uint64_t>(in_.tellg());
+	constexpr uint64_t headerSize = sizeof(RecordOutputStream::MAGIC);
+	if (size < headerSize + RecordOutputStream::TRAILER_SIZE) {
+		throw std::ios_base::failure("Not a record file: " + path_.string());
+	}
+	std::byte magic[headerSize];
+	in_.seekg(0);
+	in_.read(reinterpret_cast<char*>(magic), headerSize);
+	std::byte trailer[RecordOutputStream::TRAILER_SIZE];
+	in_.seekg(static_cast<std::streamoff>(size - RecordOutputStream::TRAILER_SIZE));
+	in_.read(reinterpret_cast<char*>(trailer), RecordOutputStream::TRAILER_SIZE);
+	if (!in_ || std::memcmp(magic, RecordOutputStream::MAGIC, headerSize) != 0 || std::memcmp(trailer + 20, RecordOutputStream::INDEX_MAGIC, sizeof(RecordOutputStream::INDEX_MAGIC)) != 0) {
+		throw std::ios_base::failure("Not a complete record file: " + path_.string());
+	}
+	count_ = LittleEndian::load<uint64_t>(trailer);
+	const auto entries = LittleEndian::load<uint64_t>(trailer + 8);
+	const auto crc = LittleEndian::load<uint32_t>(trailer + 16);
+	const uint64_t indexEnd = size - RecordOutputStream::TRAILER_SIZE;
+	if (entries > (indexEnd - headerSize) / RecordOutputStream::INDEX_ENTRY_SIZE) {
+		throw std::ios_base::failure("Corrupt record index: " + path_.string());
+	}
+	const uint64_t indexStart = indexEnd - entries * RecordOutputStream::INDEX_ENTRY_SIZE;
+	indexStart_ = indexStart;
+	std::vector<std::byte> bytes(entries * RecordOutputStream::INDEX_ENTRY_SIZE);
+	in_.seekg(static_cast<std::streamoff>(indexStart));
+	in_.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	if (!in_ || Crc32c::compute(bytes) != crc) {
+		throw std::ios_base::failure("Corrupt record index: " + path_.string());
+	}
+	index_.resize(entries);
+	for (size_t i = 0; i < entries; ++i) {
+		const std::byte* entry = bytes.data() + i * RecordOutputStream::INDEX_ENTRY_SIZE;
+		index_[i] = {LittleEndian::load<uint64_t>(entry), LittleEndian::load<uint64_t>(entry + 8)};
+		const bool ordered = i == 0 ? index_[i].firstRecord == 0 : index_[i].firstRecord > index_[i - 1].firstRecord && index_[i].offset > index_[i - 1].offset;
+		if (!ordered || index_[i].firstRecord >= count_ || index_[i].offset < headerSize || index_[i].offset >= indexStart) {
+			throw std::ios_base::failure("Corrupt record index: " + path_.string());
+		}
+	}
+	if (index_.empty() != (count_ == 0)) {
+		throw std::ios_base::failure("Corrupt record index: " + path_.string());
+	}
+}
+
+/// \brief Makes a block the current block of the sequential reader.
+/// \param block The number of the block.
+auto RecordInputStream::load(const size_t block) -> void {
+	blockLoaded_ = false;
+	readBlock(in_, block, block_);
+	blockNumber_ = block;
+	blockLoaded_ = true;
+}
+
+/// \brief Reads and verifies a block.
+/// \details The header is read with one fixed-size read, which is always possible because the index and trailer
+/// follow the last block. The header is not covered by the checksum, so its record count must match the index and
+/// its payload length must fill the space up to the next block, or up to the index for the last block; a corrupt
+/// length is rejected before any memory is allocated for it.
+/// \param in The file to read from.
+/// \param number The number of the block.
+/// \param block Receives the block; its payload buffer is reused.
+/// \throws std::ios_base::failure If the block cannot be read, disagrees with the index or fails its checksum.
+auto RecordInputStream::readBlock(std::istream& in, const size_t number, Block& block) const -> void {
+	const IndexEntry& entry = index_[number];
+	const bool last = number + 1 == index_.size();
+	const uint64_t end = last ? indexStart_ : index_[number + 1].offset;
+	const uint64_t expectedCount = (last ? count_ : index_[number + 1].firstRecord) - entry.firstRecord;
+	std::byte header[2 * Varint::MAX_LENGTH + sizeof(uint32_t)];
+	in.clear();
+	in.seekg(static_cast<std::streamoff>(entry.offset));
+	in.read(reinterpret_cast<char*>(header), sizeof(header));
+	if (!in) {
+		throw std::ios_base::failure("Truncated record block");
+	}
+	size_t offset = 0;
+	const uint64_t count = Varint::decode(header, offset);
+	const uint64_t length = Varint::decode(header, offset);
+	const auto crc = LittleEndian::load<uint32_t>(header + offset);
+	offset += sizeof(uint32_t);
+	if (count != expectedCount || end - entry.offset < offset || length != end - entry.offset - offset) {
+		throw std::ios_base::failure("Corrupt record block header");
+	}
+	block.payload.resize(length);
+	in.seekg(static_cast<std::streamoff>(entry.offset + offset));
+	in.read(reinterpret_cast<char*>(block.payload.data()), static_cast<std::streamsize>(length));
+	if (!in) {
+		throw std::ios_base::failure("Truncated record block");
+	}
+	if (Crc32c::compute(block.payload) != crc) {
+		throw std::ios_base::failure("Record block checksum mismatch");
+	}
+	block.firstRecord = entry.firstRecord;
+	block.count = count;
+	block.consumed = 0;
+	block.next = 0;
+}
+
+/// \brief Returns the next record of a block.
+/// \param block The block.
+/// \return A view of the record bytes inside the block payload.
+/// \throws std::ios_base::failure If the block holds fewer records than its header claims.
+auto RecordInputStream::nextRecord(Block& block) -> std::span<const std::byte> {
+	if (block.consumed >= block.count) {
+		throw std::ios_base::failure("Record block ended early");
+	}
+	const uint64_t length = Varint::decode(block.payload, block.next);
+	if (length > block.payload.size() - block.next) {
+		throw std::ios_base::failure("Record block ended early");
+	}
+	const std::span<const std::byte> record(block.payload.data() + block.next, length);
+	block.next += length;
+	++block.consumed;
+	return record;
+}
+}
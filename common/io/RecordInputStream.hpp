@@ -0,0 +1,64 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <span>
+#include <vector>
+#include "thread/ThreadPool.hpp"
+
+namespace common::io
+{
+/// \brief Reads a record file written by RecordOutputStream, sequentially or at random.
+/// \details The index is loaded and verified when the stream is opened. seek() finds the block holding a record
+/// with a binary search over the index and reads that block alone, so seeking costs O(log n) plus one block read.
+/// Every block is verified against its CRC-32C when it is read. forEach() splits the blocks into contiguous ranges
+/// and decodes them on a thread pool, each worker with its own file handle.
+/// \remark The stream reads from a file rather than from an AbstractInputStream, because seeking and parallel reading
+/// need random access.
+class RecordInputStream final
+{
+public:
+	using Visitor = std::function<void(uint64_t number, std::span<const std::byte> record)>;
+	explicit RecordInputStream(std::filesystem::path path);
+	auto read(std::vector<std::byte>& record) -> bool;
+	auto seek(uint64_t number) -> void;
+	[[nodiscard]] auto position() const -> uint64_t;
+	[[nodiscard]] auto count() const -> uint64_t;
+	[[nodiscard]] auto blocks() const -> size_t;
+	auto forEach(thread::ThreadPool& pool, const Visitor& visitor, size_t partitions = 0) const -> void;
+	auto close() -> void;
+
+private:
+	struct IndexEntry
+	{
+		uint64_t firstRecord;
+		uint64_t offset;
+	};
+
+	struct Block
+	{
+		uint64_t firstRecord{0};
+		uint64_t count{0};
+		uint64_t consumed{0};
+		size_t next{0};
+		std::vector<std::byte> payload;
+	};
+
+	auto loadIndex() -> void;
+	auto load(size_t block) -> void;
+	auto readBlock(std::istream& in, size_t number, Block& block) const -> void;
+	static auto nextRecord(Block& block) -> std::span<const std::byte>;
+	std::filesystem::path path_;
+	std::ifstream in_;
+	std::vector<IndexEntry> index_;
+	uint64_t count_{0};
+	uint64_t indexStart_{0};
+	Block block_;
+	size_t blockNumber_{0};
+	bool blockLoaded_{false};
+	uint64_t position_{0};
+};
+}
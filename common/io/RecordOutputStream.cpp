@@ -0,0 +1,121 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "RecordOutputStream.hpp"
+#include <cstring>
+#include <stdexcept>
+#include "Crc32c.hpp"
+#include "LittleEndian.hpp"
+#include "Varint.hpp"
+
+namespace common::io
+{
+/// \brief Constructs a record stream and writes the file magic.
+/// \param out The stream receiving the file.
+/// \param blockSize The payload size at which a block is written.
+/// \throws std::invalid_argument If the stream is null or the block size is zero.
+RecordOutputStream::RecordOutputStream(std::shared_ptr<AbstractOutputStream> out, const size_t blockSize): out_(std::move(out)), blockSize_(blockSize), header_(2 * Varint::MAX_LENGTH + sizeof(uint32_t)) {
+	if (!out_) {
+		throw std::invalid_argument("Output stream cannot be null");
+	}
+	if (blockSize_ == 0) {
+		throw std::invalid_argument("Block size must be greater than zero");
+	}
+	block_.reserve(blockSize_ + Varint::MAX_LENGTH);
+	std::vector<std::byte> magic(sizeof(MAGIC));
+	std::memcpy(magic.data(), MAGIC, sizeof(MAGIC));
+	out_->write(magic);
+	offset_ = magic.size();
+}
+
+RecordOutputStream::~RecordOutputStream() {
+	try {
+		close();
+	}
+	catch (...) {
+		// Suppress exceptions in destructors
+	}
+}
+
+/// \brief Appends a record.
+/// \param record The bytes of the record.
+/// \throws std::ios_base::failure If the stream is closed.
+auto RecordOutputStream::write(const std::span<const std::byte> record) -> void {
+	if (closed_) {
+		throw std::ios_base::failure("Stream closed");
+	}
+	std::byte prefix[Varint::MAX_LENGTH];
+	const size_t prefixLength = Varint::encode(record.size(), prefix);
+	block_.insert(block_.end(), prefix, prefix + prefixLength);
+	block_.insert(block_.end(), record.begin(), record.end());
+	++blockRecords_;
+	++records_;
+	if (block_.size() >= blockSize_) {
+		writeBlock();
+	}
+}
+
+/// \brief Appends a record holding the given characters.
+/// \param record The characters of the record.
+/// \throws std::ios_base::failure If the stream is closed.
+auto RecordOutputStream::write(const std::string_view record) -> void {
+	write(std::as_bytes(std::span(record)));
+}
+
+/// \brief Writes the pending records as a block and flushes the underlying stream.
+/// \details Flushing often produces small blocks, which make the index larger.
+auto RecordOutputStream::flush() -> void {
+	if (closed_) {
+		return;
+	}
+	writeBlock();
+	out_->flush();
+}
+
+/// \brief Writes the pending records, the index and the trailer, then closes the underlying stream.
+/// \details Without the index the file cannot be read, so a stream must be closed to be complete.
+auto RecordOutputStream::close() -> void {
+	if (closed_) {
+		return;
+	}
+	writeBlock();
+	closed_ = true;
+	std::vector<std::byte> footer(index_.size() * INDEX_ENTRY_SIZE + TRAILER_SIZE);
+	std::byte* entry = footer.data();
+	for (const auto& [firstRecord, offset] : index_) {
+		LittleEndian::store(entry, firstRecord);
+		LittleEndian::store(entry + sizeof(uint64_t), offset);
+		entry += INDEX_ENTRY_SIZE;
+	}
+	const uint32_t crc = Crc32c::compute(std::span(footer.data(), entry));
+	LittleEndian::store<uint64_t>(entry, records_);
+	LittleEndian::store<uint64_t>(entry + 8, index_.size());
+	LittleEndian::store(entry + 16, crc);
+	std::memcpy(entry + 20, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+	out_->write(footer);
+	out_->flush();
+	out_->close();
+}
+
+/// \brief Returns the number of records written so far.
+/// \return The record count.
+auto RecordOutputStream::count() const -> uint64_t {
+	return records_;
+}
+
+/// \brief Writes the pending records as one block and records it in the index.
+auto RecordOutputStream::writeBlock() -> void {
+	if (blockRecords_ == 0) {
+		return;
+	}
+	index_.push_back({records_ - blockRecords_, offset_});
+	size_t headerLength = Varint::encode(blockRecords_, header_.data());
+	headerLength += Varint::encode(block_.size(), header_.data() + headerLength);
+	LittleEndian::store(header_.data() + headerLength, Crc32c::compute(block_));
+	headerLength += sizeof(uint32_t);
+	out_->write(header_, 0, headerLength);
+	out_->write(block_, 0, block_.size());
+	offset_ += headerLength + block_.size();
+	block_.clear();
+	blockRecords_ = 0;
+}
+}
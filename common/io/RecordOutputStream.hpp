@@ -0,0 +1,62 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "AbstractOutputStream.hpp"
+
+namespace common::io
+{
+/// \brief Writes a stream of length-delimited records in blocks, followed by an index of the blocks.
+/// \details The file layout is:
+/// - the 4-byte magic "REC1";
+/// - the blocks, each made of a varint record count, a varint payload length, the CRC-32C of the payload as a
+///   little-endian 32-bit value, and the payload, which holds the records as varint length followed by the bytes;
+/// - the index: one entry per block of two little-endian 64-bit values, the number of the first record in the block
+///   and the file offset of the block;
+/// - the 24-byte trailer: the total record count and the index entry count as little-endian 64-bit values, the
+///   CRC-32C of the index, and the magic "RIDX".
+///
+/// A block is written once its payload reaches the block size, on flush() and on close(). The index and trailer are
+/// written by close(), so a reader can locate any record with a binary search over the index and one block read.
+/// \remark RecordInputStream reads the format.
+class RecordOutputStream final
+{
+public:
+	static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+	static constexpr char MAGIC[4] = {'R', 'E', 'C', '1'};
+	static constexpr char INDEX_MAGIC[4] = {'R', 'I', 'D', 'X'};
+	static constexpr size_t INDEX_ENTRY_SIZE = 16;
+	static constexpr size_t TRAILER_SIZE = 24;
+	explicit RecordOutputStream(std::shared_ptr<AbstractOutputStream> out, size_t blockSize = DEFAULT_BLOCK_SIZE);
+	~RecordOutputStream();
+	RecordOutputStream(const RecordOutputStream&) = delete;
+	auto operator=(const RecordOutputStream&) -> RecordOutputStream& = delete;
+	auto write(std::span<const std::byte> record) -> void;
+	auto write(std::string_view record) -> void;
+	auto flush() -> void;
+	auto close() -> void;
+	[[nodiscard]] auto count() const -> uint64_t;
+
+private:
+	struct IndexEntry
+	{
+		uint64_t firstRecord;
+		uint64_t offset;
+	};
+
+	auto writeBlock() -> void;
+	std::shared_ptr<AbstractOutputStream> out_;
+	size_t blockSize_;
+	std::vector<std::byte> block_;
+	std::vector<std::byte> header_;
+	std::vector<IndexEntry> index_;
+	uint64_t blockRecords_{0};
+	uint64_t records_{0};
+	uint64_t offset_{0};
+	bool closed_{false};
+};
+}
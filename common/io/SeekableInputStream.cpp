@@ -0,0 +1,21 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "SeekableInputStream.hpp"
+#include <algorithm>
+
+namespace common::io
+{
+SeekableInputStream::~SeekableInputStream() = default;
+
+/// \brief Skips over n bytes by moving the read position.
+/// \details The position does not move past the end of the stream.
+/// \param n The number of bytes to skip.
+/// \return The number of bytes actually skipped.
+auto SeekableInputStream::skip(const size_t n) -> size_t {
+	const uint64_t current = position();
+	const uint64_t end = std::max(size(), current);
+	const uint64_t target = current + std::min<uint64_t>(n, end - current);
+	seek(target);
+	return target - current;
+}
+}
@@ -0,0 +1,25 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <cstdint>
+#include <span>
+#include "AbstractInputStream.hpp"
+
+namespace common::io
+{
+/// \brief Abstract class for input streams with random access.
+/// \details Adds a read position that can be queried and moved, and positional reads that leave the position alone.
+/// skip() moves the position instead of reading, so it costs O(1) regardless of the distance.
+/// \remark readAt() may be called concurrently from several threads; the sequential methods may not, as for every
+/// other stream.
+class SeekableInputStream abstract : public AbstractInputStream
+{
+public:
+	~SeekableInputStream() override;
+	[[nodiscard]] virtual auto position() const -> uint64_t = 0;
+	virtual auto seek(uint64_t position) -> void = 0;
+	virtual auto readAt(uint64_t offset, std::span<std::byte> buffer) -> size_t = 0;
+	[[nodiscard]] virtual auto size() const -> uint64_t = 0;
+	auto skip(size_t n) -> size_t override;
+};
+}
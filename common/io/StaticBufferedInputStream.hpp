@@ -0,0 +1,142 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <utility>
+#include <vector>
+#include "StaticStream.hpp"
+
+namespace common::io
+{
+/// \brief A buffered input stream composed at compile time.
+/// \details The counterpart of BufferedInputStream for stacks whose layers are known at compile time. The layer
+/// below is held by value and called directly, and read() is defined in the header, so reading byte by byte costs
+/// an inlined bounds check instead of a virtual call per layer. The layer is constructed in place from the
+/// constructor arguments.
+/// \tparam Source The layer to read from.
+/// \tparam BufferSize The size of the internal buffer in bytes.
+/// \remark Unlike the virtual hierarchy, read() returns an int so that the end of the stream (-1) is distinct from
+/// the byte 0xFF. Use DynamicInputStream to pass a composed stack where an AbstractInputStream is expected.
+template <ByteSource Source, size_t BufferSize = 8192> class StaticBufferedInputStream final
+{
+public:
+	template <typename... Args> explicit StaticBufferedInputStream(Args&&... args);
+	auto read() -> int;
+	auto read(std::vector<std::byte>& buffer, size_t offset, size_t len) -> size_t;
+	auto read(std::span<std::byte> buffer) -> size_t;
+	auto skip(size_t n) -> size_t;
+	[[nodiscard]] auto available() -> size_t;
+	auto close() -> void;
+	auto source() -> Source&;
+
+private:
+	auto fillBuffer() -> bool;
+	Source source_;
+	std::vector<std::byte> buf_;
+	size_t pos_{0};
+	size_t count_{0};
+};
+
+/// \brief Constructs the stream and the layer below it.
+/// \param args The arguments forwarded to the constructor of the layer below.
+template <ByteSource Source, size_t BufferSize> template <typename... Args> StaticBufferedInputStream<Source, BufferSize>::StaticBufferedInputStream(Args&&... args) : source_(std::forward<Args>(args)...), buf_(BufferSize) {}
+
+/// \brief Reads the next byte of data.
+/// \return The next byte as a value from 0 to 255, or -1 at the end of the stream.
+template <ByteSource Source, size_t BufferSize> auto StaticBufferedInputStream<Source, BufferSize>::read() -> int {
+	if (pos_ == count_ && !fillBuffer()) [[unlikely]] {
+		return -1;
+	}
+	return std::to_integer<int>(buf_[pos_++]);
+}
+
+/// \brief Reads up to \p len bytes into the given range of \p buffer.
+/// \param buffer The destination array.
+/// \param offset The offset in the destination array where to start writing.
+/// \param len The maximum number of bytes to read.
+/// \return The number of bytes read, or 0 at the end of the stream.
+/// \throw std::out_of_range If the offset and length exceed the buffer size.
+template <ByteSource Source, size_t BufferSize> auto StaticBufferedInputStream<Source, BufferSize>::read(std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> size_t {
+	if (offset + len > buffer.size()) {
+		throw std::out_of_range("Buffer offset/length out of range");
+	}
+	if (pos_ == count_ && len >= BufferSize) {
+		const size_t count = source_.read(buffer, offset, len);
+		return isEndOfStream(count) ? 0 : count;
+	}
+	return read(std::span(buffer).subspan(offset, len));
+}
+
+/// \brief Reads up to \p buffer.size() bytes into the given span.
+/// \details Buffered bytes are copied first; the buffer is refilled at most once per call, so the call does not
+/// block for more data after it has produced some.
+/// \param buffer The destination range.
+/// \return The number of bytes read, or 0 at the end of the stream.
+template <ByteSource Source, size_t BufferSize> auto StaticBufferedInputStream<Source, BufferSize>::read(const std::span<std::byte> buffer) -> size_t {
+	if (buffer.empty() || (pos_ == count_ && !fillBuffer())) {
+		return 0;
+	}
+	const size_t count = std::min(buffer.size(), count_ - pos_);
+	std::memcpy(buffer.data(), buf_.data() + pos_, count);
+	pos_ += count;
+	return count;
+}
+
+/// \brief Skips over and discards up to \p n bytes.
+/// \details Buffered bytes are discarded first; the rest is skipped by the layer below when it supports skipping.
+/// \param n The number of bytes to skip.
+/// \return The number of bytes skipped.
+template <ByteSource Source, size_t BufferSize> auto StaticBufferedInputStream<Source, BufferSize>::skip(const size_t n) -> size_t {
+	const size_t buffered = std::min(n, count_ - pos_);
+	pos_ += buffered;
+	size_t skipped = buffered;
+	if constexpr (requires { source_.skip(n); }) {
+		if (skipped < n) {
+			skipped += source_.skip(n - skipped);
+		}
+	}
+	else {
+		while (skipped < n && fillBuffer()) {
+			const size_t count = std::min(n - skipped, count_);
+			pos_ = count;
+			skipped += count;
+		}
+	}
+	return skipped;
+}
+
+/// \brief Returns the number of bytes that can be read without blocking.
+/// \return The buffered bytes plus those reported by the layer below, if it reports any.
+template <ByteSource Source, size_t BufferSize> auto StaticBufferedInputStream<Source, BufferSize>::available() -> size_t {
+	size_t result = count_ - pos_;
+	if constexpr (requires { source_.available(); }) {
+		result += source_.available();
+	}
+	return result;
+}
+
+/// \brief Discards the buffered bytes and closes the layer below, if it can be closed.
+template <ByteSource Source, size_t BufferSize> auto StaticBufferedInputStream<Source, BufferSize>::close() -> void {
+	pos_ = count_ = 0;
+	if constexpr (requires { source_.close(); }) {
+		source_.close();
+	}
+}
+
+/// \brief Returns the layer below this stream.
+/// \return The layer below.
+template <ByteSource Source, size_t BufferSize> auto StaticBufferedInputStream<Source, BufferSize>::source() -> Source& {
+	return source_;
+}
+
+/// \brief Refills the internal buffer from the layer below.
+/// \return false at the end of the stream.
+template <ByteSource Source, size_t BufferSize> auto StaticBufferedInputStream<Source, BufferSize>::fillBuffer() -> bool {
+	const size_t count = source_.read(buf_, 0, BufferSize);
+	pos_ = 0;
+	count_ = isEndOfStream(count) ? 0 : count;
+	return count_ > 0;
+}
+}
@@ -0,0 +1,123 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "StaticStream.hpp"
+
+namespace common::io
+{
+/// \brief A buffered output stream composed at compile time.
+/// \details The counterpart of BufferedOutputStream for stacks whose layers are known at compile time. The layer
+/// below is held by value and write(std::byte) is defined in the header, so writing byte by byte costs an inlined
+/// store instead of a virtual call per layer. The buffer is flushed to the layer below on flush(), close() and
+/// destruction.
+/// \tparam Sink The layer to write to.
+/// \tparam BufferSize The size of the internal buffer in bytes.
+template <ByteSink Sink, size_t BufferSize = 8192> class StaticBufferedOutputStream final
+{
+public:
+	template <typename... Args> explicit StaticBufferedOutputStream(Args&&... args);
+	~StaticBufferedOutputStream();
+	StaticBufferedOutputStream(const StaticBufferedOutputStream&) = delete;
+	auto operator=(const StaticBufferedOutputStream&) -> StaticBufferedOutputStream& = delete;
+	auto write(std::byte b) -> void;
+	auto write(const std::vector<std::byte>& buffer, size_t offset, size_t len) -> void;
+	auto write(std::span<const std::byte> data) -> void;
+	auto flush() -> void;
+	auto close() -> void;
+	auto sink() -> Sink&;
+
+private:
+	auto flushBuffer() -> void;
+	Sink sink_;
+	std::vector<std::byte> buf_;
+	size_t count_{0};
+};
+
+/// \brief Constructs the stream and the layer below it.
+/// \param args The arguments forwarded to the constructor of the layer below.
+template <ByteSink Sink, size_t BufferSize> template <typename... Args> StaticBufferedOutputStream<Sink, BufferSize>::StaticBufferedOutputStream(Args&&... args) : sink_(std::forward<Args>(args)...), buf_(BufferSize) {}
+
+template <ByteSink Sink, size_t BufferSize> StaticBufferedOutputStream<Sink, BufferSize>::~StaticBufferedOutputStream() {
+	try {
+		flushBuffer();
+	}
+	catch (...) {
+		// Suppress exceptions in destructors
+	}
+}
+
+/// \brief Writes a single byte.
+/// \param b The byte to write.
+template <ByteSink Sink, size_t BufferSize> auto StaticBufferedOutputStream<Sink, BufferSize>::write(const std::byte b) -> void {
+	if (count_ == BufferSize) [[unlikely]] {
+		flushBuffer();
+	}
+	buf_[count_++] = b;
+}
+
+/// \brief Writes the given range of \p buffer.
+/// \details Blocks at least as large as the buffer bypass it and go to the layer below directly.
+/// \param buffer The source array.
+/// \param offset The offset in the source array where to start reading.
+/// \param len The number of bytes to write.
+/// \throw std::out_of_range If the offset and length exceed the buffer size.
+template <ByteSink Sink, size_t BufferSize> auto StaticBufferedOutputStream<Sink, BufferSize>::write(const std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> void {
+	if (offset + len > buffer.size()) {
+		throw std::out_of_range("Data offset/length out of range");
+	}
+	if (len >= BufferSize) {
+		flushBuffer();
+		sink_.write(buffer, offset, len);
+		return;
+	}
+	write(std::span(buffer).subspan(offset, len));
+}
+
+/// \brief Writes a block of bytes through the buffer.
+/// \param data The bytes to write.
+template <ByteSink Sink, size_t BufferSize> auto StaticBufferedOutputStream<Sink, BufferSize>::write(std::span<const std::byte> data) -> void {
+	while (!data.empty()) {
+		if (count_ == BufferSize) {
+			flushBuffer();
+		}
+		const size_t count = std::min(data.size(), BufferSize - count_);
+		std::memcpy(buf_.data() + count_, data.data(), count);
+		count_ += count;
+		data = data.subspan(count);
+	}
+}
+
+/// \brief Writes out the buffer and flushes the layer below.
+template <ByteSink Sink, size_t BufferSize> auto StaticBufferedOutputStream<Sink, BufferSize>::flush() -> void {
+	flushBuffer();
+	sink_.flush();
+}
+
+/// \brief Writes out the buffer and closes the layer below, if it can be closed.
+template <ByteSink Sink, size_t BufferSize> auto StaticBufferedOutputStream<Sink, BufferSize>::close() -> void {
+	flushBuffer();
+	if constexpr (requires { sink_.close(); }) {
+		sink_.close();
+	}
+}
+
+/// \brief Returns the layer below this stream.
+/// \return The layer below.
+template <ByteSink Sink, size_t BufferSize> auto StaticBufferedOutputStream<Sink, BufferSize>::sink() -> Sink& {
+	return sink_;
+}
+
+/// \brief Writes the buffered bytes to the layer below.
+template <ByteSink Sink, size_t BufferSize> auto StaticBufferedOutputStream<Sink, BufferSize>::flushBuffer() -> void {
+	if (count_ > 0) {
+		sink_.write(buf_, 0, count_);
+		count_ = 0;
+	}
+}
+}
@@ -0,0 +1,104 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include "StaticStream.hpp"
+
+namespace common::io
+{
+/// \brief A pushback input stream composed at compile time.
+/// \details The counterpart of PushbackInputStream for stacks whose layers are known at compile time. The pushback
+/// buffer is a fixed array and reading falls through to the layer below without virtual dispatch, so a parser that
+/// peeks one byte ahead over a StaticBufferedInputStream inlines both layers.
+/// \tparam Source The layer to read from; it must provide int read() when bytes are read one at a time.
+/// \tparam PushbackSize The number of bytes that can be pushed back.
+template <ByteSource Source, size_t PushbackSize = 64> class StaticPushbackInputStream final
+{
+public:
+	template <typename... Args> explicit StaticPushbackInputStream(Args&&... args);
+	auto read() -> int requires requires(Source& s) { { s.read() } -> std::same_as<int>; };
+	auto read(std::vector<std::byte>& buffer, size_t offset, size_t len) -> size_t;
+	auto unread(std::byte b) -> void;
+	auto unread(std::span<const std::byte> data) -> void;
+	auto close() -> void;
+	auto source() -> Source&;
+
+private:
+	Source source_;
+	std::array<std::byte, PushbackSize> pushback_{};
+	size_t pushbackPos_{PushbackSize};
+};
+
+/// \brief Constructs the stream and the layer below it.
+/// \param args The arguments forwarded to the constructor of the layer below.
+template <ByteSource Source, size_t PushbackSize> template <typename... Args> StaticPushbackInputStream<Source, PushbackSize>::StaticPushbackInputStream(Args&&... args) : source_(std::forward<Args>(args)...) {}
+
+/// \brief Reads the next byte, taking pushed back bytes first.
+/// \return The next byte as a value from 0 to 255, or -1 at the end of the stream.
+template <ByteSource Source, size_t PushbackSize> auto StaticPushbackInputStream<Source, PushbackSize>::read() -> int requires requires(Source& s) { { s.read() } -> std::same_as<int>; } {
+	if (pushbackPos_ < PushbackSize) {
+		return std::to_integer<int>(pushback_[pushbackPos_++]);
+	}
+	return source_.read();
+}
+
+/// \brief Reads up to \p len bytes into the given range of \p buffer, taking pushed back bytes first.
+/// \param buffer The destination array.
+/// \param offset The offset in the destination array where to start writing.
+/// \param len The maximum number of bytes to read.
+/// \return The number of bytes read, or 0 at the end of the stream.
+/// \throw std::out_of_range If the offset and length exceed the buffer size.
+template <ByteSource Source, size_t PushbackSize> auto StaticPushbackInputStream<Source, PushbackSize>::read(std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> size_t {
+	if (offset + len > buffer.size()) {
+		throw std::out_of_range("Buffer offset/length out of range");
+	}
+	const size_t pushed = std::min(len, PushbackSize - pushbackPos_);
+	std::memcpy(buffer.data() + offset, pushback_.data() + pushbackPos_, pushed);
+	pushbackPos_ += pushed;
+	if (pushed == len) {
+		return pushed;
+	}
+	const size_t count = source_.read(buffer, offset + pushed, len - pushed);
+	return pushed + (isEndOfStream(count) ? 0 : count);
+}
+
+/// \brief Pushes back a single byte; the next read returns it.
+/// \param b The byte to push back.
+/// \throw std::overflow_error If the pushback buffer is full.
+template <ByteSource Source, size_t PushbackSize> auto StaticPushbackInputStream<Source, PushbackSize>::unread(const std::byte b) -> void {
+	if (pushbackPos_ == 0) {
+		throw std::overflow_error("Pushback buffer overflow");
+	}
+	pushback_[--pushbackPos_] = b;
+}
+
+/// \brief Pushes back a block of bytes; the next read returns its first byte.
+/// \param data The bytes to push back.
+/// \throw std::overflow_error If the bytes do not fit into the pushback buffer.
+template <ByteSource Source, size_t PushbackSize> auto StaticPushbackInputStream<Source, PushbackSize>::unread(const std::span<const std::byte> data) -> void {
+	if (data.size() > pushbackPos_) {
+		throw std::overflow_error("Pushback buffer overflow");
+	}
+	pushbackPos_ -= data.size();
+	std::memcpy(pushback_.data() + pushbackPos_, data.data(), data.size());
+}
+
+/// \brief Discards the pushed back bytes and closes the layer below, if it can be closed.
+template <ByteSource Source, size_t PushbackSize> auto StaticPushbackInputStream<Source, PushbackSize>::close() -> void {
+	pushbackPos_ = PushbackSize;
+	if constexpr (requires { source_.close(); }) {
+		source_.close();
+	}
+}
+
+/// \brief Returns the layer below this stream.
+/// \return The layer below.
+template <ByteSource Source, size_t PushbackSize> auto StaticPushbackInputStream<Source, PushbackSize>::source() -> Source& {
+	return source_;
+}
+}
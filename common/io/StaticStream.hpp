@@ -0,0 +1,84 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <concepts>
+#include <memory>
+#include <vector>
+#include "AbstractInputStream.hpp"
+#include "AbstractOutputStream.hpp"
+
+namespace common::io
+{
+/// \brief A layer that can be read in blocks by a compile-time stream decorator.
+/// \details Every concrete input stream of the virtual hierarchy satisfies the concept through its
+/// read(buffer, offset, len) member. When the type is final, as FileInputStream or ByteArrayInputStream are, the
+/// decorator calls it without virtual dispatch.
+template <typename T> concept ByteSource = requires(T& source, std::vector<std::byte>& buffer, size_t n) {
+	{ source.read(buffer, n, n) } -> std::convertible_to<size_t>;
+};
+
+/// \brief A layer that can be written in blocks by a compile-time stream decorator.
+/// \details Every concrete output stream of the virtual hierarchy satisfies the concept.
+template <typename T> concept ByteSink = requires(T& sink, const std::vector<std::byte>& buffer, size_t n) {
+	sink.write(buffer, n, n);
+	sink.flush();
+};
+
+/// \brief Tests whether a block read returned the end of the stream.
+/// \details The virtual hierarchy reports the end of a stream either as 0 or as -1 converted to size_t.
+/// \param count The value returned by a block read.
+/// \return true if no bytes were read.
+constexpr auto isEndOfStream(const size_t count) -> bool {
+	return count == 0 || count == static_cast<size_t>(-1);
+}
+
+/// \brief Adapts a stream of the virtual hierarchy to the bottom of a compile-time stack.
+/// \details Use it when the innermost stream is only known at run time; the decorators above it are still inlined
+/// and only the block reads cross the virtual boundary.
+class InputStreamSource final
+{
+public:
+	explicit InputStreamSource(std::unique_ptr<AbstractInputStream> inputStream) : inputStream_(std::move(inputStream)) {}
+
+	auto read(std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> size_t {
+		return inputStream_->read(buffer, offset, len);
+	}
+
+	auto skip(const size_t n) -> size_t {
+		return inputStream_->skip(n);
+	}
+
+	auto available() -> size_t {
+		return inputStream_->available();
+	}
+
+	auto close() -> void {
+		inputStream_->close();
+	}
+
+private:
+	std::unique_ptr<AbstractInputStream> inputStream_;
+};
+
+/// \brief Adapts a stream of the virtual hierarchy to the bottom of a compile-time output stack.
+class OutputStreamSink final
+{
+public:
+	explicit OutputStreamSink(std::shared_ptr<AbstractOutputStream> outputStream) : outputStream_(std::move(outputStream)) {}
+
+	auto write(const std::vector<std::byte>& buffer, const size_t offset, const size_t len) -> void {
+		outputStream_->write(buffer, offset, len);
+	}
+
+	auto flush() -> void {
+		outputStream_->flush();
+	}
+
+	auto close() -> void {
+		outputStream_->close();
+	}
+
+private:
+	std::shared_ptr<AbstractOutputStream> outputStream_;
+};
+}
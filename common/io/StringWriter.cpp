@@ -1,13 +1,13 @@
 // Created by author ethereal on 2024/12/7.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #include "StringWriter.hpp"
+#include <stdexcept>
+#include <utility>
 
 namespace common::io
 {
 StringWriter::StringWriter(const size_t initialSize) {
-	// Reserve an approximate initial size for the string buffer.
-	buffer_.str(std::string(initialSize, '\0'));
-	buffer_.seekp(0); // Reset the write position to the start.
+	buffer_.reserve(initialSize);
 }
 
 StringWriter::~StringWriter() = default;
@@ -16,7 +16,7 @@ StringWriter::~StringWriter() = default;
 /// \details This method appends the character to the internal string buffer.
 /// \return The writer object, allowing method chaining.
 auto StringWriter::append(const char c) -> StringWriter& {
-	buffer_.put(c);
+	buffer_.push_back(c);
 	return *this;
 }
 
@@ -24,7 +24,7 @@ auto StringWriter::append(const char c) -> StringWriter& {
 /// \details This method appends the entire string to the internal string buffer.
 /// \return The writer object, allowing method chaining.
 auto StringWriter::append(const std::string& csq) -> StringWriter& {
-	buffer_ << csq;
+	buffer_.append(csq);
 	return *this;
 }
 
@@ -41,7 +41,7 @@ auto StringWriter::append(const std::string& csq, const size_t start, const size
 	if (start > end || end > csq.size()) {
 		throw std::out_of_range("Invalid start or end position");
 	}
-	buffer_.write(csq.data() + start, static_cast<std::streamsize>(end - start));
+	buffer_.append(csq, start, end - start);
 	return *this;
 }
 
@@ -52,18 +52,38 @@ auto StringWriter::close() -> void {
 }
 
 /// \brief Flushes the internal buffer.
-/// \details This method flushes the underlying string buffer,
-/// ensuring that all buffered output is written out.
-/// It is a no-op for std::ostringstream, as it does not require flushing.
+/// \details This method has no effect; the characters are written straight into the string buffer.
 auto StringWriter::flush() -> void {
-	buffer_.flush();
+	// No operation; there is nothing to flush.
 }
 
 /// \brief Retrieves the current contents of the buffer.
 /// \details This function returns the current contents of the internal string buffer
 /// as a std::string. It provides a snapshot of the data accumulated in the buffer.
 auto StringWriter::getBuffer() const -> std::string {
-	return buffer_.str();
+	return buffer_;
+}
+
+/// \brief Returns a view of the current contents of the buffer.
+/// \details Unlike getBuffer() this does not copy. The view is invalidated by the next write.
+/// \return A view of the internal string buffer.
+auto StringWriter::view() const -> std::string_view {
+	return buffer_;
+}
+
+/// \brief Moves the contents of the buffer out of the writer.
+/// \details The string is handed over without a copy and the writer is left empty, ready to be written again.
+/// \return The contents of the buffer.
+auto StringWriter::take() -> std::string {
+	return std::exchange(buffer_, {});
+}
+
+/// \brief Reserves space for at least \p capacity characters.
+/// \details Reserving the expected final size up front avoids the reallocations, and the copies they cause, while
+/// the content grows.
+/// \param capacity The number of characters to reserve space for, including those already written.
+auto StringWriter::reserve(const size_t capacity) -> void {
+	buffer_.reserve(capacity);
 }
 
 /// \brief Converts the writer to a string.
@@ -71,21 +91,21 @@ auto StringWriter::getBuffer() const -> std::string {
 /// It is equivalent to calling `getBuffer()`.
 /// \return The string representation of the writer.
 auto StringWriter::toString() const -> std::string {
-	return buffer_.str();
+	return buffer_;
 }
 
 /// \brief Writes a single character to the writer.
 /// \details This function writes a single character to the internal string buffer.
 /// \param c the character to write.
 auto StringWriter::write(const char c) -> void {
-	buffer_.put(c);
+	buffer_.push_back(c);
 }
 
 /// \brief Writes a string to the writer.
 /// \details This function writes the contents of the provided string to the writer.
 /// \param str the string to write.
 auto StringWriter::write(const std::string& str) -> void {
-	buffer_ << str;
+	buffer_.append(str);
 }
 
 /// \brief Writes a substring of the given string to the writer.
@@ -97,10 +117,10 @@ auto StringWriter::write(const std::string& str) -> void {
 /// \param off the starting index (inclusive) of the substring to write.
 /// \param len the length of the substring to write.
 auto StringWriter::write(const std::string& str, const size_t off, const size_t len) -> void {
-	if (off > str.size() || off + len > str.size()) {
+	if (off > str.size() || len > str.size() - off) {
 		throw std::out_of_range("Invalid offset or length");
 	}
-	buffer_.write(str.data() + off, static_cast<std::streamsize>(len));
+	buffer_.append(str, off, len);
 }
 
 /// \brief Writes a portion of the byte array to the writer.
@@ -115,6 +135,19 @@ void StringWriter::write(const std::vector<char>& cBuf, const size_t off, const
 	if (off > cBuf.size() || len > cBuf.size() - off) {
 		throw std::out_of_range("Invalid offset or length");
 	}
-	buffer_.write(cBuf.data() + off, static_cast<std::streamsize>(len));
+	buffer_.append(cBuf.data() + off, len);
+}
+
+/// \brief Writes a view of characters to the writer.
+/// \details This function copies the viewed characters straight into the internal string buffer.
+/// \param str the characters to write.
+auto StringWriter::write(const std::string_view str) -> void {
+	buffer_.append(str);
+}
+
+/// \brief Writes a block of characters to the writer.
+/// \param data the characters to write.
+auto StringWriter::write(const std::span<const char> data) -> void {
+	buffer_.append(data.data(), data.size());
 }
 }
@@ -1,7 +1,8 @@
 // Created by author ethereal on 2024/12/7.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #pragma once
-#include <sstream>
+#include <span>
+#include <string>
 #include <vector>
 #include "AbstractWriter.hpp"
 #include "interface/IfaceAppendable.hpp"
@@ -13,10 +14,11 @@ namespace common::io
 /// It implements the Closeable, Flushable, and Appendable interfaces.
 /// The class allows appending characters and strings, as well as flushing and closing operations.
 /// It is useful for accumulating strings into a single string buffer and then retrieving the full content.
+/// Use reserve() when the final size can be estimated, and take() to move the content out without copying it.
 class StringWriter final : public AbstractWriter, public interface::IfaceAppendable<StringWriter>
 {
 public:
-	explicit StringWriter(size_t initialSize);
+	explicit StringWriter(size_t initialSize = 0);
 	~StringWriter() override;
 	auto append(char c) -> StringWriter& override;
 	auto append(const std::string& csq) -> StringWriter& override;
@@ -24,13 +26,19 @@ public:
 	auto close() -> void override;
 	auto flush() -> void override;
 	[[nodiscard]] auto getBuffer() const -> std::string;
+	[[nodiscard]] auto view() const -> std::string_view;
+	[[nodiscard]] auto take() -> std::string;
+	auto reserve(size_t capacity) -> void;
 	[[nodiscard]] auto toString() const -> std::string override;
+	using AbstractWriter::write;
 	auto write(char c) -> void override;
 	auto write(const std::string& str) -> void override;
 	auto write(const std::string& str, size_t off, size_t len) -> void override;
 	void write(const std::vector<char>& cBuf, size_t off, size_t len) override;
+	auto write(std::string_view str) -> void override;
+	auto write(std::span<const char> data) -> void;
 
 private:
-	std::ostringstream buffer_;
+	std::string buffer_;
 };
 }
@@ -0,0 +1,140 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "Utf8Decoder.hpp"
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define COMMON_IO_UTF8_SSE2 1
+#endif
+
+namespace common::io
+{
+/// \brief Feeds a single byte into the decoder.
+/// \details The byte either completes the current code point, continues a multibyte sequence or starts a new one.
+/// \param byte The next input byte.
+/// \return The decoded code point, or INCOMPLETE if more bytes are needed.
+/// \throws std::runtime_error if the byte is not valid at this position of a UTF-8 sequence.
+auto Utf8Decoder::feed(const unsigned char byte) -> int {
+	if (remaining_ == 0) {
+		if (byte < 0x80) {
+			return byte;
+		}
+		lower_ = 0x80;
+		upper_ = 0xBF;
+		if (byte >= 0xC2 && byte <= 0xDF) {
+			remaining_ = 1;
+			codePoint_ = byte & 0x1F;
+		}
+		else if (byte >= 0xE0 && byte <= 0xEF) {
+			remaining_ = 2;
+			codePoint_ = byte & 0x0F;
+			if (byte == 0xE0) lower_ = 0xA0;
+			if (byte == 0xED) upper_ = 0x9F;
+		}
+		else if (byte >= 0xF0 && byte <= 0xF4) {
+			remaining_ = 3;
+			codePoint_ = byte & 0x07;
+			if (byte == 0xF0) lower_ = 0x90;
+			if (byte == 0xF4) upper_ = 0x8F;
+		}
+		else {
+			throw std::runtime_error("Invalid UTF-8 lead byte");
+		}
+		return INCOMPLETE;
+	}
+	if (byte < lower_ || byte > upper_) {
+		reset();
+		throw std::runtime_error("Invalid UTF-8 continuation byte");
+	}
+	lower_ = 0x80;
+	upper_ = 0xBF;
+	codePoint_ = (codePoint_ << 6) | (byte & 0x3F);
+	if (--remaining_ > 0) {
+		return INCOMPLETE;
+	}
+	return static_cast<int>(codePoint_);
+}
+
+/// \brief Discards any partially decoded sequence.
+auto Utf8Decoder::reset() -> void {
+	codePoint_ = 0;
+	remaining_ = 0;
+	lower_ = 0x80;
+	upper_ = 0xBF;
+}
+
+/// \brief Checks whether a multibyte sequence has been started but not completed.
+/// \return true if more bytes are needed to finish the current code point.
+auto Utf8Decoder::pending() const -> bool {
+	return remaining_ != 0;
+}
+
+/// \brief Returns the length of the leading run of ASCII bytes.
+/// \details Sixteen bytes are tested per step with SSE2 where available, otherwise eight bytes at a time through a
+/// word-sized mask, so that plain ASCII text is validated without inspecting each byte individually.
+/// \param data The bytes to scan.
+/// \param len The number of bytes to scan.
+/// \return The number of leading bytes below 0x80.
+auto Utf8Decoder::asciiPrefix(const char* data, const size_t len) -> size_t {
+	size_t i = 0;
+#ifdef COMMON_IO_UTF8_SSE2
+	for (; i + 16 <= len; i += 16) {
+		const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+		if (const int mask = _mm_movemask_epi8(chunk); mask != 0) {
+			return i + static_cast<size_t>(std::countr_zero(static_cast<unsigned>(mask)));
+		}
+	}
+#endif
+	for (; i + 8 <= len; i += 8) {
+		uint64_t word;
+		std::memcpy(&word, data + i, sizeof(word));
+		if ((word & 0x8080808080808080ULL) != 0) {
+			break;
+		}
+	}
+	while (i < len && static_cast<unsigned char>(data[i]) < 0x80) {
+		++i;
+	}
+	return i;
+}
+
+/// \brief Returns the length of the longest prefix made of complete, valid UTF-8 sequences.
+/// \details A sequence truncated by the end of the block is not an error; it is left out of the prefix so that the
+/// caller can keep it until the remaining bytes arrive.
+/// \param data The bytes to validate.
+/// \param len The number of bytes to validate.
+/// \return The number of bytes forming complete code points.
+/// \throws std::runtime_error if the block contains an invalid sequence.
+auto Utf8Decoder::completePrefix(const char* data, const size_t len) -> size_t {
+	size_t i = 0;
+	Utf8Decoder decoder;
+	while (i < len) {
+		i += asciiPrefix(data + i, len - i);
+		if (i == len) {
+			break;
+		}
+		const size_t seqLen = sequenceLength(static_cast<unsigned char>(data[i]));
+		const size_t available = seqLen < len - i ? seqLen : len - i;
+		for (size_t k = 0; k < available; ++k) {
+			static_cast<void>(decoder.feed(static_cast<unsigned char>(data[i + k])));
+		}
+		if (decoder.pending()) {
+			break;
+		}
+		i += seqLen;
+	}
+	return i;
+}
+
+/// \brief Returns the total length of the sequence introduced by a lead byte.
+/// \param lead The first byte of the sequence.
+/// \return The sequence length in bytes, or 1 for bytes that cannot start a sequence.
+auto Utf8Decoder::sequenceLength(const unsigned char lead) -> size_t {
+	if (lead < 0xC0) return 1;
+	if (lead < 0xE0) return 2;
+	if (lead < 0xF0) return 3;
+	return 4;
+}
+}
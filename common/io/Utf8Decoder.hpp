@@ -0,0 +1,30 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace common::io
+{
+/// \brief An incremental, allocation-free UTF-8 decoder.
+/// \details The decoder accepts one byte at a time and keeps the state of a partially received sequence, so a code
+/// point may be split across any number of buffer boundaries. Overlong forms, surrogates and values above U+10FFFF
+/// are rejected. The static helpers validate whole blocks and use SSE2 to skip runs of ASCII when available.
+class Utf8Decoder final
+{
+public:
+	static constexpr int INCOMPLETE = -2;
+	auto feed(unsigned char byte) -> int;
+	auto reset() -> void;
+	[[nodiscard]] auto pending() const -> bool;
+	[[nodiscard]] static auto asciiPrefix(const char* data, size_t len) -> size_t;
+	[[nodiscard]] static auto completePrefix(const char* data, size_t len) -> size_t;
+	[[nodiscard]] static auto sequenceLength(unsigned char lead) -> size_t;
+
+private:
+	char32_t codePoint_{0};
+	uint8_t remaining_{0};
+	unsigned char lower_{0x80};
+	unsigned char upper_{0xBF};
+};
+}
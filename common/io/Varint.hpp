@@ -0,0 +1,69 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <ios>
+#include <span>
+
+namespace common::io
+{
+/// \brief Encodes and decodes unsigned integers as LEB128 variable-length integers.
+/// \details Each byte carries seven bits of the value, least significant group first, and its high bit is set when
+/// more bytes follow. Values below 128 take one byte, and a 64-bit value takes at most MAX_LENGTH bytes.
+class Varint final
+{
+public:
+	static constexpr size_t MAX_LENGTH = 10;
+	Varint() = delete;
+	static auto encode(uint64_t value, std::byte* out) -> size_t;
+	static auto decode(std::span<const std::byte> data, size_t& offset) -> uint64_t;
+	static auto length(uint64_t value) -> size_t;
+};
+
+/// \brief Encodes a value.
+/// \param value The value to encode.
+/// \param out The destination; must have room for MAX_LENGTH bytes.
+/// \return The number of bytes written.
+inline auto Varint::encode(uint64_t value, std::byte* out) -> size_t {
+	size_t count = 0;
+	while (value >= 0x80) {
+		out[count++] = static_cast<std::byte>(value | 0x80);
+		value >>= 7;
+	}
+	out[count++] = static_cast<std::byte>(value);
+	return count;
+}
+
+/// \brief Decodes a value.
+/// \param data The encoded bytes.
+/// \param offset The offset of the value in \p data; advanced past it.
+/// \return The decoded value.
+/// \throws std::ios_base::failure If the value is truncated or longer than MAX_LENGTH bytes.
+inline auto Varint::decode(const std::span<const std::byte> data, size_t& offset) -> uint64_t {
+	uint64_t value = 0;
+	for (unsigned shift = 0; shift < 64; shift += 7) {
+		if (offset >= data.size()) {
+			throw std::ios_base::failure("Truncated varint");
+		}
+		const auto byte = static_cast<uint64_t>(data[offset++]);
+		value |= (byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) {
+			return value;
+		}
+	}
+	throw std::ios_base::failure("Malformed varint");
+}
+
+/// \brief Returns the encoded length of a value.
+/// \param value The value.
+/// \return The number of bytes encode() writes for it.
+inline auto Varint::length(uint64_t value) -> size_t {
+	size_t count = 1;
+	while (value >= 0x80) {
+		value >>= 7;
+		++count;
+	}
+	return count;
+}
+}
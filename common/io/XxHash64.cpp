@@ -0,0 +1,128 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "XxHash64.hpp"
+#include <bit>
+#include <cstring>
+#include "LittleEndian.hpp"
+
+namespace common::io
+{
+constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+/// \brief Mixes one 8-byte lane into an accumulator.
+constexpr auto mixLane(uint64_t accumulator, const uint64_t lane) -> uint64_t {
+	accumulator += lane * PRIME2;
+	accumulator = std::rotl(accumulator, 31);
+	return accumulator * PRIME1;
+}
+
+/// \brief Folds an accumulator into the hash.
+constexpr auto mergeAccumulator(uint64_t hash, const uint64_t accumulator) -> uint64_t {
+	hash ^= mixLane(0, accumulator);
+	return hash * PRIME1 + PRIME4;
+}
+
+/// \brief Constructs an empty hash.
+/// \param seed The seed; hashes with different seeds are unrelated.
+XxHash64::XxHash64(const uint64_t seed): seed_(seed) {
+	reset();
+}
+
+/// \brief Adds bytes to the hash.
+/// \param data The bytes to add.
+auto XxHash64::update(std::span<const std::byte> data) -> void {
+	total_ += data.size();
+	if (buffered_ + data.size() < STRIPE_SIZE) {
+		std::memcpy(buffer_ + buffered_, data.data(), data.size());
+		buffered_ += data.size();
+		return;
+	}
+	if (buffered_ > 0) {
+		const size_t fill = STRIPE_SIZE - buffered_;
+		std::memcpy(buffer_ + buffered_, data.data(), fill);
+		for (size_t lane = 0; lane < 4; ++lane) {
+			accumulators_[lane] = mixLane(accumulators_[lane], LittleEndian::load<uint64_t>(buffer_ + lane * 8));
+		}
+		data = data.subspan(fill);
+		buffered_ = 0;
+	}
+	uint64_t v1 = accumulators_[0], v2 = accumulators_[1], v3 = accumulators_[2], v4 = accumulators_[3];
+	const std::byte* in = data.data();
+	const std::byte* const end = in + data.size() / STRIPE_SIZE * STRIPE_SIZE;
+	for (; in < end; in += STRIPE_SIZE) {
+		v1 = mixLane(v1, LittleEndian::load<uint64_t>(in));
+		v2 = mixLane(v2, LittleEndian::load<uint64_t>(in + 8));
+		v3 = mixLane(v3, LittleEndian::load<uint64_t>(in + 16));
+		v4 = mixLane(v4, LittleEndian::load<uint64_t>(in + 24));
+	}
+	accumulators_[0] = v1;
+	accumulators_[1] = v2;
+	accumulators_[2] = v3;
+	accumulators_[3] = v4;
+	buffered_ = data.size() % STRIPE_SIZE;
+	std::memcpy(buffer_, end, buffered_);
+}
+
+/// \brief Returns the hash of the bytes added so far.
+/// \details The state is not modified, so more bytes can be added afterward.
+/// \return The hash.
+auto XxHash64::digest() const -> uint64_t {
+	uint64_t hash;
+	if (total_ >= STRIPE_SIZE) {
+		hash = std::rotl(accumulators_[0], 1) + std::rotl(accumulators_[1], 7) + std::rotl(accumulators_[2], 12) + std::rotl(accumulators_[3], 18);
+		for (const uint64_t accumulator : accumulators_) {
+			hash = mergeAccumulator(hash, accumulator);
+		}
+	}
+	else {
+		hash = seed_ + PRIME5;
+	}
+	hash += total_;
+	const std::byte* in = buffer_;
+	size_t remaining = buffered_;
+	for (; remaining >= 8; in += 8, remaining -= 8) {
+		hash ^= mixLane(0, LittleEndian::load<uint64_t>(in));
+		hash = std::rotl(hash, 27) * PRIME1 + PRIME4;
+	}
+	if (remaining >= 4) {
+		hash ^= static_cast<uint64_t>(LittleEndian::load<uint32_t>(in)) * PRIME1;
+		hash = std::rotl(hash, 23) * PRIME2 + PRIME3;
+		in += 4;
+		remaining -= 4;
+	}
+	for (; remaining > 0; ++in, --remaining) {
+		hash ^= static_cast<uint64_t>(*in) * PRIME5;
+		hash = std::rotl(hash, 11) * PRIME1;
+	}
+	hash ^= hash >> 33;
+	hash *= PRIME2;
+	hash ^= hash >> 29;
+	hash *= PRIME3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+/// \brief Discards the bytes added so far, keeping the seed.
+auto XxHash64::reset() -> void {
+	accumulators_[0] = seed_ + PRIME1 + PRIME2;
+	accumulators_[1] = seed_ + PRIME2;
+	accumulators_[2] = seed_;
+	accumulators_[3] = seed_ - PRIME1;
+	buffered_ = 0;
+	total_ = 0;
+}
+
+/// \brief Hashes a block of bytes in one call.
+/// \param data The bytes to hash.
+/// \param seed The seed.
+/// \return The hash.
+auto XxHash64::hash(const std::span<const std::byte> data, const uint64_t seed) -> uint64_t {
+	XxHash64 state(seed);
+	state.update(data);
+	return state.digest();
+}
+}
@@ -0,0 +1,32 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace common::io
+{
+/// \brief Computes XXH64, a fast non-cryptographic 64-bit hash, incrementally.
+/// \details Input is consumed in 32-byte stripes by four independent accumulators, so the hash runs at several bytes
+/// per cycle; partial stripes are buffered between calls to update(). The result equals the reference XXH64 for
+/// the same seed, however the input is split.
+/// \remark Not suitable where an adversary chooses the input; use a cryptographic hash there.
+class XxHash64 final
+{
+public:
+	explicit XxHash64(uint64_t seed = 0);
+	auto update(std::span<const std::byte> data) -> void;
+	[[nodiscard]] auto digest() const -> uint64_t;
+	auto reset() -> void;
+	static auto hash(std::span<const std::byte> data, uint64_t seed = 0) -> uint64_t;
+
+private:
+	static constexpr size_t STRIPE_SIZE = 32;
+	uint64_t seed_;
+	uint64_t accumulators_[4]{};
+	std::byte buffer_[STRIPE_SIZE]{};
+	size_t buffered_{0};
+	uint64_t total_{0};
+};
+}
@@ -0,0 +1,32 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include "IfaceJsonSerializable.hpp"
+#include "io/serialize/JsonReflection.hpp"
+
+namespace common::interface
+{
+/// \brief Implements IfaceJsonSerializable from the field descriptors of the derived class.
+/// \details The derived class declares a static constexpr jsonFields() function (see
+/// io::serialize::JsonReflectable) instead of writing serialize and deserialize by hand, and can then be used
+/// wherever an IfaceJsonSerializable is expected, such as JsonSerializer::saveStudentToJsonFile.
+/// \tparam T The type of the derived class.
+template <typename T> class IfaceJsonReflectable abstract : public IfaceJsonSerializable
+{
+public:
+	auto serialize(rapidjson::Writer<rapidjson::StringBuffer>& writer) const -> void override;
+	auto deserialize(const rapidjson::Value& json) -> void override;
+};
+
+/// \brief Writes the object as a JSON object of its described fields.
+/// \param writer The JSON writer to use.
+template <typename T> auto IfaceJsonReflectable<T>::serialize(rapidjson::Writer<rapidjson::StringBuffer>& writer) const -> void {
+	io::serialize::JsonReflection::write(writer, static_cast<const T&>(*this));
+}
+
+/// \brief Reads the described fields from a JSON object.
+/// \param json The JSON value to read.
+template <typename T> auto IfaceJsonReflectable<T>::deserialize(const rapidjson::Value& json) -> void {
+	io::serialize::JsonReflection::read(json, static_cast<T&>(*this));
+}
+}
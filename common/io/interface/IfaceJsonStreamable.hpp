@@ -0,0 +1,38 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include "IfaceJsonSerializable.hpp"
+
+namespace common::interface
+{
+/// \brief Implements IfaceJsonSerializable for classes that can write themselves to any rapidjson writer.
+/// \details The derived class implements a member template serializeTo(Writer&) instead of serialize, and
+/// deserialize as usual. JsonReflection::writeValue calls serializeTo with the writer it was given, so the object is
+/// written straight to a JsonStreamWriter, an NdjsonWriter or a PrettyWriter instead of being rendered into a
+/// separate buffer first; serialize forwards to it for callers holding a Writer<StringBuffer>.
+/// \code
+/// class Student : public IfaceJsonStreamable<Student>
+/// {
+/// public:
+/// 	template <typename Writer> auto serializeTo(Writer& writer) const -> void {
+/// 		writer.StartObject();
+/// 		writer.Key("name");
+/// 		writer.String(name_.data(), static_cast<rapidjson::SizeType>(name_.size()));
+/// 		writer.EndObject();
+/// 	}
+/// 	auto deserialize(const rapidjson::Value& json) -> void override;
+/// };
+/// \endcode
+/// \tparam T The type of the derived class.
+template <typename T> class IfaceJsonStreamable abstract : public IfaceJsonSerializable
+{
+public:
+	auto serialize(rapidjson::Writer<rapidjson::StringBuffer>& writer) const -> void override;
+};
+
+/// \brief Writes the object through serializeTo of the derived class.
+/// \param writer The JSON writer to use.
+template <typename T> auto IfaceJsonStreamable<T>::serialize(rapidjson::Writer<rapidjson::StringBuffer>& writer) const -> void {
+	static_cast<const T&>(*this).serializeTo(writer);
+}
+}
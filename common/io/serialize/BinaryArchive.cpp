@@ -0,0 +1,77 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "BinaryArchive.hpp"
+#include <algorithm>
+
+namespace common::io::serialize
+{
+/// \brief Constructs an archive appending to a vector.
+/// \param buffer The vector receiving the bytes; its content is kept and its capacity reused.
+BinaryOutputArchive::BinaryOutputArchive(std::vector<std::byte>& buffer): target_(Target::VECTOR), vector_(&buffer) {}
+
+/// \brief Constructs an archive writing into a fixed buffer.
+/// \param buffer The buffer receiving the bytes; writes beyond it throw std::out_of_range.
+BinaryOutputArchive::BinaryOutputArchive(const std::span<std::byte> buffer): target_(Target::SPAN), span_(buffer) {}
+
+/// \brief Constructs an archive writing to an output stream through a staging buffer of STAGING_SIZE bytes.
+/// \details The staged bytes are written when the buffer fills, on flush() and on destruction.
+/// \param out The stream receiving the bytes, for example a ByteArrayOutputStream.
+BinaryOutputArchive::BinaryOutputArchive(AbstractOutputStream& out): target_(Target::STREAM), stream_(&out), staging_(STAGING_SIZE) {}
+
+BinaryOutputArchive::~BinaryOutputArchive() {
+	try {
+		flush();
+	}
+	catch (...) {
+		// Suppress exceptions in destructors
+	}
+}
+
+/// \brief Writes the staged bytes to the output stream; does nothing for the other targets.
+/// \details The output stream itself is not flushed.
+auto BinaryOutputArchive::flush() -> void {
+	if (target_ == Target::STREAM && used_ > 0) {
+		stream_->write(staging_, 0, used_);
+		used_ = 0;
+	}
+}
+
+/// \brief Returns the number of bytes written so far, including staged ones.
+/// \return The byte count.
+auto BinaryOutputArchive::size() const -> size_t {
+	return written_;
+}
+
+/// \brief Writes bytes that do not fit in the staging buffer.
+/// \details The staging buffer is filled up and written, and the rest is passed through in staging-sized pieces.
+/// \param data The bytes to write.
+/// \param length The number of bytes.
+auto BinaryOutputArchive::writeStaged(const std::byte* data, size_t length) -> void {
+	while (length > 0) {
+		if (used_ == staging_.size()) {
+			flush();
+		}
+		const size_t chunk = std::min(length, staging_.size() - used_);
+		std::memcpy(staging_.data() + used_, data, chunk);
+		used_ += chunk;
+		data += chunk;
+		length -= chunk;
+	}
+}
+
+/// \brief Constructs an archive reading from a block of bytes.
+/// \param data The bytes to read; they must stay valid while the archive is used.
+BinaryInputArchive::BinaryInputArchive(const std::span<const std::byte> data): data_(data) {}
+
+/// \brief Returns the number of bytes read so far.
+/// \return The read offset.
+auto BinaryInputArchive::position() const -> size_t {
+	return offset_;
+}
+
+/// \brief Returns the number of bytes left to read.
+/// \return The remaining byte count.
+auto BinaryInputArchive::remaining() const -> size_t {
+	return data_.size() - offset_;
+}
+}
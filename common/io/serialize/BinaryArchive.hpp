@@ -0,0 +1,481 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <ios>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <boost/mpl/bool.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/serialization.hpp>
+#include "io/AbstractOutputStream.hpp"
+#include "io/LittleEndian.hpp"
+#include "io/Varint.hpp"
+
+namespace common::io::serialize
+{
+/// \brief Types stored as their raw little-endian bytes, and copied in bulk when they form an array.
+/// \details Arithmetic types, enums and trivially copyable classes without padding bits. Such a class is copied
+/// bitwise even if a serialize function exists for it.
+template <typename T> concept BinaryBitwise = std::is_arithmetic_v<T> || std::is_enum_v<T> || (std::is_trivially_copyable_v<T> && std::has_unique_object_representations_v<T>);
+
+template <typename T> struct IsBoostNvp : std::false_type {};
+
+template <typename T> struct IsBoostNvp<boost::serialization::nvp<T>> : std::true_type {};
+
+template <typename T> struct IsStdOptional : std::false_type {};
+
+template <typename T> struct IsStdOptional<std::optional<T>> : std::true_type {};
+
+template <typename T> struct IsStdPair : std::false_type {};
+
+template <typename T1, typename T2> struct IsStdPair<std::pair<T1, T2>> : std::true_type {};
+
+template <typename T> struct IsStdArray : std::false_type {};
+
+template <typename T, size_t N> struct IsStdArray<std::array<T, N>> : std::true_type {};
+
+/// \brief Containers stored as an element count followed by the elements.
+template <typename T> concept BinarySequence = std::ranges::sized_range<T> && requires(T& container) {
+	typename T::value_type;
+	container.clear();
+};
+
+/// \brief Writes values in a compact binary layout, with the interface of a Boost output archive.
+/// \details The layout has no header and no type or tracking information:
+/// - bool and 1-byte integers are one byte;
+/// - wider integers are LEB128 varints, signed ones zigzag-encoded first;
+/// - floating-point values and bitwise classes are their little-endian bytes;
+/// - enums are their underlying integer;
+/// - strings and sequences are a varint count followed by the elements; arrays of bitwise elements are copied with
+///   one memcpy, and fixed-size arrays omit the count;
+/// - optionals are a presence byte followed by the value, and pairs are their two members;
+/// - other classes are written by their Boost serialize function, which sees class version 0.
+///
+/// The bytes are appended to a vector, written into a fixed buffer or staged and written to an output stream.
+/// Pointers are not supported. BinaryInputArchive reads the layout back.
+class BinaryOutputArchive final
+{
+public:
+	using is_saving = boost::mpl::bool_<true>;
+	using is_loading = boost::mpl::bool_<false>;
+	static constexpr size_t STAGING_SIZE = 8192;
+	explicit BinaryOutputArchive(std::vector<std::byte>& buffer);
+	explicit BinaryOutputArchive(std::span<std::byte> buffer);
+	explicit BinaryOutputArchive(AbstractOutputStream& out);
+	~BinaryOutputArchive();
+	BinaryOutputArchive(const BinaryOutputArchive&) = delete;
+	auto operator=(const BinaryOutputArchive&) -> BinaryOutputArchive& = delete;
+	template <typename T> auto operator<<(const T& value) -> BinaryOutputArchive&;
+	template <typename T> auto operator&(const T& value) -> BinaryOutputArchive&;
+	auto writeBytes(const void* data, size_t length) -> void;
+	auto writeVarint(uint64_t value) -> void;
+	auto flush() -> void;
+	[[nodiscard]] auto size() const -> size_t;
+	[[nodiscard]] static constexpr auto get_library_version() -> unsigned {
+		return 0;
+	}
+
+private:
+	enum class Target { VECTOR, SPAN, STREAM };
+
+	template <typename T> auto save(const T& value) -> void;
+	template <typename T> auto saveBitwise(const T* data, size_t count) -> void;
+	auto writeStaged(const std::byte* data, size_t length) -> void;
+	Target target_;
+	std::vector<std::byte>* vector_{nullptr};
+	std::span<std::byte> span_;
+	AbstractOutputStream* stream_{nullptr};
+	std::vector<std::byte> staging_;
+	size_t used_{0};
+	size_t written_{0};
+};
+
+/// \brief Reads values written by BinaryOutputArchive from a block of bytes, with the interface of a Boost input
+/// archive.
+/// \details Every read is bounds-checked; truncated or malformed input throws std::ios_base::failure instead of
+/// reading past the block. Strings and arrays are copied out of the block, so it need not outlive the values.
+class BinaryInputArchive final
+{
+public:
+	using is_saving = boost::mpl::bool_<false>;
+	using is_loading = boost::mpl::bool_<true>;
+	explicit BinaryInputArchive(std::span<const std::byte> data);
+	template <typename T> auto operator>>(T& value) -> BinaryInputArchive&;
+	template <typename T> auto operator&(T& value) -> BinaryInputArchive&;
+	auto readBytes(void* data, size_t length) -> void;
+	auto readVarint() -> uint64_t;
+	[[nodiscard]] auto position() const -> size_t;
+	[[nodiscard]] auto remaining() const -> size_t;
+	[[nodiscard]] static constexpr auto get_library_version() -> unsigned {
+		return 0;
+	}
+
+private:
+	template <typename T> auto load(T& value) -> void;
+	template <typename T> auto loadBitwise(T* data, size_t count) -> void;
+	std::span<const std::byte> data_;
+	size_t offset_{0};
+};
+
+/// \brief Writes a value.
+/// \param value The value to write.
+/// \return This archive.
+/// \throws std::out_of_range If a fixed buffer is full.
+template <typename T> auto BinaryOutputArchive::operator<<(const T& value) -> BinaryOutputArchive& {
+	save(value);
+	return *this;
+}
+
+/// \brief Writes a value; the form used by Boost serialize functions.
+/// \param value The value to write.
+/// \return This archive.
+/// \throws std::out_of_range If a fixed buffer is full.
+template <typename T> auto BinaryOutputArchive::operator&(const T& value) -> BinaryOutputArchive& {
+	save(value);
+	return *this;
+}
+
+/// \brief Appends raw bytes.
+/// \param data The bytes to write.
+/// \param length The number of bytes.
+/// \throws std::out_of_range If a fixed buffer is full.
+inline auto BinaryOutputArchive::writeBytes(const void* data, const size_t length) -> void {
+	const auto* bytes = static_cast<const std::byte*>(data);
+	switch (target_) {
+	case Target::VECTOR:
+		vector_->insert(vector_->end(), bytes, bytes + length);
+		break;
+	case Target::SPAN:
+		if (length > span_.size() - used_) {
+			throw std::out_of_range("Binary archive buffer is full");
+		}
+		std::memcpy(span_.data() + used_, bytes, length);
+		used_ += length;
+		break;
+	case Target::STREAM:
+		if (length <= staging_.size() - used_) {
+			std::memcpy(staging_.data() + used_, bytes, length);
+			used_ += length;
+		}
+		else {
+			writeStaged(bytes, length);
+		}
+		break;
+	}
+	written_ += length;
+}
+
+/// \brief Appends an unsigned LEB128 varint.
+/// \param value The value to write.
+/// \throws std::out_of_range If a fixed buffer is full.
+inline auto BinaryOutputArchive::writeVarint(const uint64_t value) -> void {
+	std::byte encoded[Varint::MAX_LENGTH];
+	writeBytes(encoded, Varint::encode(value, encoded));
+}
+
+/// \brief Writes one value in the archive layout.
+/// \param value The value to write.
+template <typename T> auto BinaryOutputArchive::save(const T& value) -> void {
+	static_assert(!std::is_pointer_v<T>, "Pointers are not supported by the binary archive");
+	if constexpr (IsBoostNvp<std::remove_cv_t<T>>::value) {
+		save(value.value());
+	}
+	else if constexpr (std::is_same_v<T, bool>) {
+		const auto byte = static_cast<std::byte>(value ? 1 : 0);
+		writeBytes(&byte, 1);
+	}
+	else if constexpr (std::is_integral_v<T> && sizeof(T) == 1) {
+		writeBytes(&value, 1);
+	}
+	else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+		const auto wide = static_cast<int64_t>(value);
+		writeVarint((static_cast<uint64_t>(wide) << 1) ^ static_cast<uint64_t>(wide >> 63));
+	}
+	else if constexpr (std::is_integral_v<T>) {
+		writeVarint(value);
+	}
+	else if constexpr (std::is_enum_v<T>) {
+		save(static_cast<std::underlying_type_t<T>>(value));
+	}
+	else if constexpr (std::is_floating_point_v<T>) {
+		saveBitwise(&value, 1);
+	}
+	else if constexpr (std::is_same_v<T, std::string>) {
+		writeVarint(value.size());
+		writeBytes(value.data(), value.size());
+	}
+	else if constexpr (std::is_same_v<T, std::vector<bool>>) {
+		writeVarint(value.size());
+		for (const bool element : value) {
+			save(element);
+		}
+	}
+	else if constexpr (std::is_array_v<T> || IsStdArray<T>::value) {
+		using Element = std::remove_cvref_t<decltype(*std::begin(value))>;
+		if constexpr (BinaryBitwise<Element>) {
+			saveBitwise(std::data(value), std::size(value));
+		}
+		else {
+			for (const auto& element : value) {
+				save(element);
+			}
+		}
+	}
+	else if constexpr (IsStdOptional<T>::value) {
+		save(value.has_value());
+		if (value) {
+			save(*value);
+		}
+	}
+	else if constexpr (IsStdPair<T>::value) {
+		save(value.first);
+		save(value.second);
+	}
+	else if constexpr (BinarySequence<T>) {
+		writeVarint(std::ranges::size(value));
+		if constexpr (std::ranges::contiguous_range<T> && BinaryBitwise<typename T::value_type>) {
+			saveBitwise(std::ranges::data(value), std::ranges::size(value));
+		}
+		else {
+			for (const auto& element : value) {
+				save(element);
+			}
+		}
+	}
+	else if constexpr (BinaryBitwise<T>) {
+		saveBitwise(&value, 1);
+	}
+	else {
+		boost::serialization::serialize_adl(*this, const_cast<T&>(value), 0);
+	}
+}
+
+/// \brief Writes bitwise values as little-endian bytes, with one copy on little-endian hosts.
+/// \param data The values.
+/// \param count The number of values.
+template <typename T> auto BinaryOutputArchive::saveBitwise(const T* data, const size_t count) -> void {
+	if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1) {
+		writeBytes(data, count * sizeof(T));
+	}
+	else if constexpr (std::is_enum_v<T>) {
+		for (size_t i = 0; i < count; ++i) {
+			const auto value = static_cast<std::underlying_type_t<T>>(data[i]);
+			saveBitwise(&value, 1);
+		}
+	}
+	else if constexpr (std::is_arithmetic_v<T>) {
+		using Bits = std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>;
+		for (size_t i = 0; i < count; ++i) {
+			std::byte bytes[sizeof(T)];
+			LittleEndian::store(bytes, std::bit_cast<Bits>(data[i]));
+			writeBytes(bytes, sizeof(T));
+		}
+	}
+	else {
+		static_assert(std::endian::native == std::endian::little, "Bitwise classes need a little-endian host");
+	}
+}
+
+/// \brief Reads a value.
+/// \param value Receives the value.
+/// \return This archive.
+/// \throws std::ios_base::failure If the input is truncated or malformed.
+template <typename T> auto BinaryInputArchive::operator>>(T& value) -> BinaryInputArchive& {
+	load(value);
+	return *this;
+}
+
+/// \brief Reads a value; the form used by Boost serialize functions.
+/// \param value Receives the value.
+/// \return This archive.
+/// \throws std::ios_base::failure If the input is truncated or malformed.
+template <typename T> auto BinaryInputArchive::operator&(T& value) -> BinaryInputArchive& {
+	load(value);
+	return *this;
+}
+
+/// \brief Reads raw bytes.
+/// \param data Receives the bytes.
+/// \param length The number of bytes.
+/// \throws std::ios_base::failure If fewer bytes remain.
+inline auto BinaryInputArchive::readBytes(void* data, const size_t length) -> void {
+	if (length > data_.size() - offset_) {
+		throw std::ios_base::failure("Truncated binary archive");
+	}
+	std::memcpy(data, data_.data() + offset_, length);
+	offset_ += length;
+}
+
+/// \brief Reads an unsigned LEB128 varint.
+/// \return The value.
+/// \throws std::ios_base::failure If the varint is truncated or malformed.
+inline auto BinaryInputArchive::readVarint() -> uint64_t {
+	return Varint::decode(data_, offset_);
+}
+
+/// \brief Reads one value in the archive layout.
+/// \param value Receives the value.
+template <typename T> auto BinaryInputArchive::load(T& value) -> void {
+	static_assert(!std::is_pointer_v<T>, "Pointers are not supported by the binary archive");
+	if constexpr (IsBoostNvp<std::remove_cv_t<T>>::value) {
+		load(value.value());
+	}
+	else if constexpr (std::is_same_v<T, bool>) {
+		std::byte byte;
+		readBytes(&byte, 1);
+		value = byte != std::byte{0};
+	}
+	else if constexpr (std::is_integral_v<T> && sizeof(T) == 1) {
+		readBytes(&value, 1);
+	}
+	else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+		const uint64_t encoded = readVarint();
+		const auto wide = static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+		if (wide < std::numeric_limits<T>::min() || wide > std::numeric_limits<T>::max()) {
+			throw std::ios_base::failure("Binary archive value out of range");
+		}
+		value = static_cast<T>(wide);
+	}
+	else if constexpr (std::is_integral_v<T>) {
+		const uint64_t wide = readVarint();
+		if (wide > std::numeric_limits<T>::max()) {
+			throw std::ios_base::failure("Binary archive value out of range");
+		}
+		value = static_cast<T>(wide);
+	}
+	else if constexpr (std::is_enum_v<T>) {
+		std::underlying_type_t<T> underlying;
+		load(underlying);
+		value = static_cast<T>(underlying);
+	}
+	else if constexpr (std::is_floating_point_v<T>) {
+		loadBitwise(&value, 1);
+	}
+	else if constexpr (std::is_same_v<T, std::string>) {
+		const uint64_t length = readVarint();
+		if (length > remaining()) {
+			throw std::ios_base::failure("Truncated binary archive");
+		}
+		value.assign(reinterpret_cast<const char*>(data_.data() + offset_), length);
+		offset_ += length;
+	}
+	else if constexpr (std::is_same_v<T, std::vector<bool>>) {
+		const uint64_t count = readVarint();
+		if (count > remaining()) {
+			throw std::ios_base::failure("Truncated binary archive");
+		}
+		value.resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			bool element;
+			load(element);
+			value[i] = element;
+		}
+	}
+	else if constexpr (std::is_array_v<T> || IsStdArray<T>::value) {
+		using Element = std::remove_cvref_t<decltype(*std::begin(value))>;
+		if constexpr (BinaryBitwise<Element>) {
+			loadBitwise(std::data(value), std::size(value));
+		}
+		else {
+			for (auto& element : value) {
+				load(element);
+			}
+		}
+	}
+	else if constexpr (IsStdOptional<T>::value) {
+		bool present;
+		load(present);
+		if (present) {
+			load(value.emplace());
+		}
+		else {
+			value.reset();
+		}
+	}
+	else if constexpr (IsStdPair<T>::value) {
+		load(value.first);
+		load(value.second);
+	}
+	else if constexpr (BinarySequence<T>) {
+		using Element = typename T::value_type;
+		const uint64_t count = readVarint();
+		value.clear();
+		if constexpr (requires { typename T::mapped_type; }) {
+			for (uint64_t i = 0; i < count; ++i) {
+				std::pair<std::remove_const_t<typename T::key_type>, typename T::mapped_type> element;
+				load(element);
+				value.emplace_hint(value.end(), std::move(element));
+			}
+		}
+		else if constexpr (requires { typename T::key_type; }) {
+			for (uint64_t i = 0; i < count; ++i) {
+				Element element;
+				load(element);
+				value.emplace_hint(value.end(), std::move(element));
+			}
+		}
+		else if constexpr (std::ranges::contiguous_range<T> && BinaryBitwise<Element>) {
+			if (count > remaining() / sizeof(Element)) {
+				throw std::ios_base::failure("Truncated binary archive");
+			}
+			value.resize(count);
+			loadBitwise(std::ranges::data(value), count);
+		}
+		else {
+			if constexpr (requires { value.reserve(count); }) {
+				value.reserve(std::min<uint64_t>(count, remaining()));
+			}
+			for (uint64_t i = 0; i < count; ++i) {
+				load(value.emplace_back());
+			}
+		}
+	}
+	else if constexpr (BinaryBitwise<T>) {
+		loadBitwise(&value, 1);
+	}
+	else {
+		boost::serialization::serialize_adl(*this, value, 0);
+	}
+}
+
+/// \brief Reads bitwise values stored as little-endian bytes, with one copy on little-endian hosts.
+/// \param data Receives the values.
+/// \param count The number of values.
+template <typename T> auto BinaryInputArchive::loadBitwise(T* data, const size_t count) -> void {
+	if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1) {
+		if (count > remaining() / sizeof(T)) {
+			throw std::ios_base::failure("Truncated binary archive");
+		}
+		readBytes(data, count * sizeof(T));
+	}
+	else if constexpr (std::is_enum_v<T>) {
+		for (size_t i = 0; i < count; ++i) {
+			std::underlying_type_t<T> value;
+			loadBitwise(&value, 1);
+			data[i] = static_cast<T>(value);
+		}
+	}
+	else if constexpr (std::is_arithmetic_v<T>) {
+		using Bits = std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>;
+		for (size_t i = 0; i < count; ++i) {
+			std::byte bytes[sizeof(T)];
+			readBytes(bytes, sizeof(T));
+			data[i] = std::bit_cast<T>(LittleEndian::load<Bits>(bytes));
+		}
+	}
+	else {
+		static_assert(std::endian::native == std::endian::little, "Bitwise classes need a little-endian host");
+	}
+}
+}
@@ -0,0 +1,93 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <span>
+#include <vector>
+#include "BinaryArchive.hpp"
+#include "io/AbstractOutputStream.hpp"
+#include "io/interface/IfaceBoostSerializable.hpp"
+
+namespace common::io::serialize
+{
+template <typename T>concept DerivedFromBinarySerializable = std::is_base_of_v<interface::IfaceBoostSerializable<T>, T>;
+
+/// \brief Abstract class for serializing and deserializing objects in the compact binary layout of BinaryOutputArchive.
+/// \details It accepts the same types as BoostSerializer: their serializeImpl function is instantiated with the binary
+/// archives instead of the Boost ones. The output has no archive header, class information or object tracking, and
+/// arrays of bitwise values are copied in bulk, so it is smaller and faster to produce than binary_oarchive output.
+/// The two formats are not interchangeable.
+class BinarySerializer abstract
+{
+public:
+	BinarySerializer() = delete;
+	template <DerivedFromBinarySerializable T> static auto serializeObject(const T& obj) -> std::vector<std::byte>;
+	template <DerivedFromBinarySerializable T> static auto serializeObject(const T& obj, std::vector<std::byte>& buffer) -> size_t;
+	template <DerivedFromBinarySerializable T> static auto serializeObject(const T& obj, std::span<std::byte> buffer) -> size_t;
+	template <DerivedFromBinarySerializable T> static auto serializeObject(const T& obj, AbstractOutputStream& out) -> size_t;
+	template <DerivedFromBinarySerializable T> static auto deserializeObject(std::span<const std::byte> data) -> T;
+	template <DerivedFromBinarySerializable T> static auto deserializeObject(std::span<const std::byte> data, T& obj) -> size_t;
+};
+
+/// \brief Serializes an object into a new byte vector.
+/// \param obj The object to serialize.
+/// \return The serialized bytes.
+template <DerivedFromBinarySerializable T> auto BinarySerializer::serializeObject(const T& obj) -> std::vector<std::byte> {
+	std::vector<std::byte> buffer;
+	serializeObject(obj, buffer);
+	return buffer;
+}
+
+/// \brief Serializes an object at the end of a caller-provided vector.
+/// \details Reusing the vector across calls avoids reallocating it.
+/// \param obj The object to serialize.
+/// \param buffer The vector receiving the bytes.
+/// \return The number of bytes appended.
+template <DerivedFromBinarySerializable T> auto BinarySerializer::serializeObject(const T& obj, std::vector<std::byte>& buffer) -> size_t {
+	BinaryOutputArchive archive(buffer);
+	archive << obj;
+	return archive.size();
+}
+
+/// \brief Serializes an object into a caller-provided fixed buffer.
+/// \param obj The object to serialize.
+/// \param buffer The buffer receiving the bytes.
+/// \return The number of bytes written.
+/// \throws std::out_of_range If the buffer is too small; its content is then unspecified.
+template <DerivedFromBinarySerializable T> auto BinarySerializer::serializeObject(const T& obj, const std::span<std::byte> buffer) -> size_t {
+	BinaryOutputArchive archive(buffer);
+	archive << obj;
+	return archive.size();
+}
+
+/// \brief Serializes an object to an output stream, such as a ByteArrayOutputStream.
+/// \param obj The object to serialize.
+/// \param out The stream receiving the bytes; it is not flushed.
+/// \return The number of bytes written.
+template <DerivedFromBinarySerializable T> auto BinarySerializer::serializeObject(const T& obj, AbstractOutputStream& out) -> size_t {
+	BinaryOutputArchive archive(out);
+	archive << obj;
+	archive.flush();
+	return archive.size();
+}
+
+/// \brief Deserializes an object.
+/// \param data The serialized bytes.
+/// \return The deserialized object.
+/// \throws std::ios_base::failure If the data is truncated or malformed.
+template <DerivedFromBinarySerializable T> auto BinarySerializer::deserializeObject(const std::span<const std::byte> data) -> T {
+	T t = T();
+	deserializeObject(data, t);
+	return t;
+}
+
+/// \brief Deserializes into an existing object, for example to reuse its string and vector capacity.
+/// \param data The serialized bytes.
+/// \param obj The object receiving the values.
+/// \return The number of bytes consumed, so that consecutive objects can be read from one block.
+/// \throws std::ios_base::failure If the data is truncated or malformed.
+template <DerivedFromBinarySerializable T> auto BinarySerializer::deserializeObject(const std::span<const std::byte> data, T& obj) -> size_t {
+	BinaryInputArchive archive(data);
+	archive >> obj;
+	return archive.position();
+}
+}
@@ -0,0 +1,68 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include "FlatBuilder.hpp"
+#include "FlatTable.hpp"
+#include "FlatVerifier.hpp"
+
+namespace common::io::serialize
+{
+/// \brief Opens flat buffers written by FlatBuilder.
+/// \details Opening a buffer reads its root position and returns a view; no bytes are parsed or copied, so a cache
+/// file mapped with MappedFile is usable as soon as it is mapped, and only the pages actually read are loaded:
+/// \code
+/// const MappedFile file(path, MappedFile::Access::RANDOM);
+/// const auto monster = FlatBuffer::verifiedRoot<MonsterView>(file.bytes(), "MONS");
+/// \endcode
+/// The views point into the bytes, which must outlive them.
+class FlatBuffer final
+{
+public:
+	FlatBuffer() = delete;
+
+	/// \brief Returns the root table without verifying the buffer.
+	/// \tparam V FlatTable or a typed view derived from it.
+	/// \param bytes A buffer known to be valid, such as one this process wrote.
+	/// \return The root view.
+	template <typename V = FlatTable> static auto root(const std::span<const std::byte> bytes) -> V {
+		return V(bytes.data(), LittleEndian::load<uint32_t>(bytes.data()));
+	}
+
+	/// \brief Returns the file identifier of a buffer.
+	/// \param bytes The buffer.
+	/// \return The identifier, which is all zero bytes if none was written, or empty if the buffer is too small.
+	static auto identifier(const std::span<const std::byte> bytes) -> std::string_view {
+		if (bytes.size() < FlatBuilder::HEADER_SIZE) {
+			return {};
+		}
+		return {reinterpret_cast<const char*>(bytes.data() + sizeof(uint32_t)), FlatBuilder::IDENTIFIER_SIZE};
+	}
+
+	/// \brief Verifies a buffer.
+	/// \tparam V The type of the root table.
+	/// \param bytes The buffer.
+	/// \param identifier The expected identifier, or empty to accept any.
+	/// \return true if the buffer can be read through V without leaving it.
+	template <typename V = FlatTable> static auto verify(const std::span<const std::byte> bytes, const std::string_view identifier = {}) -> bool {
+		FlatVerifier verifier(bytes);
+		return verifier.verifyRoot<V>(identifier);
+	}
+
+	/// \brief Verifies a buffer and returns its root table.
+	/// \tparam V The type of the root table.
+	/// \param bytes The buffer.
+	/// \param identifier The expected identifier, or empty to accept any.
+	/// \return The root view.
+	/// \throws std::runtime_error If the buffer is not valid.
+	template <typename V = FlatTable> static auto verifiedRoot(const std::span<const std::byte> bytes, const std::string_view identifier = {}) -> V {
+		if (!verify<V>(bytes, identifier)) {
+			throw std::runtime_error("Invalid flat buffer");
+		}
+		return root<V>(bytes);
+	}
+};
+}
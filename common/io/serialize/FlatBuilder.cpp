@@ -0,0 +1,202 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "FlatBuilder.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace common::io::serialize
+{
+/// \brief Creates an empty builder.
+/// \param initialCapacity The number of bytes reserved for the buffer.
+FlatBuilder::FlatBuilder(const size_t initialCapacity) {
+	buffer_.reserve(std::max(initialCapacity, HEADER_SIZE));
+	buffer_.resize(HEADER_SIZE);
+}
+
+/// \brief Appends a string: its length, its characters and a terminating zero byte.
+/// \param value The characters.
+/// \return The position of the string.
+/// \throws std::logic_error If a table is being built or the buffer is finished.
+/// \throws std::length_error If the buffer would exceed 2 GiB.
+auto FlatBuilder::createString(const std::string_view value) -> FlatOffset<std::string_view> {
+	checkWritable();
+	align(0, sizeof(uint32_t));
+	const uint32_t position = append(sizeof(uint32_t) + value.size() + 1);
+	LittleEndian::store(buffer_.data() + position, static_cast<uint32_t>(value.size()));
+	if (!value.empty()) {
+		std::memcpy(buffer_.data() + position + sizeof(uint32_t), value.data(), value.size());
+	}
+	return {position};
+}
+
+/// \brief Starts a table; its fields are added until endTable().
+/// \throws std::logic_error If a table is already being built or the buffer is finished.
+auto FlatBuilder::startTable() -> void {
+	checkWritable();
+	fields_.clear();
+	inTable_ = true;
+}
+
+/// \brief Returns the bytes written so far, or the finished buffer.
+/// \return The buffer.
+auto FlatBuilder::bytes() const -> std::span<const std::byte> {
+	return buffer_;
+}
+
+/// \brief Returns the number of bytes written so far.
+/// \return The size of the buffer.
+auto FlatBuilder::size() const -> size_t {
+	return buffer_.size();
+}
+
+/// \brief Takes the finished buffer and clears the builder.
+/// \return The buffer.
+/// \throws std::logic_error If the buffer is not finished.
+auto FlatBuilder::release() -> std::vector<std::byte> {
+	if (!finished_) {
+		throw std::logic_error("Flat buffer not finished");
+	}
+	std::vector<std::byte> buffer = std::move(buffer_);
+	buffer_ = {};
+	clear();
+	return buffer;
+}
+
+/// \brief Discards everything written, keeping the capacity of the buffers.
+auto FlatBuilder::clear() -> void {
+	buffer_.assign(HEADER_SIZE, std::byte{0});
+	fields_.clear();
+	vtables_.clear();
+	inTable_ = false;
+	finished_ = false;
+}
+
+/// \brief Checks that objects can be appended.
+/// \throws std::logic_error If a table is being built or the buffer is finished.
+auto FlatBuilder::checkWritable() const -> void {
+	if (finished_) {
+		throw std::logic_error("Flat buffer already finished");
+	}
+	if (inTable_) {
+		throw std::logic_error("Cannot create objects while a table is being built");
+	}
+}
+
+/// \brief Checks that a table is being built.
+/// \throws std::logic_error If no table is being built.
+auto FlatBuilder::checkInTable() const -> void {
+	if (!inTable_) {
+		throw std::logic_error("No table is being built");
+	}
+}
+
+/// \brief Records a field of the current table.
+/// \param field The field.
+/// \throws std::invalid_argument If the field was already added.
+auto FlatBuilder::addField(const Field& field) -> void {
+	if (std::ranges::any_of(fields_, [&field](const Field& other) { return other.id == field.id; })) {
+		throw std::invalid_argument("Duplicate table field: " + std::to_string(field.id));
+	}
+	fields_.push_back(field);
+}
+
+/// \brief Pads the buffer with zero bytes until its size plus a skew is a multiple of an alignment.
+/// \param skew The number of bytes written before the aligned data.
+/// \param alignment The alignment, a power of two.
+auto FlatBuilder::align(const size_t skew, const size_t alignment) -> void {
+	const size_t padding = (alignment - (buffer_.size() + skew) % alignment) % alignment;
+	static_cast<void>(append(padding));
+}
+
+/// \brief Appends zero bytes.
+/// \param size The number of bytes.
+/// \return The position of the first appended byte.
+/// \throws std::length_error If the buffer would exceed 2 GiB.
+auto FlatBuilder::append(const size_t size) -> uint32_t {
+	const size_t position = buffer_.size();
+	if (size > static_cast<size_t>(INT32_MAX) - position) {
+		throw std::length_error("Flat buffer exceeds 2 GiB");
+	}
+	buffer_.resize(position + size);
+	return static_cast<uint32_t>(position);
+}
+
+/// \brief Writes the current table, reusing an identical vtable if one was written before.
+/// \details Fields are laid out by size, largest first, so that each is aligned with the least padding; the table
+/// is aligned to its largest field, which keeps every field aligned relative to the start of the buffer.
+/// \return The position of the table.
+/// \throws std::logic_error If no table is being built.
+/// \throws std::length_error If the table exceeds MAX_TABLE_SIZE bytes or the buffer would exceed 2 GiB.
+auto FlatBuilder::writeTable() -> uint32_t {
+	checkInTable();
+	std::ranges::stable_sort(fields_, std::ranges::greater{}, &Field::size);
+	size_t alignment = sizeof(int32_t);
+	size_t fieldCount = 0;
+	for (const Field& field : fields_) {
+		alignment = std::max<size_t>(alignment, field.size);
+		fieldCount = std::max<size_t>(fieldCount, field.id + 1);
+	}
+	const size_t vtableSize = 2 * sizeof(uint16_t) + fieldCount * sizeof(uint16_t);
+	vtable_.assign(fieldCount, 0);
+	size_t tableSize = sizeof(int32_t);
+	for (const Field& field : fields_) {
+		tableSize = (tableSize + field.size - 1) / field.size * field.size;
+		vtable_[field.id] = static_cast<uint16_t>(tableSize);
+		tableSize += field.size;
+	}
+	if (tableSize > MAX_TABLE_SIZE || vtableSize > MAX_TABLE_SIZE) {
+		throw std::length_error("Flat table exceeds " + std::to_string(MAX_TABLE_SIZE) + " bytes");
+	}
+	std::vector<std::byte> encoded(vtableSize);
+	LittleEndian::store(encoded.data(), static_cast<uint16_t>(vtableSize));
+	LittleEndian::store(encoded.data() + sizeof(uint16_t), static_cast<uint16_t>(tableSize));
+	for (size_t i = 0; i < fieldCount; ++i) {
+		LittleEndian::store(encoded.data() + 2 * sizeof(uint16_t) + i * sizeof(uint16_t), vtable_[i]);
+	}
+	const auto shared = std::ranges::find_if(vtables_, [this, &encoded](const uint32_t position) {
+		return LittleEndian::load<uint16_t>(buffer_.data() + position) == encoded.size() && std::memcmp(buffer_.data() + position, encoded.data(), encoded.size()) == 0;
+	});
+	uint32_t vtable;
+	if (shared != vtables_.end()) {
+		vtable = *shared;
+	}
+	else {
+		align(0, sizeof(uint16_t));
+		vtable = append(encoded.size());
+		std::memcpy(buffer_.data() + vtable, encoded.data(), encoded.size());
+		vtables_.push_back(vtable);
+	}
+	align(0, alignment);
+	const uint32_t position = append(tableSize);
+	LittleEndian::store(buffer_.data() + position, static_cast<int32_t>(position - vtable));
+	for (const Field& field : fields_) {
+		std::memcpy(buffer_.data() + position + vtable_[field.id], field.value.data(), field.size);
+	}
+	inTable_ = false;
+	return position;
+}
+
+/// \brief Writes the header and marks the buffer finished.
+/// \param root The position of the root table.
+/// \param identifier The file identifier: empty or exactly IDENTIFIER_SIZE characters.
+/// \return The finished buffer.
+/// \throws std::logic_error If a table is being built or the buffer is finished.
+/// \throws std::invalid_argument If the identifier has the wrong size or the root is not a table of this buffer.
+auto FlatBuilder::finishAt(const uint32_t root, const std::string_view identifier) -> std::span<const std::byte> {
+	checkWritable();
+	if (!identifier.empty() && identifier.size() != IDENTIFIER_SIZE) {
+		throw std::invalid_argument("Flat buffer identifier must have " + std::to_string(IDENTIFIER_SIZE) + " characters");
+	}
+	if (root < HEADER_SIZE || root >= buffer_.size()) {
+		throw std::invalid_argument("Root is not a table of this buffer");
+	}
+	LittleEndian::store(buffer_.data(), root);
+	if (!identifier.empty()) {
+		std::memcpy(buffer_.data() + sizeof(uint32_t), identifier.data(), identifier.size());
+	}
+	finished_ = true;
+	return buffer_;
+}
+}
@@ -0,0 +1,157 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "FlatTable.hpp"
+
+namespace common::io::serialize
+{
+/// \brief Builds a flat buffer that FlatTable views read in place.
+/// \details Objects are appended front to back, so strings, vectors and nested tables are created before the table
+/// that references them. A table is built between startTable() and endTable(); fields equal to their default are not
+/// stored, and tables with the same layout share one vtable. finish() writes the header: the position of the root
+/// table followed by an optional 4-byte file identifier. All values are little-endian and every scalar is aligned to
+/// its size relative to the start of the buffer, so a buffer loaded at an aligned address, such as a mapped file, is
+/// read without copying.
+/// \code
+/// FlatBuilder builder;
+/// const auto name = builder.createString("orc");
+/// const auto inventory = builder.createVector<uint8_t>(items);
+/// builder.startTable();
+/// builder.addScalar<int16_t>(MonsterView::HP, 80, 100);
+/// builder.addOffset(MonsterView::NAME, name);
+/// builder.addOffset(MonsterView::INVENTORY, inventory);
+/// const auto monster = builder.endTable<MonsterView>();
+/// const auto bytes = builder.finish(monster, "MONS");
+/// \endcode
+/// \remark The builder is reusable: clear() keeps the capacity of its buffers.
+class FlatBuilder final
+{
+public:
+	static constexpr size_t IDENTIFIER_SIZE = 4;
+	static constexpr size_t HEADER_SIZE = sizeof(uint32_t) + IDENTIFIER_SIZE;
+	static constexpr size_t MAX_TABLE_SIZE = UINT16_MAX;
+	explicit FlatBuilder(size_t initialCapacity = 1024);
+
+	auto createString(std::string_view value) -> FlatOffset<std::string_view>;
+
+	/// \brief Appends a vector of scalars.
+	/// \param values The elements.
+	/// \return The position of the vector.
+	/// \throws std::logic_error If a table is being built or the buffer is finished.
+	/// \throws std::length_error If the buffer would exceed 2 GiB.
+	template <FlatScalar T> auto createVector(const std::span<const T> values) -> FlatOffset<FlatVector<T>> {
+		checkWritable();
+		align(sizeof(uint32_t), sizeof(T) > sizeof(uint32_t) ? sizeof(T) : sizeof(uint32_t));
+		const uint32_t position = append(sizeof(uint32_t) + values.size() * sizeof(T));
+		LittleEndian::store(buffer_.data() + position, static_cast<uint32_t>(values.size()));
+		std::byte* out = buffer_.data() + position + sizeof(uint32_t);
+		for (const T& value : values) {
+			FlatScalars::store(out, value);
+			out += sizeof(T);
+		}
+		return {position};
+	}
+
+	/// \brief Appends a vector of strings or tables.
+	/// \param values The positions of the elements, created earlier.
+	/// \return The position of the vector.
+	/// \throws std::logic_error If a table is being built or the buffer is finished.
+	/// \throws std::length_error If the buffer would exceed 2 GiB.
+	template <typename T> auto createVector(const std::span<const FlatOffset<T>> values) -> FlatOffset<FlatVector<T>> {
+		checkWritable();
+		align(0, sizeof(uint32_t));
+		const uint32_t position = append(sizeof(uint32_t) + values.size() * sizeof(uint32_t));
+		LittleEndian::store(buffer_.data() + position, static_cast<uint32_t>(values.size()));
+		std::byte* out = buffer_.data() + position + sizeof(uint32_t);
+		for (const auto& value : values) {
+			LittleEndian::store(out, value.position);
+			out += sizeof(uint32_t);
+		}
+		return {position};
+	}
+
+	auto startTable() -> void;
+
+	/// \brief Adds a scalar field to the current table.
+	/// \param field The field id.
+	/// \param value The value.
+	/// \param defaultValue The value readers assume for an absent field; a value equal to it is not stored.
+	/// \throws std::logic_error If no table is being built.
+	/// \throws std::invalid_argument If the field was already added.
+	template <FlatScalar T> auto addScalar(const uint16_t field, const T value, const T defaultValue = {}) -> void {
+		checkInTable();
+		if (value == defaultValue) {
+			return;
+		}
+		Field entry{field, sizeof(T), {}};
+		FlatScalars::store(entry.value.data(), value);
+		addField(entry);
+	}
+
+	/// \brief Adds a reference to a string, vector or table to the current table.
+	/// \param field The field id.
+	/// \param value The position of the object, created before the table was started.
+	/// \throws std::logic_error If no table is being built.
+	/// \throws std::invalid_argument If the field was already added.
+	template <typename T> auto addOffset(const uint16_t field, const FlatOffset<T> value) -> void {
+		checkInTable();
+		Field entry{field, sizeof(uint32_t), {}};
+		LittleEndian::store(entry.value.data(), value.position);
+		addField(entry);
+	}
+
+	/// \brief Writes the current table and its vtable.
+	/// \tparam V The view the table is read through.
+	/// \return The position of the table.
+	/// \throws std::logic_error If no table is being built.
+	/// \throws std::length_error If the table exceeds MAX_TABLE_SIZE bytes or the buffer would exceed 2 GiB.
+	template <typename V = FlatTable> auto endTable() -> FlatOffset<V> {
+		static_assert(std::is_base_of_v<FlatTable, V>, "Tables must be viewed through FlatTable or a class derived from it");
+		return {writeTable()};
+	}
+
+	/// \brief Writes the header and finishes the buffer.
+	/// \param root The root table.
+	/// \param identifier The file identifier: empty or exactly IDENTIFIER_SIZE characters.
+	/// \return The finished buffer, valid until the builder is cleared, released or destroyed.
+	/// \throws std::logic_error If a table is being built or the buffer is finished.
+	/// \throws std::invalid_argument If the identifier has the wrong size.
+	template <typename V> auto finish(const FlatOffset<V> root, const std::string_view identifier = {}) -> std::span<const std::byte> {
+		return finishAt(root.position, identifier);
+	}
+
+	[[nodiscard]] auto bytes() const -> std::span<const std::byte>;
+	[[nodiscard]] auto size() const -> size_t;
+	auto release() -> std::vector<std::byte>;
+	auto clear() -> void;
+
+private:
+	struct Field
+	{
+		uint16_t id;
+		uint8_t size;
+		std::array<std::byte, sizeof(uint64_t)> value;
+	};
+
+	auto checkWritable() const -> void;
+	auto checkInTable() const -> void;
+	auto addField(const Field& field) -> void;
+	auto align(size_t skew, size_t alignment) -> void;
+	auto append(size_t size) -> uint32_t;
+	auto writeTable() -> uint32_t;
+	auto finishAt(uint32_t root, std::string_view identifier) -> std::span<const std::byte>;
+	std::vector<std::byte> buffer_;
+	std::vector<Field> fields_;
+	std::vector<uint16_t> vtable_;
+	std::vector<uint32_t> vtables_;
+	bool inTable_{false};
+	bool finished_{false};
+};
+}
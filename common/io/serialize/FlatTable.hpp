@@ -0,0 +1,292 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include "io/LittleEndian.hpp"
+
+namespace common::io::serialize
+{
+/// \brief Types stored inline in a flat table or vector: arithmetic types and enums of 1, 2, 4 or 8 bytes.
+template <typename T> concept FlatScalar = (std::is_arithmetic_v<T> || std::is_enum_v<T>) && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+/// \brief Stores and loads flat scalars in little-endian byte order.
+class FlatScalars final
+{
+public:
+	FlatScalars() = delete;
+
+	/// \brief Stores a scalar.
+	/// \param out The destination; must have room for sizeof(T) bytes.
+	/// \param value The value.
+	template <FlatScalar T> static auto store(std::byte* out, const T value) -> void {
+		if constexpr (std::is_same_v<T, bool>) {
+			*out = static_cast<std::byte>(value ? 1 : 0);
+		}
+		else if constexpr (std::is_enum_v<T>) {
+			store(out, static_cast<std::underlying_type_t<T>>(value));
+		}
+		else if constexpr (std::is_floating_point_v<T>) {
+			using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+			LittleEndian::store(out, std::bit_cast<Bits>(value));
+		}
+		else {
+			LittleEndian::store(out, value);
+		}
+	}
+
+	/// \brief Loads a scalar.
+	/// \param in The source; must hold sizeof(T) bytes.
+	/// \return The value.
+	template <FlatScalar T> static auto load(const std::byte* in) -> T {
+		if constexpr (std::is_same_v<T, bool>) {
+			return *in != std::byte{0};
+		}
+		else if constexpr (std::is_enum_v<T>) {
+			return static_cast<T>(load<std::underlying_type_t<T>>(in));
+		}
+		else if constexpr (std::is_floating_point_v<T>) {
+			using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+			return std::bit_cast<T>(LittleEndian::load<Bits>(in));
+		}
+		else {
+			return LittleEndian::load<T>(in);
+		}
+	}
+};
+
+/// \brief The position of an object written by FlatBuilder, typed by what it holds.
+/// \tparam T FlatTable or a view derived from it, std::string_view for strings, or FlatVector<E> for vectors.
+template <typename T> struct FlatOffset
+{
+	uint32_t position{0};
+};
+
+template <typename E> class FlatVector;
+
+/// \brief A view of a table in a flat buffer.
+/// \details A table starts with the signed 32-bit distance back to its vtable, followed by the values of its present
+/// fields. The vtable holds its own size in bytes, the inline size of the table and, for each field id, the offset of
+/// the value within the table, or 0 if the field is absent. Scalars are stored inline, aligned to their size relative
+/// to the start of the buffer; strings, vectors and nested tables are stored elsewhere and referenced by their 32-bit
+/// position in the buffer. Reading a field costs two loads and needs no parsing or allocation.
+///
+/// Typed views derive from FlatTable and name their fields:
+/// \code
+/// struct MonsterView : FlatTable
+/// {
+/// 	using FlatTable::FlatTable;
+/// 	enum Field : uint16_t { HP, NAME, INVENTORY };
+/// 	auto hp() const { return scalar<int16_t>(HP, 100); }
+/// 	auto name() const { return string(NAME); }
+/// 	auto inventory() const { return vector<uint8_t>(INVENTORY); }
+/// 	static auto verify(FlatVerifier& verifier, const MonsterView& table) -> bool {
+/// 		return verifier.verifyScalar<int16_t>(table, HP) && verifier.verifyString(table, NAME) && verifier.verifyVector<uint8_t>(table, INVENTORY);
+/// 	}
+/// };
+/// \endcode
+/// \remark Views do not check bounds; run FlatVerifier over untrusted bytes first. They hold a pointer into the
+/// buffer, which must outlive them.
+class FlatTable
+{
+public:
+	FlatTable() = default;
+
+	/// \brief Views the table at a position.
+	/// \param base The start of the buffer.
+	/// \param position The position of the table in the buffer.
+	FlatTable(const std::byte* base, const uint32_t position): base_(base), position_(position) {}
+
+	/// \brief Tests whether a field is present.
+	/// \param field The field id.
+	/// \return true if the table stores a value for the field.
+	[[nodiscard]] auto has(const uint16_t field) const -> bool {
+		return fieldOffset(field) != 0;
+	}
+
+	/// \brief Reads a scalar field.
+	/// \param field The field id.
+	/// \param defaultValue The value of an absent field.
+	/// \return The value.
+	template <FlatScalar T> [[nodiscard]] auto scalar(const uint16_t field, const T defaultValue = {}) const -> T {
+		const uint16_t offset = fieldOffset(field);
+		return offset != 0 ? FlatScalars::load<T>(base_ + position_ + offset) : defaultValue;
+	}
+
+	/// \brief Reads a string field.
+	/// \param field The field id.
+	/// \return A view of the characters in the buffer, or an empty view if the field is absent.
+	[[nodiscard]] auto string(const uint16_t field) const -> std::string_view {
+		const uint16_t offset = fieldOffset(field);
+		if (offset == 0) {
+			return {};
+		}
+		const auto position = LittleEndian::load<uint32_t>(base_ + position_ + offset);
+		return {reinterpret_cast<const char*>(base_ + position + sizeof(uint32_t)), LittleEndian::load<uint32_t>(base_ + position)};
+	}
+
+	/// \brief Reads a nested table field.
+	/// \tparam V FlatTable or a typed view derived from it.
+	/// \param field The field id.
+	/// \return The view, or std::nullopt if the field is absent.
+	template <typename V = FlatTable> [[nodiscard]] auto table(const uint16_t field) const -> std::optional<V> {
+		const uint16_t offset = fieldOffset(field);
+		if (offset == 0) {
+			return std::nullopt;
+		}
+		return V(base_, LittleEndian::load<uint32_t>(base_ + position_ + offset));
+	}
+
+	/// \brief Reads a vector field.
+	/// \tparam E The element type: a FlatScalar, std::string_view, or FlatTable or a view derived from it.
+	/// \param field The field id.
+	/// \return The vector, which is empty if the field is absent.
+	template <typename E> [[nodiscard]] auto vector(uint16_t field) const -> FlatVector<E>;
+
+	/// \brief Returns the start of the buffer.
+	/// \return The base pointer.
+	[[nodiscard]] auto base() const -> const std::byte* {
+		return base_;
+	}
+
+	/// \brief Returns the position of the table in the buffer.
+	/// \return The position.
+	[[nodiscard]] auto position() const -> uint32_t {
+		return position_;
+	}
+
+	/// \brief Returns the offset of a field within the table.
+	/// \param field The field id.
+	/// \return The offset, or 0 if the field is absent.
+	[[nodiscard]] auto fieldOffset(const uint16_t field) const -> uint16_t {
+		const std::byte* vtable = base_ + position_ - LittleEndian::load<int32_t>(base_ + position_);
+		const size_t entry = 2 * sizeof(uint16_t) + field * sizeof(uint16_t);
+		return entry < LittleEndian::load<uint16_t>(vtable) ? LittleEndian::load<uint16_t>(vtable + entry) : 0;
+	}
+
+private:
+	const std::byte* base_{nullptr};
+	uint32_t position_{0};
+};
+
+/// \brief A view of a vector in a flat buffer: a 32-bit length followed by the elements.
+/// \details Scalars are stored inline and aligned to their size; strings and tables are stored as their 32-bit
+/// positions. On little-endian hosts a vector of scalars can also be viewed as a span, without copying.
+/// \tparam E The element type: a FlatScalar, std::string_view, or FlatTable or a view derived from it.
+template <typename E> class FlatVector
+{
+	static constexpr size_t STRIDE = FlatScalar<E> ? sizeof(E) : sizeof(uint32_t);
+
+public:
+	using value_type = E;
+
+	/// \brief An input iterator over the elements.
+	class Iterator
+	{
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = E;
+		using difference_type = std::ptrdiff_t;
+		Iterator() = default;
+		Iterator(const FlatVector* vector, const uint32_t index): vector_(vector), index_(index) {}
+
+		auto operator*() const -> E {
+			return (*vector_)[index_];
+		}
+
+		auto operator++() -> Iterator& {
+			++index_;
+			return *this;
+		}
+
+		auto operator++(int) -> Iterator {
+			const Iterator copy = *this;
+			++index_;
+			return copy;
+		}
+
+		auto operator==(const Iterator& other) const -> bool {
+			return index_ == other.index_;
+		}
+
+	private:
+		const FlatVector* vector_{nullptr};
+		uint32_t index_{0};
+	};
+
+	FlatVector() = default;
+
+	/// \brief Views the vector at a position.
+	/// \param base The start of the buffer.
+	/// \param position The position of the length word in the buffer.
+	FlatVector(const std::byte* base, const uint32_t position): base_(base), position_(position), size_(LittleEndian::load<uint32_t>(base + position)) {}
+
+	[[nodiscard]] auto size() const -> uint32_t {
+		return size_;
+	}
+
+	[[nodiscard]] auto empty() const -> bool {
+		return size_ == 0;
+	}
+
+	/// \brief Reads an element.
+	/// \param index The index; not checked.
+	/// \return The element.
+	auto operator[](const uint32_t index) const -> E {
+		const std::byte* element = base_ + position_ + sizeof(uint32_t) + index * STRIDE;
+		if constexpr (FlatScalar<E>) {
+			return FlatScalars::load<E>(element);
+		}
+		else if constexpr (std::is_same_v<E, std::string_view>) {
+			const auto position = LittleEndian::load<uint32_t>(element);
+			return {reinterpret_cast<const char*>(base_ + position + sizeof(uint32_t)), LittleEndian::load<uint32_t>(base_ + position)};
+		}
+		else {
+			static_assert(std::is_base_of_v<FlatTable, E>, "Vector elements must be scalars, strings or tables");
+			return E(base_, LittleEndian::load<uint32_t>(element));
+		}
+	}
+
+	[[nodiscard]] auto begin() const -> Iterator {
+		return {this, 0};
+	}
+
+	[[nodiscard]] auto end() const -> Iterator {
+		return {this, size_};
+	}
+
+	/// \brief Views the elements in place.
+	/// \return The elements; only available for scalars on little-endian hosts, where the stored bytes are the values.
+	[[nodiscard]] auto span() const -> std::span<const E> requires (FlatScalar<E> && !std::is_same_v<E, bool> && std::endian::native == std::endian::little) {
+		if (size_ == 0) {
+			return {};
+		}
+		return {reinterpret_cast<const E*>(base_ + position_ + sizeof(uint32_t)), size_};
+	}
+
+	/// \brief Returns the position of the vector in the buffer.
+	/// \return The position of the length word.
+	[[nodiscard]] auto position() const -> uint32_t {
+		return position_;
+	}
+
+private:
+	const std::byte* base_{nullptr};
+	uint32_t position_{0};
+	uint32_t size_{0};
+};
+
+template <typename E> auto FlatTable::vector(const uint16_t field) const -> FlatVector<E> {
+	const uint16_t offset = fieldOffset(field);
+	if (offset == 0) {
+		return {};
+	}
+	return FlatVector<E>(base_, LittleEndian::load<uint32_t>(base_ + position_ + offset));
+}
+}
@@ -0,0 +1,126 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "FlatVerifier.hpp"
+#include <cstring>
+#include "FlatBuilder.hpp"
+
+namespace common::io::serialize
+{
+/// \brief Creates a verifier for a buffer.
+/// \param bytes The buffer; must outlive the verifier.
+/// \param maxDepth The deepest nesting of tables accepted.
+/// \param maxTables The most tables visited, counting a shared table once per reference; 0 allows one per 8 bytes of
+/// buffer, which is more than a buffer without shared tables can hold, since a table and its reference take 8 bytes.
+FlatVerifier::FlatVerifier(const std::span<const std::byte> bytes, const size_t maxDepth, const size_t maxTables): bytes_(bytes), maxDepth_(maxDepth), maxTables_(maxTables != 0 ? maxTables : bytes.size() / (sizeof(int32_t) + sizeof(uint32_t))) {}
+
+/// \brief Verifies a string field.
+/// \param table The table, already verified.
+/// \param field The field id.
+/// \return true if the field is absent or valid.
+auto FlatVerifier::verifyString(const FlatTable& table, const uint16_t field) const -> bool {
+	uint32_t position;
+	if (!checkReference(table, field, position)) {
+		return false;
+	}
+	return position == 0 || checkString(position);
+}
+
+/// \brief Checks the header and reads the position of the root table.
+/// \param identifier The expected identifier, or empty to accept any.
+/// \param position Receives the root position.
+/// \return true if the header is valid.
+auto FlatVerifier::checkRoot(const std::string_view identifier, uint32_t& position) const -> bool {
+	if (bytes_.size() < FlatBuilder::HEADER_SIZE || bytes_.size() > UINT32_MAX) {
+		return false;
+	}
+	if (!identifier.empty() && (identifier.size() != FlatBuilder::IDENTIFIER_SIZE || std::memcmp(bytes_.data() + sizeof(uint32_t), identifier.data(), identifier.size()) != 0)) {
+		return false;
+	}
+	position = LittleEndian::load<uint32_t>(bytes_.data());
+	return position >= FlatBuilder::HEADER_SIZE;
+}
+
+/// \brief Checks a table and its vtable.
+/// \details The table must follow the header and be aligned to 4 bytes and its vtable, aligned to 2 bytes, must lie before it. The vtable
+/// must hold at least its two size fields, and the inline size of the table must cover the vtable offset and fit in
+/// the buffer.
+/// \param position The position of the table.
+/// \return true if the table is valid.
+auto FlatVerifier::checkTable(const uint32_t position) const -> bool {
+	if (position < FlatBuilder::HEADER_SIZE || position % sizeof(uint32_t) != 0 || position > bytes_.size() - sizeof(int32_t)) {
+		return false;
+	}
+	const auto distance = LittleEndian::load<int32_t>(bytes_.data() + position);
+	if (distance <= 0 || static_cast<uint32_t>(distance) > position - FlatBuilder::HEADER_SIZE) {
+		return false;
+	}
+	const uint32_t vtable = position - static_cast<uint32_t>(distance);
+	if (vtable % sizeof(uint16_t) != 0 || position - vtable < 2 * sizeof(uint16_t)) {
+		return false;
+	}
+	const auto vtableSize = LittleEndian::load<uint16_t>(bytes_.data() + vtable);
+	const auto tableSize = LittleEndian::load<uint16_t>(bytes_.data() + vtable + sizeof(uint16_t));
+	return vtableSize >= 2 * sizeof(uint16_t) && vtableSize % sizeof(uint16_t) == 0 && vtableSize <= position - vtable && tableSize >= sizeof(int32_t) && tableSize <= bytes_.size() - position;
+}
+
+/// \brief Checks that a field lies inside its table and is aligned to its size.
+/// \param table The table, already checked.
+/// \param field The field id.
+/// \param size The size of the field.
+/// \return true if the field is absent or valid.
+auto FlatVerifier::checkField(const FlatTable& table, const uint16_t field, const size_t size) const -> bool {
+	const uint16_t offset = table.fieldOffset(field);
+	if (offset == 0) {
+		return true;
+	}
+	const std::byte* vtable = table.base() + table.position() - LittleEndian::load<int32_t>(table.base() + table.position());
+	const auto tableSize = LittleEndian::load<uint16_t>(vtable + sizeof(uint16_t));
+	return offset >= sizeof(int32_t) && offset + size <= tableSize && (table.position() + offset) % size == 0;
+}
+
+/// \brief Checks a reference field and reads its target, which must start before the table.
+/// \details A target between the start of the table and the field would let a table reference itself or a vector
+/// overlapping it, so a reader following the reference could loop forever although verification succeeded.
+/// \param table The table, already checked.
+/// \param field The field id.
+/// \param position Receives the target, or 0 if the field is absent.
+/// \return true if the field is absent or valid.
+auto FlatVerifier::checkReference(const FlatTable& table, const uint16_t field, uint32_t& position) const -> bool {
+	position = 0;
+	if (!checkField(table, field, sizeof(uint32_t))) {
+		return false;
+	}
+	const uint16_t offset = table.fieldOffset(field);
+	if (offset == 0) {
+		return true;
+	}
+	position = LittleEndian::load<uint32_t>(bytes_.data() + table.position() + offset);
+	return position >= FlatBuilder::HEADER_SIZE && position < table.position();
+}
+
+/// \brief Checks a string: an aligned length, the characters and a terminating zero byte.
+/// \param position The position of the string.
+/// \return true if the string is valid.
+auto FlatVerifier::checkString(const uint32_t position) const -> bool {
+	uint32_t size;
+	if (!checkVector(position, 1, size)) {
+		return false;
+	}
+	const size_t end = static_cast<size_t>(position) + sizeof(uint32_t) + size;
+	return end < bytes_.size() && bytes_[end] == std::byte{0};
+}
+
+/// \brief Checks a vector: an aligned length followed by elements that fit in the buffer and are aligned to their size.
+/// \param position The position of the vector.
+/// \param elementSize The size of an element.
+/// \param size Receives the number of elements.
+/// \return true if the vector is valid.
+auto FlatVerifier::checkVector(const uint32_t position, const size_t elementSize, uint32_t& size) const -> bool {
+	if (position < FlatBuilder::HEADER_SIZE || position % sizeof(uint32_t) != 0 || position > bytes_.size() - sizeof(uint32_t)) {
+		return false;
+	}
+	size = LittleEndian::load<uint32_t>(bytes_.data() + position);
+	const size_t start = static_cast<size_t>(position) + sizeof(uint32_t);
+	return start % elementSize == 0 && size <= (bytes_.size() - start) / elementSize;
+}
+}
@@ -0,0 +1,131 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include "FlatTable.hpp"
+
+namespace common::io::serialize
+{
+/// \brief Checks that the bytes of a flat buffer can be read through views without leaving the buffer.
+/// \details Every table, vtable, string and vector reached from the root is checked to lie inside the buffer, with
+/// its scalars aligned and its strings terminated. An object must start before the table or vector that references
+/// it, which is how FlatBuilder writes them; every reference then leads to a lower position, which rules out cycles,
+/// including a table that references itself. Typed views describe their fields with a static
+/// verify(FlatVerifier&, const V&) function, which is called for every table of that type. Depth and table count are
+/// bounded, so hostile input cannot exhaust the stack or make shared subtables cost exponential time.
+/// \remark Verification reads every reachable byte once, so it is the one O(n) step on load; skip it for trusted
+/// buffers such as files the process wrote itself.
+class FlatVerifier final
+{
+public:
+	static constexpr size_t DEFAULT_MAX_DEPTH = 64;
+	explicit FlatVerifier(std::span<const std::byte> bytes, size_t maxDepth = DEFAULT_MAX_DEPTH, size_t maxTables = 0);
+
+	/// \brief Verifies the root table.
+	/// \tparam V FlatTable or a typed view derived from it.
+	/// \param identifier The expected identifier, or empty to accept any.
+	/// \return true if the buffer is valid.
+	template <typename V = FlatTable> auto verifyRoot(std::string_view identifier = {}) -> bool {
+		uint32_t position;
+		if (!checkRoot(identifier, position)) {
+			return false;
+		}
+		return verifyAt<V>(position);
+	}
+
+	/// \brief Verifies a scalar field: it must lie inside the table and be aligned to its size.
+	/// \param table The table, already verified.
+	/// \param field The field id.
+	/// \return true if the field is absent or valid.
+	template <FlatScalar T> auto verifyScalar(const FlatTable& table, const uint16_t field) const -> bool {
+		return checkField(table, field, sizeof(T));
+	}
+
+	auto verifyString(const FlatTable& table, uint16_t field) const -> bool;
+
+	/// \brief Verifies a vector field and, for strings and tables, every element.
+	/// \tparam E The element type, as passed to FlatTable::vector().
+	/// \param table The table, already verified.
+	/// \param field The field id.
+	/// \return true if the field is absent or valid.
+	template <typename E> auto verifyVector(const FlatTable& table, const uint16_t field) -> bool {
+		uint32_t position;
+		if (!checkReference(table, field, position)) {
+			return false;
+		}
+		if (position == 0) {
+			return true;
+		}
+		constexpr size_t elementSize = FlatScalar<E> ? sizeof(E) : sizeof(uint32_t);
+		uint32_t size;
+		if (!checkVector(position, elementSize, size)) {
+			return false;
+		}
+		if constexpr (!FlatScalar<E>) {
+			for (uint32_t i = 0; i < size; ++i) {
+				const uint32_t element = position + static_cast<uint32_t>(sizeof(uint32_t)) + i * static_cast<uint32_t>(sizeof(uint32_t));
+				const auto target = LittleEndian::load<uint32_t>(bytes_.data() + element);
+				if (target >= position) {
+					return false;
+				}
+				if constexpr (std::is_same_v<E, std::string_view>) {
+					if (!checkString(target)) {
+						return false;
+					}
+				}
+				else if (!verifyAt<E>(target)) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	/// \brief Verifies a nested table field.
+	/// \tparam V FlatTable or a typed view derived from it.
+	/// \param table The table, already verified.
+	/// \param field The field id.
+	/// \return true if the field is absent or valid.
+	template <typename V = FlatTable> auto verifyTable(const FlatTable& table, const uint16_t field) -> bool {
+		uint32_t position;
+		if (!checkReference(table, field, position)) {
+			return false;
+		}
+		return position == 0 || verifyAt<V>(position);
+	}
+
+private:
+	template <typename V> auto verifyAt(const uint32_t position) -> bool {
+		static_assert(std::is_base_of_v<FlatTable, V>, "Tables must be viewed through FlatTable or a class derived from it");
+		if (depth_ >= maxDepth_ || tables_ >= maxTables_ || !checkTable(position)) {
+			return false;
+		}
+		++tables_;
+		if constexpr (requires(FlatVerifier& verifier, const V& view) { { V::verify(verifier, view) } -> std::convertible_to<bool>; }) {
+			++depth_;
+			const bool valid = V::verify(*this, V(bytes_.data(), position));
+			--depth_;
+			return valid;
+		}
+		else {
+			return true;
+		}
+	}
+
+	auto checkRoot(std::string_view identifier, uint32_t& position) const -> bool;
+	auto checkTable(uint32_t position) const -> bool;
+	auto checkField(const FlatTable& table, uint16_t field, size_t size) const -> bool;
+	auto checkReference(const FlatTable& table, uint16_t field, uint32_t& position) const -> bool;
+	auto checkString(uint32_t position) const -> bool;
+	auto checkVector(uint32_t position, size_t elementSize, uint32_t& size) const -> bool;
+	std::span<const std::byte> bytes_;
+	size_t maxDepth_;
+	size_t maxTables_;
+	size_t depth_{0};
+	size_t tables_{0};
+};
+}
@@ -0,0 +1,102 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "JsonDocumentPool.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace common::io::serialize
+{
+/// \brief Creates a document allocating from a new arena.
+/// \param size The size of the arena in bytes.
+JsonDocumentPool::Entry::Entry(const size_t size): arena(std::make_unique<char[]>(size)), size(size), allocator(arena.get(), size), document(&allocator) {}
+
+JsonDocumentPool::Lease::Lease(std::unique_ptr<Entry> entry): entry_(std::move(entry)) {}
+
+JsonDocumentPool::Lease::Lease(Lease&& other) noexcept = default;
+
+auto JsonDocumentPool::Lease::operator=(Lease&& other) noexcept -> Lease& {
+	if (this != &other) {
+		if (entry_ != nullptr) {
+			local().release(std::move(entry_));
+		}
+		entry_ = std::move(other.entry_);
+	}
+	return *this;
+}
+
+/// \brief Returns the document to the pool of the calling thread.
+JsonDocumentPool::Lease::~Lease() {
+	if (entry_ != nullptr) {
+		local().release(std::move(entry_));
+	}
+}
+
+/// \brief Returns the borrowed document.
+/// \return The document; it is null when first borrowed, and valid until the lease is destroyed.
+auto JsonDocumentPool::Lease::document() const -> rapidjson::Document& {
+	return entry_->document;
+}
+
+/// \brief Borrows a document from the pool of the calling thread, creating one if the pool is empty.
+/// \return The lease.
+auto JsonDocumentPool::acquire() -> Lease {
+	JsonDocumentPool& pool = local();
+	if (pool.idle_.empty()) {
+		return Lease(std::make_unique<Entry>(INITIAL_ARENA_SIZE));
+	}
+	std::unique_ptr<Entry> entry = std::move(pool.idle_.back());
+	pool.idle_.pop_back();
+	pool.retained_ -= entry->size;
+	return Lease(std::move(entry));
+}
+
+/// \brief Sets the number of arena bytes each thread may keep for idle documents; it also bounds arena growth.
+/// \param bytes The limit; 0 disables pooling.
+auto JsonDocumentPool::setRetainedLimit(const size_t bytes) -> void {
+	retainedLimit_.store(bytes, std::memory_order_relaxed);
+}
+
+/// \brief Returns the number of arena bytes each thread may keep for idle documents.
+/// \return The limit.
+auto JsonDocumentPool::retainedLimit() -> size_t {
+	return retainedLimit_.load(std::memory_order_relaxed);
+}
+
+/// \brief Returns the number of arena bytes the calling thread keeps for idle documents.
+/// \return The byte count.
+auto JsonDocumentPool::retained() -> size_t {
+	return local().retained_;
+}
+
+/// \brief Returns the pool of the calling thread.
+/// \return The pool, created on first use.
+auto JsonDocumentPool::local() -> JsonDocumentPool& {
+	thread_local JsonDocumentPool pool;
+	return pool;
+}
+
+/// \brief Resets a returned document and keeps it if the retained limit allows.
+/// \details A document overflowed its arena when the allocator holds more capacity than the arena alone provides. It is
+/// then replaced by one whose arena is the next power of two above the bytes used, with some headroom, so that a
+/// similar document fits next time.
+/// \param entry The returned document.
+auto JsonDocumentPool::release(std::unique_ptr<Entry> entry) -> void {
+	const size_t limit = retainedLimit();
+	const size_t used = entry->allocator.Size();
+	const bool overflowed = entry->allocator.Capacity() > entry->size;
+	entry->document.SetNull();
+	entry->allocator.Clear();
+	if (overflowed) {
+		const size_t size = std::bit_ceil(std::max(used + used / 4, entry->size + 1));
+		if (size > limit - std::min(limit, retained_)) {
+			return;
+		}
+		entry = std::make_unique<Entry>(size);
+	}
+	if (entry->size > limit - std::min(limit, retained_)) {
+		return;
+	}
+	retained_ += entry->size;
+	idle_.push_back(std::move(entry));
+}
+}
@@ -0,0 +1,77 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <rapidjson/document.h>
+
+namespace common::io::serialize
+{
+/// \brief A per-thread pool of rapidjson documents whose values live in reusable arenas.
+/// \details A default rapidjson::Document allocates its values from a MemoryPoolAllocator that takes a fresh 64 KiB
+/// chunk from malloc for every document and frees it when the document dies. A pooled document instead allocates
+/// from an arena handed to its MemoryPoolAllocator as the user buffer. Releasing it clears the allocator, which only
+/// rewinds the arena when the values fitted, so it costs O(1) and no call to free; the document then goes back to the
+/// pool of its thread.
+///
+/// Arenas start at INITIAL_ARENA_SIZE. When a document outgrows its arena, the extra values come from malloc as usual,
+/// and on release the arena is replaced by one large enough for that document, up to the retained limit. Each
+/// thread keeps idle documents only while their arenas total no more than the limit; the rest are freed.
+/// \code
+/// auto lease = JsonDocumentPool::acquire();
+/// rapidjson::Document& document = lease.document();
+/// document.Parse(json.data(), json.size());
+/// \endcode
+/// \remark The documents are ordinary rapidjson::Document objects, so they can be passed to
+/// IfaceJsonSerializable::deserialize. A lease must be released on the thread that acquired it. The parse stacks of
+/// rapidjson's reader still allocate; they are small and freed after each parse.
+class JsonDocumentPool final
+{
+	struct Entry
+	{
+		std::unique_ptr<char[]> arena;
+		size_t size;
+		rapidjson::MemoryPoolAllocator<> allocator;
+		rapidjson::Document document;
+		explicit Entry(size_t size);
+	};
+
+public:
+	static constexpr size_t INITIAL_ARENA_SIZE = 16 * 1024;
+	static constexpr size_t DEFAULT_RETAINED_LIMIT = 4 * 1024 * 1024;
+
+	/// \brief A document borrowed from the pool, returned when the lease is destroyed.
+	class Lease final
+	{
+	public:
+		Lease(Lease&& other) noexcept;
+		auto operator=(Lease&& other) noexcept -> Lease&;
+		Lease(const Lease&) = delete;
+		auto operator=(const Lease&) -> Lease& = delete;
+		~Lease();
+		[[nodiscard]] auto document() const -> rapidjson::Document&;
+
+	private:
+		friend class JsonDocumentPool;
+		explicit Lease(std::unique_ptr<Entry> entry);
+		std::unique_ptr<Entry> entry_;
+	};
+
+	JsonDocumentPool(const JsonDocumentPool&) = delete;
+	auto operator=(const JsonDocumentPool&) -> JsonDocumentPool& = delete;
+	static auto acquire() -> Lease;
+	static auto setRetainedLimit(size_t bytes) -> void;
+	[[nodiscard]] static auto retainedLimit() -> size_t;
+	[[nodiscard]] static auto retained() -> size_t;
+
+private:
+	JsonDocumentPool() = default;
+	static auto local() -> JsonDocumentPool&;
+	auto release(std::unique_ptr<Entry> entry) -> void;
+	std::vector<std::unique_ptr<Entry>> idle_;
+	size_t retained_{0};
+	static inline std::atomic<size_t> retainedLimit_{DEFAULT_RETAINED_LIMIT};
+};
+}
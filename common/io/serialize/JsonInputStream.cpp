@@ -0,0 +1,69 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "JsonInputStream.hpp"
+#include <stdexcept>
+
+namespace common::io::serialize
+{
+/// \brief Reads JSON text from an input stream through a buffer.
+/// \param stream The stream to read; it must outlive this object.
+/// \param bufferSize The number of bytes requested per bulk read.
+/// \throws std::invalid_argument If the buffer size is 0.
+JsonInputStream::JsonInputStream(AbstractInputStream& stream, const size_t bufferSize): stream_(&stream), buffer_(bufferSize) {
+	if (bufferSize == 0) {
+		throw std::invalid_argument("Buffer size must be positive");
+	}
+}
+
+/// \brief Reads JSON text from memory without copying it.
+/// \param bytes The text; it must stay valid while this object is used.
+JsonInputStream::JsonInputStream(const std::span<const std::byte> bytes): begin_(reinterpret_cast<const Ch*>(bytes.data())), cursor_(begin_), end_(begin_ + bytes.size()) {}
+
+/// \brief Not supported; the stream is read-only.
+/// \return nullptr.
+auto JsonInputStream::PutBegin() -> Ch* {
+	return nullptr;
+}
+
+/// \brief Not supported; the stream is read-only.
+auto JsonInputStream::Put(Ch) -> void {}
+
+/// \brief Not supported; the stream is read-only.
+auto JsonInputStream::Flush() -> void {}
+
+/// \brief Not supported; the stream is read-only.
+/// \return 0.
+auto JsonInputStream::PutEnd(Ch*) -> size_t {
+	return 0;
+}
+
+/// \brief Replaces the window with the next block of the underlying stream.
+/// \return false at the end of the input, or when reading from memory.
+auto JsonInputStream::fill() -> bool {
+	if (stream_ == nullptr) {
+		return false;
+	}
+	consumed_ += static_cast<size_t>(cursor_ - begin_);
+	const size_t bytesRead = stream_->read(buffer_, 0, buffer_.size());
+	if (bytesRead == 0 || bytesRead == static_cast<size_t>(-1)) {
+		stream_ = nullptr;
+		begin_ = cursor_ = end_ = nullptr;
+		return false;
+	}
+	begin_ = cursor_ = reinterpret_cast<const Ch*>(buffer_.data());
+	end_ = begin_ + bytesRead;
+	return true;
+}
+
+/// \brief Peek() once the window is exhausted.
+/// \return The next character, or '\0' at the end of the input.
+auto JsonInputStream::peekSlow() -> Ch {
+	return fill() ? *cursor_ : '\0';
+}
+
+/// \brief Take() once the window is exhausted.
+/// \return The next character, or '\0' at the end of the input.
+auto JsonInputStream::takeSlow() -> Ch {
+	return fill() ? *cursor_++ : '\0';
+}
+}
@@ -0,0 +1,62 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "io/AbstractInputStream.hpp"
+
+namespace common::io::serialize
+{
+/// \brief Adapts an input stream or a block of memory to the rapidjson input stream concept.
+/// \details rapidjson's Reader and Document::ParseStream pull characters one at a time through Peek() and Take(),
+/// so both are inline and touch only the current window. Over an AbstractInputStream the window is a buffer refilled
+/// with bulk reads, and memory use is bounded by its size however long the stream is; over memory, such as the bytes
+/// of a MappedFile, the window is the whole block and nothing is copied. Peek() and Take() return '\0' at the end.
+/// \remark The stream is read-only; the Put* functions exist only because rapidjson's stream concept requires them
+/// and are used by in-situ parsing, which is not supported.
+class JsonInputStream final
+{
+public:
+	using Ch = char;
+	static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+	explicit JsonInputStream(AbstractInputStream& stream, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+	explicit JsonInputStream(std::span<const std::byte> bytes);
+	JsonInputStream(const JsonInputStream&) = delete;
+	auto operator=(const JsonInputStream&) -> JsonInputStream& = delete;
+
+	/// \brief Returns the next character without consuming it.
+	/// \return The character, or '\0' at the end of the input.
+	auto Peek() -> Ch {
+		return cursor_ != end_ ? *cursor_ : peekSlow();
+	}
+
+	/// \brief Consumes the next character.
+	/// \return The character, or '\0' at the end of the input.
+	auto Take() -> Ch {
+		return cursor_ != end_ ? *cursor_++ : takeSlow();
+	}
+
+	/// \brief Returns the number of characters consumed so far.
+	/// \return The offset of the next character in the input.
+	[[nodiscard]] auto Tell() const -> size_t {
+		return consumed_ + static_cast<size_t>(cursor_ - begin_);
+	}
+
+	auto PutBegin() -> Ch*;
+	auto Put(Ch c) -> void;
+	auto Flush() -> void;
+	auto PutEnd(Ch* begin) -> size_t;
+
+private:
+	auto fill() -> bool;
+	auto peekSlow() -> Ch;
+	auto takeSlow() -> Ch;
+	AbstractInputStream* stream_{nullptr};
+	std::vector<std::byte> buffer_;
+	const Ch* begin_{nullptr};
+	const Ch* cursor_{nullptr};
+	const Ch* end_{nullptr};
+	size_t consumed_{0};
+};
+}
@@ -0,0 +1,68 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "JsonOutputStream.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace common::io::serialize
+{
+/// \brief Writes JSON text to an output stream in chunks.
+/// \param stream The stream receiving the text; it must outlive this object.
+/// \param bufferSize The size of the chunks handed to the stream.
+/// \throws std::invalid_argument If the buffer size is 0.
+JsonOutputStream::JsonOutputStream(AbstractOutputStream& stream, const size_t bufferSize): stream_(&stream), buffer_(bufferSize) {
+	if (bufferSize == 0) {
+		throw std::invalid_argument("Buffer size must be positive");
+	}
+}
+
+/// \brief Hands the pending characters to the underlying stream, which is neither flushed nor closed.
+JsonOutputStream::~JsonOutputStream() {
+	try {
+		drain();
+	}
+	catch (...) {
+		// Suppress exceptions in destructors
+	}
+}
+
+/// \brief Appends a block of text that was rendered elsewhere.
+/// \details A block that fits the free part of the chunk is copied into it; a larger one is handed to the stream
+/// directly after the pending characters.
+/// \param text The text.
+auto JsonOutputStream::write(const std::vector<std::byte>& text) -> void {
+	if (text.size() <= buffer_.size() - used_) {
+		std::copy(text.begin(), text.end(), buffer_.begin() + static_cast<std::ptrdiff_t>(used_));
+		used_ += text.size();
+		return;
+	}
+	drain();
+	stream_->write(text);
+	drained_ += text.size();
+}
+
+/// \brief Called by rapidjson after each top-level value; does nothing, the chunk is handed over when full.
+auto JsonOutputStream::Flush() -> void {}
+
+/// \brief Hands the pending characters to the underlying stream and flushes it.
+auto JsonOutputStream::flush() -> void {
+	drain();
+	stream_->flush();
+}
+
+/// \brief Returns the number of characters written so far, including those not yet handed over.
+/// \return The character count.
+auto JsonOutputStream::bytesWritten() const -> uint64_t {
+	return drained_ + used_;
+}
+
+/// \brief Writes the chunk to the underlying stream.
+auto JsonOutputStream::drain() -> void {
+	if (used_ == 0) {
+		return;
+	}
+	stream_->write(buffer_, 0, used_);
+	drained_ += used_;
+	used_ = 0;
+}
+}
@@ -0,0 +1,50 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "io/AbstractOutputStream.hpp"
+
+namespace common::io::serialize
+{
+/// \brief Adapts an output stream to the rapidjson output stream concept.
+/// \details rapidjson's Writer emits one character at a time through Put(), so Put() is inline and only appends to a
+/// fixed chunk; each full chunk is handed to the underlying stream with one bulk write. Memory use is the chunk size
+/// however much is written. The partial chunk is handed over by flush() and on destruction; rapidjson's Flush(),
+/// called after every top-level value, does nothing, so that a run of small values, such as one record per line, is
+/// still written in whole chunks.
+/// \remark The underlying stream may be a BufferedOutputStream, a FileOutputStream or a FileDescriptorOutputStream;
+/// with a chunk of at least the size of its buffer, a BufferedOutputStream passes each chunk straight through.
+class JsonOutputStream final
+{
+public:
+	using Ch = char;
+	static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+	explicit JsonOutputStream(AbstractOutputStream& stream, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+	~JsonOutputStream();
+	JsonOutputStream(const JsonOutputStream&) = delete;
+	auto operator=(const JsonOutputStream&) -> JsonOutputStream& = delete;
+
+	/// \brief Appends a character, handing the chunk to the underlying stream when it is full.
+	/// \param c The character.
+	auto Put(const Ch c) -> void {
+		if (used_ == buffer_.size()) {
+			drain();
+		}
+		buffer_[used_++] = static_cast<std::byte>(c);
+	}
+
+	auto write(const std::vector<std::byte>& text) -> void;
+	auto Flush() -> void;
+	auto flush() -> void;
+	[[nodiscard]] auto bytesWritten() const -> uint64_t;
+
+private:
+	auto drain() -> void;
+	AbstractOutputStream* stream_;
+	std::vector<std::byte> buffer_;
+	size_t used_{0};
+	uint64_t drained_{0};
+};
+}
@@ -0,0 +1,67 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "JsonRecordReader.hpp"
+
+namespace common::io::serialize
+{
+/// \brief Reads records from a stream.
+/// \param stream The stream holding the JSON array; it must outlive the reader.
+/// \param bufferSize The number of bytes read from the stream at a time.
+JsonRecordReader::JsonRecordReader(AbstractInputStream& stream, const size_t bufferSize): stream_(stream, bufferSize) {}
+
+/// \brief Reads records from a file, which is mapped into memory.
+/// \param file The file holding the JSON array.
+/// \throws std::ios_base::failure If the file cannot be opened or mapped.
+JsonRecordReader::JsonRecordReader(const std::filesystem::path& file): file_(std::make_unique<MappedFile>(file, MappedFile::Access::SEQUENTIAL)), stream_(file_->bytes()) {}
+
+/// \brief Returns the number of records read so far.
+/// \return The record count.
+auto JsonRecordReader::count() const -> uint64_t {
+	return count_;
+}
+
+/// \brief Consumes the '[' before the first record, or the ',' or ']' after a record.
+/// \return false once the closing ']' has been consumed.
+/// \throws std::runtime_error If the input is not an array.
+auto JsonRecordReader::advance() -> bool {
+	if (finished_) {
+		return false;
+	}
+	skipWhitespace();
+	if (!started_) {
+		if (stream_.Peek() != '[') {
+			fail("Expected a JSON array", stream_.Tell());
+		}
+		stream_.Take();
+		started_ = true;
+		skipWhitespace();
+		if (stream_.Peek() == ']') {
+			stream_.Take();
+			finished_ = true;
+			return false;
+		}
+		return true;
+	}
+	switch (stream_.Take()) {
+		case ',': return true;
+		case ']': finished_ = true;
+			return false;
+		default: fail("Expected ',' or ']' after record " + std::to_string(count_ - 1), stream_.Tell());
+	}
+}
+
+/// \brief Consumes JSON whitespace.
+auto JsonRecordReader::skipWhitespace() -> void {
+	for (char c = stream_.Peek(); c == ' ' || c == '\n' || c == '\r' || c == '\t'; c = stream_.Peek()) {
+		stream_.Take();
+	}
+}
+
+/// \brief Reports malformed input.
+/// \param message The description of the error.
+/// \param offset The offset in the input where the error was found.
+/// \throws std::runtime_error Always.
+auto JsonRecordReader::fail(const std::string& message, const size_t offset) const -> void {
+	throw std::runtime_error(message + " at offset " + std::to_string(offset));
+}
+}
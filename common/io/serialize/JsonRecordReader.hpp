@@ -0,0 +1,86 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <rapidjson/document.h>
+#include <rapidjson/reader.h>
+#include "JsonDocumentPool.hpp"
+#include "JsonInputStream.hpp"
+#include "JsonReflection.hpp"
+#include "JsonSaxHandler.hpp"
+#include "io/AbstractInputStream.hpp"
+#include "io/MappedFile.hpp"
+#include "io/interface/IfaceJsonSerializable.hpp"
+
+namespace common::io::serialize
+{
+/// \brief Iterates over the records of a top-level JSON array one at a time.
+/// \details Each call to next() parses exactly one element with rapidjson's SAX Reader, stopping at its end, so only
+/// the current record is ever in memory however large the file is. Reflected types (see JsonReflectable) are filled
+/// straight from the parse events through JsonSaxHandler; IfaceJsonSerializable types are given a pooled document
+/// holding only their record. A file is read through a read-only memory mapping; any other input through a JsonInputStream
+/// buffer.
+/// \code
+/// JsonRecordReader reader("students.json");
+/// for (Student student; reader.next(student);) {
+/// 	...
+/// }
+/// \endcode
+class JsonRecordReader final
+{
+public:
+	explicit JsonRecordReader(AbstractInputStream& stream, size_t bufferSize = JsonInputStream::DEFAULT_BUFFER_SIZE);
+	explicit JsonRecordReader(const std::filesystem::path& file);
+	template <typename T> auto next(T& record) -> bool;
+	[[nodiscard]] auto count() const -> uint64_t;
+
+private:
+	auto advance() -> bool;
+	auto skipWhitespace() -> void;
+	[[noreturn]] auto fail(const std::string& message, size_t offset) const -> void;
+	std::unique_ptr<MappedFile> file_;
+	JsonInputStream stream_;
+	rapidjson::Reader reader_;
+	JsonSaxHandler handler_;
+	uint64_t count_{0};
+	bool started_{false};
+	bool finished_{false};
+};
+
+/// \brief Reads the next record.
+/// \details A reflected record is updated in place, so members absent from the JSON keep their values; pass a fresh
+/// or reset object to get defaults.
+/// \tparam T The record type, JsonReflectable or derived from IfaceJsonSerializable.
+/// \param record Receives the record.
+/// \return false after the last record.
+/// \throws std::runtime_error If the input is not a JSON array or a record is malformed.
+template <typename T> auto JsonRecordReader::next(T& record) -> bool {
+	static_assert(JsonReflectable<T> || std::is_base_of_v<interface::IfaceJsonSerializable, T>, "Records must be JsonReflectable or IfaceJsonSerializable");
+	if (!advance()) {
+		return false;
+	}
+	if constexpr (JsonReflectable<T>) {
+		handler_.reset(jsonSaxSlot(record));
+		if (const rapidjson::ParseResult result = reader_.Parse<rapidjson::kParseStopWhenDoneFlag>(stream_, handler_); result.IsError()) {
+			fail("JSON parse error in record " + std::to_string(count_), result.Offset());
+		}
+	}
+	else {
+		const auto lease = JsonDocumentPool::acquire();
+		rapidjson::Document& document = lease.document();
+		if (document.ParseStream<rapidjson::kParseStopWhenDoneFlag>(stream_).HasParseError()) {
+			fail("JSON parse error in record " + std::to_string(count_), document.GetErrorOffset());
+		}
+		if (document.IsObject()) {
+			record.deserialize(document);
+		}
+	}
+	++count_;
+	return true;
+}
+}
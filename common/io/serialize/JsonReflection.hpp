@@ -0,0 +1,447 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include "io/interface/IfaceJsonSerializable.hpp"
+
+namespace common::io::serialize
+{
+/// \brief Describes one member of a reflected type: its JSON key and a pointer to the member.
+/// \tparam C The class holding the member.
+/// \tparam M The type of the member.
+template <typename C, typename M> struct JsonField
+{
+	std::string_view name;
+	M C::* member;
+};
+
+/// \brief Creates a field descriptor.
+/// \param name The JSON key of the member.
+/// \param member A pointer to the member.
+/// \return The descriptor.
+template <typename C, typename M> constexpr auto jsonField(const std::string_view name, M C::* member) -> JsonField<C, M> {
+	return {name, member};
+}
+
+/// \brief Types that describe their members with a static constexpr jsonFields() function returning a tuple of
+/// JsonField descriptors.
+/// \details For example:
+/// \code
+/// struct Config
+/// {
+/// 	std::string host;
+/// 	int port{80};
+/// 	static constexpr auto jsonFields() {
+/// 		return std::tuple{jsonField("host", &Config::host), jsonField("port", &Config::port)};
+/// 	}
+/// };
+/// \endcode
+template <typename T> concept JsonReflectable = requires { std::tuple_size<decltype(T::jsonFields())>::value; };
+
+/// \brief Reads and writes reflected types, generating both directions from their field descriptors.
+/// \details Writing emits the fields in declaration order. Reading walks the members of the JSON object once; each
+/// key is hashed with a perfect hash built at compile time from the field names, compared once against the single
+/// candidate field and converted straight into the member. Lookup therefore costs one hash per key instead of a
+/// linear FindMember per field.
+///
+/// Supported member types are bool, integers, floating-point values, enums (as their underlying integer),
+/// std::string, std::optional (null when empty), sequences (arrays), maps with string keys (objects), nested
+/// reflectable types and IfaceJsonSerializable types. As with JsonSerializer::getIntOrDefault and friends, a member
+/// whose key is missing, or whose value has the wrong type or is out of range, keeps its current value; unknown keys
+/// are ignored.
+/// \remark Reflected types and IfaceJsonStreamable types are written straight to any writer. Other
+/// IfaceJsonSerializable types can only write to a Writer<StringBuffer>, so for any other writer each object is
+/// rendered whole into a per-thread buffer and then copied to the writer; the buffer keeps at most
+/// RETAINED_BUFFER_SIZE bytes of capacity between objects.
+class JsonReflection final
+{
+public:
+	JsonReflection() = delete;
+	template <typename Writer, JsonReflectable T> static auto write(Writer& writer, const T& object) -> void;
+	template <JsonReflectable T> static auto read(const rapidjson::Value& json, T& object) -> bool;
+	template <typename Writer, typename V> static auto writeValue(Writer& writer, const V& value) -> void;
+	template <typename V> static auto readValue(const rapidjson::Value& json, V& value) -> bool;
+	template <JsonReflectable T> static auto fieldIndex(std::string_view key) -> size_t;
+	static constexpr auto hash(std::string_view key, uint32_t seed) -> uint32_t;
+
+private:
+	static constexpr size_t RETAINED_BUFFER_SIZE = 64 * 1024;
+	template <JsonReflectable T> struct KeyTable;
+	template <typename T> static constexpr auto fieldNames();
+	template <typename T> static constexpr auto buildKeyTable();
+};
+
+/// \brief The perfect hash of the field names of a type.
+/// \details A hash-and-displace (CHD) table: the hash of a key selects a bucket, and the displacement stored for the
+/// bucket moves its keys to distinct slots. slots maps a slot to a field index, or to EMPTY when no field is placed
+/// there. Both the bucket and the slot are derived from one hash of the key.
+template <JsonReflectable T> struct JsonReflection::KeyTable
+{
+	static constexpr size_t COUNT = std::tuple_size_v<decltype(T::jsonFields())>;
+	static constexpr size_t CAPACITY = std::bit_ceil(std::max<size_t>(2 * COUNT, 1));
+	static constexpr size_t BUCKETS = std::bit_ceil(std::max<size_t>(COUNT / 4, 1));
+	static constexpr uint32_t SEEDS = 64;
+	static constexpr uint16_t EMPTY = std::numeric_limits<uint16_t>::max();
+	static_assert(CAPACITY < EMPTY, "Too many JSON fields for a 16-bit key table");
+	using Reader = auto (*)(const rapidjson::Value& json, T& object) -> bool;
+
+	uint32_t seed{0};
+	std::array<uint16_t, BUCKETS> displacements{};
+	std::array<uint16_t, CAPACITY> slots{};
+	std::array<std::string_view, COUNT> names{};
+
+	/// \brief Selects the bucket of a key hash.
+	/// \param hash The hash of the key.
+	/// \return The bucket.
+	static constexpr auto bucket(const uint32_t hash) -> size_t {
+		return (hash >> 16) & (BUCKETS - 1);
+	}
+
+	/// \brief Places a key hash with a displacement.
+	/// \details The step is odd and the capacity a power of two, so the displacements of one key reach every slot.
+	/// \param hash The hash of the key.
+	/// \param displacement The displacement of the bucket of the key.
+	/// \return The slot.
+	static constexpr auto place(const uint32_t hash, const uint32_t displacement) -> size_t {
+		return (hash + displacement * ((hash >> 8) | 1U)) & (CAPACITY - 1);
+	}
+};
+
+/// \brief Hashes a key: 32-bit FNV-1a of the seed followed by the key, with a final mix of the high bits.
+/// \param key The key.
+/// \param seed The seed chosen for the type.
+/// \return The hash.
+constexpr auto JsonReflection::hash(const std::string_view key, const uint32_t seed) -> uint32_t {
+	uint32_t value = 2166136261U ^ seed;
+	for (const char c : key) {
+		value = (value ^ static_cast<unsigned char>(c)) * 16777619U;
+	}
+	return value ^ (value >> 15);
+}
+
+/// \brief Collects the field names of a type.
+/// \return The names in declaration order.
+template <typename T> constexpr auto JsonReflection::fieldNames() {
+	return std::apply([](const auto&... fields) {
+		return std::array<std::string_view, sizeof...(fields)>{fields.name...};
+	}, T::jsonFields());
+}
+
+/// \brief Builds the perfect hash of the field names of a type.
+/// \details The keys are grouped into buckets of about four by their hash, and the buckets are placed largest first:
+/// for each, the first displacement that moves all of its keys to free slots is kept. The table is half full, so a
+/// displacement is usually found within a few tries and the work grows linearly with the number of fields, which
+/// keeps the compile-time evaluation well within the constexpr step limits of the compilers. Equal names share a
+/// bucket, so duplicates are found by comparing the names within each bucket. Should two distinct keys of a bucket
+/// collide under every displacement, the search restarts with the next of SEEDS seeds.
+/// \return The key table.
+/// \throws std::logic_error If two fields share a name or no perfect hash is found; at compile time this is an error.
+template <typename T> constexpr auto JsonReflection::buildKeyTable() {
+	using Table = KeyTable<T>;
+	Table table;
+	table.names = fieldNames<T>();
+	std::array<uint32_t, Table::COUNT> hashes{};
+	std::array<size_t, Table::COUNT> members{};
+	std::array<size_t, Table::COUNT> placed{};
+	for (uint32_t seed = 0; seed < Table::SEEDS; ++seed) {
+		std::array<size_t, Table::BUCKETS> sizes{};
+		std::array<size_t, Table::BUCKETS + 1> offsets{};
+		size_t largest = 0;
+		for (size_t i = 0; i < Table::COUNT; ++i) {
+			hashes[i] = hash(table.names[i], seed);
+			largest = std::max(largest, ++sizes[Table::bucket(hashes[i])]);
+		}
+		for (size_t bucket = 0; bucket < Table::BUCKETS; ++bucket) {
+			offsets[bucket + 1] = offsets[bucket] + sizes[bucket];
+		}
+		std::array<size_t, Table::BUCKETS> filled{};
+		for (size_t i = 0; i < Table::COUNT; ++i) {
+			const size_t bucket = Table::bucket(hashes[i]);
+			members[offsets[bucket] + filled[bucket]++] = i;
+		}
+		for (size_t bucket = 0; bucket < Table::BUCKETS; ++bucket) {
+			for (size_t k = offsets[bucket]; k < offsets[bucket + 1]; ++k) {
+				for (size_t l = offsets[bucket]; l < k; ++l) {
+					if (hashes[members[k]] == hashes[members[l]] && table.names[members[k]] == table.names[members[l]]) {
+						throw std::logic_error("Duplicate JSON field name");
+					}
+				}
+			}
+		}
+		table.slots.fill(Table::EMPTY);
+		bool perfect = true;
+		for (size_t size = largest; size > 0 && perfect; --size) {
+			for (size_t bucket = 0; bucket < Table::BUCKETS && perfect; ++bucket) {
+				if (sizes[bucket] != size) {
+					continue;
+				}
+				const size_t first = offsets[bucket];
+				perfect = false;
+				for (uint32_t displacement = 0; displacement < Table::CAPACITY && !perfect; ++displacement) {
+					perfect = true;
+					for (size_t k = 0; k < size && perfect; ++k) {
+						placed[k] = Table::place(hashes[members[first + k]], displacement);
+						perfect = table.slots[placed[k]] == Table::EMPTY && std::find(placed.begin(), placed.begin() + k, placed[k]) == placed.begin() + k;
+					}
+					if (perfect) {
+						table.displacements[bucket] = static_cast<uint16_t>(displacement);
+						for (size_t k = 0; k < size; ++k) {
+							table.slots[placed[k]] = static_cast<uint16_t>(members[first + k]);
+						}
+					}
+				}
+			}
+		}
+		if (perfect) {
+			table.seed = seed;
+			return table;
+		}
+	}
+	throw std::logic_error("No perfect hash found for the JSON field names");
+}
+
+/// \brief Writes a reflected object as a JSON object.
+/// \param writer A rapidjson Writer or PrettyWriter.
+/// \param object The object to write.
+template <typename Writer, JsonReflectable T> auto JsonReflection::write(Writer& writer, const T& object) -> void {
+	writer.StartObject();
+	std::apply([&](const auto&... fields) {
+		((writer.Key(fields.name.data(), static_cast<rapidjson::SizeType>(fields.name.size())), writeValue(writer, object.*fields.member)), ...);
+	}, T::jsonFields());
+	writer.EndObject();
+}
+
+/// \brief Reads a JSON object into a reflected object.
+/// \param json The JSON value.
+/// \param object The object receiving the members.
+/// \return false if the value is not an object; the object is then unchanged.
+template <JsonReflectable T> auto JsonReflection::read(const rapidjson::Value& json, T& object) -> bool {
+	using Table = KeyTable<T>;
+	static constexpr auto readers = []<size_t... I>(std::index_sequence<I...>) {
+		return std::array<typename Table::Reader, Table::COUNT>{[](const rapidjson::Value& value, T& target) -> bool {
+			constexpr auto member = std::get<I>(T::jsonFields()).member;
+			return readValue(value, target.*member);
+		}...};
+	}(std::make_index_sequence<Table::COUNT>{});
+	if (!json.IsObject()) {
+		return false;
+	}
+	for (auto it = json.MemberBegin(); it != json.MemberEnd(); ++it) {
+		if (const size_t index = fieldIndex<T>({it->name.GetString(), it->name.GetStringLength()}); index < Table::COUNT) {
+			readers[index](it->value, object);
+		}
+	}
+	return true;
+}
+
+/// \brief Finds the field of a reflected type with the given JSON key.
+/// \details The key is hashed once with the perfect hash of the type and compared against the single candidate.
+/// \param key The JSON key.
+/// \return The index of the field in jsonFields(), or the number of fields if no field has the key.
+template <JsonReflectable T> auto JsonReflection::fieldIndex(const std::string_view key) -> size_t {
+	using Table = KeyTable<T>;
+	static constexpr Table table = buildKeyTable<T>();
+	const uint32_t keyHash = hash(key, table.seed);
+	const uint16_t index = table.slots[Table::place(keyHash, table.displacements[Table::bucket(keyHash)])];
+	return index != Table::EMPTY && table.names[index] == key ? index : Table::COUNT;
+}
+
+/// \brief Writes one member value.
+/// \param writer A rapidjson Writer or PrettyWriter.
+/// \param value The value to write.
+template <typename Writer, typename V> auto JsonReflection::writeValue(Writer& writer, const V& value) -> void {
+	if constexpr (std::is_same_v<V, bool>) {
+		writer.Bool(value);
+	}
+	else if constexpr (std::is_integral_v<V> && std::is_signed_v<V>) {
+		if constexpr (sizeof(V) <= sizeof(int)) {
+			writer.Int(value);
+		}
+		else {
+			writer.Int64(value);
+		}
+	}
+	else if constexpr (std::is_integral_v<V>) {
+		if constexpr (sizeof(V) <= sizeof(unsigned)) {
+			writer.Uint(value);
+		}
+		else {
+			writer.Uint64(value);
+		}
+	}
+	else if constexpr (std::is_floating_point_v<V>) {
+		writer.Double(static_cast<double>(value));
+	}
+	else if constexpr (std::is_enum_v<V>) {
+		writeValue(writer, static_cast<std::underlying_type_t<V>>(value));
+	}
+	else if constexpr (std::is_same_v<V, std::string>) {
+		writer.String(value.data(), static_cast<rapidjson::SizeType>(value.size()));
+	}
+	else if constexpr (requires { value.has_value(); *value; }) {
+		if (value) {
+			writeValue(writer, *value);
+		}
+		else {
+			writer.Null();
+		}
+	}
+	else if constexpr (JsonReflectable<V>) {
+		write(writer, value);
+	}
+	else if constexpr (std::is_base_of_v<interface::IfaceJsonSerializable, V>) {
+		if constexpr (requires { value.serializeTo(writer); }) {
+			value.serializeTo(writer);
+		}
+		else if constexpr (std::is_base_of_v<rapidjson::Writer<rapidjson::StringBuffer>, Writer>) {
+			value.serialize(writer);
+		}
+		else {
+			// serialize() only takes a Writer<StringBuffer>; render into a per-thread buffer and splice the text in.
+			// After a large object the buffer is released, so the thread does not keep its capacity.
+			thread_local rapidjson::StringBuffer buffer;
+			buffer.Clear();
+			rapidjson::Writer<rapidjson::StringBuffer> bufferWriter(buffer);
+			value.serialize(bufferWriter);
+			writer.RawValue(buffer.GetString(), buffer.GetSize(), rapidjson::kObjectType);
+			if (buffer.GetSize() > RETAINED_BUFFER_SIZE) {
+				buffer.Clear();
+				buffer.ShrinkToFit();
+			}
+		}
+	}
+	else if constexpr (requires { typename V::mapped_type; }) {
+		static_assert(std::is_same_v<typename V::key_type, std::string>, "Map members need string keys");
+		writer.StartObject();
+		for (const auto& [key, element] : value) {
+			writer.Key(key.data(), static_cast<rapidjson::SizeType>(key.size()));
+			writeValue(writer, element);
+		}
+		writer.EndObject();
+	}
+	else if constexpr (std::ranges::range<V>) {
+		writer.StartArray();
+		for (const auto& element : value) {
+			writeValue(writer, element);
+		}
+		writer.EndArray();
+	}
+	else {
+		static_assert(sizeof(V) == 0, "Unsupported JSON member type");
+	}
+}
+
+/// \brief Reads one member value.
+/// \param json The JSON value.
+/// \param value Receives the value.
+/// \return false if the JSON value has the wrong type or is out of range; the value is then unchanged.
+template <typename V> auto JsonReflection::readValue(const rapidjson::Value& json, V& value) -> bool {
+	if constexpr (std::is_same_v<V, bool>) {
+		if (!json.IsBool()) {
+			return false;
+		}
+		value = json.GetBool();
+	}
+	else if constexpr (std::is_integral_v<V> && std::is_signed_v<V>) {
+		if (!json.IsInt64()) {
+			return false;
+		}
+		const int64_t wide = json.GetInt64();
+		if (wide < std::numeric_limits<V>::min() || wide > std::numeric_limits<V>::max()) {
+			return false;
+		}
+		value = static_cast<V>(wide);
+	}
+	else if constexpr (std::is_integral_v<V>) {
+		if (!json.IsUint64()) {
+			return false;
+		}
+		const uint64_t wide = json.GetUint64();
+		if (wide > std::numeric_limits<V>::max()) {
+			return false;
+		}
+		value = static_cast<V>(wide);
+	}
+	else if constexpr (std::is_floating_point_v<V>) {
+		if (!json.IsNumber()) {
+			return false;
+		}
+		value = static_cast<V>(json.GetDouble());
+	}
+	else if constexpr (std::is_enum_v<V>) {
+		std::underlying_type_t<V> underlying{};
+		if (!readValue(json, underlying)) {
+			return false;
+		}
+		value = static_cast<V>(underlying);
+	}
+	else if constexpr (std::is_same_v<V, std::string>) {
+		if (!json.IsString()) {
+			return false;
+		}
+		value.assign(json.GetString(), json.GetStringLength());
+	}
+	else if constexpr (requires { value.has_value(); value.emplace(); }) {
+		if (json.IsNull()) {
+			value.reset();
+			return true;
+		}
+		typename V::value_type element{};
+		if (!readValue(json, element)) {
+			return false;
+		}
+		value = std::move(element);
+	}
+	else if constexpr (JsonReflectable<V>) {
+		return read(json, value);
+	}
+	else if constexpr (std::is_base_of_v<interface::IfaceJsonSerializable, V>) {
+		if (!json.IsObject()) {
+			return false;
+		}
+		value.deserialize(json);
+	}
+	else if constexpr (requires { typename V::mapped_type; }) {
+		if (!json.IsObject()) {
+			return false;
+		}
+		value.clear();
+		for (auto it = json.MemberBegin(); it != json.MemberEnd(); ++it) {
+			typename V::mapped_type element{};
+			readValue(it->value, element);
+			value.emplace(std::string(it->name.GetString(), it->name.GetStringLength()), std::move(element));
+		}
+	}
+	else if constexpr (requires { value.clear(); value.emplace_back(); }) {
+		if (!json.IsArray()) {
+			return false;
+		}
+		value.clear();
+		if constexpr (requires { value.reserve(json.Size()); }) {
+			value.reserve(json.Size());
+		}
+		for (auto it = json.Begin(); it != json.End(); ++it) {
+			readValue(*it, value.emplace_back());
+		}
+	}
+	else {
+		static_assert(sizeof(V) == 0, "Unsupported JSON member type");
+	}
+	return true;
+}
+}
@@ -0,0 +1,203 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "JsonSaxHandler.hpp"
+#include <charconv>
+#include <utility>
+#include "JsonDocumentPool.hpp"
+
+namespace common::io::serialize
+{
+/// \brief Creates a handler that discards everything until reset() gives it a target.
+JsonSaxHandler::JsonSaxHandler(): captureWriter_(captureBuffer_) {}
+
+/// \brief Creates a handler writing into a slot.
+/// \param root The slot receiving the top-level value.
+JsonSaxHandler::JsonSaxHandler(const JsonSaxSlot root): root_(root), captureWriter_(captureBuffer_) {}
+
+/// \brief Prepares the handler for another parse.
+/// \param root The slot receiving the next top-level value.
+auto JsonSaxHandler::reset(const JsonSaxSlot root) -> void {
+	root_ = root;
+	pending_ = {};
+	stack_.clear();
+	skipDepth_ = 0;
+	capture_ = {};
+	captureDepth_ = 0;
+}
+
+/// \brief Receives a null value.
+auto JsonSaxHandler::Null() -> bool {
+	return captureDepth_ > 0 ? captureWriter_.Null() : scalar({.type = JsonSaxValue::Type::NUL, .boolean = false, .int64 = 0, .uint64 = 0, .number = 0, .string = {}});
+}
+
+/// \brief Receives a boolean value.
+auto JsonSaxHandler::Bool(const bool value) -> bool {
+	return captureDepth_ > 0 ? captureWriter_.Bool(value) : scalar({.type = JsonSaxValue::Type::BOOL, .boolean = value, .int64 = 0, .uint64 = 0, .number = 0, .string = {}});
+}
+
+/// \brief Receives an integer that fits an int.
+auto JsonSaxHandler::Int(const int value) -> bool {
+	return Int64(value);
+}
+
+/// \brief Receives an integer that fits an unsigned int.
+auto JsonSaxHandler::Uint(const unsigned value) -> bool {
+	return Uint64(value);
+}
+
+/// \brief Receives an integer that fits an int64_t.
+auto JsonSaxHandler::Int64(const int64_t value) -> bool {
+	return captureDepth_ > 0 ? captureWriter_.Int64(value) : scalar({.type = JsonSaxValue::Type::INT64, .boolean = false, .int64 = value, .uint64 = 0, .number = 0, .string = {}});
+}
+
+/// \brief Receives an integer that fits a uint64_t.
+auto JsonSaxHandler::Uint64(const uint64_t value) -> bool {
+	return captureDepth_ > 0 ? captureWriter_.Uint64(value) : scalar({.type = JsonSaxValue::Type::UINT64, .boolean = false, .int64 = 0, .uint64 = value, .number = 0, .string = {}});
+}
+
+/// \brief Receives a floating-point number.
+auto JsonSaxHandler::Double(const double value) -> bool {
+	return captureDepth_ > 0 ? captureWriter_.Double(value) : scalar({.type = JsonSaxValue::Type::DOUBLE, .boolean = false, .int64 = 0, .uint64 = 0, .number = value, .string = {}});
+}
+
+/// \brief Receives a number as text, as rapidjson reports it under kParseNumbersAsStringsFlag.
+/// \details The text is converted to the narrowest of int64, uint64 and double that holds it.
+auto JsonSaxHandler::RawNumber(const char* str, const rapidjson::SizeType length, const bool copy) -> bool {
+	if (captureDepth_ > 0) {
+		return captureWriter_.RawNumber(str, length, copy);
+	}
+	const char* last = str + length;
+	if (int64_t value; std::from_chars(str, last, value).ptr == last) {
+		return Int64(value);
+	}
+	if (uint64_t value; std::from_chars(str, last, value).ptr == last) {
+		return Uint64(value);
+	}
+	double value = 0;
+	std::from_chars(str, last, value);
+	return Double(value);
+}
+
+/// \brief Receives a string value.
+auto JsonSaxHandler::String(const char* str, const rapidjson::SizeType length, const bool copy) -> bool {
+	return captureDepth_ > 0 ? captureWriter_.String(str, length, copy) : scalar({.type = JsonSaxValue::Type::STRING, .boolean = false, .int64 = 0, .uint64 = 0, .number = 0, .string = {str, length}});
+}
+
+/// \brief Receives the start of an object.
+auto JsonSaxHandler::StartObject() -> bool {
+	return start(false);
+}
+
+/// \brief Receives the key of an object member and resolves the slot of its value.
+auto JsonSaxHandler::Key(const char* str, const rapidjson::SizeType length, const bool copy) -> bool {
+	if (captureDepth_ > 0) {
+		return captureWriter_.Key(str, length, copy);
+	}
+	if (skipDepth_ == 0) {
+		const JsonSaxSlot& object = stack_.back().slot;
+		pending_ = object.binding->member(object.target, {str, length});
+	}
+	return true;
+}
+
+/// \brief Receives the end of an object.
+auto JsonSaxHandler::EndObject(rapidjson::SizeType) -> bool {
+	return end(false);
+}
+
+/// \brief Receives the start of an array.
+auto JsonSaxHandler::StartArray() -> bool {
+	return start(true);
+}
+
+/// \brief Receives the end of an array.
+auto JsonSaxHandler::EndArray(rapidjson::SizeType) -> bool {
+	return end(true);
+}
+
+/// \brief Returns the slot of the value that arrives next: the root, the next array element or the member named
+/// by the last key.
+/// \return The slot, which is empty if the value is to be discarded.
+auto JsonSaxHandler::next() -> JsonSaxSlot {
+	if (stack_.empty()) {
+		return std::exchange(root_, {});
+	}
+	if (const JsonSaxSlot& top = stack_.back().slot; stack_.back().array) {
+		return top.binding->element(top.target);
+	}
+	return std::exchange(pending_, {});
+}
+
+/// \brief Stores a scalar into the next slot, unless a value is being skipped.
+/// \param value The scalar.
+/// \return true; a mismatched value is skipped rather than failing the parse.
+auto JsonSaxHandler::scalar(const JsonSaxValue& value) -> bool {
+	if (skipDepth_ == 0) {
+		if (const JsonSaxSlot slot = next(); slot.binding != nullptr) {
+			slot.binding->scalar(slot.target, value);
+		}
+	}
+	return true;
+}
+
+/// \brief Opens an object or an array: fills the next slot, skips the value if the slot does not accept it, or
+/// starts collecting it for an IfaceJsonSerializable member.
+/// \param array Whether the value is an array.
+/// \return false if the collecting writer fails.
+auto JsonSaxHandler::start(const bool array) -> bool {
+	if (captureDepth_ > 0) {
+		++captureDepth_;
+		return array ? captureWriter_.StartArray() : captureWriter_.StartObject();
+	}
+	if (skipDepth_ > 0) {
+		++skipDepth_;
+		return true;
+	}
+	const JsonSaxSlot slot = next();
+	JsonSaxSlot container;
+	if (slot.binding != nullptr) {
+		container = array ? slot.binding->beginArray(slot.target) : slot.binding->beginObject(slot.target);
+	}
+	if (container.binding == nullptr) {
+		skipDepth_ = 1;
+		return true;
+	}
+	if (container.binding->deserialize != nullptr) {
+		capture_ = container;
+		captureDepth_ = 1;
+		captureBuffer_.Clear();
+		captureWriter_.Reset(captureBuffer_);
+		return captureWriter_.StartObject();
+	}
+	stack_.push_back({container, array});
+	return true;
+}
+
+/// \brief Closes an object or an array; a collected object is parsed and handed to its member.
+/// \param array Whether the value is an array.
+/// \return false if the collected text cannot be parsed.
+auto JsonSaxHandler::end(const bool array) -> bool {
+	if (captureDepth_ > 0) {
+		if (!(array ? captureWriter_.EndArray() : captureWriter_.EndObject())) {
+			return false;
+		}
+		if (--captureDepth_ > 0) {
+			return true;
+		}
+		const auto lease = JsonDocumentPool::acquire();
+		rapidjson::Document& document = lease.document();
+		if (document.Parse(captureBuffer_.GetString(), captureBuffer_.GetSize()).HasParseError()) {
+			return false;
+		}
+		capture_.binding->deserialize(capture_.target, document);
+		capture_ = {};
+		return true;
+	}
+	if (skipDepth_ > 0) {
+		--skipDepth_;
+		return true;
+	}
+	stack_.pop_back();
+	return true;
+}
+}
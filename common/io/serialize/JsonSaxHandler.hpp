@@ -0,0 +1,267 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include "JsonReflection.hpp"
+
+namespace common::io::serialize
+{
+/// \brief A scalar SAX event.
+struct JsonSaxValue
+{
+	enum class Type { NUL, BOOL, INT64, UINT64, DOUBLE, STRING };
+	Type type{Type::NUL};
+	bool boolean{false};
+	int64_t int64{0};
+	uint64_t uint64{0};
+	double number{0};
+	std::string_view string;
+};
+
+struct JsonSaxBinding;
+
+/// \brief A value the SAX handler writes into: a target object and the binding that knows its type.
+/// \details A slot without a binding discards the value.
+struct JsonSaxSlot
+{
+	void* target{nullptr};
+	const JsonSaxBinding* binding{nullptr};
+};
+
+/// \brief The type-erased operations the SAX handler applies to a slot, generated for each type by JsonSaxBinder.
+struct JsonSaxBinding
+{
+	/// Stores a scalar; returns false and leaves the target unchanged if the value does not fit.
+	bool (*scalar)(void* target, const JsonSaxValue& value);
+	/// Prepares the target for the members of an object; returns the slot receiving them, or an empty slot.
+	JsonSaxSlot (*beginObject)(void* target);
+	/// Returns the slot of the member with the given key, or an empty slot for an unknown key.
+	JsonSaxSlot (*member)(void* target, std::string_view key);
+	/// Prepares the target for the elements of an array; returns the slot receiving them, or an empty slot.
+	JsonSaxSlot (*beginArray)(void* target);
+	/// Appends an element and returns its slot.
+	JsonSaxSlot (*element)(void* target);
+	/// For IfaceJsonSerializable types, which read a DOM: deserializes the object collected for the target.
+	void (*deserialize)(void* target, const rapidjson::Value& json);
+};
+
+template <typename V> struct JsonSaxBinder;
+
+/// \brief Creates the slot of a value.
+/// \param value The value.
+/// \return The slot writing into the value.
+template <typename V> auto jsonSaxSlot(V& value) -> JsonSaxSlot {
+	return {&value, &JsonSaxBinder<V>::BINDING};
+}
+
+/// \brief Generates the binding of a type, applying the conversion rules of JsonReflection::readValue.
+/// \tparam V The type of the target.
+template <typename V> struct JsonSaxBinder
+{
+	static constexpr bool OBJECT = JsonReflectable<V> || std::is_base_of_v<interface::IfaceJsonSerializable, V> || requires { typename V::mapped_type; };
+	static constexpr bool ARRAY = !OBJECT && requires(V& value) { value.clear(); value.emplace_back(); };
+
+	static auto scalar(void* target, const JsonSaxValue& value) -> bool {
+		auto& object = *static_cast<V*>(target);
+		using Type = JsonSaxValue::Type;
+		if constexpr (std::is_same_v<V, bool>) {
+			if (value.type != Type::BOOL) {
+				return false;
+			}
+			object = value.boolean;
+		}
+		else if constexpr (std::is_integral_v<V> && std::is_signed_v<V>) {
+			if (value.type == Type::INT64 && value.int64 >= std::numeric_limits<V>::min() && value.int64 <= std::numeric_limits<V>::max()) {
+				object = static_cast<V>(value.int64);
+			}
+			else if (value.type == Type::UINT64 && value.uint64 <= static_cast<std::make_unsigned_t<V>>(std::numeric_limits<V>::max())) {
+				object = static_cast<V>(value.uint64);
+			}
+			else {
+				return false;
+			}
+		}
+		else if constexpr (std::is_integral_v<V>) {
+			if (value.type == Type::UINT64 && value.uint64 <= std::numeric_limits<V>::max()) {
+				object = static_cast<V>(value.uint64);
+			}
+			else if (value.type == Type::INT64 && value.int64 >= 0 && static_cast<uint64_t>(value.int64) <= std::numeric_limits<V>::max()) {
+				object = static_cast<V>(value.int64);
+			}
+			else {
+				return false;
+			}
+		}
+		else if constexpr (std::is_floating_point_v<V>) {
+			switch (value.type) {
+				case Type::INT64: object = static_cast<V>(value.int64);
+					break;
+				case Type::UINT64: object = static_cast<V>(value.uint64);
+					break;
+				case Type::DOUBLE: object = static_cast<V>(value.number);
+					break;
+				default: return false;
+			}
+		}
+		else if constexpr (std::is_enum_v<V>) {
+			std::underlying_type_t<V> underlying{};
+			if (!JsonSaxBinder<std::underlying_type_t<V>>::scalar(&underlying, value)) {
+				return false;
+			}
+			object = static_cast<V>(underlying);
+		}
+		else if constexpr (std::is_same_v<V, std::string>) {
+			if (value.type != Type::STRING) {
+				return false;
+			}
+			object.assign(value.string);
+		}
+		else if constexpr (requires { object.has_value(); object.emplace(); }) {
+			if (value.type == Type::NUL) {
+				object.reset();
+				return true;
+			}
+			typename V::value_type element{};
+			if (!JsonSaxBinder<typename V::value_type>::scalar(&element, value)) {
+				return false;
+			}
+			object = std::move(element);
+		}
+		else {
+			return false;
+		}
+		return true;
+	}
+
+	static auto beginObject(void* target) -> JsonSaxSlot {
+		auto& object = *static_cast<V*>(target);
+		if constexpr (JsonReflectable<V> || std::is_base_of_v<interface::IfaceJsonSerializable, V>) {
+			return jsonSaxSlot(object);
+		}
+		else if constexpr (requires { typename V::mapped_type; }) {
+			static_assert(std::is_same_v<typename V::key_type, std::string>, "Map members need string keys");
+			object.clear();
+			return jsonSaxSlot(object);
+		}
+		else if constexpr (requires { object.has_value(); object.emplace(); }) {
+			if constexpr (JsonSaxBinder<typename V::value_type>::OBJECT) {
+				return JsonSaxBinder<typename V::value_type>::beginObject(&object.emplace());
+			}
+		}
+		return {};
+	}
+
+	static auto member(void* target, const std::string_view key) -> JsonSaxSlot {
+		auto& object = *static_cast<V*>(target);
+		if constexpr (JsonReflectable<V>) {
+			static constexpr auto slots = []<size_t... I>(std::index_sequence<I...>) {
+				return std::array<JsonSaxSlot (*)(V&), sizeof...(I)>{[](V& owner) -> JsonSaxSlot {
+					constexpr auto field = std::get<I>(V::jsonFields()).member;
+					return jsonSaxSlot(owner.*field);
+				}...};
+			}(std::make_index_sequence<std::tuple_size_v<decltype(V::jsonFields())>>{});
+			const size_t index = JsonReflection::fieldIndex<V>(key);
+			return index < slots.size() ? slots[index](object) : JsonSaxSlot{};
+		}
+		else if constexpr (requires { typename V::mapped_type; }) {
+			return jsonSaxSlot(object[std::string(key)]);
+		}
+		else {
+			return {};
+		}
+	}
+
+	static auto beginArray(void* target) -> JsonSaxSlot {
+		auto& object = *static_cast<V*>(target);
+		if constexpr (ARRAY) {
+			object.clear();
+			return jsonSaxSlot(object);
+		}
+		else if constexpr (requires { object.has_value(); object.emplace(); }) {
+			if constexpr (JsonSaxBinder<typename V::value_type>::ARRAY) {
+				return JsonSaxBinder<typename V::value_type>::beginArray(&object.emplace());
+			}
+		}
+		return {};
+	}
+
+	static auto element(void* target) -> JsonSaxSlot {
+		if constexpr (ARRAY) {
+			return jsonSaxSlot(static_cast<V*>(target)->emplace_back());
+		}
+		else {
+			return {};
+		}
+	}
+
+	static auto deserialize(void* target, const rapidjson::Value& json) -> void {
+		if constexpr (std::is_base_of_v<interface::IfaceJsonSerializable, V>) {
+			static_cast<V*>(target)->deserialize(json);
+		}
+	}
+
+	static constexpr JsonSaxBinding BINDING{&scalar, &beginObject, &member, &beginArray, &element, std::is_base_of_v<interface::IfaceJsonSerializable, V> && !JsonReflectable<V> ? &deserialize : nullptr};
+};
+
+/// \brief A rapidjson SAX handler that writes parse events straight into an object, without building a DOM.
+/// \details The handler keeps a stack of the objects and arrays being filled. A key is resolved to its member with
+/// the perfect hash of JsonReflection, and each scalar is converted into the member as it arrives, so memory use does
+/// not depend on the size of the input. The conversion rules are those of JsonReflection::readValue: unknown keys are
+/// skipped, and a value of the wrong type or out of range is skipped and leaves its member unchanged. Members that
+/// implement IfaceJsonSerializable read a DOM; their object alone is collected and parsed into a document.
+/// \remark One handler can be reused for many parses with reset(), keeping its buffers.
+class JsonSaxHandler final
+{
+public:
+	JsonSaxHandler();
+	explicit JsonSaxHandler(JsonSaxSlot root);
+
+	template <typename T> explicit JsonSaxHandler(T& root): JsonSaxHandler(jsonSaxSlot(root)) {}
+
+	auto reset(JsonSaxSlot root) -> void;
+	auto Null() -> bool;
+	auto Bool(bool value) -> bool;
+	auto Int(int value) -> bool;
+	auto Uint(unsigned value) -> bool;
+	auto Int64(int64_t value) -> bool;
+	auto Uint64(uint64_t value) -> bool;
+	auto Double(double value) -> bool;
+	auto RawNumber(const char* str, rapidjson::SizeType length, bool copy) -> bool;
+	auto String(const char* str, rapidjson::SizeType length, bool copy) -> bool;
+	auto StartObject() -> bool;
+	auto Key(const char* str, rapidjson::SizeType length, bool copy) -> bool;
+	auto EndObject(rapidjson::SizeType memberCount) -> bool;
+	auto StartArray() -> bool;
+	auto EndArray(rapidjson::SizeType elementCount) -> bool;
+
+private:
+	struct Frame
+	{
+		JsonSaxSlot slot;
+		bool array;
+	};
+
+	auto next() -> JsonSaxSlot;
+	auto scalar(const JsonSaxValue& value) -> bool;
+	auto start(bool array) -> bool;
+	auto end(bool array) -> bool;
+	JsonSaxSlot root_;
+	JsonSaxSlot pending_;
+	std::vector<Frame> stack_;
+	size_t skipDepth_{0};
+	JsonSaxSlot capture_;
+	size_t captureDepth_{0};
+	rapidjson::StringBuffer captureBuffer_;
+	rapidjson::Writer<rapidjson::StringBuffer> captureWriter_;
+};
+}
@@ -10,8 +10,8 @@ namespace common::io::serialize
 /// \param defaultValue the default value to return if the key doesn't exist or is not a string.
 /// \return the retrieved string value, or the default value if the key doesn't exist or is not a string.
 auto JsonSerializer::getStringOrDefault(const rapidjson::Value& json, const char* key, const std::string& defaultValue) -> std::string {
-	if (json.HasMember(key) && json[key].IsString()) {
-		return json[key].GetString();
+	if (const auto it = json.FindMember(key); it != json.MemberEnd() && it->value.IsString()) {
+		return it->value.GetString();
 	}
 	return defaultValue;
 }
@@ -22,8 +22,8 @@ auto JsonSerializer::getStringOrDefault(const rapidjson::Value& json, const char
 /// \param defaultValue the default value to return if the key doesn't exist or is not an integer.
 /// \return the retrieved integer value, or the default value if the key doesn't exist or is not an integer.
 auto JsonSerializer::getIntOrDefault(const rapidjson::Value& json, const char* key, const int defaultValue) -> int {
-	if (json.HasMember(key) && json[key].IsInt()) {
-		return json[key].GetInt();
+	if (const auto it = json.FindMember(key); it != json.MemberEnd() && it->value.IsInt()) {
+		return it->value.GetInt();
 	}
 	return defaultValue;
 }
@@ -34,8 +34,8 @@ auto JsonSerializer::getIntOrDefault(const rapidjson::Value& json, const char* k
 /// \param defaultValue the default value to return if the key doesn't exist or is not a double.
 /// \return the retrieved double value, or the default value if the key doesn't exist or is not a double.
 auto JsonSerializer::getDoubleOrDefault(const rapidjson::Value& json, const char* key, const double defaultValue) -> double {
-	if (json.HasMember(key) && json[key].IsDouble()) {
-		return json[key].GetDouble();
+	if (const auto it = json.FindMember(key); it != json.MemberEnd() && it->value.IsDouble()) {
+		return it->value.GetDouble();
 	}
 	return defaultValue;
 }
@@ -46,8 +46,8 @@ auto JsonSerializer::getDoubleOrDefault(const rapidjson::Value& json, const char
 /// \param defaultValue the default value to return if the key doesn't exist or is not a boolean.
 /// \return the retrieved boolean value, or the default value if the key doesn't exist or is not a boolean.
 auto JsonSerializer::getBoolOrDefault(const rapidjson::Value& json, const char* key, const bool defaultValue) -> bool {
-	if (json.HasMember(key) && json[key].IsBool()) {
-		return json[key].GetBool();
+	if (const auto it = json.FindMember(key); it != json.MemberEnd() && it->value.IsBool()) {
+		return it->value.GetBool();
 	}
 	return defaultValue;
 }
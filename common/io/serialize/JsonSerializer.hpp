@@ -1,11 +1,24 @@
 // Created by author ethereal on 2024/11/20.
 // Copyright (c) 2024 ethereal. All rights reserved.
 #pragma once
-#include <fstream>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <ranges>
 #include <string>
+#include <string_view>
 #include <rapidjson/document.h>
 #include <rapidjson/prettywriter.h>
+#include <rapidjson/reader.h>
 #include <rapidjson/stringbuffer.h>
+#include "JsonDocumentPool.hpp"
+#include "JsonInputStream.hpp"
+#include "JsonReflection.hpp"
+#include "JsonSaxHandler.hpp"
+#include "JsonStreamWriter.hpp"
+#include "io/AbstractInputStream.hpp"
+#include "io/FileInputStream.hpp"
+#include "io/MappedFile.hpp"
 #include "io/interface/IfaceJsonSerializable.hpp"
 
 namespace common::io::serialize
@@ -15,6 +28,12 @@ template <typename T>concept DerivedFromJsonSerializable = std::is_base_of_v<int
 /// \brief Class JsonSerializer abstract
 /// \details This class is an abstract class which provides static methods to serialize and deserialize objects to and
 /// from JSON files. It is used by the Student class to save and load student objects to and from JSON files.
+/// \remark Types describing their fields with jsonFields() (see JsonReflectable) are converted with toJson() and
+/// fromJson() without hand-written serialize and deserialize functions.
+/// \remark Files are written and parsed as streams, never through a whole-file string; only an IfaceJsonSerializable
+/// type that does not implement IfaceJsonStreamable is rendered whole into a buffer before it is written. Reflected
+/// types are loaded with the SAX Reader straight into the object, without a DOM; JsonRecordReader iterates over a
+/// top-level array of records. Documents are borrowed from the JsonDocumentPool of the calling thread.
 class JsonSerializer abstract
 {
 public:
@@ -29,43 +48,157 @@ public:
 	static auto serializeField(rapidjson::Writer<rapidjson::StringBuffer>& writer, const char* key, int value) -> void;
 	static auto serializeField(rapidjson::Writer<rapidjson::StringBuffer>& writer, const char* key, double value) -> void;
 	static auto serializeField(rapidjson::Writer<rapidjson::StringBuffer>& writer, const char* key, bool value) -> void;
+	template <JsonReflectable T> static auto toJson(const T& entity) -> std::string;
+	template <JsonReflectable T> static auto fromJson(std::string_view json) -> T;
+	template <typename T> static auto saveToJsonFile(const T& entity, const std::filesystem::path& file, JsonStreamWriter::Format format = JsonStreamWriter::Format::COMPACT) -> void;
+	template <std::ranges::input_range R> static auto saveArrayToJsonFile(R&& records, const std::filesystem::path& file, JsonStreamWriter::Format format = JsonStreamWriter::Format::COMPACT) -> uint64_t;
+	template <typename T> static auto loadFromJsonFile(const std::filesystem::path& file) -> T;
+	template <typename T> static auto loadFromJsonStream(AbstractInputStream& stream) -> T;
+
+private:
+	template <typename T> static auto loadFromJson(JsonInputStream& stream) -> T;
 };
 
 /// \brief Saves a student object to a JSON file.
+/// \details The text is written to the file as it is generated, without an intermediate string, if the type implements
+/// IfaceJsonStreamable or is reflected; otherwise serialize() renders it into a buffer first.
 /// \tparam T type of the student object, must be derived from JsonSerializable.
 /// \param entity the student object to be saved.
 /// \param filename the name of the file to save.
 template <DerivedFromJsonSerializable T> auto JsonSerializer::saveStudentToJsonFile(const T& entity, const std::string& filename) -> void {
-	rapidjson::StringBuffer buffer;
-	rapidjson::PrettyWriter writer(buffer);
-	entity.serialize(writer);
-	std::ofstream ofs(filename);
-	if (!ofs) {
+	std::unique_ptr<JsonStreamWriter> writer;
+	try {
+		writer = std::make_unique<JsonStreamWriter>(std::filesystem::path(filename), JsonStreamWriter::Format::PRETTY);
+	}
+	catch (const std::ios_base::failure&) {
 		throw std::runtime_error("Failed to open file for writing: " + filename);
 	}
-	ofs << buffer.GetString();
-	ofs.close();
+	writer->write(entity);
+	writer->close();
+}
+
+/// \brief Saves an object to a JSON file, streaming the text to the file as it is generated.
+/// \tparam T type of the object: JsonReflectable, derived from IfaceJsonSerializable, or any other type
+/// JsonReflection::writeValue supports.
+/// \param entity the object to be saved.
+/// \param file the file to write, replaced if it exists.
+/// \param format whether the text is compact or indented.
+/// \throws std::ios_base::failure If the file cannot be written.
+template <typename T> auto JsonSerializer::saveToJsonFile(const T& entity, const std::filesystem::path& file, const JsonStreamWriter::Format format) -> void {
+	JsonStreamWriter writer(file, format);
+	writer.write(entity);
+	writer.close();
+}
+
+/// \brief Saves a range of records to a JSON file as a top-level array.
+/// \details Records are written one at a time as the range is consumed, so memory use does not grow with their number.
+/// \param records the records.
+/// \param file the file to write, replaced if it exists.
+/// \param format whether the text is compact or indented.
+/// \return the number of records written.
+/// \throws std::ios_base::failure If the file cannot be written.
+template <std::ranges::input_range R> auto JsonSerializer::saveArrayToJsonFile(R&& records, const std::filesystem::path& file, const JsonStreamWriter::Format format) -> uint64_t {
+	JsonStreamWriter writer(file, format);
+	const uint64_t count = writer.writeArray(std::forward<R>(records));
+	writer.close();
+	return count;
 }
 
 /// \brief Loads a student object from a JSON file.
+/// \details The file is parsed as it is read, through a FileInputStream, instead of being read into a string first.
 /// \tparam T type of the student object, must be derived from JsonSerializable.
 /// \param filename the name of the file to load.
 /// \return the loaded student object.
 template <DerivedFromJsonSerializable T> auto JsonSerializer::loadStudentFromJsonFile(const std::string& filename) -> T {
-	T entity{};
-	std::ifstream ifs(filename);
-	if (!ifs) {
+	std::unique_ptr<FileInputStream> file;
+	try {
+		file = std::make_unique<FileInputStream>(filename);
+	}
+	catch (const std::ios_base::failure&) {
 		throw std::runtime_error("Failed to open file for reading: " + filename);
 	}
-	const std::string jsonStr{std::istreambuf_iterator(ifs), std::istreambuf_iterator<char>()};
-	ifs.close();
-	rapidjson::Document document;
-	if (document.Parse(jsonStr.c_str()).HasParseError()) {
-		throw std::runtime_error("JSON parse error!");
+	return loadFromJsonStream<T>(*file);
+}
+
+/// \brief Loads an object from a JSON file through a read-only memory mapping.
+/// \details The mapped pages are parsed in place, so the only memory used beyond the object is the page cache, and
+/// reflected types are loaded without a DOM.
+/// \tparam T type of the object, JsonReflectable or derived from IfaceJsonSerializable.
+/// \param file the file to load.
+/// \return the loaded object.
+/// \throws std::ios_base::failure If the file cannot be opened or mapped.
+/// \throws std::runtime_error If the file is not valid JSON.
+template <typename T> auto JsonSerializer::loadFromJsonFile(const std::filesystem::path& file) -> T {
+	const MappedFile mapping(file, MappedFile::Access::SEQUENTIAL);
+	JsonInputStream stream(mapping.bytes());
+	return loadFromJson<T>(stream);
+}
+
+/// \brief Loads an object from JSON text read from a stream.
+/// \details The stream is read in blocks of JsonInputStream::DEFAULT_BUFFER_SIZE bytes as the parser advances.
+/// \tparam T type of the object, JsonReflectable or derived from IfaceJsonSerializable.
+/// \param stream the stream to read.
+/// \return the loaded object.
+/// \throws std::runtime_error If the text is not valid JSON.
+template <typename T> auto JsonSerializer::loadFromJsonStream(AbstractInputStream& stream) -> T {
+	JsonInputStream input(stream);
+	return loadFromJson<T>(input);
+}
+
+/// \brief Parses one JSON value into an object: with the SAX Reader for reflected types, or into a document handed
+/// to deserialize() otherwise.
+/// \tparam T type of the object, JsonReflectable or derived from IfaceJsonSerializable.
+/// \param stream the JSON text.
+/// \return the loaded object.
+/// \throws std::runtime_error If the text is not valid JSON.
+template <typename T> auto JsonSerializer::loadFromJson(JsonInputStream& stream) -> T {
+	static_assert(JsonReflectable<T> || DerivedFromJsonSerializable<T>, "T must be JsonReflectable or IfaceJsonSerializable");
+	T entity{};
+	if constexpr (JsonReflectable<T>) {
+		JsonSaxHandler handler(entity);
+		rapidjson::Reader reader;
+		if (reader.Parse(stream, handler).IsError()) {
+			throw std::runtime_error("JSON parse error!");
+		}
 	}
-	if (document.IsObject()) {
-		entity.deserialize(document);
+	else {
+		const auto lease = JsonDocumentPool::acquire();
+		rapidjson::Document& document = lease.document();
+		if (document.ParseStream(stream).HasParseError()) {
+			throw std::runtime_error("JSON parse error!");
+		}
+		if (document.IsObject()) {
+			entity.deserialize(document);
+		}
 	}
 	return entity;
 }
+
+/// \brief Serializes a reflected object to a compact JSON string.
+/// \tparam T type of the object, must describe its fields with jsonFields().
+/// \param entity the object to serialize.
+/// \return the JSON text.
+template <JsonReflectable T> auto JsonSerializer::toJson(const T& entity) -> std::string {
+	rapidjson::StringBuffer buffer;
+	rapidjson::Writer writer(buffer);
+	JsonReflection::write(writer, entity);
+	return {buffer.GetString(), buffer.GetSize()};
+}
+
+/// \brief Deserializes a reflected object from JSON text.
+/// \details Fields missing from the text keep the values of a default-constructed object.
+/// \tparam T type of the object, must describe its fields with jsonFields().
+/// \param json the JSON text.
+/// \return the deserialized object.
+/// \throws std::runtime_error If the text is not valid JSON.
+template <JsonReflectable T> auto JsonSerializer::fromJson(const std::string_view json) -> T {
+	const auto lease = JsonDocumentPool::acquire();
+	rapidjson::Document& document = lease.document();
+	if (document.Parse(json.data(), json.size()).HasParseError()) {
+		throw std::runtime_error("JSON parse error!");
+	}
+	T entity{};
+	JsonReflection::read(document, entity);
+	return entity;
+}
 }
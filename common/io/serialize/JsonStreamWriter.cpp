@@ -0,0 +1,110 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "JsonStreamWriter.hpp"
+#include <ios>
+#include "io/FileOutputStream.hpp"
+
+namespace common::io::serialize
+{
+/// \brief Writes JSON to a stream.
+/// \param stream The stream receiving the text, such as a BufferedOutputStream or a FileDescriptorOutputStream; it
+/// must outlive the writer, which neither closes it nor flushes it before flush() or close().
+/// \param format Whether the text is compact or indented.
+/// \param bufferSize The size of the chunks handed to the stream.
+JsonStreamWriter::JsonStreamWriter(AbstractOutputStream& stream, const Format format, const size_t bufferSize): stream_(std::make_unique<JsonOutputStream>(stream, bufferSize)) {
+	if (format == Format::PRETTY) {
+		writer_.emplace<1>(*stream_);
+	}
+	else {
+		writer_.emplace<0>(*stream_);
+	}
+}
+
+/// \brief Writes JSON to a file, replacing its content.
+/// \param file The file.
+/// \param format Whether the text is compact or indented.
+/// \param bufferSize The size of the chunks written to the file.
+/// \throws std::ios_base::failure If the file cannot be created.
+JsonStreamWriter::JsonStreamWriter(const std::filesystem::path& file, const Format format, const size_t bufferSize): file_(std::make_unique<FileOutputStream>(file)) {
+	stream_ = std::make_unique<JsonOutputStream>(*file_, bufferSize);
+	if (format == Format::PRETTY) {
+		writer_.emplace<1>(*stream_);
+	}
+	else {
+		writer_.emplace<0>(*stream_);
+	}
+}
+
+JsonStreamWriter::~JsonStreamWriter() {
+	try {
+		close();
+	}
+	catch (...) {
+		// Suppress exceptions in destructors
+	}
+}
+
+/// \brief Opens a top-level array; its elements are written with append().
+/// \throws std::logic_error If an array is already open.
+/// \throws std::ios_base::failure If the writer is closed.
+auto JsonStreamWriter::beginArray() -> void {
+	checkOpen();
+	if (inArray_) {
+		throw std::logic_error("An array is already open");
+	}
+	std::visit([&](auto& writer) {
+		writer.Reset(*stream_);
+		writer.StartArray();
+	}, writer_);
+	inArray_ = true;
+}
+
+/// \brief Closes the array opened by beginArray().
+/// \throws std::logic_error If no array is open.
+/// \throws std::ios_base::failure If the writer is closed.
+auto JsonStreamWriter::endArray() -> void {
+	checkOpen();
+	if (!inArray_) {
+		throw std::logic_error("No array open");
+	}
+	std::visit([](auto& writer) {
+		writer.EndArray();
+	}, writer_);
+	inArray_ = false;
+}
+
+/// \brief Hands the pending text to the stream and flushes it.
+/// \throws std::ios_base::failure If the writer is closed.
+auto JsonStreamWriter::flush() -> void {
+	checkOpen();
+	stream_->flush();
+}
+
+/// \brief Flushes the pending text; a file opened by the writer is closed as well. An open array is left unclosed.
+auto JsonStreamWriter::close() -> void {
+	if (stream_ == nullptr) {
+		return;
+	}
+	stream_->flush();
+	closedBytes_ = stream_->bytesWritten();
+	stream_.reset();
+	if (file_ != nullptr) {
+		file_->close();
+		file_.reset();
+	}
+}
+
+/// \brief Returns the number of characters written so far.
+/// \return The character count, including text not yet handed to the stream.
+auto JsonStreamWriter::bytesWritten() const -> uint64_t {
+	return stream_ != nullptr ? stream_->bytesWritten() : closedBytes_;
+}
+
+/// \brief Checks that the writer is open.
+/// \throws std::ios_base::failure If the writer is closed.
+auto JsonStreamWriter::checkOpen() const -> void {
+	if (stream_ == nullptr) {
+		throw std::ios_base::failure("Stream closed");
+	}
+}
+}
@@ -0,0 +1,102 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <ranges>
+#include <variant>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/writer.h>
+#include "JsonOutputStream.hpp"
+#include "JsonReflection.hpp"
+#include "io/AbstractOutputStream.hpp"
+
+namespace common::io::serialize
+{
+/// \brief Writes JSON straight to an output stream as it is generated.
+/// \details The text goes through a JsonOutputStream chunk to the stream, with no intermediate document or string, so
+/// memory use stays at the chunk size however much is written. Values are written with JsonReflection::writeValue:
+/// reflected types, IfaceJsonSerializable types and everything else it supports. For large arrays, records are
+/// appended one at a time between beginArray() and endArray(), or taken from a range by writeArray().
+/// IfaceJsonSerializable types that do not implement IfaceJsonStreamable are the exception: each of their objects
+/// is rendered whole into a buffer before it reaches the stream.
+/// \code
+/// JsonStreamWriter writer("students.json");
+/// writer.writeArray(students);
+/// writer.close();
+/// \endcode
+/// \remark If the stream fails mid-value, the text written so far is incomplete and the writer should be discarded.
+class JsonStreamWriter final
+{
+public:
+	enum class Format { COMPACT, PRETTY };
+	explicit JsonStreamWriter(AbstractOutputStream& stream, Format format = Format::COMPACT, size_t bufferSize = JsonOutputStream::DEFAULT_BUFFER_SIZE);
+	explicit JsonStreamWriter(const std::filesystem::path& file, Format format = Format::COMPACT, size_t bufferSize = JsonOutputStream::DEFAULT_BUFFER_SIZE);
+	~JsonStreamWriter();
+	JsonStreamWriter(const JsonStreamWriter&) = delete;
+	auto operator=(const JsonStreamWriter&) -> JsonStreamWriter& = delete;
+	template <typename T> auto write(const T& value) -> void;
+	auto beginArray() -> void;
+	template <typename T> auto append(const T& record) -> void;
+	auto endArray() -> void;
+	template <std::ranges::input_range R> auto writeArray(R&& records) -> uint64_t;
+	auto flush() -> void;
+	auto close() -> void;
+	[[nodiscard]] auto bytesWritten() const -> uint64_t;
+
+private:
+	auto checkOpen() const -> void;
+	std::unique_ptr<AbstractOutputStream> file_;
+	std::unique_ptr<JsonOutputStream> stream_;
+	std::variant<rapidjson::Writer<JsonOutputStream>, rapidjson::PrettyWriter<JsonOutputStream>> writer_;
+	uint64_t closedBytes_{0};
+	bool inArray_{false};
+};
+
+/// \brief Writes one top-level value.
+/// \details Several values may be written one after another; they are not separated.
+/// \param value The value.
+/// \throws std::logic_error If an array is open.
+/// \throws std::ios_base::failure If the writer is closed.
+template <typename T> auto JsonStreamWriter::write(const T& value) -> void {
+	checkOpen();
+	if (inArray_) {
+		throw std::logic_error("Cannot write a value inside an open array; use append()");
+	}
+	std::visit([&](auto& writer) {
+		writer.Reset(*stream_);
+		JsonReflection::writeValue(writer, value);
+	}, writer_);
+}
+
+/// \brief Writes one element of the array opened by beginArray().
+/// \param record The element.
+/// \throws std::logic_error If no array is open.
+/// \throws std::ios_base::failure If the writer is closed.
+template <typename T> auto JsonStreamWriter::append(const T& record) -> void {
+	checkOpen();
+	if (!inArray_) {
+		throw std::logic_error("No array open; call beginArray() first");
+	}
+	std::visit([&](auto& writer) {
+		JsonReflection::writeValue(writer, record);
+	}, writer_);
+}
+
+/// \brief Writes a range as a top-level array, one element at a time.
+/// \details The range is consumed as it is written, so a lazy view over millions of records never needs to be held in
+/// memory at once.
+/// \param records The elements.
+/// \return The number of elements written.
+template <std::ranges::input_range R> auto JsonStreamWriter::writeArray(R&& records) -> uint64_t {
+	beginArray();
+	uint64_t count = 0;
+	for (auto&& record : records) {
+		append(record);
+		++count;
+	}
+	endArray();
+	return count;
+}
+}
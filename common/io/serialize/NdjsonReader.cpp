@@ -0,0 +1,98 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "NdjsonReader.hpp"
+
+namespace common::io::serialize
+{
+/// \brief Reads NDJSON from a stream.
+/// \param stream The stream; it must outlive the reader.
+/// \param chunkSize The approximate number of bytes per chunk; a chunk grows to hold at least one whole line.
+/// \throws std::invalid_argument If the chunk size is 0.
+NdjsonReader::NdjsonReader(AbstractInputStream& stream, const size_t chunkSize): stream_(&stream), chunkSize_(chunkSize) {
+	if (chunkSize == 0) {
+		throw std::invalid_argument("Chunk size must be positive");
+	}
+}
+
+/// \brief Reads NDJSON from a file, which is mapped into memory.
+/// \param file The file.
+/// \param chunkSize The approximate number of bytes per chunk; a chunk grows to hold at least one whole line.
+/// \throws std::invalid_argument If the chunk size is 0.
+/// \throws std::ios_base::failure If the file cannot be opened or mapped.
+NdjsonReader::NdjsonReader(const std::filesystem::path& file, const size_t chunkSize): chunkSize_(chunkSize) {
+	if (chunkSize == 0) {
+		throw std::invalid_argument("Chunk size must be positive");
+	}
+	file_ = std::make_unique<MappedFile>(file, MappedFile::Access::SEQUENTIAL);
+}
+
+/// \brief Cuts the next chunk, ending after a line break or at the end of the input.
+/// \return The chunk, or nullptr at the end of the input.
+/// \throws std::ios_base::failure If the stream fails.
+auto NdjsonReader::nextChunk() -> std::shared_ptr<const Chunk> {
+	auto chunk = std::make_shared<Chunk>();
+	if (file_ != nullptr) {
+		const auto bytes = file_->bytes();
+		if (offset_ >= bytes.size()) {
+			return nullptr;
+		}
+		size_t end = std::min(bytes.size(), offset_ + chunkSize_);
+		const auto newline = std::find(bytes.begin() + static_cast<std::ptrdiff_t>(end - 1), bytes.end(), std::byte{'\n'});
+		end = newline == bytes.end() ? bytes.size() : static_cast<size_t>(newline - bytes.begin()) + 1;
+		chunk->bytes = bytes.subspan(offset_, end - offset_);
+		offset_ = end;
+	}
+	else {
+		auto& storage = chunk->storage;
+		storage.swap(carry_);
+		// Read at least a chunk beyond the part already searched, until a line break is found or the input ends
+		size_t searched = 0;
+		size_t cut;
+		while (true) {
+			while (!eof_ && storage.size() < searched + chunkSize_) {
+				readMore(storage, searched + chunkSize_ - storage.size());
+			}
+			const auto last = std::find(storage.rbegin(), storage.rend() - static_cast<std::ptrdiff_t>(searched), std::byte{'\n'});
+			if (last != storage.rend() - static_cast<std::ptrdiff_t>(searched)) {
+				cut = static_cast<size_t>(storage.rend() - last);
+				break;
+			}
+			searched = storage.size();
+			if (eof_) {
+				cut = storage.size();
+				break;
+			}
+		}
+		if (cut == 0) {
+			return nullptr;
+		}
+		carry_.assign(storage.begin() + static_cast<std::ptrdiff_t>(cut), storage.end());
+		storage.resize(cut);
+		chunk->bytes = storage;
+	}
+	chunk->firstLine = nextLine_;
+	nextLine_ += static_cast<uint64_t>(std::count(chunk->bytes.begin(), chunk->bytes.end(), std::byte{'\n'}));
+	return chunk;
+}
+
+/// \brief Appends up to length bytes of the stream to a buffer.
+/// \param storage The buffer.
+/// \param length The number of bytes requested.
+auto NdjsonReader::readMore(std::vector<std::byte>& storage, const size_t length) -> void {
+	const size_t size = storage.size();
+	storage.resize(size + length);
+	size_t bytesRead = stream_->read(storage, size, length);
+	if (bytesRead == 0 || bytesRead == static_cast<size_t>(-1)) {
+		eof_ = true;
+		bytesRead = 0;
+	}
+	storage.resize(size + bytesRead);
+}
+
+/// \brief Returns the SAX reader and handler of the calling thread.
+/// \return The state, created on first use.
+auto NdjsonReader::saxState() -> SaxState& {
+	thread_local SaxState state;
+	return state;
+}
+}
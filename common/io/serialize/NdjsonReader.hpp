@@ -0,0 +1,247 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <rapidjson/document.h>
+#include <rapidjson/reader.h>
+#include "JsonDocumentPool.hpp"
+#include "JsonInputStream.hpp"
+#include "JsonReflection.hpp"
+#include "JsonSaxHandler.hpp"
+#include "io/AbstractInputStream.hpp"
+#include "io/MappedFile.hpp"
+#include "io/interface/IfaceJsonSerializable.hpp"
+#include "thread/ThreadPool.hpp"
+
+namespace common::io::serialize
+{
+/// \brief Reads newline-delimited JSON (NDJSON): one JSON value per line.
+/// \details The input is cut into chunks of about the chunk size that end on a line break, and the chunks are parsed
+/// on a thread pool. A file is mapped into memory and its chunks are views of the mapping; a stream is read a chunk at
+/// a time, carrying the partial last line over to the next chunk. At most maxInFlight chunks are queued or held, so
+/// memory use does not grow with the input.
+///
+/// Reflected records (see JsonReflectable) are parsed with the SAX Reader straight into the record. Records derived
+/// from IfaceJsonSerializable are parsed into a document borrowed from the JsonDocumentPool of the worker thread,
+/// whose arena is rewound after every line instead of being freed.
+///
+/// With Order::ORDERED the visitor runs on the calling thread and sees the records in input order. With
+/// Order::UNORDERED it runs on the worker threads as soon as each record is parsed, so it must be thread-safe. Blank
+/// lines are skipped; records are identified by their line number, counting from 0.
+/// \remark When the pool queue is full a chunk is parsed on the calling thread.
+class NdjsonReader final
+{
+public:
+	enum class Order { ORDERED, UNORDERED };
+	template <typename T> using Visitor = std::function<void(uint64_t line, T& record)>;
+	static constexpr size_t DEFAULT_CHUNK_SIZE = 1024 * 1024;
+	explicit NdjsonReader(AbstractInputStream& stream, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+	explicit NdjsonReader(const std::filesystem::path& file, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+	template <typename T> auto forEach(const Visitor<T>& visitor) -> uint64_t;
+	template <typename T> auto forEach(thread::ThreadPool& pool, const Visitor<T>& visitor, Order order = Order::ORDERED, size_t maxInFlight = 0) -> uint64_t;
+	template <typename T> static auto parse(std::string_view line, T& record) -> bool;
+
+private:
+	struct Chunk
+	{
+		std::vector<std::byte> storage;
+		std::span<const std::byte> bytes;
+		uint64_t firstLine{0};
+	};
+
+	struct SaxState
+	{
+		rapidjson::Reader reader;
+		JsonSaxHandler handler;
+	};
+
+	template <typename T> static auto decode(const Chunk& chunk, const std::function<void(uint64_t, T&)>& sink, const std::atomic<bool>& failed) -> uint64_t;
+	auto nextChunk() -> std::shared_ptr<const Chunk>;
+	auto readMore(std::vector<std::byte>& storage, size_t length) -> void;
+	static auto saxState() -> SaxState&;
+	std::unique_ptr<MappedFile> file_;
+	AbstractInputStream* stream_{nullptr};
+	size_t chunkSize_;
+	size_t offset_{0};
+	std::vector<std::byte> carry_;
+	uint64_t nextLine_{0};
+	bool eof_{false};
+};
+
+/// \brief Parses one line into a record, using the state of the calling thread.
+/// \tparam T The record type, JsonReflectable or derived from IfaceJsonSerializable.
+/// \param line The JSON text.
+/// \param record Receives the record; members absent from the text keep their values.
+/// \return false if the text is not valid JSON.
+template <typename T> auto NdjsonReader::parse(const std::string_view line, T& record) -> bool {
+	static_assert(JsonReflectable<T> || std::is_base_of_v<interface::IfaceJsonSerializable, T>, "Records must be JsonReflectable or IfaceJsonSerializable");
+	if constexpr (JsonReflectable<T>) {
+		SaxState& state = saxState();
+		JsonInputStream stream(std::as_bytes(std::span(line)));
+		state.handler.reset(jsonSaxSlot(record));
+		return !state.reader.Parse(stream, state.handler).IsError();
+	}
+	else {
+		const auto lease = JsonDocumentPool::acquire();
+		rapidjson::Document& document = lease.document();
+		const bool parsed = !document.Parse(line.data(), line.size()).HasParseError();
+		if (parsed && document.IsObject()) {
+			record.deserialize(document);
+		}
+		return parsed;
+	}
+}
+
+/// \brief Parses the lines of a chunk and hands each record to a sink.
+/// \param chunk The chunk.
+/// \param sink The receiver of the records.
+/// \param failed Set when another chunk has failed; the chunk is then abandoned.
+/// \return The number of records parsed.
+/// \throws std::runtime_error If a line is not valid JSON.
+template <typename T> auto NdjsonReader::decode(const Chunk& chunk, const std::function<void(uint64_t, T&)>& sink, const std::atomic<bool>& failed) -> uint64_t {
+	const std::string_view text(reinterpret_cast<const char*>(chunk.bytes.data()), chunk.bytes.size());
+	uint64_t line = chunk.firstLine;
+	uint64_t records = 0;
+	for (size_t start = 0; start < text.size() && !failed.load(std::memory_order_relaxed); ++line) {
+		const size_t end = std::min(text.find('\n', start), text.size());
+		const std::string_view content = text.substr(start, end - start);
+		start = end + 1;
+		if (content.find_first_not_of(" \t\r") == std::string_view::npos) {
+			continue;
+		}
+		T record{};
+		if (!parse(content, record)) {
+			throw std::runtime_error("JSON parse error at line " + std::to_string(line));
+		}
+		sink(line, record);
+		++records;
+	}
+	return records;
+}
+
+/// \brief Reads every record on the calling thread.
+/// \tparam T The record type, JsonReflectable or derived from IfaceJsonSerializable.
+/// \param visitor The callback receiving each record and its line number.
+/// \return The number of records read.
+/// \throws std::runtime_error If a line is not valid JSON.
+template <typename T> auto NdjsonReader::forEach(const Visitor<T>& visitor) -> uint64_t {
+	const std::atomic<bool> failed{false};
+	uint64_t records = 0;
+	while (const auto chunk = nextChunk()) {
+		records += decode<T>(*chunk, visitor, failed);
+	}
+	return records;
+}
+
+/// \brief Reads every record, parsing chunks on a thread pool.
+/// \details The call returns when every chunk is done. After an error no further chunks are read, the chunks in flight
+/// are abandoned at their next line as soon as the failing worker reports it, and the first error is rethrown.
+/// \tparam T The record type, JsonReflectable or derived from IfaceJsonSerializable.
+/// \param pool The pool running the tasks.
+/// \param visitor The callback receiving each record and its line number.
+/// \param order Whether records are delivered in input order on the calling thread, or as parsed on the workers.
+/// \param maxInFlight The maximum number of chunks queued or awaiting delivery; 0 chooses twice the hardware
+/// concurrency.
+/// \return The number of records delivered.
+/// \throws std::runtime_error If a line is not valid JSON.
+/// \throws Any exception thrown by the visitor or the input stream.
+template <typename T> auto NdjsonReader::forEach(thread::ThreadPool& pool, const Visitor<T>& visitor, const Order order, size_t maxInFlight) -> uint64_t {
+	using Batch = std::vector<std::pair<uint64_t, T>>;
+	if (maxInFlight == 0) {
+		maxInFlight = 2 * std::max(1U, std::thread::hardware_concurrency());
+	}
+	std::atomic<bool> failed{false};
+	std::atomic<uint64_t> delivered{0};
+	const auto task = [&visitor, &failed, &delivered, order](const std::shared_ptr<const Chunk>& chunk) -> Batch {
+		Batch batch;
+		try {
+			if (order == Order::ORDERED) {
+				decode<T>(*chunk, [&batch](const uint64_t line, T& record) {
+					batch.emplace_back(line, std::move(record));
+				}, failed);
+			}
+			else {
+				delivered += decode<T>(*chunk, visitor, failed);
+			}
+		}
+		catch (...) {
+			// Stop the other workers now rather than when the calling thread reaches this chunk's future
+			failed = true;
+			throw;
+		}
+		return batch;
+	};
+	std::deque<std::future<Batch>> pending;
+	std::exception_ptr error;
+	const auto fail = [&error, &failed] {
+		if (!error) {
+			error = std::current_exception();
+		}
+		failed = true;
+	};
+	const auto deliver = [&] {
+		try {
+			for (auto& [line, record] : pending.front().get()) {
+				if (!error) {
+					visitor(line, record);
+					++delivered;
+				}
+			}
+		}
+		catch (...) {
+			fail();
+		}
+		pending.pop_front();
+	};
+	try {
+		while (!error) {
+			const auto chunk = nextChunk();
+			if (chunk == nullptr) {
+				break;
+			}
+			if (pending.size() >= maxInFlight) {
+				deliver();
+			}
+			try {
+				pending.push_back(pool.Submit(task, chunk));
+			}
+			catch (const std::runtime_error&) {
+				std::promise<Batch> promise;
+				try {
+					promise.set_value(task(chunk));
+				}
+				catch (...) {
+					promise.set_exception(std::current_exception());
+				}
+				pending.push_back(promise.get_future());
+			}
+		}
+	}
+	catch (...) {
+		fail();
+	}
+	while (!pending.empty()) {
+		deliver();
+	}
+	if (error) {
+		std::rethrow_exception(error);
+	}
+	return delivered;
+}
+}
@@ -0,0 +1,86 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#include "NdjsonWriter.hpp"
+#include <ios>
+#include "io/FileOutputStream.hpp"
+
+namespace common::io::serialize
+{
+/// \brief Writes NDJSON to a stream.
+/// \param stream The stream; it must outlive the writer, which neither closes it nor flushes it before flush() or
+/// close().
+/// \param bufferSize The size of the chunks handed to the stream.
+NdjsonWriter::NdjsonWriter(AbstractOutputStream& stream, const size_t bufferSize): stream_(std::make_unique<JsonOutputStream>(stream, bufferSize)), writer_(*stream_) {}
+
+/// \brief Writes NDJSON to a file, replacing its content.
+/// \param file The file.
+/// \param bufferSize The size of the chunks written to the file.
+/// \throws std::ios_base::failure If the file cannot be created.
+NdjsonWriter::NdjsonWriter(const std::filesystem::path& file, const size_t bufferSize): file_(std::make_unique<FileOutputStream>(file)), stream_(std::make_unique<JsonOutputStream>(*file_, bufferSize)), writer_(*stream_) {}
+
+NdjsonWriter::~NdjsonWriter() {
+	try {
+		close();
+	}
+	catch (...) {
+		// Suppress exceptions in destructors
+	}
+}
+
+/// \brief Hands the pending text to the stream and flushes it.
+/// \throws std::ios_base::failure If the writer is closed.
+auto NdjsonWriter::flush() -> void {
+	checkOpen();
+	stream_->flush();
+}
+
+/// \brief Flushes the pending text; a file opened by the writer is closed as well.
+auto NdjsonWriter::close() -> void {
+	if (stream_ == nullptr) {
+		return;
+	}
+	stream_->flush();
+	closedBytes_ = stream_->bytesWritten();
+	stream_.reset();
+	if (file_ != nullptr) {
+		file_->close();
+		file_.reset();
+	}
+}
+
+/// \brief Returns the number of records written.
+/// \return The record count.
+auto NdjsonWriter::count() const -> uint64_t {
+	return count_;
+}
+
+/// \brief Returns the number of characters written.
+/// \return The character count, including text not yet handed to the stream.
+auto NdjsonWriter::bytesWritten() const -> uint64_t {
+	return stream_ != nullptr ? stream_->bytesWritten() : closedBytes_;
+}
+
+/// \brief Appends a rendered batch; called by the workers of an unordered writeAll(), so it locks.
+/// \param text The lines.
+/// \param records The number of lines.
+auto NdjsonWriter::writeBatch(const std::vector<std::byte>& text, const uint64_t records) -> void {
+	std::lock_guard lock(mutex_);
+	stream_->write(text);
+	count_ += records;
+}
+
+/// \brief Checks that the writer is open.
+/// \throws std::ios_base::failure If the writer is closed.
+auto NdjsonWriter::checkOpen() const -> void {
+	if (stream_ == nullptr) {
+		throw std::ios_base::failure("Stream closed");
+	}
+}
+
+/// \brief Returns the render buffer of the calling thread, which keeps its capacity between batches.
+/// \return The buffer.
+auto NdjsonWriter::threadBuffer() -> rapidjson::StringBuffer& {
+	thread_local rapidjson::StringBuffer buffer;
+	return buffer;
+}
+}
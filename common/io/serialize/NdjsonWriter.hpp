@@ -0,0 +1,169 @@
+// Created by author ethereal on 2026/10/18.
+// Copyright (c) 2026 ethereal. All rights reserved.
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include "JsonOutputStream.hpp"
+#include "JsonReflection.hpp"
+#include "NdjsonReader.hpp"
+#include "io/AbstractOutputStream.hpp"
+#include "thread/ThreadPool.hpp"
+
+namespace common::io::serialize
+{
+/// \brief Writes newline-delimited JSON (NDJSON): one compact JSON value per line.
+/// \details write() renders a record straight into the JsonOutputStream chunk. writeAll() splits a range into batches
+/// of records and renders each batch on a thread pool into a per-thread buffer; the batches are written in input
+/// order, or with Order::UNORDERED as soon as each is rendered. At most maxInFlight batches are queued or held.
+/// Records are anything JsonReflection::writeValue supports, usually reflected or IfaceJsonSerializable types.
+/// \remark The writer is not thread-safe, apart from the workers of writeAll().
+class NdjsonWriter final
+{
+public:
+	using Order = NdjsonReader::Order;
+	static constexpr size_t DEFAULT_BATCH_SIZE = 4096;
+	explicit NdjsonWriter(AbstractOutputStream& stream, size_t bufferSize = JsonOutputStream::DEFAULT_BUFFER_SIZE);
+	explicit NdjsonWriter(const std::filesystem::path& file, size_t bufferSize = JsonOutputStream::DEFAULT_BUFFER_SIZE);
+	~NdjsonWriter();
+	NdjsonWriter(const NdjsonWriter&) = delete;
+	auto operator=(const NdjsonWriter&) -> NdjsonWriter& = delete;
+	template <typename T> auto write(const T& record) -> void;
+	template <std::ranges::random_access_range R> auto writeAll(thread::ThreadPool& pool, R&& records, Order order = Order::ORDERED, size_t batchSize = DEFAULT_BATCH_SIZE, size_t maxInFlight = 0) -> uint64_t;
+	auto flush() -> void;
+	auto close() -> void;
+	[[nodiscard]] auto count() const -> uint64_t;
+	[[nodiscard]] auto bytesWritten() const -> uint64_t;
+
+private:
+	template <std::ranges::random_access_range R> static auto render(R& records, size_t first, size_t last) -> std::vector<std::byte>;
+	auto writeBatch(const std::vector<std::byte>& text, uint64_t records) -> void;
+	auto checkOpen() const -> void;
+	static auto threadBuffer() -> rapidjson::StringBuffer&;
+	std::unique_ptr<AbstractOutputStream> file_;
+	std::unique_ptr<JsonOutputStream> stream_;
+	rapidjson::Writer<JsonOutputStream> writer_;
+	std::mutex mutex_;
+	uint64_t count_{0};
+	uint64_t closedBytes_{0};
+};
+
+/// \brief Writes one record as a line.
+/// \param record The record.
+/// \throws std::ios_base::failure If the writer is closed.
+template <typename T> auto NdjsonWriter::write(const T& record) -> void {
+	checkOpen();
+	writer_.Reset(*stream_);
+	JsonReflection::writeValue(writer_, record);
+	stream_->Put('\n');
+	++count_;
+}
+
+/// \brief Renders a batch of records as lines.
+/// \param records The records.
+/// \param first The index of the first record of the batch.
+/// \param last The index after the last record of the batch.
+/// \return The text.
+template <std::ranges::random_access_range R> auto NdjsonWriter::render(R& records, const size_t first, const size_t last) -> std::vector<std::byte> {
+	rapidjson::StringBuffer& buffer = threadBuffer();
+	buffer.Clear();
+	rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+	for (size_t i = first; i < last; ++i) {
+		writer.Reset(buffer);
+		JsonReflection::writeValue(writer, std::ranges::begin(records)[static_cast<std::ranges::range_difference_t<R>>(i)]);
+		buffer.Put('\n');
+	}
+	const auto* text = reinterpret_cast<const std::byte*>(buffer.GetString());
+	return {text, text + buffer.GetSize()};
+}
+
+/// \brief Writes a range of records, rendering batches of them on a thread pool.
+/// \details The call returns when every batch is done. After an error no further batches are started, and the first
+/// error is rethrown; the output then holds a subset of the records.
+/// \param pool The pool running the tasks.
+/// \param records The records; they are read concurrently and must not change during the call.
+/// \param order Whether the lines keep the order of the range.
+/// \param batchSize The number of records per task.
+/// \param maxInFlight The maximum number of batches queued or awaiting their turn; 0 chooses twice the hardware
+/// concurrency.
+/// \return The number of records written.
+/// \throws std::invalid_argument If the batch size is 0.
+/// \throws std::ios_base::failure If the writer is closed or the stream fails.
+template <std::ranges::random_access_range R> auto NdjsonWriter::writeAll(thread::ThreadPool& pool, R&& records, const Order order, const size_t batchSize, size_t maxInFlight) -> uint64_t {
+	checkOpen();
+	if (batchSize == 0) {
+		throw std::invalid_argument("Batch size must be positive");
+	}
+	if (maxInFlight == 0) {
+		maxInFlight = 2 * std::max(1U, std::thread::hardware_concurrency());
+	}
+	struct Batch
+	{
+		std::vector<std::byte> text;
+		uint64_t records;
+	};
+	const auto size = static_cast<size_t>(std::ranges::distance(records));
+	const uint64_t before = count_;
+	const auto task = [this, &records, order](const size_t first, const size_t last) -> Batch {
+		Batch batch{render(records, first, last), last - first};
+		if (order == Order::UNORDERED) {
+			writeBatch(batch.text, batch.records);
+			batch.text.clear();
+		}
+		return batch;
+	};
+	std::deque<std::future<Batch>> pending;
+	std::exception_ptr error;
+	const auto complete = [&] {
+		try {
+			const Batch batch = pending.front().get();
+			if (order == Order::ORDERED && !error) {
+				writeBatch(batch.text, batch.records);
+			}
+		}
+		catch (...) {
+			if (!error) {
+				error = std::current_exception();
+			}
+		}
+		pending.pop_front();
+	};
+	for (size_t first = 0; first < size && !error; first += batchSize) {
+		const size_t last = std::min(size, first + batchSize);
+		if (pending.size() >= maxInFlight) {
+			complete();
+		}
+		try {
+			pending.push_back(pool.Submit(task, first, last));
+		}
+		catch (const std::runtime_error&) {
+			std::promise<Batch> promise;
+			try {
+				promise.set_value(task(first, last));
+			}
+			catch (...) {
+				promise.set_exception(std::current_exception());
+			}
+			pending.push_back(promise.get_future());
+		}
+	}
+	while (!pending.empty()) {
+		complete();
+	}
+	if (error) {
+		std::rethrow_exception(error);
+	}
+	return count_ - before;
+}
+}
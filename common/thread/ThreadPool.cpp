@@ -25,34 +25,6 @@ ThreadPool::~ThreadPool() {
 	Shutdown();
 }
 
-/// \brief Submit a task to the thread pool for execution.
-/// \tparam F The type of the function to be executed.
-/// \tparam Args The types of the arguments to be passed to the function.
-/// \param f The function to be executed.
-/// \param args The arguments to be passed to the function.
-/// \return A future object that will hold the result of the function execution.
-/// \throws std::runtime_error if the task queue is full.
-/// \details This function creates a packaged task from the function and arguments
-/// and adds it to the task queue. If the queue is full, it throws an exception.
-/// A worker thread will eventually execute the task, and the result can be
-/// retrieved from the returned future object.
-template <class F, class... Args> auto ThreadPool::Submit(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
-	using return_type = std::invoke_result_t<F, Args...>;
-	auto task = std::make_shared<std::packaged_task<return_type()>>(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
-	std::future<return_type> res = task->get_future();
-	{
-		std::unique_lock lock(queueMutex_);
-		if (task_queue_.size() >= maxQueueSize_) {
-			throw std::runtime_error("Task queue is full");
-		}
-		task_queue_.emplace([task] {
-			(*task)();
-		});
-	}
-	condition_.notify_one();
-	return res;
-}
-
 /// \brief Shuts down all the threads in the pool.
 /// \details This function notifies all the worker threads to finish their
 /// tasks and exit. It then waits for all the threads to finish and clears